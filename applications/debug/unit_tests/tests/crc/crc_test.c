@@ -0,0 +1,430 @@
+#include <furi.h>
+#include <furi_hal_random.h>
+#include "../test.h" // IWYU pragma: keep
+
+#include <toolbox/crc.h>
+#include <toolbox/crc32_calc.h>
+#include <bit_lib/bit_lib.h>
+#include <one_wire/maxim_crc.h>
+#include <nfc/helpers/iso14443_crc.h>
+#include <nfc/helpers/iso13239_crc.h>
+#include <lib/subghz/blocks/math.h>
+
+#define TAG "CrcTest"
+
+#define CRC_TEST_ROUNDS       (2000)
+#define CRC_TEST_DATA_MAX     (64)
+#define CRC_TEST_BENCH_SIZE   (4096)
+#define CRC_TEST_BENCH_ROUNDS (16)
+
+static const uint8_t crc_test_check_data[] = "123456789";
+
+// Implementations replaced by the CRC engine, results must match them exactly
+
+static uint16_t crc_test_ref_iso14443(bool type_a, const uint8_t* data, size_t size) {
+    uint16_t crc = type_a ? 0x6363 : 0xFFFF;
+    for(size_t i = 0; i < size; i++) {
+        uint8_t byte = data[i];
+        byte ^= (uint8_t)(crc & 0xff);
+        byte ^= byte << 4;
+        crc = (crc >> 8) ^ (((uint16_t)byte) << 8) ^ (((uint16_t)byte) << 3) ^ (byte >> 4);
+    }
+    return type_a ? crc : ~crc;
+}
+
+static uint16_t crc_test_ref_iso13239(bool picopass, const uint8_t* data, size_t size) {
+    uint16_t crc = picopass ? 0xE012 : 0xFFFF;
+    for(size_t i = 0; i < size; ++i) {
+        crc ^= (uint16_t)data[i];
+        for(size_t j = 0; j < 8; ++j) {
+            if(crc & 1U) {
+                crc = (crc >> 1) ^ 0x8408;
+            } else {
+                crc >>= 1;
+            }
+        }
+    }
+    return picopass ? crc : ~crc;
+}
+
+static uint16_t crc_test_ref_felica(const uint8_t* data, size_t size) {
+    uint16_t crc = 0;
+    for(size_t i = 0; i < size; i++) {
+        crc ^= ((uint16_t)data[i] << 8);
+        for(size_t j = 0; j < 8; j++) {
+            if(crc & 0x8000) {
+                crc = (crc << 1) ^ 0x1021;
+            } else {
+                crc <<= 1;
+            }
+        }
+    }
+    return (crc << 8) | (crc >> 8);
+}
+
+static uint8_t crc_test_ref_maxim(const uint8_t* data, uint8_t size, uint8_t crc) {
+    for(uint8_t index = 0; index < size; ++index) {
+        uint8_t input_byte = data[index];
+        for(uint8_t bit_position = 0; bit_position < 8; ++bit_position) {
+            const uint8_t mix = (crc ^ input_byte) & (uint8_t)(0x01);
+            crc >>= 1;
+            if(mix != 0) crc ^= 0x8C;
+            input_byte >>= 1;
+        }
+    }
+    return crc;
+}
+
+static uint32_t crc_test_ref_crc32(uint32_t crc, const uint8_t* data, size_t size) {
+    static const uint32_t rtable[16] = {
+        0x00000000,
+        0x1db71064,
+        0x3b6e20c8,
+        0x26d930ac,
+        0x76dc4190,
+        0x6b6b51f4,
+        0x4db26158,
+        0x5005713c,
+        0xedb88320,
+        0xf00f9344,
+        0xd6d6a3e8,
+        0xcb61b38c,
+        0x9b64c2b0,
+        0x86d3d2d4,
+        0xa00ae278,
+        0xbdbdf21c,
+    };
+
+    crc = ~crc;
+    for(size_t i = 0; i < size; i++) {
+        crc = (crc >> 4) ^ rtable[(crc ^ (data[i] >> 0)) & 0xf];
+        crc = (crc >> 4) ^ rtable[(crc ^ (data[i] >> 4)) & 0xf];
+    }
+    return ~crc;
+}
+
+static uint32_t crc_test_ref_reverse(uint32_t value, uint8_t width) {
+    uint32_t result = 0;
+    for(uint8_t i = 0; i < width; i++) {
+        result = (result << 1) | FURI_BIT(value, i);
+    }
+    return result;
+}
+
+static uint8_t crc_test_ref_bit_lib_crc8(
+    const uint8_t* data,
+    size_t size,
+    uint8_t polynom,
+    uint8_t crc,
+    bool ref_in,
+    bool ref_out,
+    uint8_t xor_out) {
+    for(size_t i = 0; i < size; ++i) {
+        uint8_t byte = data[i];
+        if(ref_in) byte = crc_test_ref_reverse(byte, 8);
+        crc ^= byte;
+        for(size_t j = 8; j > 0; --j) {
+            if(crc & 0x80) {
+                crc = (crc << 1) ^ polynom;
+            } else {
+                crc = (crc << 1);
+            }
+        }
+    }
+    if(ref_out) crc = crc_test_ref_reverse(crc, 8);
+    return crc ^ xor_out;
+}
+
+static uint16_t crc_test_ref_bit_lib_crc16(
+    const uint8_t* data,
+    size_t size,
+    uint16_t polynom,
+    uint16_t crc,
+    bool ref_in,
+    bool ref_out,
+    uint16_t xor_out) {
+    for(size_t i = 0; i < size; ++i) {
+        uint8_t byte = data[i];
+        if(ref_in) byte = crc_test_ref_reverse(byte, 8);
+        for(size_t j = 0; j < 8; ++j) {
+            bool c15 = (crc >> 15 & 1);
+            bool bit = (byte >> (7 - j) & 1);
+            crc <<= 1;
+            if(c15 ^ bit) crc ^= polynom;
+        }
+    }
+    if(ref_out) crc = crc_test_ref_reverse(crc, 16);
+    return crc ^ xor_out;
+}
+
+static uint8_t crc_test_ref_subghz_crc8(
+    const uint8_t* data,
+    size_t size,
+    uint8_t polynomial,
+    uint8_t remainder,
+    bool le) {
+    if(le) {
+        remainder = crc_test_ref_reverse(remainder, 8);
+        polynomial = crc_test_ref_reverse(polynomial, 8);
+    }
+    for(size_t byte = 0; byte < size; ++byte) {
+        remainder ^= data[byte];
+        for(uint8_t bit = 0; bit < 8; ++bit) {
+            if(le) {
+                remainder = (remainder & 1) ? (remainder >> 1) ^ polynomial : remainder >> 1;
+            } else {
+                remainder = (remainder & 0x80) ? (remainder << 1) ^ polynomial : remainder << 1;
+            }
+        }
+    }
+    return remainder;
+}
+
+static uint16_t crc_test_ref_subghz_crc16(
+    const uint8_t* data,
+    size_t size,
+    uint16_t polynomial,
+    uint16_t remainder,
+    bool lsb) {
+    for(size_t byte = 0; byte < size; ++byte) {
+        remainder ^= lsb ? data[byte] : data[byte] << 8;
+        for(uint8_t bit = 0; bit < 8; ++bit) {
+            if(lsb) {
+                remainder = (remainder & 1) ? (remainder >> 1) ^ polynomial : remainder >> 1;
+            } else {
+                remainder = (remainder & 0x8000) ? (remainder << 1) ^ polynomial :
+                                                   remainder << 1;
+            }
+        }
+    }
+    return remainder;
+}
+
+static const CrcModel* const crc_test_models[] = {
+    &crc_model_maxim,
+    &crc_model_iso14443a,
+    &crc_model_x25,
+    &crc_model_picopass,
+    &crc_model_xmodem,
+    &crc_model_crc32,
+};
+
+MU_TEST(test_crc_check_values) {
+    const size_t size = sizeof(crc_test_check_data) - 1;
+    mu_assert_int_eq(0xA1, crc_calculate(&crc_model_maxim, crc_test_check_data, size));
+    mu_assert_int_eq(0xBF05, crc_calculate(&crc_model_iso14443a, crc_test_check_data, size));
+    mu_assert_int_eq(0x906E, crc_calculate(&crc_model_x25, crc_test_check_data, size));
+    mu_assert_int_eq(0x31C3, crc_calculate(&crc_model_xmodem, crc_test_check_data, size));
+    mu_assert_int_eq(0xCBF43926, crc_calculate(&crc_model_crc32, crc_test_check_data, size));
+    mu_assert_int_eq(
+        crc_test_ref_iso13239(true, crc_test_check_data, size),
+        crc_calculate(&crc_model_picopass, crc_test_check_data, size));
+
+    // Same models calculated bit by bit
+    for(size_t i = 0; i < COUNT_OF(crc_test_models); i++) {
+        CrcModel bitwise = *crc_test_models[i];
+        bitwise.table = NULL;
+        mu_assert_int_eq(
+            crc_calculate(crc_test_models[i], crc_test_check_data, size),
+            crc_calculate(&bitwise, crc_test_check_data, size));
+    }
+}
+
+MU_TEST(test_crc_tables) {
+    for(size_t i = 0; i < COUNT_OF(crc_test_models); i++) {
+        const CrcModel* model = crc_test_models[i];
+        const size_t size = crc_table_size(model);
+        void* table = malloc(size);
+
+        crc_table_fill(model, table);
+        mu_assert_mem_eq(model->table, table, size);
+
+        free(table);
+    }
+}
+
+static void crc_test_random_model(CrcModel* model) {
+    static const uint8_t widths[] = {8, 16, 32};
+    const uint32_t flags = furi_hal_random_get();
+
+    model->width = widths[flags % COUNT_OF(widths)];
+    model->ref_in = flags & 0x100;
+    model->ref_out = flags & 0x200;
+    model->poly = furi_hal_random_get();
+    model->init = furi_hal_random_get();
+    model->xor_out = furi_hal_random_get();
+    model->table = NULL;
+    model->slices = 1;
+    if(model->width == 32 && model->ref_in && (flags & 0x400)) {
+        model->slices = (flags & 0x800) ? 8 : 4;
+    }
+}
+
+static void crc_test_engine_round(const uint8_t* data, size_t size) {
+    CrcModel model;
+    crc_test_random_model(&model);
+    const uint32_t expected = crc_calculate(&model, data, size);
+
+    // Table driven calculation of a random model
+    void* table = malloc(crc_table_size(&model));
+    crc_table_fill(&model, table);
+    model.table = table;
+    mu_assert_int_eq(expected, crc_calculate(&model, data, size));
+
+    // Incremental calculation, split at a random point
+    const size_t split = size ? furi_hal_random_get() % size : 0;
+    uint32_t crc = crc_init(&model);
+    crc = crc_update(&model, crc, data, split);
+    crc = crc_update(&model, crc, data + split, size - split);
+    mu_assert_int_eq(expected, crc_finish(&model, crc));
+
+    free(table);
+}
+
+static void crc_test_nfc_round(const uint8_t* data, size_t size, BitBuffer* buf) {
+    uint16_t crc;
+
+    for(size_t i = 0; i < 2; i++) {
+        bit_buffer_copy_bytes(buf, data, size);
+        iso14443_crc_append(i ? Iso14443CrcTypeB : Iso14443CrcTypeA, buf);
+        bit_buffer_write_bytes_mid(buf, &crc, size, sizeof(crc));
+        mu_assert_int_eq(crc_test_ref_iso14443(!i, data, size), crc);
+
+        bit_buffer_copy_bytes(buf, data, size);
+        iso13239_crc_append(i ? Iso13239CrcTypePicopass : Iso13239CrcTypeDefault, buf);
+        bit_buffer_write_bytes_mid(buf, &crc, size, sizeof(crc));
+        mu_assert_int_eq(crc_test_ref_iso13239(i, data, size), crc);
+    }
+
+    crc = crc_calculate(&crc_model_xmodem, data, size);
+    mu_assert_int_eq(crc_test_ref_felica(data, size), (uint16_t)((crc << 8) | (crc >> 8)));
+}
+
+static void crc_test_legacy_round(const uint8_t* data, size_t size) {
+    const uint32_t init = furi_hal_random_get();
+    const uint32_t poly = furi_hal_random_get();
+    const uint32_t xor_out = furi_hal_random_get();
+    const bool ref_in = init & 0x10000;
+    const bool ref_out = poly & 0x10000;
+
+    mu_assert_int_eq(crc_test_ref_maxim(data, size, init), maxim_crc8(data, size, init));
+    mu_assert_int_eq(crc_test_ref_crc32(init, data, size), crc32_calc_buffer(init, data, size));
+
+    mu_assert_int_eq(
+        crc_test_ref_bit_lib_crc8(data, size, poly, init, ref_in, ref_out, xor_out),
+        bit_lib_crc8(data, size, poly, init, ref_in, ref_out, xor_out));
+    mu_assert_int_eq(
+        crc_test_ref_bit_lib_crc16(data, size, poly, init, ref_in, ref_out, xor_out),
+        bit_lib_crc16(data, size, poly, init, ref_in, ref_out, xor_out));
+
+    mu_assert_int_eq(
+        crc_test_ref_subghz_crc8(data, size, poly, init, false),
+        subghz_protocol_blocks_crc8(data, size, poly, init));
+    mu_assert_int_eq(
+        crc_test_ref_subghz_crc8(data, size, poly, init, true),
+        subghz_protocol_blocks_crc8le(data, size, poly, init));
+    mu_assert_int_eq(
+        crc_test_ref_subghz_crc16(data, size, poly, init, false),
+        subghz_protocol_blocks_crc16(data, size, poly, init));
+    mu_assert_int_eq(
+        crc_test_ref_subghz_crc16(data, size, poly, init, true),
+        subghz_protocol_blocks_crc16lsb(data, size, poly, init));
+}
+
+MU_TEST(test_crc_equivalence) {
+    uint8_t data[CRC_TEST_DATA_MAX];
+    BitBuffer* buf = bit_buffer_alloc(CRC_TEST_DATA_MAX + sizeof(uint16_t));
+
+    for(size_t i = 0; i < CRC_TEST_ROUNDS; i++) {
+        const size_t size = furi_hal_random_get() % (CRC_TEST_DATA_MAX + 1);
+        furi_hal_random_fill_buf(data, size);
+
+        crc_test_engine_round(data, size);
+        crc_test_nfc_round(data, size, buf);
+        crc_test_legacy_round(data, size);
+    }
+
+    bit_buffer_free(buf);
+}
+
+// Keeps the reference loops from being optimized out
+static volatile uint32_t crc_test_bench_result;
+
+static uint32_t crc_test_bench_model(const CrcModel* model, const uint8_t* data) {
+    uint32_t start = furi_get_tick();
+    for(size_t i = 0; i < CRC_TEST_BENCH_ROUNDS; i++) {
+        crc_test_bench_result = crc_calculate(model, data, CRC_TEST_BENCH_SIZE);
+    }
+    return furi_get_tick() - start;
+}
+
+MU_TEST(test_crc_benchmark) {
+    uint8_t* data = malloc(CRC_TEST_BENCH_SIZE);
+    furi_hal_random_fill_buf(data, CRC_TEST_BENCH_SIZE);
+
+    uint32_t start = furi_get_tick();
+    for(size_t i = 0; i < CRC_TEST_BENCH_ROUNDS; i++) {
+        crc_test_bench_result = crc_test_ref_iso14443(false, data, CRC_TEST_BENCH_SIZE);
+    }
+    uint32_t ref_ticks = furi_get_tick() - start;
+
+    CrcModel model = crc_model_x25;
+    uint32_t table_ticks = crc_test_bench_model(&model, data);
+    model.table = NULL;
+    uint32_t bitwise_ticks = crc_test_bench_model(&model, data);
+
+    FURI_LOG_I(
+        TAG,
+        "CRC-16 of %d KiB: %lu ticks before, %lu ticks bitwise, %lu ticks table",
+        CRC_TEST_BENCH_ROUNDS * CRC_TEST_BENCH_SIZE / 1024,
+        ref_ticks,
+        bitwise_ticks,
+        table_ticks);
+
+    start = furi_get_tick();
+    for(size_t i = 0; i < CRC_TEST_BENCH_ROUNDS; i++) {
+        crc_test_bench_result = crc_test_ref_crc32(0, data, CRC_TEST_BENCH_SIZE);
+    }
+    ref_ticks = furi_get_tick() - start;
+
+    model = crc_model_crc32;
+    uint32_t slice4_ticks = crc_test_bench_model(&model, data);
+    model.slices = 1;
+    table_ticks = crc_test_bench_model(&model, data);
+
+    model.slices = 8;
+    void* table = malloc(crc_table_size(&model));
+    crc_table_fill(&model, table);
+    model.table = table;
+    uint32_t slice8_ticks = crc_test_bench_model(&model, data);
+    mu_assert_int_eq(
+        crc_calculate(&crc_model_crc32, data, CRC_TEST_BENCH_SIZE),
+        crc_calculate(&model, data, CRC_TEST_BENCH_SIZE));
+
+    FURI_LOG_I(
+        TAG,
+        "CRC-32 of %d KiB: %lu ticks before, %lu ticks table, %lu ticks slice-by-4, "
+        "%lu ticks slice-by-8",
+        CRC_TEST_BENCH_ROUNDS * CRC_TEST_BENCH_SIZE / 1024,
+        ref_ticks,
+        table_ticks,
+        slice4_ticks,
+        slice8_ticks);
+
+    free(table);
+    free(data);
+}
+
+MU_TEST_SUITE(test_crc_suite) {
+    MU_RUN_TEST(test_crc_check_values);
+    MU_RUN_TEST(test_crc_tables);
+    MU_RUN_TEST(test_crc_equivalence);
+    MU_RUN_TEST(test_crc_benchmark);
+}
+
+int run_minunit_test_crc(void) {
+    MU_RUN_SUITE(test_crc_suite);
+    return MU_EXIT_CODE;
+}
+
+TEST_API_DEFINE(run_minunit_test_crc)
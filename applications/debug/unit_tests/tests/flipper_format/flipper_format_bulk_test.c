@@ -0,0 +1,324 @@
+#include <furi.h>
+#include <flipper_format/flipper_format.h>
+#include <flipper_format/flipper_format_i.h>
+#include <flipper_format/flipper_format_stream.h>
+#include <toolbox/stream/stream.h>
+#include <storage/storage.h>
+#include "../test.h" // IWYU pragma: keep
+
+#define TAG "FlipperFormatBulkTest"
+
+#define BULK_TEST_FILE EXT_PATH(".tmp/unit_tests/ff/ff_bulk.test")
+
+#define BULK_TEST_BLOCKS      256
+#define BULK_TEST_BLOCK_SIZE  16
+#define BULK_TEST_RAW_SAMPLES 1024
+
+static const char* test_bulk_data = "Filetype: Bulk test\n"
+                                    "Hex: 00 01 7F 80 ff Ab\n"
+                                    "Tabs:\t01\t \t02 \t03\t\r\n"
+                                    "Long: 00000000000000000000000000000000000000000000000042 -7\n"
+                                    "Wide: 0123456789ABCDEF0 FFFFFFFFFFFFFFFF\n"
+                                    "Bool: TRUE false yes\n"
+                                    "Short: 01 02\n"
+                                    "Last: 10 20";
+
+static int32_t test_bulk_raw_sample(size_t i) {
+    int32_t sample = 100 + (i * 37) % 9000;
+    return (i & 1) ? -sample : sample;
+}
+
+// Values as they were formatted before bulk writing, one printf per value
+static void test_bulk_expected_line(
+    FuriString* line,
+    const char* key,
+    FlipperStreamValue type,
+    const void* data,
+    size_t data_size) {
+    furi_string_printf(line, "%s: ", key);
+    for(size_t i = 0; i < data_size; i++) {
+        if(i) furi_string_cat(line, " ");
+        switch(type) {
+        case FlipperStreamValueHex:
+            furi_string_cat_printf(line, "%02X", ((const uint8_t*)data)[i]);
+            break;
+        case FlipperStreamValueFloat:
+            furi_string_cat_printf(line, "%f", (double)((const float*)data)[i]);
+            break;
+        case FlipperStreamValueInt32:
+            furi_string_cat_printf(line, "%ld", ((const int32_t*)data)[i]);
+            break;
+        case FlipperStreamValueUint32:
+            furi_string_cat_printf(line, "%lu", ((const uint32_t*)data)[i]);
+            break;
+        case FlipperStreamValueHexUint64: {
+            const uint64_t value = ((const uint64_t*)data)[i];
+            furi_string_cat_printf(line, "%08lX%08lX", (uint32_t)(value >> 32), (uint32_t)value);
+        } break;
+        case FlipperStreamValueBool:
+            furi_string_cat(line, ((const bool*)data)[i] ? "true" : "false");
+            break;
+        default:
+            furi_crash();
+        }
+    }
+    furi_string_cat(line, "\n");
+}
+
+static bool test_bulk_check_line(
+    FlipperFormat* flipper_format,
+    FuriString* expected,
+    FuriString* actual,
+    const char* key,
+    FlipperStreamValue type,
+    const void* data,
+    size_t data_size) {
+    Stream* stream = flipper_format_get_raw_stream(flipper_format);
+    stream_clean(stream);
+
+    FlipperStreamWriteData write_data = {
+        .key = key,
+        .type = type,
+        .data = data,
+        .data_size = data_size,
+    };
+    if(!flipper_format_stream_write_value_line(stream, &write_data)) return false;
+
+    test_bulk_expected_line(expected, key, type, data, data_size);
+
+    furi_string_reset(actual);
+    stream_rewind(stream);
+    uint8_t c;
+    while(stream_read(stream, &c, 1) == 1) {
+        furi_string_push_back(actual, c);
+    }
+
+    return furi_string_equal(expected, actual);
+}
+
+static void test_bulk_write(void) {
+    FlipperFormat* flipper_format = flipper_format_string_alloc();
+    FuriString* expected = furi_string_alloc();
+    FuriString* actual = furi_string_alloc();
+
+    uint8_t hex[64];
+    int32_t int32[40];
+    uint32_t uint32[40];
+    uint64_t uint64[8];
+    float floats[8];
+    bool bools[8];
+    for(size_t i = 0; i < COUNT_OF(hex); i++) {
+        hex[i] = i * 73;
+    }
+    for(size_t i = 0; i < COUNT_OF(int32); i++) {
+        int32[i] = (i & 1) ? INT32_MIN + i : INT32_MAX - i * 1000003;
+        uint32[i] = UINT32_MAX - i * 7777777;
+    }
+    for(size_t i = 0; i < COUNT_OF(uint64); i++) {
+        uint64[i] = 0x0123456789ABCDEFULL * (i + 1);
+        bools[i] = i & 1;
+    }
+    floats[0] = 0.0f;
+    floats[1] = -1.5f;
+    floats[2] = 3.0e38f;
+    floats[3] = -3.4e38f;
+    floats[4] = 1.0e-7f;
+    floats[5] = 1000.0f;
+    floats[6] = 0.1f;
+    floats[7] = -0.0f;
+
+    mu_check(test_bulk_check_line(
+        flipper_format, expected, actual, "Hex", FlipperStreamValueHex, hex, COUNT_OF(hex)));
+    mu_check(test_bulk_check_line(
+        flipper_format, expected, actual, "Empty", FlipperStreamValueHex, hex, 0));
+    mu_check(test_bulk_check_line(
+        flipper_format, expected, actual, "Int", FlipperStreamValueInt32, int32, COUNT_OF(int32)));
+    mu_check(test_bulk_check_line(
+        flipper_format,
+        expected,
+        actual,
+        "Uint",
+        FlipperStreamValueUint32,
+        uint32,
+        COUNT_OF(uint32)));
+    mu_check(test_bulk_check_line(
+        flipper_format,
+        expected,
+        actual,
+        "Uint64",
+        FlipperStreamValueHexUint64,
+        uint64,
+        COUNT_OF(uint64)));
+    mu_check(test_bulk_check_line(
+        flipper_format,
+        expected,
+        actual,
+        "Float",
+        FlipperStreamValueFloat,
+        floats,
+        COUNT_OF(floats)));
+    mu_check(test_bulk_check_line(
+        flipper_format, expected, actual, "Bool", FlipperStreamValueBool, bools, COUNT_OF(bools)));
+
+    furi_string_free(actual);
+    furi_string_free(expected);
+    flipper_format_free(flipper_format);
+}
+
+static void test_bulk_read(void) {
+    FlipperFormat* flipper_format = flipper_format_string_alloc();
+    Stream* stream = flipper_format_get_raw_stream(flipper_format);
+    stream_write_cstring(stream, test_bulk_data);
+    stream_rewind(stream);
+
+    uint8_t hex[6];
+    mu_check(flipper_format_read_hex(flipper_format, "Hex", hex, COUNT_OF(hex)));
+    const uint8_t hex_expected[] = {0x00, 0x01, 0x7F, 0x80, 0xFF, 0xAB};
+    mu_assert_mem_eq(hex_expected, hex, COUNT_OF(hex));
+
+    uint32_t count = 0;
+    mu_check(flipper_format_get_value_count(flipper_format, "Tabs", &count));
+    mu_assert_int_eq(3, count);
+    mu_check(flipper_format_read_hex(flipper_format, "Tabs", hex, 3));
+    mu_assert_int_eq(0x03, hex[2]);
+
+    int32_t int32[2];
+    mu_check(flipper_format_read_int32(flipper_format, "Long", int32, COUNT_OF(int32)));
+    mu_assert_int_eq(42, int32[0]);
+    mu_assert_int_eq(-7, int32[1]);
+
+    uint64_t uint64[2];
+    mu_check(flipper_format_read_hex_uint64(flipper_format, "Wide", uint64, COUNT_OF(uint64)));
+    mu_check(uint64[0] == 0x0123456789ABCDEFULL);
+    mu_check(uint64[1] == UINT64_MAX);
+
+    bool bools[3];
+    mu_check(flipper_format_read_bool(flipper_format, "Bool", bools, COUNT_OF(bools)));
+    mu_check(bools[0] && !bools[1] && !bools[2]);
+
+    // Less values than requested
+    mu_check(!flipper_format_read_hex(flipper_format, "Short", hex, 3));
+    mu_check(flipper_format_rewind(flipper_format));
+    mu_check(flipper_format_read_hex(flipper_format, "Short", hex, 2));
+
+    // Last line without newline
+    mu_check(flipper_format_read_hex(flipper_format, "Last", hex, 2));
+    mu_assert_int_eq(0x20, hex[1]);
+    mu_check(flipper_format_rewind(flipper_format));
+    mu_check(flipper_format_get_value_count(flipper_format, "Last", &count));
+    mu_assert_int_eq(2, count);
+
+    flipper_format_free(flipper_format);
+}
+
+static bool test_bulk_benchmark_write(Storage* storage, FuriString* key) {
+    FlipperFormat* flipper_format = flipper_format_buffered_file_alloc(storage);
+    int32_t* raw = malloc(BULK_TEST_RAW_SAMPLES * sizeof(int32_t));
+    for(size_t i = 0; i < BULK_TEST_RAW_SAMPLES; i++) {
+        raw[i] = test_bulk_raw_sample(i);
+    }
+
+    bool result = false;
+    uint32_t start = furi_get_tick();
+    do {
+        if(!flipper_format_buffered_file_open_always(flipper_format, BULK_TEST_FILE)) break;
+        if(!flipper_format_write_header_cstr(flipper_format, "Bulk test", 1)) break;
+
+        bool error = false;
+        for(size_t i = 0; i < BULK_TEST_BLOCKS && !error; i++) {
+            uint8_t block[BULK_TEST_BLOCK_SIZE];
+            for(size_t j = 0; j < BULK_TEST_BLOCK_SIZE; j++) {
+                block[j] = i + j;
+            }
+            furi_string_printf(key, "Block %zu", i);
+            error = !flipper_format_write_hex(
+                flipper_format, furi_string_get_cstr(key), block, BULK_TEST_BLOCK_SIZE);
+        }
+        if(error) break;
+
+        if(!flipper_format_write_int32(flipper_format, "RAW_Data", raw, BULK_TEST_RAW_SAMPLES))
+            break;
+
+        result = true;
+    } while(false);
+
+    FURI_LOG_I(
+        TAG,
+        "Write %u blocks and %u samples: %lu ticks",
+        BULK_TEST_BLOCKS,
+        BULK_TEST_RAW_SAMPLES,
+        furi_get_tick() - start);
+
+    free(raw);
+    flipper_format_free(flipper_format);
+    return result;
+}
+
+static bool test_bulk_benchmark_read(Storage* storage, FuriString* key) {
+    FlipperFormat* flipper_format = flipper_format_buffered_file_alloc(storage);
+    int32_t* raw = malloc(BULK_TEST_RAW_SAMPLES * sizeof(int32_t));
+    uint32_t version;
+
+    bool result = false;
+    uint32_t start = furi_get_tick();
+    uint32_t raw_start = start;
+    do {
+        if(!flipper_format_buffered_file_open_existing(flipper_format, BULK_TEST_FILE)) break;
+        if(!flipper_format_read_header(flipper_format, key, &version)) break;
+
+        bool error = false;
+        for(size_t i = 0; i < BULK_TEST_BLOCKS && !error; i++) {
+            uint8_t block[BULK_TEST_BLOCK_SIZE];
+            furi_string_printf(key, "Block %zu", i);
+            error = !flipper_format_read_hex(
+                        flipper_format, furi_string_get_cstr(key), block, BULK_TEST_BLOCK_SIZE) ||
+                    block[0] != (uint8_t)i ||
+                    block[BULK_TEST_BLOCK_SIZE - 1] != (uint8_t)(i + BULK_TEST_BLOCK_SIZE - 1);
+        }
+        if(error) break;
+
+        raw_start = furi_get_tick();
+        uint32_t count = 0;
+        if(!flipper_format_get_value_count(flipper_format, "RAW_Data", &count)) break;
+        if(count != BULK_TEST_RAW_SAMPLES) break;
+        if(!flipper_format_read_int32(flipper_format, "RAW_Data", raw, count)) break;
+
+        for(size_t i = 0; i < BULK_TEST_RAW_SAMPLES && !error; i++) {
+            error = raw[i] != test_bulk_raw_sample(i);
+        }
+        if(error) break;
+
+        result = true;
+    } while(false);
+
+    uint32_t end = furi_get_tick();
+    FURI_LOG_I(
+        TAG,
+        "Read %u blocks: %lu ticks, %u samples: %lu ticks",
+        BULK_TEST_BLOCKS,
+        raw_start - start,
+        BULK_TEST_RAW_SAMPLES,
+        end - raw_start);
+
+    free(raw);
+    flipper_format_free(flipper_format);
+    return result;
+}
+
+void test_flipper_format_bulk(void) {
+    test_bulk_write();
+    test_bulk_read();
+
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    FuriString* key = furi_string_alloc();
+
+    bool write = test_bulk_benchmark_write(storage, key);
+    bool read = write && test_bulk_benchmark_read(storage, key);
+    storage_simply_remove(storage, BULK_TEST_FILE);
+
+    furi_string_free(key);
+    furi_record_close(RECORD_STORAGE);
+
+    mu_assert(write, "Bulk benchmark write error");
+    mu_assert(read, "Bulk benchmark read error");
+}
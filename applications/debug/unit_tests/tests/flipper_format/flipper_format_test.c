@@ -7,6 +7,8 @@
 #define TEST_DIR_NAME EXT_PATH(".tmp/unit_tests/ff")
 #define TEST_DIR      TEST_DIR_NAME "/"
 
+void test_flipper_format_bulk(void);
+
 static const char* test_filetype = "Flipper File test";
 static const uint32_t test_version = 666;
 
@@ -75,6 +77,11 @@ static const char* test_data_odd = "Filetype: Flipper File test\n"
                                    // Mixed trailing whitespace
                                    "Hex data: DE AD BE\t    ";
 
+#define KEY_INDEX_TEST_BLOCKS 256
+static const char* test_file_key_index = TEST_DIR "ff_mf_classic_4k.test";
+
+static bool test_key_index_enabled = false;
+
 // data created by user on linux machine
 static const char* test_file_linux = TEST_DIR READ_TEST_NIX;
 // data created by user on windows machine
@@ -121,6 +128,7 @@ static bool test_read(const char* file_name) {
     bool result = false;
 
     FlipperFormat* file = flipper_format_file_alloc(storage);
+    flipper_format_set_key_index(file, test_key_index_enabled);
     FuriString* string_value;
     string_value = furi_string_alloc();
     uint32_t uint32_value;
@@ -419,6 +427,7 @@ static bool test_read_multikey(const char* file_name) {
     Storage* storage = furi_record_open(RECORD_STORAGE);
     bool result = false;
     FlipperFormat* file = flipper_format_file_alloc(storage);
+    flipper_format_set_key_index(file, test_key_index_enabled);
 
     FuriString* string_value;
     string_value = furi_string_alloc();
@@ -456,6 +465,91 @@ static bool test_read_multikey(const char* file_name) {
     return result;
 }
 
+static bool test_write_key_index(const char* file_name) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    FlipperFormat* file = flipper_format_buffered_file_alloc(storage);
+    FuriString* key = furi_string_alloc();
+    bool result = false;
+
+    do {
+        if(!flipper_format_buffered_file_open_always(file, file_name)) break;
+        if(!flipper_format_write_header_cstr(file, "Flipper NFC device", 4)) break;
+        if(!flipper_format_write_string_cstr(file, "Device type", "Mifare Classic")) break;
+        if(!flipper_format_write_string_cstr(file, "Mifare Classic type", "4K")) break;
+        if(!flipper_format_write_comment_cstr(file, "Mifare Classic blocks")) break;
+
+        bool error = false;
+        for(size_t i = 0; i < KEY_INDEX_TEST_BLOCKS && !error; i++) {
+            uint8_t block[16];
+            memset(block, i, sizeof(block));
+            furi_string_printf(key, "Block %zu", i);
+            error = !flipper_format_write_hex(file, furi_string_get_cstr(key), block, 16);
+        }
+        if(error) break;
+
+        result = true;
+    } while(false);
+
+    furi_string_free(key);
+    flipper_format_free(file);
+    furi_record_close(RECORD_STORAGE);
+
+    return result;
+}
+
+static bool test_read_key_index(const char* file_name, bool key_index) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    FlipperFormat* file = flipper_format_buffered_file_alloc(storage);
+    flipper_format_set_key_index(file, key_index);
+    FuriString* key = furi_string_alloc();
+    uint32_t version;
+    bool result = false;
+
+    uint32_t start = furi_get_tick();
+    do {
+        if(!flipper_format_buffered_file_open_existing(file, file_name)) break;
+        if(!flipper_format_read_header(file, key, &version)) break;
+        if(!flipper_format_read_string(file, "Mifare Classic type", key)) break;
+
+        // Missing key, the same way as old dumps are loaded
+        if(flipper_format_key_exist(file, "Data format version")) break;
+
+        // Every block in file order, then in reverse order, then one of the blocks again
+        bool error = false;
+        for(size_t pass = 0; pass < 2 && !error; pass++) {
+            for(size_t i = 0; i < KEY_INDEX_TEST_BLOCKS && !error; i++) {
+                size_t block_num = pass ? KEY_INDEX_TEST_BLOCKS - i - 1 : i;
+                uint8_t block[16];
+                furi_string_printf(key, "Block %zu", block_num);
+                if(pass) flipper_format_rewind(file);
+                error = !flipper_format_read_hex(file, furi_string_get_cstr(key), block, 16) ||
+                        block[0] != block_num || block[15] != block_num;
+            }
+        }
+        if(error) break;
+
+        uint8_t block[16];
+        if(flipper_format_read_hex(file, "Block 0", block, 16)) break;
+        if(!flipper_format_rewind(file)) break;
+        if(!flipper_format_read_hex(file, "Block 0", block, 16)) break;
+
+        result = true;
+    } while(false);
+
+    FURI_LOG_I(
+        "FlipperFormatTest",
+        "%u blocks %s key index: %lu ticks",
+        KEY_INDEX_TEST_BLOCKS,
+        key_index ? "with" : "without",
+        furi_get_tick() - start);
+
+    furi_string_free(key);
+    flipper_format_free(file);
+    furi_record_close(RECORD_STORAGE);
+
+    return result;
+}
+
 MU_TEST(flipper_format_write_test) {
     mu_assert(storage_write_string(test_file_linux, test_data_nix), "Write test error [Linux]");
     mu_assert(
@@ -528,6 +622,24 @@ MU_TEST(flipper_format_oddities_test) {
     mu_assert(test_read(test_file_linux), "Read test error [Oddities]");
 }
 
+MU_TEST(flipper_format_key_index_test) {
+    test_key_index_enabled = true;
+    mu_assert(test_read(test_file_linux), "Read test error [Linux, key index]");
+    mu_assert(test_read(test_file_windows), "Read test error [Windows, key index]");
+    mu_assert(test_read(test_file_flipper), "Read test error [Flipper, key index]");
+    mu_assert(
+        test_read_multikey(TEST_DIR "ff_multiline.test"), "Multikey read test error [key index]");
+    test_key_index_enabled = false;
+
+    mu_assert(test_write_key_index(test_file_key_index), "Key index write test error");
+    mu_assert(test_read_key_index(test_file_key_index, false), "Key index read test error");
+    mu_assert(test_read_key_index(test_file_key_index, true), "Key index read test error [index]");
+}
+
+MU_TEST(flipper_format_bulk_test) {
+    test_flipper_format_bulk();
+}
+
 MU_TEST_SUITE(flipper_format) {
     tests_setup();
     MU_RUN_TEST(flipper_format_write_test);
@@ -542,6 +654,8 @@ MU_TEST_SUITE(flipper_format) {
     MU_RUN_TEST(flipper_format_update_2_result_test);
     MU_RUN_TEST(flipper_format_multikey_test);
     MU_RUN_TEST(flipper_format_oddities_test);
+    MU_RUN_TEST(flipper_format_key_index_test);
+    MU_RUN_TEST(flipper_format_bulk_test);
     tests_teardown();
 }
 
@@ -0,0 +1,154 @@
+#include <furi.h>
+#include <furi_hal.h>
+#include "../test.h" // IWYU pragma: keep
+
+#define TAG "SpscRingTest"
+
+#define SPSC_RING_TEST_CAPACITY  64
+#define SPSC_RING_TEST_ITEMS     20000
+#define SPSC_RING_TEST_BATCH     16
+#define SPSC_RING_TEST_FLAG      (1UL << 0)
+#define SPSC_RING_TEST_WATERMARK 8
+
+typedef struct {
+    FuriSpscRing* ring;
+    uint32_t pushed;
+} SpscRingTestProducer;
+
+static void test_furi_spsc_ring_basic(void) {
+    FuriSpscRing* ring = furi_spsc_ring_alloc(8, sizeof(uint32_t));
+
+    // Push and pop across the wrap boundary several times
+    uint32_t in[5], out[8];
+    uint32_t expected = 0;
+    uint32_t value = 0;
+    bool ordered = true;
+    for(size_t round = 0; round < 10; round++) {
+        for(size_t i = 0; i < COUNT_OF(in); i++) {
+            in[i] = value++;
+        }
+        mu_check(furi_spsc_ring_push(ring, in, COUNT_OF(in)));
+        mu_assert_int_eq(COUNT_OF(in), furi_spsc_ring_get_count(ring));
+
+        size_t count = furi_spsc_ring_pop(ring, out, COUNT_OF(out));
+        mu_assert_int_eq(COUNT_OF(in), count);
+        for(size_t i = 0; i < count; i++) {
+            ordered &= (out[i] == expected++);
+        }
+    }
+    mu_check(ordered);
+    mu_assert_int_eq(0, furi_spsc_ring_get_count(ring));
+
+    // Push is all or nothing
+    mu_check(furi_spsc_ring_push(ring, in, 5));
+    mu_check(!furi_spsc_ring_push(ring, in, 4));
+    mu_assert_int_eq(5, furi_spsc_ring_get_count(ring));
+    mu_assert_int_eq(1, furi_spsc_ring_get_overrun_count(ring));
+    mu_check(furi_spsc_ring_push(ring, in, 3));
+    mu_assert_int_eq(8, furi_spsc_ring_get_count(ring));
+
+    furi_spsc_ring_flush(ring);
+    mu_assert_int_eq(0, furi_spsc_ring_get_count(ring));
+    mu_assert_int_eq(0, furi_spsc_ring_pop(ring, out, COUNT_OF(out)));
+
+    furi_spsc_ring_free(ring);
+}
+
+static int32_t test_furi_spsc_ring_producer(void* context) {
+    SpscRingTestProducer* producer = context;
+
+    uint32_t batch[SPSC_RING_TEST_BATCH];
+    while(producer->pushed < SPSC_RING_TEST_ITEMS) {
+        for(size_t i = 0; i < SPSC_RING_TEST_BATCH; i++) {
+            batch[i] = producer->pushed + i;
+        }
+        if(furi_spsc_ring_push(producer->ring, batch, SPSC_RING_TEST_BATCH)) {
+            producer->pushed += SPSC_RING_TEST_BATCH;
+        } else {
+            furi_thread_yield();
+        }
+    }
+
+    return 0;
+}
+
+static void test_furi_spsc_ring_threads(void) {
+    SpscRingTestProducer producer = {
+        .ring = furi_spsc_ring_alloc(SPSC_RING_TEST_CAPACITY, sizeof(uint32_t)),
+        .pushed = 0,
+    };
+    furi_spsc_ring_set_consumer(
+        producer.ring,
+        furi_thread_get_current_id(),
+        SPSC_RING_TEST_FLAG,
+        SPSC_RING_TEST_WATERMARK);
+
+    FuriThread* thread =
+        furi_thread_alloc_ex("SpscRingProducer", 1024, test_furi_spsc_ring_producer, &producer);
+    furi_thread_start(thread);
+
+    uint32_t items[SPSC_RING_TEST_CAPACITY];
+    uint32_t expected = 0;
+    bool ordered = true;
+    const uint32_t start = furi_get_tick();
+    while(expected < SPSC_RING_TEST_ITEMS && furi_get_tick() - start < 5000) {
+        size_t count = furi_spsc_ring_receive(producer.ring, items, COUNT_OF(items), 10);
+        for(size_t i = 0; i < count; i++) {
+            ordered &= (items[i] == expected++);
+        }
+    }
+    const uint32_t elapsed = furi_get_tick() - start;
+
+    furi_thread_join(thread);
+    furi_thread_free(thread);
+    furi_spsc_ring_set_consumer(producer.ring, NULL, 0, 1);
+
+    FURI_LOG_I(
+        TAG,
+        "%lu items in %lums, %lu producer retries",
+        expected,
+        elapsed,
+        furi_spsc_ring_get_overrun_count(producer.ring));
+
+    furi_spsc_ring_free(producer.ring);
+
+    mu_check(ordered);
+    mu_assert_int_eq(SPSC_RING_TEST_ITEMS, expected);
+}
+
+static void test_furi_spsc_ring_cost(void) {
+    // Producer side cost in cycles compared with the stream buffer it replaces in workers
+    FuriSpscRing* ring = furi_spsc_ring_alloc(SPSC_RING_TEST_CAPACITY, sizeof(uint32_t));
+    FuriStreamBuffer* stream =
+        furi_stream_buffer_alloc(SPSC_RING_TEST_CAPACITY * sizeof(uint32_t), sizeof(uint32_t));
+
+    uint32_t value = 0;
+    uint32_t ring_cycles = 0;
+    uint32_t stream_cycles = 0;
+    for(size_t i = 0; i < SPSC_RING_TEST_CAPACITY; i++) {
+        uint32_t cycles = DWT->CYCCNT;
+        furi_spsc_ring_push(ring, &value, 1);
+        ring_cycles += DWT->CYCCNT - cycles;
+
+        cycles = DWT->CYCCNT;
+        furi_stream_buffer_send(stream, &value, sizeof(value), 0);
+        stream_cycles += DWT->CYCCNT - cycles;
+    }
+
+    FURI_LOG_I(
+        TAG,
+        "push: ring %lu cycles, stream buffer %lu cycles",
+        ring_cycles / SPSC_RING_TEST_CAPACITY,
+        stream_cycles / SPSC_RING_TEST_CAPACITY);
+
+    furi_stream_buffer_free(stream);
+    furi_spsc_ring_free(ring);
+
+    mu_check(ring_cycles < stream_cycles);
+}
+
+void test_furi_spsc_ring(void) {
+    test_furi_spsc_ring_basic();
+    test_furi_spsc_ring_threads();
+    test_furi_spsc_ring_cost();
+}
@@ -1,11 +1,21 @@
 #include <furi.h>
+#include <furi_hal.h>
 #include "../test.h" // IWYU pragma: keep
 #include <toolbox/protocols/protocol_dict.h>
+#include <toolbox/varint.h>
 #include <lfrfid/protocols/lfrfid_protocols.h>
+#include <lfrfid/lfrfid_raw_file.h>
 #include <toolbox/pulse_protocols/pulse_glue.h>
 
+#define TAG "LfRfidProtocolsTest"
+
 #define LF_RFID_READ_TIMING_MULTIPLIER 8
 
+#define LF_RFID_REPLAY_FILE        EXT_PATH(".tmp/unit_tests/lfrfid_replay.raw")
+#define LF_RFID_REPLAY_BUFFER_SIZE 512
+#define LF_RFID_REPLAY_REPEATS     20
+#define LF_RFID_REPLAY_LOCK_TIME   200000
+
 #define EM_TEST_DATA                    {0x58, 0x00, 0x85, 0x64, 0x02}
 #define EM_TEST_DATA_SIZE               5
 #define EM_TEST_EMULATION_TIMINGS_COUNT (64 * 2)
@@ -526,6 +536,198 @@ MU_TEST(test_lfrfid_protocol_fdxb_read_simple) {
     protocol_dict_free(dict);
 }
 
+typedef struct {
+    uint32_t pairs;
+    uint32_t cycles;
+    uint32_t em_count;
+    uint32_t hid_count;
+    ProtocolId lock;
+    bool data_ok;
+} LfRfidReplayResult;
+
+static bool lfrfid_test_replay_write_timings(
+    LFRFIDRawFile* file,
+    PulseGlue* pulse_glue,
+    const int8_t* timings,
+    size_t timings_count,
+    uint8_t* buffer,
+    size_t* buffer_size) {
+    for(size_t i = 0; i < timings_count * LF_RFID_REPLAY_REPEATS; i++) {
+        int8_t timing = timings[i % timings_count];
+        if(!pulse_glue_push(pulse_glue, timing >= 0, abs(timing) * LF_RFID_READ_TIMING_MULTIPLIER))
+            continue;
+
+        uint32_t length, period;
+        pulse_glue_pop(pulse_glue, &length, &period);
+
+        // Same layout as raw capture: pulse, then whole period
+        if(*buffer_size + 2 * 5 > LF_RFID_REPLAY_BUFFER_SIZE) {
+            if(!lfrfid_raw_file_write_buffer(file, buffer, *buffer_size)) return false;
+            *buffer_size = 0;
+        }
+        *buffer_size += varint_uint32_pack(period, &buffer[*buffer_size]);
+        *buffer_size += varint_uint32_pack(length, &buffer[*buffer_size]);
+    }
+
+    return true;
+}
+
+static bool lfrfid_test_replay_write(Storage* storage) {
+    LFRFIDRawFile* file = lfrfid_raw_file_alloc(storage);
+    PulseGlue* pulse_glue = pulse_glue_alloc();
+    uint8_t* buffer = malloc(LF_RFID_REPLAY_BUFFER_SIZE);
+    size_t buffer_size = 0;
+
+    bool result = false;
+    do {
+        if(!lfrfid_raw_file_open_write(file, LF_RFID_REPLAY_FILE)) break;
+        if(!lfrfid_raw_file_write_header(file, 125000, 0.5, LF_RFID_REPLAY_BUFFER_SIZE)) break;
+
+        // EM4100 card followed by H10301 card, as if one was replaced by another
+        if(!lfrfid_test_replay_write_timings(
+               file,
+               pulse_glue,
+               em_test_timings,
+               EM_TEST_EMULATION_TIMINGS_COUNT,
+               buffer,
+               &buffer_size))
+            break;
+        if(!lfrfid_test_replay_write_timings(
+               file,
+               pulse_glue,
+               hid10301_test_timings,
+               HID10301_TEST_EMULATION_TIMINGS_COUNT,
+               buffer,
+               &buffer_size))
+            break;
+        if(buffer_size && !lfrfid_raw_file_write_buffer(file, buffer, buffer_size)) break;
+
+        result = true;
+    } while(false);
+
+    free(buffer);
+    pulse_glue_free(pulse_glue);
+    lfrfid_raw_file_free(file);
+
+    return result;
+}
+
+static bool lfrfid_test_replay(
+    Storage* storage,
+    bool pair_feed,
+    bool lock,
+    LfRfidReplayResult* result) {
+    const uint8_t em_data[EM_TEST_DATA_SIZE] = EM_TEST_DATA;
+    const uint8_t hid_data[HID10301_TEST_DATA_SIZE] = HID10301_TEST_DATA;
+    uint8_t data[EM_TEST_DATA_SIZE];
+
+    memset(result, 0, sizeof(LfRfidReplayResult));
+    result->data_ok = true;
+
+    LFRFIDRawFile* file = lfrfid_raw_file_alloc(storage);
+    ProtocolDict* dict = protocol_dict_alloc(lfrfid_protocols, LFRFIDProtocolMax);
+    protocol_dict_decoders_set_lock_timeout(dict, lock ? LF_RFID_REPLAY_LOCK_TIME : 0);
+    protocol_dict_decoders_start(dict);
+
+    bool success = false;
+    do {
+        float frequency, duty_cycle;
+        if(!lfrfid_raw_file_open_read(file, LF_RFID_REPLAY_FILE)) break;
+        if(!lfrfid_raw_file_read_header(file, &frequency, &duty_cycle)) break;
+
+        uint32_t pulse, duration;
+        bool pass_end = false;
+        while(lfrfid_raw_file_read_pair(file, &duration, &pulse, &pass_end) && !pass_end) {
+            ProtocolId protocol;
+            uint32_t cycles = DWT->CYCCNT;
+            if(pair_feed) {
+                protocol = protocol_dict_decoders_feed_pair_by_feature(
+                    dict, LFRFIDFeatureASK, pulse, duration);
+            } else {
+                protocol = protocol_dict_decoders_feed_by_feature(
+                    dict, LFRFIDFeatureASK, true, pulse);
+                if(protocol == PROTOCOL_NO) {
+                    protocol = protocol_dict_decoders_feed_by_feature(
+                        dict, LFRFIDFeatureASK, false, duration - pulse);
+                }
+            }
+            result->cycles += DWT->CYCCNT - cycles;
+            result->pairs++;
+
+            if(protocol == PROTOCOL_NO) continue;
+
+            if(protocol == LFRFIDProtocolEM4100) {
+                result->em_count++;
+                protocol_dict_get_data(dict, protocol, data, EM_TEST_DATA_SIZE);
+                result->data_ok &= !memcmp(data, em_data, EM_TEST_DATA_SIZE);
+            } else if(protocol == LFRFIDProtocolH10301) {
+                result->hid_count++;
+                protocol_dict_get_data(dict, protocol, data, HID10301_TEST_DATA_SIZE);
+                result->data_ok &= !memcmp(data, hid_data, HID10301_TEST_DATA_SIZE);
+            }
+            protocol_dict_decoders_start(dict);
+        }
+
+        success = true;
+    } while(false);
+
+    result->lock = protocol_dict_decoders_get_lock(dict);
+    protocol_dict_free(dict);
+    lfrfid_raw_file_free(file);
+
+    if(success && result->cycles) {
+        FURI_LOG_I(
+            TAG,
+            "%s%s: %lu pairs, %lu pairs/s, EM4100 %lu, H10301 %lu",
+            pair_feed ? "pair feed" : "feed by feature",
+            lock ? " with lock" : "",
+            result->pairs,
+            (uint32_t)((uint64_t)result->pairs * furi_hal_cortex_instructions_per_microsecond() *
+                       1000000 / result->cycles),
+            result->em_count,
+            result->hid_count);
+    }
+
+    return success;
+}
+
+MU_TEST(test_lfrfid_protocol_dict_replay) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+
+    LfRfidReplayResult feed, pair, locked;
+    bool written = lfrfid_test_replay_write(storage);
+    bool feed_ok = written && lfrfid_test_replay(storage, false, false, &feed);
+    bool pair_ok = written && lfrfid_test_replay(storage, true, false, &pair);
+    bool locked_ok = written && lfrfid_test_replay(storage, true, true, &locked);
+
+    storage_simply_remove(storage, LF_RFID_REPLAY_FILE);
+    furi_record_close(RECORD_STORAGE);
+
+    mu_check(written);
+    mu_check(feed_ok);
+    mu_check(pair_ok);
+    mu_check(locked_ok);
+
+    // Timing classes must not change decoding results
+    mu_check(feed.em_count > 0);
+    mu_check(feed.hid_count > 0);
+    mu_assert_int_eq(feed.pairs, pair.pairs);
+    mu_assert_int_eq(feed.em_count, pair.em_count);
+    mu_assert_int_eq(feed.hid_count, pair.hid_count);
+    mu_check(feed.data_ok);
+    mu_check(pair.data_ok);
+
+    // Locked decoder gives up on the replaced card and the new one is read
+    mu_assert_int_eq(PROTOCOL_NO, pair.lock);
+    mu_assert_int_eq(LFRFIDProtocolH10301, locked.lock);
+    mu_check(locked.em_count > 0);
+    mu_check(locked.hid_count > 0);
+    mu_check(locked.data_ok);
+
+    mu_check(pair.cycles < feed.cycles);
+    mu_check(locked.cycles < pair.cycles);
+}
+
 MU_TEST_SUITE(test_lfrfid_protocols_suite) {
     MU_RUN_TEST(test_lfrfid_protocol_em_read_simple);
     MU_RUN_TEST(test_lfrfid_protocol_em_emulate_simple);
@@ -540,6 +742,8 @@ MU_TEST_SUITE(test_lfrfid_protocols_suite) {
 
     MU_RUN_TEST(test_lfrfid_protocol_fdxb_read_simple);
     MU_RUN_TEST(test_lfrfid_protocol_fdxb_emulate_simple);
+
+    MU_RUN_TEST(test_lfrfid_protocol_dict_replay);
 }
 
 int run_minunit_test_lfrfid_protocols(void) {
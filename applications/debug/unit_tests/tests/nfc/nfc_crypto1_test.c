@@ -0,0 +1,222 @@
+#include "../test.h" // IWYU pragma: keep
+#include <furi.h>
+#include <furi_hal_random.h>
+#include <nfc/helpers/crypto1.h>
+#include <nfc/helpers/nfc_util.h>
+
+#define TAG "Crypto1Test"
+
+#define CRYPTO1_TEST_ROUNDS     (2000)
+#define CRYPTO1_TEST_DATA_MAX   (18)
+#define CRYPTO1_TEST_BENCH_SIZE (4096)
+
+#define CRYPTO1_TEST_LF_POLY_ODD  (0x29CE5C)
+#define CRYPTO1_TEST_LF_POLY_EVEN (0x870804)
+
+// Bit by bit reference implementation, the library one must match it exactly
+
+static uint32_t crypto1_test_ref_filter(uint32_t in) {
+    uint32_t out = 0;
+    out = 0xf22c0 >> (in & 0xf) & 16;
+    out |= 0x6c9c0 >> (in >> 4 & 0xf) & 8;
+    out |= 0x3c8b0 >> (in >> 8 & 0xf) & 4;
+    out |= 0x1e458 >> (in >> 12 & 0xf) & 2;
+    out |= 0x0d938 >> (in >> 16 & 0xf) & 1;
+    return FURI_BIT(0xEC57E80A, out);
+}
+
+static uint8_t crypto1_test_ref_bit(Crypto1* crypto1, uint8_t in, int is_encrypted) {
+    uint8_t out = crypto1_test_ref_filter(crypto1->odd);
+    uint32_t feed = out & (!!is_encrypted);
+    feed ^= !!in;
+    feed ^= CRYPTO1_TEST_LF_POLY_ODD & crypto1->odd;
+    feed ^= CRYPTO1_TEST_LF_POLY_EVEN & crypto1->even;
+    crypto1->even = crypto1->even << 1 | (nfc_util_even_parity32(feed));
+
+    FURI_SWAP(crypto1->odd, crypto1->even);
+    return out;
+}
+
+static uint8_t crypto1_test_ref_byte(Crypto1* crypto1, uint8_t in, int is_encrypted) {
+    uint8_t out = 0;
+    for(uint8_t i = 0; i < 8; i++) {
+        out |= crypto1_test_ref_bit(crypto1, FURI_BIT(in, i), is_encrypted) << i;
+    }
+    return out;
+}
+
+static uint32_t crypto1_test_ref_word(Crypto1* crypto1, uint32_t in, int is_encrypted) {
+    uint32_t out = 0;
+    for(uint8_t i = 0; i < 32; i++) {
+        out |= (uint32_t)crypto1_test_ref_bit(crypto1, FURI_BIT(in, i ^ 24), is_encrypted)
+               << (24 ^ i);
+    }
+    return out;
+}
+
+static void crypto1_test_ref_decrypt(Crypto1* crypto, const BitBuffer* buff, BitBuffer* out) {
+    size_t bits = bit_buffer_get_size(buff);
+    bit_buffer_set_size(out, bits);
+    const uint8_t* encrypted_data = bit_buffer_get_data(buff);
+    if(bits < 8) {
+        uint8_t decrypted_byte = 0;
+        for(size_t i = 0; i < 4; i++) {
+            decrypted_byte |=
+                (crypto1_test_ref_bit(crypto, 0, 0) ^ FURI_BIT(encrypted_data[0], i)) << i;
+        }
+        bit_buffer_set_byte(out, 0, decrypted_byte);
+    } else {
+        for(size_t i = 0; i < bits / 8; i++) {
+            bit_buffer_set_byte(out, i, crypto1_test_ref_byte(crypto, 0, 0) ^ encrypted_data[i]);
+        }
+    }
+}
+
+static void crypto1_test_ref_encrypt(
+    Crypto1* crypto,
+    const uint8_t* keystream,
+    const BitBuffer* buff,
+    BitBuffer* out) {
+    size_t bits = bit_buffer_get_size(buff);
+    bit_buffer_set_size(out, bits);
+    const uint8_t* plain_data = bit_buffer_get_data(buff);
+    if(bits < 8) {
+        uint8_t encrypted_byte = 0;
+        for(size_t i = 0; i < bits; i++) {
+            encrypted_byte |= (crypto1_test_ref_bit(crypto, 0, 0) ^ FURI_BIT(plain_data[0], i))
+                              << i;
+        }
+        bit_buffer_set_byte(out, 0, encrypted_byte);
+    } else {
+        for(size_t i = 0; i < bits / 8; i++) {
+            uint8_t encrypted_byte =
+                crypto1_test_ref_byte(crypto, keystream ? keystream[i] : 0, 0) ^ plain_data[i];
+            bool parity_bit =
+                (crypto1_test_ref_filter(crypto->odd) ^ nfc_util_odd_parity8(plain_data[i])) &
+                0x01;
+            bit_buffer_set_byte_with_parity(out, i, encrypted_byte, parity_bit);
+        }
+    }
+}
+
+static void crypto1_test_random_state(Crypto1* crypto, Crypto1* ref) {
+    uint64_t key = 0;
+    furi_hal_random_fill_buf((uint8_t*)&key, 6);
+    crypto1_init(crypto, key);
+    *ref = *crypto;
+
+    // Garbage above the 24 register bits must be handled the same way
+    if(furi_hal_random_get() & 1) {
+        ref->odd = crypto->odd = furi_hal_random_get();
+        ref->even = crypto->even = furi_hal_random_get();
+    }
+}
+
+static void crypto1_test_assert_state(const Crypto1* crypto, const Crypto1* ref) {
+    mu_assert_int_eq(ref->odd, crypto->odd);
+    mu_assert_int_eq(ref->even, crypto->even);
+}
+
+static void crypto1_test_assert_buffer(const BitBuffer* buff, const BitBuffer* ref) {
+    size_t size_bytes = bit_buffer_get_size_bytes(ref);
+    mu_assert_int_eq(bit_buffer_get_size(ref), bit_buffer_get_size(buff));
+    mu_assert_mem_eq(bit_buffer_get_data(ref), bit_buffer_get_data(buff), size_bytes);
+    if(bit_buffer_get_size(ref) >= 8) {
+        mu_assert_mem_eq(
+            bit_buffer_get_parity(ref), bit_buffer_get_parity(buff), (size_bytes + 7) / 8);
+    }
+}
+
+static void crypto1_test_bit_exact_stream(Crypto1* crypto, Crypto1* ref) {
+    uint32_t in = furi_hal_random_get();
+    int is_encrypted = in % 3;
+
+    crypto1_test_random_state(crypto, ref);
+    mu_assert_int_eq(
+        crypto1_test_ref_bit(ref, in & 1, is_encrypted),
+        crypto1_bit(crypto, in & 1, is_encrypted));
+    crypto1_test_assert_state(crypto, ref);
+
+    mu_assert_int_eq(
+        crypto1_test_ref_byte(ref, in, is_encrypted), crypto1_byte(crypto, in, is_encrypted));
+    crypto1_test_assert_state(crypto, ref);
+
+    mu_assert_int_eq(
+        crypto1_test_ref_word(ref, in, is_encrypted), crypto1_word(crypto, in, is_encrypted));
+    crypto1_test_assert_state(crypto, ref);
+}
+
+static void crypto1_test_bit_exact_buffer(
+    Crypto1* crypto,
+    Crypto1* ref,
+    BitBuffer* plain,
+    BitBuffer* out,
+    BitBuffer* ref_out) {
+    uint8_t data[CRYPTO1_TEST_DATA_MAX];
+    uint8_t keystream[CRYPTO1_TEST_DATA_MAX];
+    furi_hal_random_fill_buf(data, sizeof(data));
+    furi_hal_random_fill_buf(keystream, sizeof(keystream));
+
+    // Either a short frame, like 4 bit ACK, or whole bytes
+    size_t size_bytes = 1 + furi_hal_random_get() % CRYPTO1_TEST_DATA_MAX;
+    size_t bits = (furi_hal_random_get() & 3) ? size_bytes * 8 : 4;
+    bit_buffer_copy_bytes(plain, data, size_bytes);
+    bit_buffer_set_size(plain, bits);
+
+    crypto1_test_random_state(crypto, ref);
+    crypto1_test_ref_decrypt(ref, plain, ref_out);
+    crypto1_decrypt(crypto, plain, out);
+    crypto1_test_assert_buffer(out, ref_out);
+    crypto1_test_assert_state(crypto, ref);
+
+    crypto1_test_random_state(crypto, ref);
+    uint8_t* ks = (furi_hal_random_get() & 1) ? keystream : NULL;
+    crypto1_test_ref_encrypt(ref, ks, plain, ref_out);
+    crypto1_encrypt(crypto, ks, plain, out);
+    crypto1_test_assert_buffer(out, ref_out);
+    crypto1_test_assert_state(crypto, ref);
+}
+
+static void crypto1_test_benchmark(Crypto1* crypto, Crypto1* ref) {
+    crypto1_test_random_state(crypto, ref);
+
+    uint32_t start = furi_get_tick();
+    for(size_t i = 0; i < CRYPTO1_TEST_BENCH_SIZE; i++) {
+        crypto1_test_ref_byte(ref, 0, 0);
+    }
+    uint32_t ref_ticks = furi_get_tick() - start;
+
+    start = furi_get_tick();
+    for(size_t i = 0; i < CRYPTO1_TEST_BENCH_SIZE; i++) {
+        crypto1_byte(crypto, 0, 0);
+    }
+    uint32_t ticks = furi_get_tick() - start;
+    crypto1_test_assert_state(crypto, ref);
+
+    FURI_LOG_I(
+        TAG,
+        "%d keystream bytes: %lu ticks bit by bit, %lu ticks",
+        CRYPTO1_TEST_BENCH_SIZE,
+        ref_ticks,
+        ticks);
+}
+
+void test_crypto1_bit_exact(void) {
+    Crypto1* crypto = crypto1_alloc();
+    Crypto1 ref = {};
+    BitBuffer* plain = bit_buffer_alloc(CRYPTO1_TEST_DATA_MAX);
+    BitBuffer* out = bit_buffer_alloc(CRYPTO1_TEST_DATA_MAX);
+    BitBuffer* ref_out = bit_buffer_alloc(CRYPTO1_TEST_DATA_MAX);
+
+    for(size_t i = 0; i < CRYPTO1_TEST_ROUNDS; i++) {
+        crypto1_test_bit_exact_stream(crypto, &ref);
+        crypto1_test_bit_exact_buffer(crypto, &ref, plain, out, ref_out);
+    }
+
+    crypto1_test_benchmark(crypto, &ref);
+
+    bit_buffer_free(ref_out);
+    bit_buffer_free(out);
+    bit_buffer_free(plain);
+    crypto1_free(crypto);
+}
@@ -0,0 +1,194 @@
+#include "../test.h" // IWYU pragma: keep
+#include <furi.h>
+#include <storage/storage.h>
+#include <toolbox/keys_dict.h>
+#include <toolbox/keys_dict_prefetch.h>
+#include <nfc/nfc.h>
+#include <nfc/nfc_device.h>
+#include <nfc/nfc_poller.h>
+#include <nfc/nfc_listener.h>
+#include <nfc/helpers/nfc_data_generator.h>
+#include <nfc/protocols/mf_classic/mf_classic_poller.h>
+
+#define TAG "NfcDictAttackTest"
+
+#define NFC_DICT_ATTACK_TEST_PATH EXT_PATH(".tmp/unit_tests/nfc_dict_attack.nfc")
+#define NFC_DICT_ATTACK_TEST_KEYS (128)
+
+#define NFC_DICT_ATTACK_TEST_FLAG_DONE (1UL << 0)
+
+typedef struct {
+    FuriThreadId thread_id;
+    MfClassicData* mode_data;
+    KeysDict* dict;
+    KeysDictPrefetch* prefetch;
+    uint32_t keys_requested;
+    bool is_success;
+} NfcDictAttackTestContext;
+
+static void nfc_dict_attack_test_key(uint32_t index, MfClassicKey* key) {
+    key->data[0] = 0xA5;
+    key->data[1] = index;
+    for(size_t i = 2; i < sizeof(MfClassicKey); i++) {
+        key->data[i] = (index * 0x9E + i * 0x3B) & 0xFF;
+    }
+}
+
+// Sectors use different keys spread over the dict, two of them share a key
+static uint32_t nfc_dict_attack_test_key_index(uint8_t sector) {
+    return sector == 7 ? 85 : (sector * 37 + 11) % NFC_DICT_ATTACK_TEST_KEYS;
+}
+
+static bool nfc_dict_attack_test_create_dict(Storage* storage) {
+    File* file = storage_file_alloc(storage);
+    FuriString* line = furi_string_alloc();
+    MfClassicKey key = {};
+    bool result =
+        storage_file_open(file, NFC_DICT_ATTACK_TEST_PATH, FSAM_WRITE, FSOM_CREATE_ALWAYS);
+
+    for(uint32_t i = 0; i < NFC_DICT_ATTACK_TEST_KEYS && result; i++) {
+        nfc_dict_attack_test_key(i, &key);
+        furi_string_reset(line);
+        for(size_t j = 0; j < sizeof(MfClassicKey); j++) {
+            furi_string_cat_printf(line, "%02X", key.data[j]);
+        }
+        furi_string_push_back(line, '\n');
+        result = storage_file_write(file, furi_string_get_cstr(line), furi_string_size(line)) ==
+                 furi_string_size(line);
+    }
+
+    furi_string_free(line);
+    storage_file_free(file);
+    return result;
+}
+
+static NfcCommand nfc_dict_attack_test_callback(NfcGenericEvent event, void* context) {
+    NfcDictAttackTestContext* test = context;
+    MfClassicPollerEvent* mfc_event = event.event_data;
+    NfcCommand command = NfcCommandContinue;
+
+    if(mfc_event->type == MfClassicPollerEventTypeRequestMode) {
+        mfc_event->data->poller_mode.mode = MfClassicPollerModeDictAttack;
+        mfc_event->data->poller_mode.data = test->mode_data;
+    } else if(mfc_event->type == MfClassicPollerEventTypeRequestKey) {
+        MfClassicPollerEventDataKeyRequest* request = &mfc_event->data->key_request_data;
+        if(test->prefetch) {
+            request->key_provided = keys_dict_prefetch_get_next_key(
+                test->prefetch, request->key.data, sizeof(MfClassicKey));
+        } else {
+            request->key_provided =
+                keys_dict_get_next_key(test->dict, request->key.data, sizeof(MfClassicKey));
+        }
+        test->keys_requested += request->key_provided;
+    } else if(
+        mfc_event->type == MfClassicPollerEventTypeNextSector ||
+        mfc_event->type == MfClassicPollerEventTypeKeyAttackStop) {
+        if(test->prefetch) {
+            keys_dict_prefetch_rewind(test->prefetch);
+        } else {
+            keys_dict_rewind(test->dict);
+        }
+    } else if(mfc_event->type == MfClassicPollerEventTypeSuccess) {
+        test->is_success = true;
+        command = NfcCommandStop;
+    } else if(mfc_event->type == MfClassicPollerEventTypeFail) {
+        command = NfcCommandStop;
+    }
+
+    if(command == NfcCommandStop) {
+        furi_thread_flags_set(test->thread_id, NFC_DICT_ATTACK_TEST_FLAG_DONE);
+    }
+
+    return command;
+}
+
+static void nfc_dict_attack_test_run(const MfClassicData* card_data, bool use_prefetch) {
+    Nfc* poller = nfc_alloc();
+    Nfc* listener = nfc_alloc();
+
+    NfcListener* mfc_listener = nfc_listener_alloc(listener, NfcProtocolMfClassic, card_data);
+    nfc_listener_start(mfc_listener, NULL, NULL);
+
+    NfcDictAttackTestContext test = {
+        .thread_id = furi_thread_get_current_id(),
+        .mode_data = mf_classic_alloc(),
+        .dict = keys_dict_alloc(
+            NFC_DICT_ATTACK_TEST_PATH, KeysDictModeOpenExisting, sizeof(MfClassicKey)),
+    };
+    mu_assert_int_eq(NFC_DICT_ATTACK_TEST_KEYS, keys_dict_get_total_keys(test.dict));
+
+    // Card is known, but nothing is read from it yet
+    mf_classic_copy(test.mode_data, card_data);
+    memset(test.mode_data->block, 0, sizeof(test.mode_data->block));
+    memset(test.mode_data->block_read_mask, 0, sizeof(test.mode_data->block_read_mask));
+    test.mode_data->key_a_mask = 0;
+    test.mode_data->key_b_mask = 0;
+
+    if(use_prefetch) {
+        test.prefetch = keys_dict_prefetch_alloc(test.dict, NULL, sizeof(MfClassicKey));
+    }
+
+    NfcPoller* mfc_poller = nfc_poller_alloc(poller, NfcProtocolMfClassic);
+    uint32_t start = furi_get_tick();
+    nfc_poller_start(mfc_poller, nfc_dict_attack_test_callback, &test);
+    furi_thread_flags_wait(NFC_DICT_ATTACK_TEST_FLAG_DONE, FuriFlagWaitAny, FuriWaitForever);
+    uint32_t ticks = MAX(furi_get_tick() - start, 1UL);
+    nfc_poller_stop(mfc_poller);
+
+    const MfClassicData* read_data = nfc_poller_get_data(mfc_poller);
+    mu_assert(test.is_success, "dict attack failed");
+    mu_assert(mf_classic_is_card_read(read_data), "card is not fully read");
+    for(uint16_t block = 0; block < mf_classic_get_total_block_num(card_data->type); block++) {
+        if(mf_classic_is_sector_trailer(block)) continue;
+        mu_assert_mem_eq(
+            card_data->block[block].data, read_data->block[block].data, sizeof(MfClassicBlock));
+    }
+
+    FURI_LOG_I(
+        TAG,
+        "%s: %lu keys in %lu ticks, %lu keys/s",
+        use_prefetch ? "prefetch" : "direct",
+        test.keys_requested,
+        ticks,
+        test.keys_requested * 1000 / ticks);
+
+    nfc_poller_free(mfc_poller);
+    if(test.prefetch) {
+        keys_dict_prefetch_free(test.prefetch);
+    }
+    keys_dict_free(test.dict);
+    mf_classic_free(test.mode_data);
+
+    nfc_listener_stop(mfc_listener);
+    nfc_listener_free(mfc_listener);
+    nfc_free(listener);
+    nfc_free(poller);
+}
+
+void test_mf_classic_dict_attack(void) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    mu_assert(nfc_dict_attack_test_create_dict(storage), "failed to create test dict");
+
+    NfcDevice* nfc_device = nfc_device_alloc();
+    nfc_data_generator_fill_data(NfcDataGeneratorTypeMfClassic1k_4b, nfc_device);
+    MfClassicData* card_data = mf_classic_alloc();
+    mf_classic_copy(card_data, nfc_device_get_data(nfc_device, NfcProtocolMfClassic));
+
+    uint8_t sectors_total = mf_classic_get_total_sectors_num(card_data->type);
+    for(uint8_t sector = 0; sector < sectors_total; sector++) {
+        uint8_t trailer = mf_classic_get_sector_trailer_num_by_sector(sector);
+        MfClassicSectorTrailer* sec_tr = (MfClassicSectorTrailer*)&card_data->block[trailer];
+        uint32_t key_index = nfc_dict_attack_test_key_index(sector);
+        nfc_dict_attack_test_key(key_index, &sec_tr->key_a);
+        nfc_dict_attack_test_key(NFC_DICT_ATTACK_TEST_KEYS - 1 - key_index, &sec_tr->key_b);
+    }
+
+    nfc_dict_attack_test_run(card_data, false);
+    nfc_dict_attack_test_run(card_data, true);
+
+    mf_classic_free(card_data);
+    nfc_device_free(nfc_device);
+
+    storage_simply_remove(storage, NFC_DICT_ATTACK_TEST_PATH);
+    furi_record_close(RECORD_STORAGE);
+}
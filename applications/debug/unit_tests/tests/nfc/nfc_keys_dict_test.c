@@ -0,0 +1,180 @@
+#include "../test.h" // IWYU pragma: keep
+#include <furi.h>
+#include <storage/storage.h>
+#include <toolbox/keys_dict.h>
+
+#define TAG "KeysDictTest"
+
+#define KEYS_DICT_TEST_PATH       EXT_PATH(".tmp/unit_tests/keys_dict.nfc")
+#define KEYS_DICT_TEST_INDEX_PATH KEYS_DICT_TEST_PATH ".idx"
+
+#define KEYS_DICT_TEST_KEY_SIZE (6)
+#define KEYS_DICT_TEST_KEYS     (5000)
+#define KEYS_DICT_TEST_LOOKUPS  (200)
+#define KEYS_DICT_TEST_BATCH    (64)
+
+static void keys_dict_test_key(uint32_t index, uint8_t* key) {
+    uint32_t value = index * 2654435761UL;
+    for(size_t i = 0; i < KEYS_DICT_TEST_KEY_SIZE; i++) {
+        key[i] = (value >> ((i % 4) * 8)) ^ (index >> 8) ^ (i * 0x5A);
+    }
+}
+
+// Only even indexes are written, odd ones are used as missing keys
+static bool keys_dict_test_create(Storage* storage, const char* header) {
+    File* file = storage_file_alloc(storage);
+    FuriString* text = furi_string_alloc();
+    uint8_t key[KEYS_DICT_TEST_KEY_SIZE];
+    bool result = false;
+
+    if(storage_file_open(file, KEYS_DICT_TEST_PATH, FSAM_WRITE, FSOM_CREATE_ALWAYS)) {
+        result = true;
+        furi_string_set(text, header);
+        for(uint32_t i = 0; i < KEYS_DICT_TEST_KEYS && result; i++) {
+            keys_dict_test_key(i * 2, key);
+            for(size_t j = 0; j < KEYS_DICT_TEST_KEY_SIZE; j++) {
+                furi_string_cat_printf(text, "%02X", key[j]);
+            }
+            furi_string_push_back(text, '\n');
+
+            if(furi_string_size(text) > 512 || i == KEYS_DICT_TEST_KEYS - 1) {
+                result = storage_file_write(
+                             file, furi_string_get_cstr(text), furi_string_size(text)) ==
+                         furi_string_size(text);
+                furi_string_reset(text);
+            }
+        }
+    }
+
+    furi_string_free(text);
+    storage_file_free(file);
+    return result;
+}
+
+static void keys_dict_test_lookups(KeysDict* dict) {
+    uint8_t key[KEYS_DICT_TEST_KEY_SIZE];
+
+    uint32_t start = furi_get_tick();
+    for(uint32_t i = 0; i < KEYS_DICT_TEST_LOOKUPS; i++) {
+        uint32_t index = (i * 7919) % (KEYS_DICT_TEST_KEYS * 2);
+        keys_dict_test_key(index, key);
+        mu_assert(
+            keys_dict_is_key_present(dict, key, KEYS_DICT_TEST_KEY_SIZE) == (index % 2 == 0),
+            "keys_dict_is_key_present() mismatch");
+    }
+    FURI_LOG_I(TAG, "%d lookups: %lu ticks", KEYS_DICT_TEST_LOOKUPS, furi_get_tick() - start);
+}
+
+static void keys_dict_test_iteration(KeysDict* dict) {
+    uint8_t* keys = malloc(KEYS_DICT_TEST_BATCH * KEYS_DICT_TEST_KEY_SIZE);
+    uint8_t key[KEYS_DICT_TEST_KEY_SIZE];
+    size_t keys_read = 0;
+
+    mu_assert(keys_dict_rewind(dict), "keys_dict_rewind() failed");
+    uint32_t start = furi_get_tick();
+    while(keys_dict_get_next_key(dict, keys, KEYS_DICT_TEST_KEY_SIZE)) {
+        keys_read++;
+    }
+    uint32_t single_ticks = furi_get_tick() - start;
+    mu_assert_int_eq(KEYS_DICT_TEST_KEYS, keys_read);
+
+    keys_read = 0;
+    mu_assert(keys_dict_rewind(dict), "keys_dict_rewind() failed");
+    start = furi_get_tick();
+    for(size_t count = KEYS_DICT_TEST_BATCH; count == KEYS_DICT_TEST_BATCH;) {
+        count = keys_dict_get_next_keys(dict, keys, KEYS_DICT_TEST_KEY_SIZE, KEYS_DICT_TEST_BATCH);
+        for(size_t i = 0; i < count; i++) {
+            keys_dict_test_key((keys_read + i) * 2, key);
+            mu_assert_mem_eq(key, &keys[i * KEYS_DICT_TEST_KEY_SIZE], KEYS_DICT_TEST_KEY_SIZE);
+        }
+        keys_read += count;
+    }
+    uint32_t batch_ticks = furi_get_tick() - start;
+    mu_assert_int_eq(KEYS_DICT_TEST_KEYS, keys_read);
+
+    FURI_LOG_I(
+        TAG,
+        "Iteration: %lu ticks by one key, %lu ticks by %d keys",
+        single_ticks,
+        batch_ticks,
+        KEYS_DICT_TEST_BATCH);
+
+    keys_dict_rewind(dict);
+    free(keys);
+}
+
+void test_keys_dict_index(void) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    uint8_t added[KEYS_DICT_TEST_KEY_SIZE];
+    uint8_t deleted[KEYS_DICT_TEST_KEY_SIZE];
+    keys_dict_test_key(1, added);
+    keys_dict_test_key(1000, deleted);
+
+    storage_simply_remove(storage, KEYS_DICT_TEST_INDEX_PATH);
+    mu_assert(
+        keys_dict_test_create(storage, "# Keys dict test\n"), "failed to create test dict");
+
+    KeysDict* dict =
+        keys_dict_alloc(KEYS_DICT_TEST_PATH, KeysDictModeOpenExisting, KEYS_DICT_TEST_KEY_SIZE);
+    mu_assert_int_eq(KEYS_DICT_TEST_KEYS, keys_dict_get_total_keys(dict));
+
+    keys_dict_test_iteration(dict);
+
+    // First lookup builds the index
+    uint32_t start = furi_get_tick();
+    mu_assert(
+        keys_dict_is_key_present(dict, deleted, KEYS_DICT_TEST_KEY_SIZE),
+        "keys_dict_is_key_present() failed");
+    FURI_LOG_I(TAG, "Index build: %lu ticks", furi_get_tick() - start);
+    mu_assert(
+        storage_file_exists(storage, KEYS_DICT_TEST_INDEX_PATH), "index file is not created");
+
+    keys_dict_test_lookups(dict);
+
+    // Add and delete keep the index in sync
+    mu_assert(
+        keys_dict_add_key(dict, added, KEYS_DICT_TEST_KEY_SIZE), "keys_dict_add_key() failed");
+    mu_assert(
+        keys_dict_delete_key(dict, deleted, KEYS_DICT_TEST_KEY_SIZE),
+        "keys_dict_delete_key() failed");
+    mu_assert(
+        !keys_dict_delete_key(dict, deleted, KEYS_DICT_TEST_KEY_SIZE),
+        "keys_dict_delete_key() removed a missing key");
+    mu_assert(
+        keys_dict_is_key_present(dict, added, KEYS_DICT_TEST_KEY_SIZE),
+        "added key is not present");
+    mu_assert(
+        !keys_dict_is_key_present(dict, deleted, KEYS_DICT_TEST_KEY_SIZE),
+        "deleted key is present");
+    keys_dict_free(dict);
+
+    // Index is reused after reopening
+    dict = keys_dict_alloc(KEYS_DICT_TEST_PATH, KeysDictModeOpenExisting, KEYS_DICT_TEST_KEY_SIZE);
+    mu_assert_int_eq(KEYS_DICT_TEST_KEYS, keys_dict_get_total_keys(dict));
+    start = furi_get_tick();
+    mu_assert(
+        keys_dict_is_key_present(dict, added, KEYS_DICT_TEST_KEY_SIZE),
+        "added key is not present after reopen");
+    FURI_LOG_I(TAG, "Index reuse: %lu ticks", furi_get_tick() - start);
+    mu_assert(
+        !keys_dict_is_key_present(dict, deleted, KEYS_DICT_TEST_KEY_SIZE),
+        "deleted key is present after reopen");
+    keys_dict_free(dict);
+
+    // Index doesn't match the dict changed outside of KeysDict and is rebuilt
+    mu_assert(
+        keys_dict_test_create(storage, "# Keys dict test, rewritten\n"),
+        "failed to create test dict");
+    dict = keys_dict_alloc(KEYS_DICT_TEST_PATH, KeysDictModeOpenExisting, KEYS_DICT_TEST_KEY_SIZE);
+    mu_assert(
+        !keys_dict_is_key_present(dict, added, KEYS_DICT_TEST_KEY_SIZE),
+        "key of a stale index is present");
+    mu_assert(
+        keys_dict_is_key_present(dict, deleted, KEYS_DICT_TEST_KEY_SIZE),
+        "key of a rebuilt index is missing");
+    keys_dict_free(dict);
+
+    storage_simply_remove(storage, KEYS_DICT_TEST_PATH);
+    storage_simply_remove(storage, KEYS_DICT_TEST_INDEX_PATH);
+    furi_record_close(RECORD_STORAGE);
+}
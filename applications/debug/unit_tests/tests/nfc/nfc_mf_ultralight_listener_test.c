@@ -0,0 +1,214 @@
+#include "../test.h" // IWYU pragma: keep
+#include <furi.h>
+#include <furi_hal_random.h>
+#include <nfc/nfc.h>
+#include <nfc/nfc_device.h>
+#include <nfc/nfc_poller.h>
+#include <nfc/nfc_listener.h>
+#include <nfc/helpers/nfc_data_generator.h>
+#include <nfc/protocols/iso14443_3a/iso14443_3a_poller.h>
+#include <nfc/protocols/mf_ultralight/mf_ultralight.h>
+
+#define TAG "MfUltralightListenerTest"
+
+#define MF_ULTRALIGHT_LISTENER_TEST_FWT_FC       (60000)
+#define MF_ULTRALIGHT_LISTENER_TEST_BENCH_ROUNDS (256)
+#define MF_ULTRALIGHT_LISTENER_TEST_WRITE_PAGE   (9)
+
+#define MF_ULTRALIGHT_LISTENER_TEST_FLAG_DONE (1UL << 0)
+
+typedef struct {
+    FuriThreadId thread_id;
+    MfUltralightPage* pages;
+    uint16_t user_pages;
+    BitBuffer* tx_buf;
+    BitBuffer* rx_buf;
+    uint32_t window_ticks;
+    uint32_t unaligned_ticks;
+    bool is_success;
+} NfcMfUltralightListenerTestContext;
+
+static bool mf_ultralight_listener_test_read(
+    Iso14443_3aPoller* poller,
+    NfcMfUltralightListenerTestContext* ctx,
+    uint16_t page) {
+    const uint8_t cmd[] = {MF_ULTRALIGHT_CMD_READ_PAGE, page};
+    bit_buffer_copy_bytes(ctx->tx_buf, cmd, sizeof(cmd));
+
+    Iso14443_3aError error = iso14443_3a_poller_send_standard_frame(
+        poller, ctx->tx_buf, ctx->rx_buf, MF_ULTRALIGHT_LISTENER_TEST_FWT_FC);
+    if(error != Iso14443_3aErrorNone) return false;
+    if(bit_buffer_get_size_bytes(ctx->rx_buf) != sizeof(MfUltralightPageReadCommandData))
+        return false;
+
+    return memcmp(
+               bit_buffer_get_data(ctx->rx_buf),
+               ctx->pages[page].data,
+               sizeof(MfUltralightPageReadCommandData)) == 0;
+}
+
+static bool mf_ultralight_listener_test_fast_read(
+    Iso14443_3aPoller* poller,
+    NfcMfUltralightListenerTestContext* ctx,
+    uint16_t start_page,
+    uint16_t end_page) {
+    const uint8_t cmd[] = {MF_ULTRALIGHT_CMD_FAST_READ, start_page, end_page};
+    bit_buffer_copy_bytes(ctx->tx_buf, cmd, sizeof(cmd));
+
+    Iso14443_3aError error = iso14443_3a_poller_send_standard_frame(
+        poller, ctx->tx_buf, ctx->rx_buf, MF_ULTRALIGHT_LISTENER_TEST_FWT_FC);
+    if(error != Iso14443_3aErrorNone) return false;
+
+    size_t size = (end_page - start_page + 1) * sizeof(MfUltralightPage);
+    if(bit_buffer_get_size_bytes(ctx->rx_buf) != size) return false;
+
+    return memcmp(bit_buffer_get_data(ctx->rx_buf), ctx->pages[start_page].data, size) == 0;
+}
+
+static bool mf_ultralight_listener_test_write(
+    Iso14443_3aPoller* poller,
+    NfcMfUltralightListenerTestContext* ctx,
+    uint16_t page) {
+    uint8_t cmd[MF_ULTRALIGHT_PAGE_SIZE + 2] = {MF_ULTRALIGHT_CMD_WRITE_PAGE, page};
+    furi_hal_random_fill_buf(ctx->pages[page].data, sizeof(MfUltralightPage));
+    memcpy(&cmd[2], ctx->pages[page].data, sizeof(MfUltralightPage));
+    bit_buffer_copy_bytes(ctx->tx_buf, cmd, sizeof(cmd));
+
+    // ACK is a 4 bit frame without CRC
+    Iso14443_3aError error = iso14443_3a_poller_send_standard_frame(
+        poller, ctx->tx_buf, ctx->rx_buf, MF_ULTRALIGHT_LISTENER_TEST_FWT_FC);
+    if(error != Iso14443_3aErrorWrongCrc) return false;
+    if(bit_buffer_get_size(ctx->rx_buf) != 4) return false;
+
+    return bit_buffer_starts_with_byte(ctx->rx_buf, MF_ULTRALIGHT_CMD_ACK);
+}
+
+static bool mf_ultralight_listener_test_check_pages(
+    Iso14443_3aPoller* poller,
+    NfcMfUltralightListenerTestContext* ctx) {
+    bool success = true;
+
+    // Second pass is served from the windows cached by the first one
+    for(size_t pass = 0; pass < 2 && success; pass++) {
+        for(uint16_t page = 0; page + 4 <= ctx->user_pages; page++) {
+            success = mf_ultralight_listener_test_read(poller, ctx, page);
+            if(!success) {
+                FURI_LOG_E(TAG, "Read page %u failed, pass %u", page, pass);
+                break;
+            }
+        }
+    }
+
+    return success;
+}
+
+static uint32_t mf_ultralight_listener_test_bench(
+    Iso14443_3aPoller* poller,
+    NfcMfUltralightListenerTestContext* ctx,
+    uint16_t page_offset) {
+    uint16_t windows = ctx->user_pages / 4;
+
+    uint32_t start = furi_get_tick();
+    for(size_t i = 0; i < MF_ULTRALIGHT_LISTENER_TEST_BENCH_ROUNDS; i++) {
+        if(!mf_ultralight_listener_test_read(poller, ctx, (i % windows) * 4 + page_offset)) {
+            ctx->is_success = false;
+            break;
+        }
+    }
+
+    return furi_get_tick() - start;
+}
+
+static NfcCommand mf_ultralight_listener_test_callback(NfcGenericEvent event, void* context) {
+    furi_check(event.protocol == NfcProtocolIso14443_3a);
+    furi_check(context);
+
+    NfcMfUltralightListenerTestContext* ctx = context;
+    Iso14443_3aPoller* poller = event.instance;
+    Iso14443_3aPollerEvent* iso3_event = event.event_data;
+
+    if(iso3_event->type == Iso14443_3aPollerEventTypeReady) {
+        const uint16_t write_page = MF_ULTRALIGHT_LISTENER_TEST_WRITE_PAGE;
+        do {
+            ctx->is_success = false;
+            if(!mf_ultralight_listener_test_check_pages(poller, ctx)) break;
+            if(!mf_ultralight_listener_test_fast_read(poller, ctx, 3, 41)) break;
+
+            // Write must drop the cached window, next reads return the new data
+            if(!mf_ultralight_listener_test_read(poller, ctx, write_page - 1)) break;
+            if(!mf_ultralight_listener_test_write(poller, ctx, write_page)) break;
+            if(!mf_ultralight_listener_test_read(poller, ctx, write_page - 1)) break;
+            if(!mf_ultralight_listener_test_read(poller, ctx, write_page)) break;
+            if(!mf_ultralight_listener_test_fast_read(poller, ctx, 5, 12)) break;
+
+            ctx->is_success = true;
+            ctx->window_ticks = mf_ultralight_listener_test_bench(poller, ctx, 0);
+            ctx->unaligned_ticks = mf_ultralight_listener_test_bench(poller, ctx, 1);
+        } while(false);
+    }
+
+    furi_thread_flags_set(ctx->thread_id, MF_ULTRALIGHT_LISTENER_TEST_FLAG_DONE);
+
+    return NfcCommandStop;
+}
+
+void test_mf_ultralight_listener_cache(void) {
+    Nfc* poller = nfc_alloc();
+    Nfc* listener = nfc_alloc();
+
+    NfcDevice* nfc_device = nfc_device_alloc();
+    nfc_data_generator_fill_data(NfcDataGeneratorTypeNTAG216, nfc_device);
+    MfUltralightData* data =
+        (MfUltralightData*)nfc_device_get_data(nfc_device, NfcProtocolMfUltralight);
+
+    // Random user memory, up to the dynamic lock page
+    uint16_t user_pages = mf_ultralight_get_config_page_num(data->type) - 1;
+    for(uint16_t i = 4; i < user_pages; i++) {
+        furi_hal_random_fill_buf(data->page[i].data, sizeof(MfUltralightPage));
+    }
+
+    NfcMfUltralightListenerTestContext context = {
+        .thread_id = furi_thread_get_current_id(),
+        .pages = malloc(data->pages_total * sizeof(MfUltralightPage)),
+        .user_pages = user_pages,
+        .tx_buf = bit_buffer_alloc(32),
+        .rx_buf = bit_buffer_alloc(256),
+    };
+    memcpy(context.pages, data->page, data->pages_total * sizeof(MfUltralightPage));
+
+    NfcListener* mfu_listener = nfc_listener_alloc(listener, NfcProtocolMfUltralight, data);
+    nfc_listener_start(mfu_listener, NULL, NULL);
+
+    NfcPoller* iso3_poller = nfc_poller_alloc(poller, NfcProtocolIso14443_3a);
+    nfc_poller_start(iso3_poller, mf_ultralight_listener_test_callback, &context);
+
+    uint32_t flag = furi_thread_flags_wait(
+        MF_ULTRALIGHT_LISTENER_TEST_FLAG_DONE, FuriFlagWaitAny, FuriWaitForever);
+    mu_assert(flag == MF_ULTRALIGHT_LISTENER_TEST_FLAG_DONE, "Wrong thread flag");
+    nfc_poller_stop(iso3_poller);
+    nfc_poller_free(iso3_poller);
+
+    nfc_listener_stop(mfu_listener);
+    const MfUltralightData* listener_data =
+        nfc_listener_get_data(mfu_listener, NfcProtocolMfUltralight);
+    mu_assert(context.is_success, "Listener responses don't match");
+    mu_assert_mem_eq(
+        context.pages[MF_ULTRALIGHT_LISTENER_TEST_WRITE_PAGE].data,
+        listener_data->page[MF_ULTRALIGHT_LISTENER_TEST_WRITE_PAGE].data,
+        sizeof(MfUltralightPage));
+
+    FURI_LOG_I(
+        TAG,
+        "%d READs: %lu ticks on cached windows, %lu ticks unaligned",
+        MF_ULTRALIGHT_LISTENER_TEST_BENCH_ROUNDS,
+        context.window_ticks,
+        context.unaligned_ticks);
+
+    nfc_listener_free(mfu_listener);
+    bit_buffer_free(context.rx_buf);
+    bit_buffer_free(context.tx_buf);
+    free(context.pages);
+    nfc_device_free(nfc_device);
+    nfc_free(listener);
+    nfc_free(poller);
+}
@@ -0,0 +1,350 @@
+#include "../test.h" // IWYU pragma: keep
+#include <furi.h>
+#include <storage/storage.h>
+#include <nfc/nfc.h>
+#include <nfc/nfc_device.h>
+#include <nfc/nfc_listener.h>
+#include <nfc/nfc_scanner.h>
+#include <nfc/helpers/nfc_data_generator.h>
+#include <nfc/helpers/iso14443_crc.h>
+#include <nfc/protocols/iso14443_4a/iso14443_4a.h>
+
+#define TAG "NfcScannerTest"
+
+#define NFC_SCANNER_TEST_TIMEOUT_MS (10000)
+
+#define NFC_SCANNER_TEST_FLAG_DETECTED (1UL << 0)
+
+#define NFC_SCANNER_TEST_CARD_B_BUFFER_SIZE (32U)
+
+#define NFC_SCANNER_TEST_CMD_REQB        (0x05)
+#define NFC_SCANNER_TEST_CMD_ATTRIB      (0x1D)
+#define NFC_SCANNER_TEST_CMD_HLTB        (0x50)
+#define NFC_SCANNER_TEST_CMD_ST25TB_INIT (0x06)
+#define NFC_SCANNER_TEST_CMD_ST25TB_SEL  (0x0E)
+#define NFC_SCANNER_TEST_CMD_ST25TB_UID  (0x0B)
+#define NFC_SCANNER_TEST_ST25TB_CHIP_ID  (0x42)
+
+typedef enum {
+    NfcScannerTestScanDefault,
+    NfcScannerTestScanFast,
+    NfcScannerTestScanCached,
+
+    NfcScannerTestScanNum,
+} NfcScannerTestScan;
+
+typedef struct {
+    FuriThreadId thread_id;
+    size_t protocols_num;
+    NfcProtocol protocols[NfcProtocolNum];
+} NfcScannerTestResult;
+
+static void nfc_scanner_test_callback(NfcScannerEvent event, void* context) {
+    furi_check(context);
+
+    NfcScannerTestResult* result = context;
+
+    if(event.type == NfcScannerEventTypeDetected) {
+        result->protocols_num = event.data.protocol_num;
+        memcpy(
+            result->protocols,
+            event.data.protocols,
+            event.data.protocol_num * sizeof(NfcProtocol));
+        furi_thread_flags_set(result->thread_id, NFC_SCANNER_TEST_FLAG_DETECTED);
+    }
+}
+
+static uint32_t nfc_scanner_test_scan(NfcScanner* scanner, NfcScannerTestResult* result) {
+    result->thread_id = furi_thread_get_current_id();
+    result->protocols_num = 0;
+
+    uint32_t start = furi_get_tick();
+    nfc_scanner_start(scanner, nfc_scanner_test_callback, result);
+    furi_thread_flags_wait(
+        NFC_SCANNER_TEST_FLAG_DETECTED, FuriFlagWaitAny, NFC_SCANNER_TEST_TIMEOUT_MS);
+    uint32_t ticks = furi_get_tick() - start;
+    nfc_scanner_stop(scanner);
+
+    return ticks;
+}
+
+typedef struct {
+    Nfc* poller;
+    NfcScanner* fast_scanner;
+} NfcScannerTestContext;
+
+/** Minimal ISO14443B card, there are no ISO14443-3B and ST25TB listeners */
+typedef struct {
+    Nfc* nfc;
+    NfcProtocol protocol;
+    BitBuffer* tx_buffer;
+    size_t frames_num;
+} NfcScannerTestCardB;
+
+static const uint8_t nfc_scanner_test_atqb[] = {
+    0x50, // ATQB
+    0x11, 0x22, 0x33, 0x44, // PUPI
+    0x00, 0x00, 0x00, 0x00, // Application data
+    0x00, 0x81, 0x70, // 256 byte frames, ISO14443-4 compliant, FWI 7
+};
+
+static const uint8_t nfc_scanner_test_st25tb_uid[] = {
+    0x55, 0x44, 0x33, 0x22, 0x11, 0x1B, 0x02, 0xD0,
+};
+
+static NfcCommand nfc_scanner_test_card_b_callback(NfcEvent event, void* context) {
+    furi_check(context);
+
+    NfcScannerTestCardB* card = context;
+    BitBuffer* rx_buffer = event.data.buffer;
+
+    if((event.type == NfcEventTypeRxEnd) &&
+       (bit_buffer_get_size_bytes(rx_buffer) > ISO14443_CRC_SIZE) &&
+       iso14443_crc_check(Iso14443CrcTypeB, rx_buffer)) {
+        card->frames_num++;
+        iso14443_crc_trim(rx_buffer);
+
+        const uint8_t cmd = bit_buffer_get_byte(rx_buffer, 0);
+        bit_buffer_reset(card->tx_buffer);
+
+        if(card->protocol == NfcProtocolIso14443_4b) {
+            if(cmd == NFC_SCANNER_TEST_CMD_REQB) {
+                bit_buffer_append_bytes(
+                    card->tx_buffer, nfc_scanner_test_atqb, sizeof(nfc_scanner_test_atqb));
+            } else if(cmd == NFC_SCANNER_TEST_CMD_ATTRIB || cmd == NFC_SCANNER_TEST_CMD_HLTB) {
+                bit_buffer_append_byte(card->tx_buffer, 0x00);
+            }
+        } else {
+            if(cmd == NFC_SCANNER_TEST_CMD_ST25TB_INIT || cmd == NFC_SCANNER_TEST_CMD_ST25TB_SEL) {
+                bit_buffer_append_byte(card->tx_buffer, NFC_SCANNER_TEST_ST25TB_CHIP_ID);
+            } else if(cmd == NFC_SCANNER_TEST_CMD_ST25TB_UID) {
+                bit_buffer_append_bytes(
+                    card->tx_buffer,
+                    nfc_scanner_test_st25tb_uid,
+                    sizeof(nfc_scanner_test_st25tb_uid));
+            }
+        }
+
+        // Commands of other protocols are not answered, like a real card does
+        if(bit_buffer_get_size_bytes(card->tx_buffer) > 0) {
+            iso14443_crc_append(Iso14443CrcTypeB, card->tx_buffer);
+            nfc_listener_tx(card->nfc, card->tx_buffer);
+        }
+    }
+
+    return NfcCommandContinue;
+}
+
+/**
+ * Run a default scan, a fast scan and a cached fast scan of the card in the field.
+ * If card_frames_num is set, the number of frames the card received in each scan is
+ * stored in frames_num.
+ */
+static void nfc_scanner_test_scans(
+    NfcScannerTestContext* ctx,
+    const char* family,
+    NfcProtocol protocol,
+    const size_t* card_frames_num,
+    size_t* frames_num) {
+    NfcScannerTestResult results[NfcScannerTestScanNum] = {};
+    uint32_t ticks[NfcScannerTestScanNum] = {};
+
+    NfcScanner* scanner = nfc_scanner_alloc(ctx->poller);
+
+    // Fast scanner cache holds the previous card, so the first fast scan must not use it
+    for(size_t i = 0; i < NfcScannerTestScanNum; i++) {
+        NfcScanner* current = (i == NfcScannerTestScanDefault) ? scanner : ctx->fast_scanner;
+        size_t frames_start = card_frames_num ? *card_frames_num : 0;
+        ticks[i] = nfc_scanner_test_scan(current, &results[i]);
+        if(card_frames_num) {
+            frames_num[i] = *card_frames_num - frames_start;
+        }
+    }
+
+    nfc_scanner_free(scanner);
+
+    FURI_LOG_I(
+        TAG,
+        "%s: %lu ticks default, %lu ticks fast, %lu ticks cached",
+        family,
+        ticks[NfcScannerTestScanDefault],
+        ticks[NfcScannerTestScanFast],
+        ticks[NfcScannerTestScanCached]);
+
+    for(size_t i = 0; i < NfcScannerTestScanNum; i++) {
+        mu_assert(results[i].protocols_num == 1, "Wrong number of detected protocols");
+        mu_assert(results[i].protocols[0] == protocol, "Wrong detected protocol");
+    }
+}
+
+/**
+ * Present a card with the same base protocol data, but without the child protocol behind it.
+ * The fast scanner can only report the child protocol from the cache, because probing it
+ * fails. After the cache reset, the result must be the same as of a default scan.
+ */
+static void nfc_scanner_test_base_only(
+    NfcScannerTestContext* ctx,
+    const NfcDevice* nfc_device,
+    NfcProtocol protocol,
+    NfcProtocol base_protocol) {
+    Nfc* listener = nfc_alloc();
+    NfcListener* nfc_listener = nfc_listener_alloc(
+        listener, base_protocol, nfc_device_get_data(nfc_device, base_protocol));
+    nfc_listener_start(nfc_listener, NULL, NULL);
+
+    NfcScannerTestResult cached = {};
+    NfcScannerTestResult expected = {};
+    NfcScannerTestResult reset = {};
+
+    nfc_scanner_test_scan(ctx->fast_scanner, &cached);
+
+    NfcScanner* scanner = nfc_scanner_alloc(ctx->poller);
+    nfc_scanner_test_scan(scanner, &expected);
+    nfc_scanner_free(scanner);
+
+    nfc_scanner_reset_cache(ctx->fast_scanner);
+    nfc_scanner_test_scan(ctx->fast_scanner, &reset);
+
+    nfc_listener_stop(nfc_listener);
+    nfc_listener_free(nfc_listener);
+    nfc_free(listener);
+
+    mu_assert(cached.protocols_num == 1, "Wrong number of cached protocols");
+    mu_assert(cached.protocols[0] == protocol, "Cached scan probed the card again");
+    mu_assert(reset.protocols_num == expected.protocols_num, "Cache reset is ignored");
+    const size_t protocols_size = expected.protocols_num * sizeof(NfcProtocol);
+    mu_assert(
+        memcmp(reset.protocols, expected.protocols, protocols_size) == 0,
+        "Cache reset is ignored");
+}
+
+static void nfc_scanner_test_family(
+    NfcScannerTestContext* ctx,
+    const char* family,
+    const NfcDevice* nfc_device,
+    NfcProtocol protocol) {
+    Nfc* listener = nfc_alloc();
+    NfcListener* nfc_listener =
+        nfc_listener_alloc(listener, protocol, nfc_device_get_data(nfc_device, protocol));
+    nfc_listener_start(nfc_listener, NULL, NULL);
+
+    nfc_scanner_test_scans(ctx, family, protocol, NULL, NULL);
+
+    nfc_listener_stop(nfc_listener);
+    nfc_listener_free(nfc_listener);
+    nfc_free(listener);
+
+    NfcProtocol base_protocol = protocol;
+    while(nfc_protocol_get_parent(base_protocol) != NfcProtocolInvalid) {
+        base_protocol = nfc_protocol_get_parent(base_protocol);
+    }
+
+    if(base_protocol != protocol) {
+        nfc_scanner_test_base_only(ctx, nfc_device, protocol, base_protocol);
+    }
+}
+
+static void nfc_scanner_test_card_b(NfcScannerTestContext* ctx, NfcProtocol protocol) {
+    NfcScannerTestCardB card = {
+        .nfc = nfc_alloc(),
+        .protocol = protocol,
+        .tx_buffer = bit_buffer_alloc(NFC_SCANNER_TEST_CARD_B_BUFFER_SIZE),
+    };
+    nfc_config(card.nfc, NfcModeListener, NfcTechIso14443b);
+    nfc_start(card.nfc, nfc_scanner_test_card_b_callback, &card);
+
+    size_t frames_num[NfcScannerTestScanNum] = {};
+    nfc_scanner_test_scans(
+        ctx, nfc_device_get_protocol_name(protocol), protocol, &card.frames_num, frames_num);
+
+    nfc_stop(card.nfc);
+    nfc_free(card.nfc);
+    bit_buffer_free(card.tx_buffer);
+
+    FURI_LOG_I(
+        TAG,
+        "%s: %zu frames default, %zu frames fast, %zu frames cached",
+        nfc_device_get_protocol_name(protocol),
+        frames_num[NfcScannerTestScanDefault],
+        frames_num[NfcScannerTestScanFast],
+        frames_num[NfcScannerTestScanCached]);
+
+    // Child protocols are decided from the base protocol data or from the cache
+    mu_assert(
+        frames_num[NfcScannerTestScanCached] <= frames_num[NfcScannerTestScanFast],
+        "Cached scan probed the card again");
+    if(nfc_protocol_get_parent(protocol) != NfcProtocolInvalid) {
+        mu_assert(
+            frames_num[NfcScannerTestScanFast] < frames_num[NfcScannerTestScanDefault],
+            "Fast scan probed the child protocol");
+    } else {
+        mu_assert(
+            frames_num[NfcScannerTestScanFast] <= frames_num[NfcScannerTestScanDefault],
+            "Fast scan sent more frames");
+    }
+}
+
+static void nfc_scanner_test_iso14443_4a(NfcScannerTestContext* ctx) {
+    const uint8_t uid[] = {0x04, 0x51, 0x5C, 0xFA, 0x6F, 0x73, 0x81};
+    const uint8_t atqa[] = {0x44, 0x03};
+
+    Iso14443_4aData* data = iso14443_4a_alloc();
+    Iso14443_3aData* base_data = iso14443_4a_get_base_data(data);
+    iso14443_3a_set_uid(base_data, uid, sizeof(uid));
+    iso14443_3a_set_atqa(base_data, atqa);
+    iso14443_3a_set_sak(base_data, 0x20);
+    data->ats_data.tl = 1;
+
+    NfcDevice* nfc_device = nfc_device_alloc();
+    nfc_device_set_data(nfc_device, NfcProtocolIso14443_4a, data);
+    iso14443_4a_free(data);
+
+    nfc_scanner_test_family(
+        ctx,
+        nfc_device_get_protocol_name(NfcProtocolIso14443_4a),
+        nfc_device,
+        NfcProtocolIso14443_4a);
+
+    nfc_device_free(nfc_device);
+}
+
+static void nfc_scanner_test_generator(
+    NfcScannerTestContext* ctx,
+    NfcDataGeneratorType type,
+    NfcProtocol protocol) {
+    NfcDevice* nfc_device = nfc_device_alloc();
+    nfc_data_generator_fill_data(type, nfc_device);
+
+    nfc_scanner_test_family(ctx, nfc_data_generator_get_name(type), nfc_device, protocol);
+
+    nfc_device_free(nfc_device);
+}
+
+static void
+    nfc_scanner_test_file(NfcScannerTestContext* ctx, const char* path, NfcProtocol protocol) {
+    NfcDevice* nfc_device = nfc_device_alloc();
+    mu_assert(nfc_device_load(nfc_device, path), "nfc_device_load() failed");
+
+    nfc_scanner_test_family(ctx, nfc_device_get_protocol_name(protocol), nfc_device, protocol);
+
+    nfc_device_free(nfc_device);
+}
+
+void test_nfc_scanner_fast_mode(void) {
+    NfcScannerTestContext ctx = {
+        .poller = nfc_alloc(),
+    };
+    ctx.fast_scanner = nfc_scanner_alloc(ctx.poller);
+    nfc_scanner_set_mode(ctx.fast_scanner, NfcScannerModeFast);
+
+    nfc_scanner_test_generator(&ctx, NfcDataGeneratorTypeNTAG215, NfcProtocolMfUltralight);
+    nfc_scanner_test_generator(&ctx, NfcDataGeneratorTypeMfClassic1k_7b, NfcProtocolMfClassic);
+    nfc_scanner_test_file(&ctx, EXT_PATH("unit_tests/nfc/Felica.nfc"), NfcProtocolFelica);
+    nfc_scanner_test_file(&ctx, EXT_PATH("unit_tests/nfc/Slix_cap_default.nfc"), NfcProtocolSlix);
+    nfc_scanner_test_iso14443_4a(&ctx);
+    nfc_scanner_test_card_b(&ctx, NfcProtocolIso14443_4b);
+    nfc_scanner_test_card_b(&ctx, NfcProtocolSt25tb);
+
+    nfc_scanner_free(ctx.fast_scanner);
+    nfc_free(ctx.poller);
+}
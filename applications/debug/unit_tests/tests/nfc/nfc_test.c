@@ -35,6 +35,12 @@
 
 #define NFC_TEST_FLAG_WORKER_DONE (1)
 
+void test_keys_dict_index(void);
+void test_mf_classic_dict_attack(void);
+void test_crypto1_bit_exact(void);
+void test_mf_ultralight_listener_cache(void);
+void test_nfc_scanner_fast_mode(void);
+
 typedef enum {
     NfcTestMfClassicSendFrameTestStateAuth,
     NfcTestMfClassicSendFrameTestStateReadBlock,
@@ -387,6 +393,14 @@ static void mf_ultralight_write(void) {
     nfc_free(poller);
 }
 
+MU_TEST(mf_ultralight_listener_cache_test) {
+    test_mf_ultralight_listener_cache();
+}
+
+MU_TEST(nfc_scanner_fast_mode_test) {
+    test_nfc_scanner_fast_mode();
+}
+
 static void mf_classic_reader(void) {
     Nfc* poller = nfc_alloc();
     Nfc* listener = nfc_alloc();
@@ -650,6 +664,19 @@ MU_TEST(mf_classic_dict_test) {
     mu_assert(
         storage_simply_remove(storage, NFC_APP_MF_CLASSIC_DICT_UNIT_TEST_PATH),
         "Remove test dict failed");
+    storage_simply_remove(storage, NFC_APP_MF_CLASSIC_DICT_UNIT_TEST_PATH ".idx");
+}
+
+MU_TEST(mf_classic_dict_index_test) {
+    test_keys_dict_index();
+}
+
+MU_TEST(mf_classic_dict_attack_test) {
+    test_mf_classic_dict_attack();
+}
+
+MU_TEST(crypto1_bit_exact_test) {
+    test_crypto1_bit_exact();
 }
 
 static FelicaError
@@ -835,6 +862,7 @@ MU_TEST_SUITE(nfc) {
     MU_RUN_TEST(mf_ultralight_c_reader);
 
     MU_RUN_TEST(mf_ultralight_write);
+    MU_RUN_TEST(mf_ultralight_listener_cache_test);
 
     MU_RUN_TEST(iso14443_3a_4b_file_test);
     MU_RUN_TEST(iso14443_3a_7b_file_test);
@@ -863,7 +891,10 @@ MU_TEST_SUITE(nfc) {
     MU_RUN_TEST(mf_classic_write);
     MU_RUN_TEST(mf_classic_value_block);
     MU_RUN_TEST(mf_classic_send_frame_test);
+    MU_RUN_TEST(crypto1_bit_exact_test);
     MU_RUN_TEST(mf_classic_dict_test);
+    MU_RUN_TEST(mf_classic_dict_index_test);
+    MU_RUN_TEST(mf_classic_dict_attack_test);
     MU_RUN_TEST(felica_read);
     MU_RUN_TEST(felica_read_auth);
 
@@ -872,6 +903,8 @@ MU_TEST_SUITE(nfc) {
     MU_RUN_TEST(slix_set_password_default_cap_incorrect_pass);
     MU_RUN_TEST(slix_set_password_access_all_passwords_cap);
 
+    MU_RUN_TEST(nfc_scanner_fast_mode_test);
+
     nfc_test_free();
 }
 
@@ -0,0 +1,235 @@
+#include "../test.h" // IWYU pragma: keep
+#include <furi.h>
+#include <furi_hal.h>
+
+#include <targets/f7/fatfs/sector_cache.h>
+
+#define TAG "SectorCacheTest"
+
+#define SECTOR_CACHE_TEST_SIZE       16
+#define SECTOR_CACHE_TEST_DISK_SIZE  256
+#define SECTOR_CACHE_TEST_ITERATIONS 20000
+
+// Disk layout of the simulated FatFs trace
+#define SECTOR_CACHE_TEST_FAT_START  1
+#define SECTOR_CACHE_TEST_FAT_SIZE   4
+#define SECTOR_CACHE_TEST_DIR_START  5
+#define SECTOR_CACHE_TEST_DIR_SIZE   4
+#define SECTOR_CACHE_TEST_DATA_START 16
+#define SECTOR_CACHE_TEST_FILES      64
+#define SECTOR_CACHE_TEST_FILE_SIZE  32
+
+// Round robin cache that was used before, for comparison
+#define SECTOR_CACHE_TEST_OLD_SIZE 8
+
+/*
+ * Disk image keeps only a version of each sector,
+ * sector contents are derived from sector number and version.
+ */
+typedef struct {
+    uint32_t versions[SECTOR_CACHE_TEST_DISK_SIZE];
+    uint32_t device_reads;
+    uint32_t device_writes;
+} SectorCacheTestDisk;
+
+typedef struct {
+    uint32_t itr;
+    uint32_t sectors[SECTOR_CACHE_TEST_OLD_SIZE];
+    uint32_t hits;
+} SectorCacheTestOld;
+
+static void sector_cache_test_fill(uint8_t* data, uint32_t sector, uint32_t version) {
+    uint32_t* words = (uint32_t*)data;
+    for(size_t i = 0; i < SECTOR_CACHE_SECTOR_SIZE / sizeof(uint32_t); i++) {
+        words[i] = sector * 0x9E3779B1UL + version * 0x85EBCA77UL + i;
+    }
+}
+
+static bool sector_cache_test_check(const uint8_t* data, uint32_t sector, uint32_t version) {
+    uint8_t expected[SECTOR_CACHE_SECTOR_SIZE];
+    sector_cache_test_fill(expected, sector, version);
+    return memcmp(expected, data, SECTOR_CACHE_SECTOR_SIZE) == 0;
+}
+
+static uint32_t sector_cache_test_version(const uint8_t* data, uint32_t sector) {
+    const uint32_t* words = (const uint32_t*)data;
+    return (words[0] - sector * 0x9E3779B1UL) * 0xB6C92F47UL; // Inverse of 0x85EBCA77
+}
+
+static bool sector_cache_test_write_callback(void* context, uint32_t sector, const uint8_t* data) {
+    SectorCacheTestDisk* disk = context;
+    disk->versions[sector] = sector_cache_test_version(data, sector);
+    disk->device_writes++;
+    return true;
+}
+
+static void sector_cache_test_read(
+    SectorCache* cache,
+    SectorCacheTestDisk* disk,
+    uint32_t sector,
+    uint8_t* data) {
+    uint8_t* cached = sector_cache_get(cache, sector);
+    if(cached) {
+        memcpy(data, cached, SECTOR_CACHE_SECTOR_SIZE);
+    } else {
+        sector_cache_test_fill(data, sector, disk->versions[sector]);
+        disk->device_reads++;
+        sector_cache_put(cache, sector, data);
+    }
+}
+
+static void test_sector_cache_coherence(void) {
+    SectorCacheTestDisk* disk = malloc(sizeof(SectorCacheTestDisk));
+    uint32_t* versions = malloc(sizeof(uint32_t) * SECTOR_CACHE_TEST_DISK_SIZE);
+    uint8_t* data = malloc(SECTOR_CACHE_SECTOR_SIZE * 4);
+
+    SectorCache* cache = sector_cache_alloc(SECTOR_CACHE_TEST_SIZE, NULL);
+    sector_cache_set_write_callback(cache, sector_cache_test_write_callback, disk);
+    mu_check(sector_cache_pin_range(
+        cache,
+        SECTOR_CACHE_TEST_FAT_START,
+        SECTOR_CACHE_TEST_FAT_START + SECTOR_CACHE_TEST_FAT_SIZE - 1));
+
+    // Random single reads, single writes, multi sector reads and writes against a model
+    bool coherent = true;
+    for(size_t i = 0; i < SECTOR_CACHE_TEST_ITERATIONS && coherent; i++) {
+        uint32_t random = furi_hal_random_get();
+        uint32_t sector = (random >> 8) % (SECTOR_CACHE_TEST_DISK_SIZE - 4);
+        if(random & 0x80) sector %= 32;
+        uint32_t count = 1 + ((random >> 4) & 3);
+
+        switch(random & 7) {
+        case 0:
+        case 1:
+        case 2:
+            sector_cache_test_read(cache, disk, sector, data);
+            coherent = sector_cache_test_check(data, sector, versions[sector]);
+            break;
+        case 3:
+            for(size_t j = 0; j < count; j++) {
+                sector_cache_test_fill(
+                    &data[j * SECTOR_CACHE_SECTOR_SIZE], sector + j, disk->versions[sector + j]);
+            }
+            sector_cache_apply_dirty(cache, sector, count, data);
+            for(size_t j = 0; j < count; j++) {
+                coherent &= sector_cache_test_check(
+                    &data[j * SECTOR_CACHE_SECTOR_SIZE], sector + j, versions[sector + j]);
+            }
+            break;
+        case 4:
+        case 5:
+            sector_cache_test_fill(data, sector, ++versions[sector]);
+            mu_check(sector_cache_write(cache, sector, data));
+            break;
+        case 6:
+            for(size_t j = 0; j < count; j++) {
+                versions[sector + j]++;
+                disk->versions[sector + j] = versions[sector + j];
+            }
+            sector_cache_invalidate_range(cache, sector, sector + count - 1);
+            break;
+        default:
+            if((random & 0xF00) == 0) {
+                mu_check(sector_cache_flush(cache));
+                coherent = memcmp(disk->versions, versions, sizeof(disk->versions)) == 0;
+            }
+            break;
+        }
+    }
+    mu_check(coherent);
+
+    mu_check(sector_cache_flush(cache));
+    mu_check(memcmp(disk->versions, versions, sizeof(disk->versions)) == 0);
+
+    SectorCacheStats stats;
+    sector_cache_get_stats(cache, &stats);
+    mu_assert_int_eq(0, stats.dirty);
+    FURI_LOG_I(
+        TAG,
+        "hits %lu, misses %lu, writes %lu, write backs %lu, evictions %lu",
+        stats.hits,
+        stats.misses,
+        stats.writes,
+        stats.write_backs,
+        stats.evictions);
+
+    sector_cache_free(cache);
+    free(data);
+    free(versions);
+    free(disk);
+}
+
+static bool sector_cache_test_old_read(SectorCacheTestOld* old, uint32_t sector) {
+    for(size_t i = 0; i < SECTOR_CACHE_TEST_OLD_SIZE; i++) {
+        if(old->sectors[i] == sector) {
+            old->hits++;
+            return true;
+        }
+    }
+    old->sectors[old->itr % SECTOR_CACHE_TEST_OLD_SIZE] = sector;
+    old->itr++;
+    return false;
+}
+
+static void test_sector_cache_trace(void) {
+    SectorCacheTestDisk* disk = malloc(sizeof(SectorCacheTestDisk));
+    SectorCacheTestOld* old = malloc(sizeof(SectorCacheTestOld));
+    uint8_t* data = malloc(SECTOR_CACHE_SECTOR_SIZE);
+
+    SectorCache* cache = sector_cache_alloc(SECTOR_CACHE_TEST_SIZE, NULL);
+    sector_cache_pin_range(
+        cache,
+        SECTOR_CACHE_TEST_FAT_START,
+        SECTOR_CACHE_TEST_DIR_START + SECTOR_CACHE_TEST_DIR_SIZE - 1);
+
+    // Open every file in turn: directory lookup, FAT chain walk, then data read
+    uint32_t accesses = 0;
+    uint32_t cycles = 0;
+    for(size_t round = 0; round < 4; round++) {
+        for(uint32_t file = 0; file < SECTOR_CACHE_TEST_FILES; file++) {
+            uint32_t sectors[3 + SECTOR_CACHE_TEST_FILE_SIZE];
+            size_t count = 0;
+            sectors[count++] = SECTOR_CACHE_TEST_DIR_START + file % SECTOR_CACHE_TEST_DIR_SIZE;
+            sectors[count++] = SECTOR_CACHE_TEST_FAT_START + file % SECTOR_CACHE_TEST_FAT_SIZE;
+            sectors[count++] =
+                SECTOR_CACHE_TEST_FAT_START + (file + 1) % SECTOR_CACHE_TEST_FAT_SIZE;
+            for(size_t i = 0; i < SECTOR_CACHE_TEST_FILE_SIZE; i++) {
+                sectors[count++] = SECTOR_CACHE_TEST_DATA_START +
+                                   (file * SECTOR_CACHE_TEST_FILE_SIZE + i) %
+                                       (SECTOR_CACHE_TEST_DISK_SIZE -
+                                        SECTOR_CACHE_TEST_DATA_START);
+            }
+
+            for(size_t i = 0; i < count; i++) {
+                uint32_t start = DWT->CYCCNT;
+                sector_cache_test_read(cache, disk, sectors[i], data);
+                cycles += DWT->CYCCNT - start;
+                sector_cache_test_old_read(old, sectors[i]);
+                accesses++;
+            }
+        }
+    }
+
+    SectorCacheStats stats;
+    sector_cache_get_stats(cache, &stats);
+    FURI_LOG_I(
+        TAG,
+        "trace: %lu accesses, lru %lu hits, round robin %lu hits, %lu cycles per access",
+        accesses,
+        stats.hits,
+        old->hits,
+        cycles / accesses);
+
+    mu_assert_int_eq(accesses, stats.hits + stats.misses);
+    mu_check(stats.hits > old->hits);
+
+    sector_cache_free(cache);
+    free(data);
+    free(old);
+    free(disk);
+}
+
+void test_sector_cache(void) {
+    test_sector_cache_coherence();
+    test_sector_cache_trace();
+}
@@ -0,0 +1,188 @@
+#include "../test.h" // IWYU pragma: keep
+#include <furi.h>
+#include <storage/storage.h>
+
+#define TAG "StorageBatchTest"
+
+#define STORAGE_BATCH_TEST_FILE EXT_PATH(".tmp/unit_tests/batch.test")
+
+#define STORAGE_BATCH_TEST_FILE_SIZE (16 * 1024)
+#define STORAGE_BATCH_TEST_PIECE     64
+#define STORAGE_BATCH_TEST_OPS       16
+
+typedef enum {
+    StorageBatchTestModeCall,
+    StorageBatchTestModeBatch,
+    StorageBatchTestModeLease,
+    StorageBatchTestModeNum,
+} StorageBatchTestMode;
+
+static const char* const storage_batch_test_mode_names[StorageBatchTestModeNum] = {
+    [StorageBatchTestModeCall] = "call per piece",
+    [StorageBatchTestModeBatch] = "batch",
+    [StorageBatchTestModeLease] = "lease",
+};
+
+static uint8_t storage_batch_test_byte(size_t position) {
+    return (position * 31 + (position >> 8)) & 0xFF;
+}
+
+static bool storage_batch_test_check(const uint8_t* data, size_t position, size_t size) {
+    for(size_t i = 0; i < size; i++) {
+        if(data[i] != storage_batch_test_byte(position + i)) return false;
+    }
+    return true;
+}
+
+static bool storage_batch_test_create(Storage* storage) {
+    File* file = storage_file_alloc(storage);
+    uint8_t* data = malloc(STORAGE_BATCH_TEST_FILE_SIZE);
+    for(size_t i = 0; i < STORAGE_BATCH_TEST_FILE_SIZE; i++) {
+        data[i] = storage_batch_test_byte(i);
+    }
+
+    bool result = false;
+    if(storage_file_open(file, STORAGE_BATCH_TEST_FILE, FSAM_WRITE, FSOM_CREATE_ALWAYS)) {
+        result = storage_file_write(file, data, STORAGE_BATCH_TEST_FILE_SIZE) ==
+                 STORAGE_BATCH_TEST_FILE_SIZE;
+    }
+
+    free(data);
+    storage_file_free(file);
+    return result;
+}
+
+static bool storage_batch_test_read(File* file, StorageBatchTestMode mode, uint8_t* data) {
+    const size_t pieces = STORAGE_BATCH_TEST_FILE_SIZE / STORAGE_BATCH_TEST_PIECE;
+    bool result = true;
+
+    if(mode == StorageBatchTestModeBatch) {
+        StorageFileOp ops[STORAGE_BATCH_TEST_OPS];
+        for(size_t i = 0; i < pieces && result; i += STORAGE_BATCH_TEST_OPS) {
+            for(size_t j = 0; j < STORAGE_BATCH_TEST_OPS; j++) {
+                ops[j] = (StorageFileOp){
+                    .type = StorageFileOpRead,
+                    .buff = &data[(i + j) * STORAGE_BATCH_TEST_PIECE],
+                    .size = STORAGE_BATCH_TEST_PIECE,
+                };
+            }
+            result = storage_file_batch(file, ops, STORAGE_BATCH_TEST_OPS) ==
+                     STORAGE_BATCH_TEST_OPS;
+        }
+    } else {
+        if(mode == StorageBatchTestModeLease) storage_file_lease_acquire(file);
+        for(size_t i = 0; i < pieces && result; i++) {
+            result = storage_file_read(
+                         file, &data[i * STORAGE_BATCH_TEST_PIECE], STORAGE_BATCH_TEST_PIECE) ==
+                     STORAGE_BATCH_TEST_PIECE;
+        }
+        if(mode == StorageBatchTestModeLease) storage_file_lease_release(file);
+    }
+
+    return result;
+}
+
+static void test_storage_batch_benchmark(Storage* storage) {
+    File* file = storage_file_alloc(storage);
+    uint8_t* data = malloc(STORAGE_BATCH_TEST_FILE_SIZE);
+
+    for(StorageBatchTestMode mode = 0; mode < StorageBatchTestModeNum; mode++) {
+        mu_assert(
+            storage_file_open(file, STORAGE_BATCH_TEST_FILE, FSAM_READ, FSOM_OPEN_EXISTING),
+            "failed to open test file");
+
+        memset(data, 0, STORAGE_BATCH_TEST_FILE_SIZE);
+        uint32_t start = furi_get_tick();
+        bool read = storage_batch_test_read(file, mode, data);
+        uint32_t ticks = furi_get_tick() - start;
+
+        storage_file_close(file);
+
+        mu_assert(read, storage_batch_test_mode_names[mode]);
+        mu_assert(
+            storage_batch_test_check(data, 0, STORAGE_BATCH_TEST_FILE_SIZE),
+            storage_batch_test_mode_names[mode]);
+        FURI_LOG_I(
+            TAG,
+            "%s: %d bytes in %d byte pieces, %lu ticks",
+            storage_batch_test_mode_names[mode],
+            STORAGE_BATCH_TEST_FILE_SIZE,
+            STORAGE_BATCH_TEST_PIECE,
+            ticks);
+    }
+
+    free(data);
+    storage_file_free(file);
+}
+
+static void test_storage_batch_ops(Storage* storage) {
+    File* file = storage_file_alloc(storage);
+    uint8_t data[32];
+
+    mu_assert(
+        storage_file_open(
+            file, STORAGE_BATCH_TEST_FILE, FSAM_READ | FSAM_WRITE, FSOM_OPEN_EXISTING),
+        "failed to open test file");
+
+    // Seek, read and write in one request
+    const uint8_t patch[4] = {0xDE, 0xAD, 0xBE, 0xEF};
+    StorageFileOp ops[] = {
+        {.type = StorageFileOpSeek, .offset = 100, .from_start = true},
+        {.type = StorageFileOpRead, .buff = data, .size = 10},
+        {.type = StorageFileOpWrite, .write_buff = patch, .size = sizeof(patch)},
+        {.type = StorageFileOpSeek, .offset = 110, .from_start = true},
+        {.type = StorageFileOpRead, .buff = &data[10], .size = sizeof(patch)},
+    };
+    mu_assert_int_eq(COUNT_OF(ops), storage_file_batch(file, ops, COUNT_OF(ops)));
+    mu_assert_int_eq(10, ops[1].result);
+    mu_assert_int_eq(sizeof(patch), ops[2].result);
+    mu_check(storage_batch_test_check(data, 100, 10));
+    mu_assert_mem_eq(patch, &data[10], sizeof(patch));
+
+    // Short read stops the batch, its result is still filled
+    StorageFileOp eof_ops[] = {
+        {.type = StorageFileOpSeek,
+         .offset = STORAGE_BATCH_TEST_FILE_SIZE - 8,
+         .from_start = true},
+        {.type = StorageFileOpRead, .buff = data, .size = 16},
+        {.type = StorageFileOpRead, .buff = data, .size = 16, .result = 0xFF},
+    };
+    mu_assert_int_eq(1, storage_file_batch(file, eof_ops, COUNT_OF(eof_ops)));
+    mu_assert_int_eq(8, eof_ops[1].result);
+    mu_assert_int_eq(0xFF, eof_ops[2].result);
+    mu_check(storage_batch_test_check(data, STORAGE_BATCH_TEST_FILE_SIZE - 8, 8));
+
+    // Lease: same calls executed in this thread, checked after release to not block storage
+    storage_file_lease_acquire(file);
+    bool seek = storage_file_seek(file, 200, true);
+    uint64_t tell = storage_file_tell(file);
+    uint64_t size = storage_file_size(file);
+    size_t read = storage_file_read(file, data, 16);
+    size_t batch = storage_file_batch(file, ops, 1);
+    uint64_t batch_tell = storage_file_tell(file);
+    bool eof = storage_file_eof(file);
+    storage_file_lease_release(file);
+
+    mu_check(seek);
+    mu_assert_int_eq(200, tell);
+    mu_assert_int_eq(STORAGE_BATCH_TEST_FILE_SIZE, size);
+    mu_assert_int_eq(16, read);
+    mu_check(storage_batch_test_check(data, 200, 16));
+    mu_assert_int_eq(1, batch);
+    mu_assert_int_eq(100, batch_tell);
+    mu_check(!eof);
+
+    storage_file_close(file);
+    storage_file_free(file);
+}
+
+void test_storage_batch(void) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+
+    mu_assert(storage_batch_test_create(storage), "failed to create test file");
+    test_storage_batch_benchmark(storage);
+    test_storage_batch_ops(storage);
+    storage_simply_remove(storage, STORAGE_BATCH_TEST_FILE);
+
+    furi_record_close(RECORD_STORAGE);
+}
@@ -1,11 +1,15 @@
 #include "../test.h" // IWYU pragma: keep
 #include <furi.h>
+#include <furi_hal_sd.h>
 #include <storage/storage.h>
+#include <toolbox/stream/buffered_file_stream.h>
 
 // DO NOT USE THIS IN PRODUCTION CODE
 // This is a hack to access internal storage functions and definitions
 #include <storage/storage_i.h>
 
+#define TAG "StorageTest"
+
 #define UNIT_TESTS_RESOURCES_PATH(path) EXT_PATH("unit_tests/" path)
 #define UNIT_TESTS_PATH(path)           EXT_PATH(".tmp/unit_tests/" path)
 
@@ -14,6 +18,9 @@
 
 #define STORAGE_TEST_DIR UNIT_TESTS_PATH("test_dir")
 
+void test_sector_cache(void);
+void test_storage_batch(void);
+
 static bool storage_file_create(Storage* storage, const char* path, const char* data) {
     File* file = storage_file_alloc(storage);
     bool result = false;
@@ -176,6 +183,74 @@ MU_TEST(storage_file_read_write_64k) {
     furi_record_close(RECORD_STORAGE);
 }
 
+#define STORAGE_READ_AHEAD_FILE      UNIT_TESTS_PATH("storage_read_ahead.test")
+#define STORAGE_READ_AHEAD_FILE_SIZE (64 * 1024 + 77)
+#define STORAGE_READ_AHEAD_WINDOW    4096
+
+static void storage_file_read_ahead_test(
+    Storage* storage,
+    const uint8_t* data,
+    size_t chunk,
+    uint32_t* card_reads) {
+    File* file = storage_file_alloc(storage);
+    uint8_t* buffer = malloc(chunk);
+    FuriHalSdCacheStats stats_before, stats_after;
+    size_t total = 0;
+    bool equal = true;
+
+    mu_check(storage_file_open(file, STORAGE_READ_AHEAD_FILE, FSAM_READ, FSOM_OPEN_EXISTING));
+    furi_hal_sd_cache_get_stats(&stats_before);
+    size_t read_size;
+    do {
+        read_size = storage_file_read(file, buffer, chunk);
+        equal &= !memcmp(buffer, &data[total], read_size);
+        total += read_size;
+        mu_assert_int_eq(total, storage_file_tell(file));
+    } while(read_size == chunk);
+    furi_hal_sd_cache_get_stats(&stats_after);
+    storage_file_close(file);
+
+    free(buffer);
+    storage_file_free(file);
+
+    mu_assert_int_eq(STORAGE_READ_AHEAD_FILE_SIZE, total);
+    mu_assert(equal, "Read-ahead data mismatch");
+    *card_reads = stats_after.reads - stats_before.reads;
+}
+
+MU_TEST(storage_file_read_ahead) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    uint8_t* data = malloc(STORAGE_READ_AHEAD_FILE_SIZE);
+    for(size_t i = 0; i < STORAGE_READ_AHEAD_FILE_SIZE; i++) {
+        data[i] = (i % 113);
+    }
+
+    File* file = storage_file_alloc(storage);
+    mu_check(storage_file_open(file, STORAGE_READ_AHEAD_FILE, FSAM_WRITE, FSOM_CREATE_ALWAYS));
+    mu_assert_int_eq(
+        STORAGE_READ_AHEAD_FILE_SIZE,
+        storage_file_write(file, data, STORAGE_READ_AHEAD_FILE_SIZE));
+    storage_file_close(file);
+    storage_file_free(file);
+
+    // Window grows to its largest size and stays there, so each card read fetches a whole
+    // window. Chunks that straddle refills must not restart it, BufferedFileStream chunks
+    // must not be too large for it.
+    const size_t chunks[] = {300, 512, BUFFERED_FILE_STREAM_CACHE_SIZE};
+    for(size_t i = 0; i < COUNT_OF(chunks); i++) {
+        uint32_t reads = UINT32_MAX;
+        storage_file_read_ahead_test(storage, data, chunks[i], &reads);
+        FURI_LOG_I(TAG, "Read-ahead %zu byte chunks: %lu card reads", chunks[i], reads);
+        mu_assert(
+            reads <= STORAGE_READ_AHEAD_FILE_SIZE / STORAGE_READ_AHEAD_WINDOW + 8,
+            "Read-ahead window doesn't grow");
+    }
+
+    free(data);
+    storage_simply_remove(storage, STORAGE_READ_AHEAD_FILE);
+    furi_record_close(RECORD_STORAGE);
+}
+
 MU_TEST_SUITE(storage_file) {
     storage_file_open_lock_setup();
     MU_RUN_TEST(storage_file_open_close);
@@ -185,6 +260,7 @@ MU_TEST_SUITE(storage_file) {
 
 MU_TEST_SUITE(storage_file_64k) {
     MU_RUN_TEST(storage_file_read_write_64k);
+    MU_RUN_TEST(storage_file_read_ahead);
 }
 
 MU_TEST(storage_dir_open_close) {
@@ -751,6 +827,22 @@ MU_TEST_SUITE(test_md5_calc_suite) {
     MU_RUN_TEST(test_md5_calc);
 }
 
+MU_TEST(mu_test_sector_cache) {
+    test_sector_cache();
+}
+
+MU_TEST_SUITE(test_sector_cache_suite) {
+    MU_RUN_TEST(mu_test_sector_cache);
+}
+
+MU_TEST(mu_test_storage_batch) {
+    test_storage_batch();
+}
+
+MU_TEST_SUITE(test_storage_batch_suite) {
+    MU_RUN_TEST(mu_test_storage_batch);
+}
+
 int run_minunit_test_storage(void) {
     MU_RUN_SUITE(storage_file);
     MU_RUN_SUITE(storage_file_64k);
@@ -759,6 +851,8 @@ int run_minunit_test_storage(void) {
     MU_RUN_SUITE(test_data_path);
     MU_RUN_SUITE(test_storage_common);
     MU_RUN_SUITE(test_md5_calc_suite);
+    MU_RUN_SUITE(test_sector_cache_suite);
+    MU_RUN_SUITE(test_storage_batch_suite);
     return MU_EXIT_CODE;
 }
 
@@ -517,12 +517,128 @@ MU_TEST(stream_buffered_large_file_test) {
     furi_string_free(output_data);
 }
 
+static uint8_t stream_cache_test_byte(size_t position) {
+    return (position * 13 + (position >> 9)) & 0xFF;
+}
+
+MU_TEST_1(stream_buffered_cache_subtest, size_t cache_size) {
+    const size_t data_size = 8192;
+    const size_t piece_size = 128;
+    const int32_t give_back = 80;
+    uint8_t data[piece_size];
+
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    Stream* stream = buffered_file_stream_alloc(storage);
+    mu_check(buffered_file_stream_open_ex(
+        stream, FILESTREAM_PATH, FSAM_READ_WRITE, FSOM_CREATE_ALWAYS, cache_size));
+    for(size_t i = 0; i < data_size; i++) {
+        mu_assert_int_eq(1, stream_write_char(stream, stream_cache_test_byte(i)));
+    }
+    mu_check(buffered_file_stream_close(stream));
+
+    mu_check(buffered_file_stream_open_ex(
+        stream, FILESTREAM_PATH, FSAM_READ, FSOM_OPEN_EXISTING, cache_size));
+
+    // Read ahead and give back the unused part, then go back to a remembered position
+    size_t position = 0;
+    size_t pieces = 0;
+    while(position + piece_size <= data_size) {
+        mu_assert_int_eq(position, stream_tell(stream));
+        mu_assert_int_eq(piece_size, stream_read(stream, data, piece_size));
+        for(size_t i = 0; i < piece_size; i++) {
+            mu_assert_int_eq(stream_cache_test_byte(position + i), data[i]);
+        }
+        mu_check(stream_seek(stream, -give_back, StreamOffsetFromCurrent));
+
+        if(++pieces % 4 == 0) {
+            mu_check(stream_seek(stream, position, StreamOffsetFromStart));
+            mu_assert_int_eq(1, stream_read(stream, data, 1));
+            mu_assert_int_eq(stream_cache_test_byte(position), data[0]);
+            mu_check(stream_seek(stream, piece_size - give_back - 1, StreamOffsetFromCurrent));
+        }
+
+        position += piece_size - give_back;
+    }
+
+    BufferedFileStreamStats stats;
+    buffered_file_stream_get_stats(stream, &stats);
+    FURI_LOG_I(
+        "StreamTest",
+        "Cache %zu: %lu fills, %lu bytes, %lu seek hits, %lu seek misses",
+        cache_size,
+        stats.cache_fills,
+        stats.fill_bytes,
+        stats.seek_hits,
+        stats.seek_misses);
+
+    // Every byte is read from the file once, all seeks are served from the cache
+    mu_check(stats.fill_bytes <= data_size);
+    mu_assert_int_eq(0, stats.seek_misses);
+
+    stream_free(stream);
+    furi_record_close(RECORD_STORAGE);
+}
+
+MU_TEST(stream_buffered_cache_test) {
+    MU_RUN_TEST_1(stream_buffered_cache_subtest, BUFFERED_FILE_STREAM_CACHE_SIZE);
+    MU_RUN_TEST_1(stream_buffered_cache_subtest, 4096);
+}
+
+static bool stream_cache_test_insert_callback(Stream* stream, const void* context) {
+    const char* data = context;
+    return stream_write_cstring(stream, data) == strlen(data);
+}
+
+MU_TEST(stream_buffered_delete_and_insert_test) {
+    const size_t data_size = 8192;
+    const size_t position = 5000;
+    const size_t delete_size = 100;
+    const char* insert_data = "Hello there";
+    const size_t insert_size = strlen(insert_data);
+    uint8_t data[16];
+
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    Stream* stream = buffered_file_stream_alloc(storage);
+    mu_check(
+        buffered_file_stream_open(stream, FILESTREAM_PATH, FSAM_READ_WRITE, FSOM_CREATE_ALWAYS));
+    for(size_t i = 0; i < data_size; i++) {
+        mu_assert_int_eq(1, stream_write_char(stream, stream_cache_test_byte(i)));
+    }
+
+    // Fill the cache at the start of the file, then seek far past it
+    mu_check(stream_rewind(stream));
+    mu_assert_int_eq(1, stream_read(stream, data, 1));
+    mu_check(stream_seek(stream, position, StreamOffsetFromStart));
+
+    mu_check(stream_delete_and_insert(
+        stream, delete_size, stream_cache_test_insert_callback, insert_data));
+    mu_assert_int_eq(position + insert_size, stream_tell(stream));
+    mu_assert_int_eq(data_size - delete_size + insert_size, stream_size(stream));
+
+    // Data after the inserted part
+    mu_assert_int_eq(sizeof(data), stream_read(stream, data, sizeof(data)));
+    for(size_t i = 0; i < sizeof(data); i++) {
+        mu_assert_int_eq(stream_cache_test_byte(position + delete_size + i), data[i]);
+    }
+
+    // Inserted part and data before it
+    mu_check(stream_seek(stream, position - 1, StreamOffsetFromStart));
+    mu_assert_int_eq(insert_size + 1, stream_read(stream, data, insert_size + 1));
+    mu_assert_int_eq(stream_cache_test_byte(position - 1), data[0]);
+    mu_check(memcmp(data + 1, insert_data, insert_size) == 0);
+
+    stream_free(stream);
+    furi_record_close(RECORD_STORAGE);
+}
+
 MU_TEST_SUITE(stream_suite) {
     MU_RUN_TEST(stream_write_read_save_load_test);
     MU_RUN_TEST(stream_composite_test);
     MU_RUN_TEST(stream_split_test);
     MU_RUN_TEST(stream_buffered_write_after_read_test);
     MU_RUN_TEST(stream_buffered_large_file_test);
+    MU_RUN_TEST(stream_buffered_cache_test);
+    MU_RUN_TEST(stream_buffered_delete_and_insert_test);
 }
 
 int run_minunit_test_stream(void) {
@@ -0,0 +1,107 @@
+#include "../test.h" // IWYU pragma: keep
+#include <furi.h>
+#include <lib/subghz/environment.h>
+#include <lib/subghz/protocols/princeton.h>
+
+// Sub-GHz history is a part of the application, not of the firmware API
+#include "../../../../main/subghz/subghz_history.c"
+
+#define SUBGHZ_HISTORY_TEST_KEY_A   0x95D5D4
+#define SUBGHZ_HISTORY_TEST_KEY_B   0x95D5D1
+#define SUBGHZ_HISTORY_TEST_REPEATS 3
+#define SUBGHZ_HISTORY_TEST_TE      400
+
+static void subghz_history_test_set_key(
+    SubGhzProtocolDecoderBase* decoder,
+    uint64_t key,
+    uint32_t te) {
+    FlipperFormat* flipper_format = flipper_format_string_alloc();
+    uint32_t bit = 24;
+    uint8_t key_data[sizeof(uint64_t)] = {0};
+    for(size_t i = 0; i < sizeof(uint64_t); i++) {
+        key_data[sizeof(uint64_t) - i - 1] = (key >> (i * 8)) & 0xFF;
+    }
+    flipper_format_write_uint32(flipper_format, "Bit", &bit, 1);
+    flipper_format_write_hex(flipper_format, "Key", key_data, sizeof(uint64_t));
+    flipper_format_write_uint32(flipper_format, "TE", &te, 1);
+
+    flipper_format_rewind(flipper_format);
+    mu_assert(
+        subghz_protocol_decoder_base_deserialize(decoder, flipper_format) ==
+            SubGhzProtocolStatusOk,
+        "Princeton deserialize failed");
+    flipper_format_free(flipper_format);
+}
+
+void subghz_history_repeat_test_run(SubGhzEnvironment* environment) {
+    SubGhzHistory* history = subghz_history_alloc();
+    SubGhzProtocolDecoderBase* decoder = subghz_protocol_princeton.decoder->alloc(environment);
+    SubGhzRadioPreset preset = {.name = furi_string_alloc_set("AM650"), .frequency = 433920000};
+    FuriString* text = furi_string_alloc();
+    uint16_t idx = UINT16_MAX;
+
+    subghz_history_test_set_key(decoder, SUBGHZ_HISTORY_TEST_KEY_A, SUBGHZ_HISTORY_TEST_TE);
+    mu_assert_int_eq(
+        SubGhzHistoryAddResultNew,
+        subghz_history_add_to_history(history, decoder, &preset, &idx));
+    mu_assert_int_eq(0, idx);
+    subghz_history_get_text_item_menu(history, text, idx);
+    mu_assert_string_eq("Princeton 95D5D4", furi_string_get_cstr(text));
+
+    // Next packet of the same burst, measured TE jitters, is not counted as a repeat
+    subghz_history_test_set_key(decoder, SUBGHZ_HISTORY_TEST_KEY_A, SUBGHZ_HISTORY_TEST_TE + 10);
+    idx = UINT16_MAX;
+    mu_assert_int_eq(
+        SubGhzHistoryAddResultBurst,
+        subghz_history_add_to_history(history, decoder, &preset, &idx));
+    mu_assert_int_eq(0, idx);
+    mu_assert_int_eq(1, subghz_history_get_repeat(history, 0));
+
+    // Another press of the same key with a different TE only bumps the repeat count
+    for(size_t i = 1; i < SUBGHZ_HISTORY_TEST_REPEATS; i++) {
+        furi_delay_ms(SUBGHZ_HISTORY_BURST_MS + 100);
+        subghz_history_test_set_key(
+            decoder, SUBGHZ_HISTORY_TEST_KEY_A, SUBGHZ_HISTORY_TEST_TE - 10 * i);
+        idx = UINT16_MAX;
+        mu_assert_int_eq(
+            SubGhzHistoryAddResultRepeat,
+            subghz_history_add_to_history(history, decoder, &preset, &idx));
+        mu_assert_int_eq(0, idx);
+    }
+    mu_assert_int_eq(1, subghz_history_get_item(history));
+    mu_assert_int_eq(SUBGHZ_HISTORY_TEST_REPEATS, subghz_history_get_repeat(history, 0));
+    subghz_history_get_text_item_menu(history, text, 0);
+    mu_assert_string_eq("Princeton 95D5D4 x3", furi_string_get_cstr(text));
+
+    // Another key right after is a new record even within the burst window
+    subghz_history_test_set_key(decoder, SUBGHZ_HISTORY_TEST_KEY_B, SUBGHZ_HISTORY_TEST_TE);
+    mu_assert_int_eq(
+        SubGhzHistoryAddResultNew,
+        subghz_history_add_to_history(history, decoder, &preset, &idx));
+    mu_assert_int_eq(1, idx);
+    mu_assert_int_eq(1, subghz_history_get_repeat(history, 1));
+    subghz_history_get_text_item_menu(history, text, 1);
+    mu_assert_string_eq("Princeton 95D5D1", furi_string_get_cstr(text));
+    mu_assert_string_eq("Princeton", subghz_history_get_protocol_name(history, 0));
+
+    // Same key on another frequency is a separate record
+    subghz_history_test_set_key(decoder, SUBGHZ_HISTORY_TEST_KEY_A, SUBGHZ_HISTORY_TEST_TE);
+    preset.frequency = 315000000;
+    mu_assert_int_eq(
+        SubGhzHistoryAddResultNew,
+        subghz_history_add_to_history(history, decoder, &preset, &idx));
+    mu_assert_int_eq(2, idx);
+    mu_assert_int_eq(3, subghz_history_get_item(history));
+
+    subghz_history_reset(history);
+    mu_assert_int_eq(0, subghz_history_get_item(history));
+    mu_assert_int_eq(
+        SubGhzHistoryAddResultNew,
+        subghz_history_add_to_history(history, decoder, &preset, &idx));
+    mu_assert_int_eq(0, idx);
+
+    furi_string_free(text);
+    furi_string_free(preset.name);
+    subghz_protocol_princeton.decoder->free(decoder);
+    subghz_history_free(history);
+}
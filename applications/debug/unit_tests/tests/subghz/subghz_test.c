@@ -4,8 +4,12 @@
 #include <lib/subghz/receiver.h>
 #include <lib/subghz/transmitter.h>
 #include <lib/subghz/subghz_keystore.h>
+#include <lib/subghz/protocols/keeloq_common.h>
 #include <lib/subghz/subghz_file_encoder_worker.h>
+#include <lib/subghz/subghz_raw_binary.h>
+#include <lib/subghz/subghz_file_decoder.h>
 #include <lib/subghz/protocols/protocol_items.h>
+#include <storage/storage.h>
 #include <flipper_format/flipper_format_i.h>
 #include <lib/subghz/devices/devices.h>
 #include <lib/subghz/devices/cc1101_configs.h>
@@ -16,9 +20,22 @@
 #define CAME_ATOMO_DIR_NAME     EXT_PATH("subghz/assets/came_atomo")
 #define NICE_FLOR_S_DIR_NAME    EXT_PATH("subghz/assets/nice_flor_s")
 #define ALUTECH_AT_4N_DIR_NAME  EXT_PATH("subghz/assets/alutech_at_4n")
+#define KEYSTORE_BINARY_NAME    EXT_PATH(".tmp/unit_tests/keeloq_mfcodes.bin")
 #define TEST_RANDOM_DIR_NAME    EXT_PATH("unit_tests/subghz/test_random_raw.sub")
+#define TEST_RANDOM_BINARY_NAME EXT_PATH(".tmp/unit_tests/test_random_raw_binary.sub")
+#define TEST_RANDOM_TEXT_NAME   EXT_PATH(".tmp/unit_tests/test_random_raw_text.sub")
+#define TEST_RECORD_NAME        "unit_tests_raw_record"
+#define TEST_RECORD_PATH        EXT_PATH("subghz/" TEST_RECORD_NAME ".sub")
+#define TEST_RECORD_TEXT_NAME   EXT_PATH(".tmp/unit_tests/raw_record_text.sub")
+#define TEST_RECORD_REPEAT      16
 #define TEST_RANDOM_COUNT_PARSE 329
 #define TEST_TIMEOUT            10000
+#define TEST_BENCH_PULSE_COUNT  4096
+#define TEST_BENCH_REPEAT       8
+#define TEST_BATCH_PULSE_COUNT  8192
+#define TEST_KEELOQ_BENCH_KEYS  10000
+
+void subghz_history_repeat_test_run(SubGhzEnvironment* environment);
 
 static SubGhzEnvironment* environment_handler;
 static SubGhzReceiver* receiver_handler;
@@ -149,6 +166,51 @@ static bool subghz_decode_random_test(const char* path) {
     }
 }
 
+static size_t subghz_bench_load(const char* path, LevelDuration* pulses, size_t pulses_max) {
+    size_t pulses_count = 0;
+    uint32_t test_start = furi_get_tick();
+
+    file_worker_encoder_handler = subghz_file_encoder_worker_alloc();
+    if(subghz_file_encoder_worker_start(file_worker_encoder_handler, path, NULL)) {
+        // the worker needs a file in order to open and read part of the file
+        furi_delay_ms(100);
+
+        while((pulses_count < pulses_max) && (furi_get_tick() - test_start < TEST_TIMEOUT)) {
+            LevelDuration level_duration =
+                subghz_file_encoder_worker_get_level_duration(file_worker_encoder_handler);
+            if(level_duration_is_reset(level_duration)) {
+                break;
+            } else if(!level_duration_is_wait(level_duration)) {
+                pulses[pulses_count++] = level_duration;
+            }
+            // Yield, to load data inside the worker
+            furi_thread_yield();
+        }
+        if(subghz_file_encoder_worker_is_running(file_worker_encoder_handler)) {
+            subghz_file_encoder_worker_stop(file_worker_encoder_handler);
+        }
+    }
+    subghz_file_encoder_worker_free(file_worker_encoder_handler);
+
+    return pulses_count;
+}
+
+static uint32_t subghz_bench_decode(const LevelDuration* pulses, size_t pulses_count) {
+    uint32_t bench_start = furi_get_tick();
+
+    for(size_t repeat = 0; repeat < TEST_BENCH_REPEAT; repeat++) {
+        subghz_receiver_reset(receiver_handler);
+        for(size_t i = 0; i < pulses_count; i++) {
+            subghz_receiver_decode(
+                receiver_handler,
+                level_duration_get_level(pulses[i]),
+                level_duration_get_duration(pulses[i]));
+        }
+    }
+
+    return furi_get_tick() - bench_start;
+}
+
 static bool subghz_encoder_test(const char* path) {
     subghz_test_decoder_count = 0;
     uint32_t test_start = furi_get_tick();
@@ -217,6 +279,103 @@ MU_TEST(subghz_keystore_test) {
         "Test keystore error");
 }
 
+static SubGhzKeystore* subghz_keystore_bench_load(const char* path, size_t* heap, uint32_t* time) {
+    size_t heap_before = memmgr_get_free_heap();
+    uint32_t start = furi_get_tick();
+
+    SubGhzKeystore* keystore = subghz_keystore_alloc();
+    bool loaded = subghz_keystore_load(keystore, path);
+
+    *time = furi_get_tick() - start;
+    *heap = heap_before - memmgr_get_free_heap();
+
+    if(!loaded) {
+        subghz_keystore_free(keystore);
+        keystore = NULL;
+    }
+    return keystore;
+}
+
+static bool subghz_keystore_compare(SubGhzKeystore* a, SubGhzKeystore* b) {
+    SubGhzKeyArray_t* keys_a = subghz_keystore_get_data(a);
+    SubGhzKeyArray_t* keys_b = subghz_keystore_get_data(b);
+    if(SubGhzKeyArray_size(*keys_a) != SubGhzKeyArray_size(*keys_b)) return false;
+
+    for(size_t i = 0; i < SubGhzKeyArray_size(*keys_a); i++) {
+        const SubGhzKey* key_a = SubGhzKeyArray_get(*keys_a, i);
+        const SubGhzKey* key_b = SubGhzKeyArray_get(*keys_b, i);
+        if(key_a->key != key_b->key || key_a->type != key_b->type ||
+           key_a->flags != key_b->flags || strcmp(key_a->name, key_b->name) != 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+MU_TEST(subghz_keystore_binary_test) {
+    uint8_t iv[16] = {
+        0x2A,
+        0x17,
+        0x91,
+        0x0C,
+        0x5E,
+        0x63,
+        0xB8,
+        0x44,
+        0xD0,
+        0x7F,
+        0x19,
+        0xA2,
+        0x36,
+        0xE5,
+        0x8B,
+        0x01,
+    };
+    size_t heap_text, heap_plain, heap_encrypted;
+    uint32_t time_text, time_plain, time_encrypted;
+
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    storage_simply_mkdir(storage, EXT_PATH(".tmp/unit_tests"));
+
+    SubGhzKeystore* text = subghz_keystore_bench_load(KEYSTORE_DIR_NAME, &heap_text, &time_text);
+    mu_assert(text, "Text keystore load error");
+
+    bool saved = subghz_keystore_save_binary(text, KEYSTORE_BINARY_NAME, NULL);
+    SubGhzKeystore* plain =
+        saved ? subghz_keystore_bench_load(KEYSTORE_BINARY_NAME, &heap_plain, &time_plain) : NULL;
+    bool plain_equal = plain && subghz_keystore_compare(text, plain);
+
+    saved = subghz_keystore_save_binary(text, KEYSTORE_BINARY_NAME, iv);
+    SubGhzKeystore* encrypted = NULL;
+    if(saved) {
+        encrypted =
+            subghz_keystore_bench_load(KEYSTORE_BINARY_NAME, &heap_encrypted, &time_encrypted);
+    }
+    bool encrypted_equal = encrypted && subghz_keystore_compare(text, encrypted);
+
+    if(plain && encrypted) {
+        FURI_LOG_I(
+            TAG,
+            "Keystore %zu keys: text %lums %zuB, binary %lums %zuB, encrypted binary %lums %zuB",
+            SubGhzKeyArray_size(*subghz_keystore_get_data(text)),
+            time_text,
+            heap_text,
+            time_plain,
+            heap_plain,
+            time_encrypted,
+            heap_encrypted);
+    }
+
+    if(encrypted) subghz_keystore_free(encrypted);
+    if(plain) subghz_keystore_free(plain);
+    subghz_keystore_free(text);
+    storage_simply_remove(storage, KEYSTORE_BINARY_NAME);
+    furi_record_close(RECORD_STORAGE);
+
+    mu_assert(plain_equal, "Binary keystore mismatch");
+    mu_assert(encrypted_equal, "Encrypted binary keystore mismatch");
+}
+
 typedef enum {
     SubGhzHalAsyncTxTestTypeNormal,
     SubGhzHalAsyncTxTestTypeInvalidStart,
@@ -839,9 +998,556 @@ MU_TEST(subghz_random_test) {
     mu_assert(subghz_decode_random_test(TEST_RANDOM_DIR_NAME), "Random test error\r\n");
 }
 
+MU_TEST(subghz_receiver_start_pulse_filter_test) {
+    LevelDuration* pulses = malloc(sizeof(LevelDuration) * TEST_BENCH_PULSE_COUNT);
+    size_t pulses_count = subghz_bench_load(TEST_RANDOM_DIR_NAME, pulses, TEST_BENCH_PULSE_COUNT);
+
+    subghz_receiver_set_start_pulse_filter(receiver_handler, false);
+    subghz_test_decoder_count = 0;
+    uint32_t time_unfiltered = subghz_bench_decode(pulses, pulses_count);
+    uint16_t count_unfiltered = subghz_test_decoder_count;
+
+    subghz_receiver_set_start_pulse_filter(receiver_handler, true);
+    subghz_test_decoder_count = 0;
+    uint32_t time_filtered = subghz_bench_decode(pulses, pulses_count);
+    uint16_t count_filtered = subghz_test_decoder_count;
+
+    FURI_LOG_I(
+        TAG,
+        "Receiver %zu pulses x%d: all decoders %lums, start pulse filter %lums",
+        pulses_count,
+        TEST_BENCH_REPEAT,
+        time_unfiltered,
+        time_filtered);
+
+    free(pulses);
+    subghz_receiver_reset(receiver_handler);
+
+    mu_assert(pulses_count > 0, "Failed to load RAW pulses\r\n");
+    mu_assert_int_eq(count_unfiltered, count_filtered);
+}
+
+static void subghz_test_batch_rx_callback(
+    SubGhzReceiver* receiver,
+    SubGhzProtocolDecoderBase* decoder_base,
+    void* context) {
+    FuriString* decoded = context;
+    FuriString* text = furi_string_alloc();
+    subghz_protocol_decoder_base_get_string(decoder_base, text);
+    furi_string_cat(decoded, text);
+    furi_string_free(text);
+    subghz_receiver_reset(receiver);
+}
+
+static size_t subghz_test_batch_decode(
+    const LevelDuration* pulses,
+    size_t pulses_count,
+    size_t block_size,
+    FuriString* decoded) {
+    // Fresh receiver, some decoders keep state that reset doesn't clear
+    SubGhzReceiver* receiver = subghz_receiver_alloc_init(environment_handler);
+    subghz_receiver_set_filter(receiver, SubGhzProtocolFlag_Decodable);
+    subghz_receiver_set_rx_callback(receiver, subghz_test_batch_rx_callback, decoded);
+
+    furi_string_reset(decoded);
+    if(block_size) {
+        for(size_t i = 0; i < pulses_count; i += block_size) {
+            subghz_receiver_decode_batch(
+                receiver, &pulses[i], MIN(block_size, pulses_count - i));
+        }
+    } else {
+        for(size_t i = 0; i < pulses_count; i++) {
+            subghz_receiver_decode(
+                receiver,
+                level_duration_get_level(pulses[i]),
+                level_duration_get_duration(pulses[i]));
+        }
+    }
+
+    subghz_receiver_free(receiver);
+    return furi_string_size(decoded);
+}
+
+MU_TEST(subghz_receiver_decode_batch_test) {
+    const char* paths[] = {
+        TEST_RANDOM_DIR_NAME,
+        EXT_PATH("unit_tests/subghz/came_raw.sub"),
+        EXT_PATH("unit_tests/subghz/princeton_raw.sub"),
+        EXT_PATH("unit_tests/subghz/holtek_ht12x_raw.sub"),
+        EXT_PATH("unit_tests/subghz/linear_raw.sub"),
+        EXT_PATH("unit_tests/subghz/clemsa_raw.sub"),
+        EXT_PATH("unit_tests/subghz/honeywell_wdb_raw.sub"),
+        EXT_PATH("unit_tests/subghz/security_pls_2_0_raw.sub"),
+    };
+    // Partial last block and blocks split in the middle of a packet included
+    const size_t block_sizes[] = {1, 7, 128};
+
+    LevelDuration* pulses = malloc(sizeof(LevelDuration) * TEST_BATCH_PULSE_COUNT);
+    FuriString* expected = furi_string_alloc();
+    FuriString* decoded = furi_string_alloc();
+
+    for(size_t i = 0; i < COUNT_OF(paths); i++) {
+        size_t pulses_count = subghz_bench_load(paths[i], pulses, TEST_BATCH_PULSE_COUNT);
+        mu_assert(pulses_count > 0, "Failed to load RAW pulses\r\n");
+
+        size_t expected_size = subghz_test_batch_decode(pulses, pulses_count, 0, expected);
+        mu_assert(expected_size > 0, "Nothing decoded pulse by pulse\r\n");
+
+        for(size_t j = 0; j < COUNT_OF(block_sizes); j++) {
+            subghz_test_batch_decode(pulses, pulses_count, block_sizes[j], decoded);
+            if(!furi_string_equal(expected, decoded)) {
+                FURI_LOG_E(TAG, "%s: block of %zu differs", paths[i], block_sizes[j]);
+            }
+            mu_assert(
+                furi_string_equal(expected, decoded),
+                "Batch decode differs from pulse by pulse decode\r\n");
+        }
+    }
+
+    furi_string_free(decoded);
+    furi_string_free(expected);
+    free(pulses);
+}
+
+MU_TEST(subghz_keeloq_decrypt_batch_test) {
+    uint64_t keys[KEELOQ_DECRYPT_BATCH_SIZE];
+    uint32_t result[KEELOQ_DECRYPT_BATCH_SIZE];
+    uint32_t expected[KEELOQ_DECRYPT_BATCH_SIZE];
+    const uint32_t hop = 0x5A3C96E1;
+
+    size_t mismatch = 0;
+    uint32_t time_scalar = 0;
+    uint32_t time_batch = 0;
+
+    // Synthetic keystore, partial last batch included
+    for(size_t offset = 0; offset < TEST_KEELOQ_BENCH_KEYS; offset += KEELOQ_DECRYPT_BATCH_SIZE) {
+        size_t count = MIN((size_t)TEST_KEELOQ_BENCH_KEYS - offset, KEELOQ_DECRYPT_BATCH_SIZE);
+        for(size_t i = 0; i < count; i++) {
+            keys[i] = (offset + i + 1) * 0x9E3779B97F4A7C15ULL;
+        }
+
+        uint32_t start = furi_get_tick();
+        for(size_t i = 0; i < count; i++) {
+            expected[i] = subghz_protocol_keeloq_common_decrypt(hop, keys[i]);
+        }
+        time_scalar += furi_get_tick() - start;
+
+        start = furi_get_tick();
+        subghz_protocol_keeloq_common_decrypt_batch(hop, keys, result, count);
+        time_batch += furi_get_tick() - start;
+
+        for(size_t i = 0; i < count; i++) {
+            if(result[i] != expected[i]) mismatch++;
+        }
+    }
+
+    FURI_LOG_I(
+        TAG,
+        "KeeLoq decrypt %d keys: scalar %lums, bitsliced %lums",
+        TEST_KEELOQ_BENCH_KEYS,
+        time_scalar,
+        time_batch);
+
+    mu_assert_int_eq(0, mismatch);
+}
+
+static LevelDuration subghz_raw_binary_test_next(SubGhzFileEncoderWorker* worker) {
+    uint32_t start = furi_get_tick();
+    while(furi_get_tick() - start < TEST_TIMEOUT) {
+        LevelDuration level_duration = subghz_file_encoder_worker_get_level_duration(worker);
+        if(!level_duration_is_wait(level_duration)) return level_duration;
+        // Yield, to load data inside the worker
+        furi_thread_yield();
+    }
+    return level_duration_reset();
+}
+
+/** Play two RAW files side by side and compare every sample
+ *
+ * @param path_a, path_b RAW files, text or binary samples
+ * @return compared sample count, 0 on mismatch or error
+ */
+static size_t subghz_raw_binary_test_compare(const char* path_a, const char* path_b) {
+    SubGhzFileEncoderWorker* worker_a = subghz_file_encoder_worker_alloc();
+    SubGhzFileEncoderWorker* worker_b = subghz_file_encoder_worker_alloc();
+    size_t count = 0;
+
+    if(subghz_file_encoder_worker_start(worker_a, path_a, NULL) &&
+       subghz_file_encoder_worker_start(worker_b, path_b, NULL)) {
+        while(true) {
+            LevelDuration a = subghz_raw_binary_test_next(worker_a);
+            LevelDuration b = subghz_raw_binary_test_next(worker_b);
+            if(level_duration_is_reset(a) || level_duration_is_reset(b)) {
+                // Both must end on the same sample
+                if(!level_duration_is_reset(a) || !level_duration_is_reset(b)) count = 0;
+                break;
+            }
+            if(level_duration_get_level(a) != level_duration_get_level(b) ||
+               level_duration_get_duration(a) != level_duration_get_duration(b)) {
+                count = 0;
+                break;
+            }
+            count++;
+        }
+    }
+
+    if(subghz_file_encoder_worker_is_running(worker_a)) {
+        subghz_file_encoder_worker_stop(worker_a);
+    }
+    if(subghz_file_encoder_worker_is_running(worker_b)) {
+        subghz_file_encoder_worker_stop(worker_b);
+    }
+    subghz_file_encoder_worker_free(worker_b);
+    subghz_file_encoder_worker_free(worker_a);
+
+    return count;
+}
+
+static bool subghz_raw_binary_test_seek(const LevelDuration* pulses, size_t pulses_count) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    FlipperFormat* flipper_format = flipper_format_file_alloc(storage);
+    FuriString* temp_str = furi_string_alloc();
+    bool result = false;
+
+    do {
+        if(!flipper_format_file_open_existing(flipper_format, TEST_RANDOM_BINARY_NAME)) break;
+        if(!flipper_format_read_string(flipper_format, "Protocol", temp_str)) break;
+        Stream* stream = flipper_format_get_raw_stream(flipper_format);
+        stream_seek(stream, 1, StreamOffsetFromCurrent);
+        if(!subghz_raw_binary_read_marker(stream)) break;
+
+        SubGhzRawBinaryReader* reader = subghz_raw_binary_reader_alloc(stream);
+        result = true;
+        // Backwards, so every seek has to rewind
+        for(size_t i = pulses_count; i > 0; i -= MIN(i, (size_t)97)) {
+            size_t index = i - 1;
+            int32_t sample = 0;
+            if(!subghz_raw_binary_reader_seek(reader, index) ||
+               subghz_raw_binary_reader_read(reader, &sample, 1) != 1 ||
+               (sample > 0) != level_duration_get_level(pulses[index]) ||
+               (uint32_t)abs(sample) != level_duration_get_duration(pulses[index])) {
+                result = false;
+                break;
+            }
+        }
+        subghz_raw_binary_reader_free(reader);
+    } while(false);
+
+    furi_string_free(temp_str);
+    flipper_format_free(flipper_format);
+    furi_record_close(RECORD_STORAGE);
+
+    return result;
+}
+
+MU_TEST(subghz_raw_binary_test) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    storage_simply_mkdir(storage, EXT_PATH(".tmp/unit_tests"));
+
+    LevelDuration* pulses = malloc(sizeof(LevelDuration) * TEST_BENCH_PULSE_COUNT);
+
+    uint32_t start = furi_get_tick();
+    bool to_binary = subghz_raw_binary_convert(TEST_RANDOM_DIR_NAME, TEST_RANDOM_BINARY_NAME);
+    uint32_t time_to_binary = furi_get_tick() - start;
+
+    start = furi_get_tick();
+    bool to_text = subghz_raw_binary_convert(TEST_RANDOM_BINARY_NAME, TEST_RANDOM_TEXT_NAME);
+    uint32_t time_to_text = furi_get_tick() - start;
+
+    FileInfo info_text = {0}, info_binary = {0};
+    storage_common_stat(storage, TEST_RANDOM_DIR_NAME, &info_text);
+    storage_common_stat(storage, TEST_RANDOM_BINARY_NAME, &info_binary);
+
+    // Whole files, sample by sample
+    size_t count_binary =
+        subghz_raw_binary_test_compare(TEST_RANDOM_DIR_NAME, TEST_RANDOM_BINARY_NAME);
+    size_t count_text =
+        subghz_raw_binary_test_compare(TEST_RANDOM_DIR_NAME, TEST_RANDOM_TEXT_NAME);
+
+    size_t count = subghz_bench_load(TEST_RANDOM_DIR_NAME, pulses, TEST_BENCH_PULSE_COUNT);
+    bool seek = subghz_raw_binary_test_seek(pulses, count);
+
+    FURI_LOG_I(
+        TAG,
+        "RAW %zu samples, text %lluB, binary %lluB, text to binary %lums, binary to text %lums",
+        count_binary,
+        info_text.size,
+        info_binary.size,
+        time_to_binary,
+        time_to_text);
+
+    free(pulses);
+    storage_simply_remove(storage, TEST_RANDOM_BINARY_NAME);
+    storage_simply_remove(storage, TEST_RANDOM_TEXT_NAME);
+    furi_record_close(RECORD_STORAGE);
+
+    mu_assert(to_binary, "Convert to binary error");
+    mu_assert(to_text, "Convert to text error");
+    mu_assert(count > 0, "Failed to load RAW pulses");
+    mu_assert(count_binary > 0, "Binary RAW samples mismatch");
+    mu_assert(count_text > 0, "Converted back RAW samples mismatch");
+    mu_assert_int_eq(count_binary, count_text);
+    mu_assert(seek, "Binary RAW seek error");
+}
+
+static uint32_t subghz_raw_record_test_run(
+    SubGhzProtocolDecoderRAW* decoder,
+    bool binary,
+    const LevelDuration* pulses,
+    size_t pulses_count) {
+    SubGhzRadioPreset preset = {
+        .name = furi_string_alloc_set("AM650"),
+        .frequency = 433920000,
+        .data = NULL,
+        .data_size = 0,
+    };
+
+    uint32_t time = UINT32_MAX;
+    subghz_protocol_raw_save_to_file_set_binary(decoder, binary);
+    if(subghz_protocol_raw_save_to_file_init(decoder, TEST_RECORD_NAME, &preset)) {
+        // Same path as Read RAW: samples are buffered by the decoder and written in blocks
+        uint32_t start = furi_get_tick();
+        for(size_t repeat = 0; repeat < TEST_RECORD_REPEAT; repeat++) {
+            for(size_t i = 0; i < pulses_count; i++) {
+                subghz_protocol_decoder_raw_feed(
+                    decoder,
+                    level_duration_get_level(pulses[i]),
+                    level_duration_get_duration(pulses[i]));
+            }
+        }
+        subghz_protocol_raw_save_to_file_stop(decoder);
+        time = furi_get_tick() - start;
+    }
+
+    furi_string_free(preset.name);
+    return time;
+}
+
+MU_TEST(subghz_raw_record_test) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    storage_simply_mkdir(storage, EXT_PATH(".tmp/unit_tests"));
+
+    LevelDuration* pulses = malloc(sizeof(LevelDuration) * TEST_BENCH_PULSE_COUNT);
+    size_t pulses_count = subghz_bench_load(TEST_RANDOM_DIR_NAME, pulses, TEST_BENCH_PULSE_COUNT);
+
+    SubGhzProtocolDecoderRAW* decoder = subghz_protocol_decoder_raw_alloc(environment_handler);
+
+    uint32_t time_text = subghz_raw_record_test_run(decoder, false, pulses, pulses_count);
+    size_t samples_text = subghz_protocol_raw_get_sample_write(decoder);
+    FileInfo info_text = {0};
+    storage_common_stat(storage, TEST_RECORD_PATH, &info_text);
+    bool renamed = storage_common_rename(storage, TEST_RECORD_PATH, TEST_RECORD_TEXT_NAME) ==
+                   FSE_OK;
+
+    uint32_t time_binary = subghz_raw_record_test_run(decoder, true, pulses, pulses_count);
+    size_t samples_binary = subghz_protocol_raw_get_sample_write(decoder);
+    FileInfo info_binary = {0};
+    storage_common_stat(storage, TEST_RECORD_PATH, &info_binary);
+
+    // Binary recording must play back exactly as the text one
+    size_t count =
+        renamed ? subghz_raw_binary_test_compare(TEST_RECORD_TEXT_NAME, TEST_RECORD_PATH) : 0;
+
+    FURI_LOG_I(
+        TAG,
+        "RAW record %zu samples: text %lums %lluB, binary %lums %lluB",
+        samples_text,
+        time_text,
+        info_text.size,
+        time_binary,
+        info_binary.size);
+
+    subghz_protocol_decoder_raw_free(decoder);
+    free(pulses);
+    storage_simply_remove(storage, TEST_RECORD_TEXT_NAME);
+    storage_simply_remove(storage, TEST_RECORD_PATH);
+    furi_record_close(RECORD_STORAGE);
+
+    mu_assert(pulses_count > 0, "Failed to load RAW pulses");
+    mu_assert(time_text != UINT32_MAX, "Text RAW record error");
+    mu_assert(time_binary != UINT32_MAX, "Binary RAW record error");
+    mu_assert(samples_text > 0, "Nothing recorded");
+    mu_assert_int_eq(samples_text, samples_binary);
+    mu_assert_int_eq(samples_text, count);
+}
+
+MU_TEST(subghz_file_decoder_test) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    storage_simply_mkdir(storage, EXT_PATH(".tmp/unit_tests"));
+    bool to_binary = subghz_raw_binary_convert(TEST_RANDOM_DIR_NAME, TEST_RANDOM_BINARY_NAME);
+
+    SubGhzFileDecoder* decoder = subghz_file_decoder_alloc();
+
+    subghz_test_decoder_count = 0;
+    uint32_t start = furi_get_tick();
+    bool decoded_text = subghz_file_decoder_run(decoder, receiver_handler, TEST_RANDOM_DIR_NAME);
+    uint32_t time_text = furi_get_tick() - start;
+    size_t samples_text = subghz_file_decoder_get_sample_count(decoder);
+    uint16_t count_text = subghz_test_decoder_count;
+
+    subghz_test_decoder_count = 0;
+    start = furi_get_tick();
+    bool decoded_binary =
+        to_binary && subghz_file_decoder_run(decoder, receiver_handler, TEST_RANDOM_BINARY_NAME);
+    uint32_t time_binary = furi_get_tick() - start;
+    size_t samples_binary = subghz_file_decoder_get_sample_count(decoder);
+    uint16_t count_binary = subghz_test_decoder_count;
+
+    FURI_LOG_I(
+        TAG,
+        "File decoder %zu pulses: text %lums, binary %lums",
+        samples_text,
+        time_text,
+        time_binary);
+
+    subghz_file_decoder_free(decoder);
+    subghz_receiver_reset(receiver_handler);
+    storage_simply_remove(storage, TEST_RANDOM_BINARY_NAME);
+    furi_record_close(RECORD_STORAGE);
+
+    mu_assert(decoded_text, "Text RAW decode error");
+    mu_assert(decoded_binary, "Binary RAW decode error");
+    mu_assert_int_eq(samples_text, samples_binary);
+    mu_assert_int_eq(TEST_RANDOM_COUNT_PARSE, count_text);
+    mu_assert_int_eq(TEST_RANDOM_COUNT_PARSE, count_binary);
+}
+
+MU_TEST(subghz_receiver_stats_test) {
+    SubGhzFileDecoder* decoder = subghz_file_decoder_alloc();
+
+    subghz_receiver_reset_stats(receiver_handler);
+    subghz_receiver_set_stats(receiver_handler, true);
+    subghz_test_decoder_count = 0;
+    bool decoded = subghz_file_decoder_run(decoder, receiver_handler, TEST_RANDOM_DIR_NAME);
+    subghz_receiver_set_stats(receiver_handler, false);
+
+    uint32_t decode_count = 0;
+    uint32_t fed_decoders = 0;
+    SubGhzReceiverStats stats;
+    for(size_t i = 0; i < subghz_receiver_get_stats_count(receiver_handler); i++) {
+        subghz_receiver_get_stats(receiver_handler, i, &stats);
+        decode_count += stats.decode_count;
+        if(stats.feed_count) fed_decoders++;
+        FURI_LOG_I(
+            TAG,
+            "%s: %lu pulses, %llu cycles, %lu decoded",
+            stats.name,
+            stats.feed_count,
+            stats.cycles,
+            stats.decode_count);
+    }
+
+    subghz_receiver_reset_stats(receiver_handler);
+    subghz_receiver_get_stats(receiver_handler, 0, &stats);
+
+    subghz_file_decoder_free(decoder);
+    subghz_receiver_reset(receiver_handler);
+
+    mu_assert(decoded, "RAW decode error");
+    mu_assert(fed_decoders > 0, "No decoder was fed");
+    mu_assert_int_eq(subghz_test_decoder_count, decode_count);
+    mu_assert(!stats.feed_count && !stats.decode_count && !stats.cycles, "Stats are not reset");
+}
+
+typedef struct {
+    const char* path;
+    uint32_t te;
+    uint32_t bit;
+    uint8_t hash;
+} SubGhzBinRawTestCase;
+
+// Results of the previous buffer-everything BinRAW decoder on the same records
+static const SubGhzBinRawTestCase subghz_bin_raw_test_cases[] = {
+    {EXT_PATH("unit_tests/subghz/princeton_raw.sub"), 554, 127, 45},
+    {EXT_PATH("unit_tests/subghz/came_raw.sub"), 337, 105, 47},
+    {EXT_PATH("unit_tests/subghz/nice_flo_raw.sub"), 695, 109, 230},
+    {EXT_PATH("unit_tests/subghz/mastercode_raw.sub"), 1058, 121, 196},
+};
+
+static void subghz_bin_raw_test_callback(SubGhzProtocolDecoderBase* decoder_base, void* context) {
+    UNUSED(decoder_base);
+    uint16_t* count = context;
+    (*count)++;
+}
+
+MU_TEST(subghz_decoder_bin_raw_test) {
+    LevelDuration* pulses = malloc(TEST_BENCH_PULSE_COUNT * sizeof(LevelDuration));
+    SubGhzProtocolDecoderBase* decoder =
+        subghz_protocol_bin_raw.decoder->alloc(environment_handler);
+    FlipperFormat* flipper_format = flipper_format_string_alloc();
+    SubGhzRadioPreset preset = {.name = furi_string_alloc_set("AM650"), .frequency = 433920000};
+
+    uint16_t count = 0;
+    subghz_protocol_decoder_base_set_decoder_callback(
+        decoder, subghz_bin_raw_test_callback, &count);
+
+    size_t passed = 0;
+    for(size_t i = 0; i < COUNT_OF(subghz_bin_raw_test_cases); i++) {
+        const SubGhzBinRawTestCase* test_case = &subghz_bin_raw_test_cases[i];
+        size_t pulses_count = subghz_bench_load(test_case->path, pulses, TEST_BENCH_PULSE_COUNT);
+
+        // RSSI above the noise floor opens the record, dropping back closes and analyzes it
+        count = 0;
+        subghz_protocol_decoder_bin_raw_data_input_rssi(
+            (SubGhzProtocolDecoderBinRAW*)decoder, -100.0f);
+        subghz_protocol_decoder_bin_raw_data_input_rssi(
+            (SubGhzProtocolDecoderBinRAW*)decoder, -50.0f);
+        uint32_t cycles = DWT->CYCCNT;
+        for(size_t j = 0; j < pulses_count; j++) {
+            decoder->protocol->decoder->feed(
+                decoder,
+                level_duration_get_level(pulses[j]),
+                level_duration_get_duration(pulses[j]));
+        }
+        uint32_t feed_cycles = DWT->CYCCNT - cycles;
+        cycles = DWT->CYCCNT;
+        subghz_protocol_decoder_bin_raw_data_input_rssi(
+            (SubGhzProtocolDecoderBinRAW*)decoder, -100.0f);
+        uint32_t analysis_cycles = DWT->CYCCNT - cycles;
+
+        uint32_t te = 0;
+        uint32_t bit = 0;
+        if(count == 1 &&
+           subghz_protocol_decoder_base_serialize(decoder, flipper_format, &preset) ==
+               SubGhzProtocolStatusOk) {
+            flipper_format_rewind(flipper_format);
+            flipper_format_read_uint32(flipper_format, "TE", &te, 1);
+            flipper_format_read_uint32(flipper_format, "Bit", &bit, 1);
+        }
+        uint8_t hash = subghz_protocol_decoder_base_get_hash_data(decoder);
+
+        FURI_LOG_I(
+            TAG,
+            "BinRAW %zu pulses: te %lu, %lu bit, feed %lu cycles, analysis %lu cycles",
+            pulses_count,
+            te,
+            bit,
+            feed_cycles,
+            analysis_cycles);
+
+        if(te == test_case->te && bit == test_case->bit && hash == test_case->hash) {
+            passed++;
+        } else {
+            FURI_LOG_E(TAG, "BinRAW mismatch: %s", test_case->path);
+        }
+    }
+
+    furi_string_free(preset.name);
+    flipper_format_free(flipper_format);
+    subghz_protocol_bin_raw.decoder->free(decoder);
+    free(pulses);
+
+    mu_assert_int_eq(COUNT_OF(subghz_bin_raw_test_cases), passed);
+}
+
+MU_TEST(subghz_history_repeat_test) {
+    subghz_history_repeat_test_run(environment_handler);
+}
+
 MU_TEST_SUITE(subghz) {
     subghz_test_init();
     MU_RUN_TEST(subghz_keystore_test);
+    MU_RUN_TEST(subghz_keystore_binary_test);
 
     MU_RUN_TEST(subghz_hal_async_tx_test);
 
@@ -917,6 +1623,15 @@ MU_TEST_SUITE(subghz) {
     MU_RUN_TEST(subghz_encoder_dickert_test);
 
     MU_RUN_TEST(subghz_random_test);
+    MU_RUN_TEST(subghz_receiver_start_pulse_filter_test);
+    MU_RUN_TEST(subghz_receiver_decode_batch_test);
+    MU_RUN_TEST(subghz_keeloq_decrypt_batch_test);
+    MU_RUN_TEST(subghz_raw_binary_test);
+    MU_RUN_TEST(subghz_raw_record_test);
+    MU_RUN_TEST(subghz_file_decoder_test);
+    MU_RUN_TEST(subghz_receiver_stats_test);
+    MU_RUN_TEST(subghz_decoder_bin_raw_test);
+    MU_RUN_TEST(subghz_history_repeat_test);
     subghz_test_deinit();
 }
 
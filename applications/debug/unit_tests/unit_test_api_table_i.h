@@ -8,6 +8,9 @@
 #include <rpc/rpc_i.h>
 #include <flipper.pb.h>
 #include <core/event_loop.h>
+#include <lib/subghz/protocols/keeloq_common.h>
+#include <lib/subghz/subghz_keystore.h>
+#include <targets/f7/fatfs/sector_cache.h>
 
 static constexpr auto unit_tests_api_table = sort(create_array_t<sym_entry>(
     API_METHOD(resource_manifest_reader_alloc, ResourceManifestReader*, (Storage*)),
@@ -17,6 +20,30 @@ static constexpr auto unit_tests_api_table = sort(create_array_t<sym_entry>(
     API_METHOD(resource_manifest_reader_previous, ResourceManifestEntry*, (ResourceManifestReader*)),
     API_METHOD(slix_process_iso15693_3_error, SlixError, (Iso15693_3Error)),
     API_METHOD(iso15693_3_poller_get_data, const Iso15693_3Data*, (Iso15693_3Poller*)),
+    API_METHOD(subghz_protocol_keeloq_common_decrypt, uint32_t, (const uint32_t, const uint64_t)),
+    API_METHOD(
+        subghz_protocol_keeloq_common_decrypt_batch,
+        void,
+        (const uint32_t, const uint64_t*, uint32_t*, size_t)),
+    API_METHOD(subghz_keystore_alloc, SubGhzKeystore*, (void)),
+    API_METHOD(subghz_keystore_free, void, (SubGhzKeystore*)),
+    API_METHOD(subghz_keystore_load, bool, (SubGhzKeystore*, const char*)),
+    API_METHOD(subghz_keystore_save_binary, bool, (SubGhzKeystore*, const char*, uint8_t*)),
+    API_METHOD(subghz_keystore_get_data, SubGhzKeyArray_t*, (SubGhzKeystore*)),
+    API_METHOD(sector_cache_alloc, SectorCache*, (size_t, uint8_t*)),
+    API_METHOD(sector_cache_free, void, (SectorCache*)),
+    API_METHOD(
+        sector_cache_set_write_callback,
+        void,
+        (SectorCache*, SectorCacheWriteCallback, void*)),
+    API_METHOD(sector_cache_get, uint8_t*, (SectorCache*, uint32_t)),
+    API_METHOD(sector_cache_put, void, (SectorCache*, uint32_t, const uint8_t*)),
+    API_METHOD(sector_cache_write, bool, (SectorCache*, uint32_t, const uint8_t*)),
+    API_METHOD(sector_cache_apply_dirty, void, (SectorCache*, uint32_t, uint32_t, uint8_t*)),
+    API_METHOD(sector_cache_invalidate_range, void, (SectorCache*, uint32_t, uint32_t)),
+    API_METHOD(sector_cache_flush, bool, (SectorCache*)),
+    API_METHOD(sector_cache_pin_range, bool, (SectorCache*, uint32_t, uint32_t)),
+    API_METHOD(sector_cache_get_stats, void, (SectorCache*, SectorCacheStats*)),
     API_METHOD(rpc_system_storage_get_error, PB_CommandStatus, (FS_Error)),
     API_METHOD(xQueueSemaphoreTake, BaseType_t, (QueueHandle_t, TickType_t)),
     API_METHOD(
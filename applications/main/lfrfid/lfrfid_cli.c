@@ -322,11 +322,8 @@ static void lfrfid_cli_raw_analyze(Cli* cli, FuriString* args) {
                 }
 
                 if(total_protocol == PROTOCOL_NO) {
-                    total_protocol = protocol_dict_decoders_feed(dict, true, pulse);
-                    if(total_protocol == PROTOCOL_NO) {
-                        total_protocol =
-                            protocol_dict_decoders_feed(dict, false, duration - pulse);
-                    }
+                    total_protocol = protocol_dict_decoders_feed_pair_by_feature(
+                        dict, PROTOCOL_ALL_FEATURES, pulse, duration);
 
                     if(total_protocol != PROTOCOL_NO) {
                         printf(" <FOUND %s>", protocol_dict_get_name(dict, total_protocol));
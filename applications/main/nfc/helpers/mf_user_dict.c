@@ -23,11 +23,10 @@ MfUserDict* mf_user_dict_alloc(size_t max_keys_to_load) {
 
     if(instance->keys_num > 0) {
         instance->keys_arr = malloc(instance->keys_num * sizeof(MfClassicKey));
-        for(size_t i = 0; i < instance->keys_num; i++) {
-            bool key_loaded =
-                keys_dict_get_next_key(dict, instance->keys_arr[i].data, sizeof(MfClassicKey));
-            furi_assert(key_loaded);
-        }
+        size_t keys_loaded = keys_dict_get_next_keys(
+            dict, instance->keys_arr[0].data, sizeof(MfClassicKey), instance->keys_num);
+        furi_assert(keys_loaded == instance->keys_num);
+        UNUSED(keys_loaded);
     }
     keys_dict_free(dict);
 
@@ -41,12 +41,15 @@ NfcCommand nfc_dict_attack_worker_callback(NfcGenericEvent event, void* context)
             instance->view_dispatcher, NfcCustomEventDictAttackDataUpdate);
     } else if(mfc_event->type == MfClassicPollerEventTypeRequestKey) {
         MfClassicKey key = {};
-        if(keys_dict_get_next_key(
-               instance->nfc_dict_context.dict, key.data, sizeof(MfClassicKey))) {
+        if(keys_dict_prefetch_get_next_key(
+               instance->nfc_dict_context.prefetch, key.data, sizeof(MfClassicKey))) {
             mfc_event->data->key_request_data.key = key;
             mfc_event->data->key_request_data.key_provided = true;
-            instance->nfc_dict_context.dict_keys_current++;
-            if(instance->nfc_dict_context.dict_keys_current % 10 == 0) {
+            // Position counts skipped keys too, so it may advance by more than one
+            size_t keys_previous = instance->nfc_dict_context.dict_keys_current;
+            instance->nfc_dict_context.dict_keys_current =
+                keys_dict_prefetch_get_position(instance->nfc_dict_context.prefetch);
+            if(instance->nfc_dict_context.dict_keys_current / 10 != keys_previous / 10) {
                 view_dispatcher_send_custom_event(
                     instance->view_dispatcher, NfcCustomEventDictAttackDataUpdate);
             }
@@ -61,7 +64,7 @@ NfcCommand nfc_dict_attack_worker_callback(NfcGenericEvent event, void* context)
         view_dispatcher_send_custom_event(
             instance->view_dispatcher, NfcCustomEventDictAttackDataUpdate);
     } else if(mfc_event->type == MfClassicPollerEventTypeNextSector) {
-        keys_dict_rewind(instance->nfc_dict_context.dict);
+        keys_dict_prefetch_rewind(instance->nfc_dict_context.prefetch);
         instance->nfc_dict_context.dict_keys_current = 0;
         instance->nfc_dict_context.current_sector =
             mfc_event->data->next_sector_data.current_sector;
@@ -80,7 +83,7 @@ NfcCommand nfc_dict_attack_worker_callback(NfcGenericEvent event, void* context)
         view_dispatcher_send_custom_event(
             instance->view_dispatcher, NfcCustomEventDictAttackDataUpdate);
     } else if(mfc_event->type == MfClassicPollerEventTypeKeyAttackStop) {
-        keys_dict_rewind(instance->nfc_dict_context.dict);
+        keys_dict_prefetch_rewind(instance->nfc_dict_context.prefetch);
         instance->nfc_dict_context.is_key_attack = false;
         instance->nfc_dict_context.dict_keys_current = 0;
         view_dispatcher_send_custom_event(
@@ -120,7 +123,15 @@ static void nfc_scene_mf_classic_dict_attack_update_view(NfcApp* instance) {
     }
 }
 
-static void nfc_scene_mf_classic_dict_attack_prepare_view(NfcApp* instance) {
+static void nfc_scene_mf_classic_dict_attack_free_dict(NfcApp* instance) {
+    keys_dict_prefetch_free(instance->nfc_dict_context.prefetch);
+    instance->nfc_dict_context.prefetch = NULL;
+    keys_dict_free(instance->nfc_dict_context.dict);
+    instance->nfc_dict_context.dict = NULL;
+}
+
+static void
+    nfc_scene_mf_classic_dict_attack_prepare_view(NfcApp* instance, bool skip_user_dict_keys) {
     uint32_t state =
         scene_manager_get_scene_state(instance->scene_manager, NfcSceneMfClassicDictAttack);
     if(state == DictAttackStateUserDictInProgress) {
@@ -141,10 +152,25 @@ static void nfc_scene_mf_classic_dict_attack_prepare_view(NfcApp* instance) {
             dict_attack_set_header(instance->dict_attack, "MF Classic User Dictionary");
         } while(false);
     }
+    KeysDict* skip_dict = NULL;
     if(state == DictAttackStateSystemDictInProgress) {
         instance->nfc_dict_context.dict = keys_dict_alloc(
             NFC_APP_MF_CLASSIC_DICT_SYSTEM_PATH, KeysDictModeOpenExisting, sizeof(MfClassicKey));
         dict_attack_set_header(instance->dict_attack, "MF Classic System Dictionary");
+
+        // Keys of a completed user dict attack were already tried on every sector
+        if(skip_user_dict_keys) {
+            skip_dict = keys_dict_alloc(
+                NFC_APP_MF_CLASSIC_DICT_USER_PATH,
+                KeysDictModeOpenExisting,
+                sizeof(MfClassicKey));
+        }
+    }
+
+    instance->nfc_dict_context.prefetch = keys_dict_prefetch_alloc(
+        instance->nfc_dict_context.dict, skip_dict, sizeof(MfClassicKey));
+    if(skip_dict) {
+        keys_dict_free(skip_dict);
     }
 
     instance->nfc_dict_context.dict_keys_total =
@@ -165,7 +191,7 @@ void nfc_scene_mf_classic_dict_attack_on_enter(void* context) {
 
     scene_manager_set_scene_state(
         instance->scene_manager, NfcSceneMfClassicDictAttack, DictAttackStateUserDictInProgress);
-    nfc_scene_mf_classic_dict_attack_prepare_view(instance);
+    nfc_scene_mf_classic_dict_attack_prepare_view(instance, false);
     dict_attack_set_card_state(instance->dict_attack, true);
     view_dispatcher_switch_to_view(instance->view_dispatcher, NfcViewDictAttack);
     nfc_blink_read_start(instance);
@@ -196,12 +222,12 @@ bool nfc_scene_mf_classic_dict_attack_on_event(void* context, SceneManagerEvent
             if(state == DictAttackStateUserDictInProgress) {
                 nfc_poller_stop(instance->poller);
                 nfc_poller_free(instance->poller);
-                keys_dict_free(instance->nfc_dict_context.dict);
+                nfc_scene_mf_classic_dict_attack_free_dict(instance);
                 scene_manager_set_scene_state(
                     instance->scene_manager,
                     NfcSceneMfClassicDictAttack,
                     DictAttackStateSystemDictInProgress);
-                nfc_scene_mf_classic_dict_attack_prepare_view(instance);
+                nfc_scene_mf_classic_dict_attack_prepare_view(instance, true);
                 instance->poller = nfc_poller_alloc(instance->nfc, NfcProtocolMfClassic);
                 nfc_poller_start(instance->poller, nfc_dict_attack_worker_callback, instance);
                 consumed = true;
@@ -226,12 +252,12 @@ bool nfc_scene_mf_classic_dict_attack_on_event(void* context, SceneManagerEvent
                 if(instance->nfc_dict_context.is_card_present) {
                     nfc_poller_stop(instance->poller);
                     nfc_poller_free(instance->poller);
-                    keys_dict_free(instance->nfc_dict_context.dict);
+                    nfc_scene_mf_classic_dict_attack_free_dict(instance);
                     scene_manager_set_scene_state(
                         instance->scene_manager,
                         NfcSceneMfClassicDictAttack,
                         DictAttackStateSystemDictInProgress);
-                    nfc_scene_mf_classic_dict_attack_prepare_view(instance);
+                    nfc_scene_mf_classic_dict_attack_prepare_view(instance, false);
                     instance->poller = nfc_poller_alloc(instance->nfc, NfcProtocolMfClassic);
                     nfc_poller_start(instance->poller, nfc_dict_attack_worker_callback, instance);
                 } else {
@@ -264,7 +290,7 @@ void nfc_scene_mf_classic_dict_attack_on_exit(void* context) {
     scene_manager_set_scene_state(
         instance->scene_manager, NfcSceneMfClassicDictAttack, DictAttackStateUserDictInProgress);
 
-    keys_dict_free(instance->nfc_dict_context.dict);
+    nfc_scene_mf_classic_dict_attack_free_dict(instance);
 
     instance->nfc_dict_context.current_sector = 0;
     instance->nfc_dict_context.sectors_total = 0;
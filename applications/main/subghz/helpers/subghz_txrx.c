@@ -1,6 +1,7 @@
 #include "subghz_txrx_i.h" // IWYU pragma: keep
 
 #include <lib/subghz/protocols/protocol_items.h>
+#include <lib/subghz/blocks/generic.h>
 #include <applications/drivers/subghz/cc1101_ext/cc1101_ext_interconnect.h>
 #include <lib/subghz/devices/cc1101_int/cc1101_int_interconnect.h>
 
@@ -61,8 +62,8 @@ SubGhzTxRx* subghz_txrx_alloc(void) {
 
     subghz_worker_set_overrun_callback(
         instance->worker, (SubGhzWorkerOverrunCallback)subghz_receiver_reset);
-    subghz_worker_set_pair_callback(
-        instance->worker, (SubGhzWorkerPairCallback)subghz_receiver_decode);
+    subghz_worker_set_pair_batch_callback(
+        instance->worker, (SubGhzWorkerPairBatchCallback)subghz_receiver_decode_batch);
     subghz_worker_set_context(instance->worker, instance->receiver);
 
     //set default device External
@@ -116,18 +117,9 @@ void subghz_txrx_set_preset(
 
 const char* subghz_txrx_get_preset_name(SubGhzTxRx* instance, const char* preset) {
     UNUSED(instance);
-    const char* preset_name = "";
-    if(!strcmp(preset, "FuriHalSubGhzPresetOok270Async")) {
-        preset_name = "AM270";
-    } else if(!strcmp(preset, "FuriHalSubGhzPresetOok650Async")) {
-        preset_name = "AM650";
-    } else if(!strcmp(preset, "FuriHalSubGhzPreset2FSKDev238Async")) {
-        preset_name = "FM238";
-    } else if(!strcmp(preset, "FuriHalSubGhzPreset2FSKDev476Async")) {
-        preset_name = "FM476";
-    } else if(!strcmp(preset, "FuriHalSubGhzPresetCustom")) {
-        preset_name = "CUSTOM";
-    } else {
+    const char* preset_name = subghz_block_generic_get_preset_short_name(preset);
+    if(!preset_name) {
+        preset_name = "";
         FURI_LOG_E(TAG, "Unknown preset");
     }
     return preset_name;
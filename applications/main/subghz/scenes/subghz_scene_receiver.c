@@ -78,18 +78,25 @@ static void subghz_scene_add_to_history_callback(
 
     SubGhzRadioPreset preset = subghz_txrx_get_preset(subghz->txrx);
 
-    if(subghz_history_add_to_history(history, decoder_base, &preset)) {
+    uint16_t idx;
+    SubGhzHistoryAddResult result =
+        subghz_history_add_to_history(history, decoder_base, &preset, &idx);
+    if(result == SubGhzHistoryAddResultNew) {
         furi_string_reset(str_buff);
 
         subghz->state_notifications = SubGhzNotificationStateRxDone;
-        uint16_t item_history = subghz_history_get_item(history);
-        subghz_history_get_text_item_menu(history, str_buff, item_history - 1);
+        subghz_history_get_text_item_menu(history, str_buff, idx);
         subghz_view_receiver_add_item_to_menu(
             subghz->subghz_receiver,
             furi_string_get_cstr(str_buff),
-            subghz_history_get_type_protocol(history, item_history - 1));
+            subghz_history_get_type_protocol(history, idx));
 
         subghz_scene_receiver_update_statusbar(subghz);
+    } else if(result == SubGhzHistoryAddResultRepeat) {
+        // Repeat count is a part of the menu text
+        subghz_history_get_text_item_menu(history, str_buff, idx);
+        subghz_view_receiver_set_item_text(
+            subghz->subghz_receiver, idx, furi_string_get_cstr(str_buff));
     }
     subghz_receiver_reset(receiver);
     furi_string_free(str_buff);
@@ -113,7 +120,7 @@ void subghz_scene_receiver_on_enter(void* context) {
 
     //Load history to receiver
     subghz_view_receiver_exit(subghz->subghz_receiver);
-    for(uint8_t i = 0; i < subghz_history_get_item(history); i++) {
+    for(uint16_t i = 0; i < subghz_history_get_item(history); i++) {
         furi_string_reset(str_buff);
         subghz_history_get_text_item_menu(history, str_buff, i);
         subghz_view_receiver_add_item_to_menu(
@@ -136,7 +136,9 @@ SubGhz* subghz_alloc(void) {
     subghz_unlock(subghz);
     subghz_rx_key_state_set(subghz, SubGhzRxKeyStateIDLE);
     subghz->history = subghz_history_alloc();
+    subghz_history_set_spill_file(subghz->history, SUBGHZ_HISTORY_SPILL_FILE_NAME);
     subghz->filter = SubGhzProtocolFlag_Decodable;
+    subghz->raw_binary = false;
 
     //init TxRx & History & KeyBoard
     subghz->txrx = subghz_txrx_alloc();
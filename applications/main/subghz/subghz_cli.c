@@ -9,6 +9,8 @@
 #include <lib/subghz/receiver.h>
 #include <lib/subghz/transmitter.h>
 #include <lib/subghz/subghz_file_encoder_worker.h>
+#include <lib/subghz/subghz_raw_binary.h>
+#include <lib/subghz/subghz_file_decoder.h>
 #include <lib/subghz/protocols/protocol_items.h>
 #include <lib/subghz/devices/cc1101_int/cc1101_int_interconnect.h>
 #include <lib/subghz/devices/devices.h>
@@ -16,6 +18,8 @@
 
 #include <lib/toolbox/args.h>
 #include <lib/toolbox/strint.h>
+#include <lib/toolbox/path.h>
+#include <toolbox/stream/file_stream.h>
 
 #include "helpers/subghz_chat.h"
 
@@ -27,6 +31,8 @@
 
 #define TAG "SubGhzCli"
 
+#define SUBGHZ_DECODE_RAW_NAME_LENGTH 256
+
 static void subghz_cli_radio_device_power_on(void) {
     uint8_t attempts = 5;
     while(--attempts > 0) {
@@ -462,100 +468,240 @@ void subghz_cli_command_rx_raw(Cli* cli, FuriString* args, void* context) {
     free(instance);
 }
 
-void subghz_cli_command_decode_raw(Cli* cli, FuriString* args, void* context) {
-    UNUSED(context);
-    FuriString* file_name;
-    file_name = furi_string_alloc();
-    furi_string_set(file_name, EXT_PATH("subghz/test.sub"));
+typedef struct {
+    SubGhzFileDecoder* decoder;
+    FlipperFormat* serialized;
+    Stream* output;
+    bool quiet;
+    size_t packet_count;
+} SubGhzCliCommandDecodeRaw;
 
-    Storage* storage = furi_record_open(RECORD_STORAGE);
-    FlipperFormat* fff_data_file = flipper_format_file_alloc(storage);
-    FuriString* temp_str;
-    temp_str = furi_string_alloc();
-    uint32_t temp_data32;
-    bool check_file = false;
+static void subghz_cli_command_decode_raw_callback(
+    SubGhzReceiver* receiver,
+    SubGhzProtocolDecoderBase* decoder_base,
+    void* context) {
+    SubGhzCliCommandDecodeRaw* instance = context;
+    instance->packet_count++;
 
-    do {
-        if(furi_string_size(args)) {
-            if(!args_read_string_and_trim(args, file_name)) {
-                cli_print_usage(
-                    "subghz decode_raw", "<file_name: path_RAW_file>", furi_string_get_cstr(args));
-                break;
-            }
-        }
+    FuriString* text;
+    text = furi_string_alloc();
+    subghz_protocol_decoder_base_get_string(decoder_base, text);
+    if(!instance->quiet) printf("%s", furi_string_get_cstr(text));
+    furi_string_free(text);
 
-        if(!flipper_format_file_open_existing(fff_data_file, furi_string_get_cstr(file_name))) {
-            printf(
-                "subghz decode_raw \033[0;31mError open file\033[0m %s\r\n",
-                furi_string_get_cstr(file_name));
-            break;
+    // Reset may clear decoded data, serialize it first
+    if(instance->output) {
+        SubGhzRadioPreset* preset = subghz_file_decoder_get_preset(instance->decoder);
+        if(subghz_protocol_decoder_base_serialize(decoder_base, instance->serialized, preset) ==
+           SubGhzProtocolStatusOk) {
+            Stream* stream = flipper_format_get_raw_stream(instance->serialized);
+            stream_rewind(stream);
+            stream_copy(stream, instance->output, stream_size(stream));
         }
+    }
 
-        if(!flipper_format_read_header(fff_data_file, temp_str, &temp_data32)) {
-            printf("subghz decode_raw \033[0;31mMissing or incorrect header\033[0m\r\n");
-            break;
-        }
+    subghz_receiver_reset(receiver);
+}
 
-        if(!strcmp(furi_string_get_cstr(temp_str), SUBGHZ_RAW_FILE_TYPE) &&
-           temp_data32 == SUBGHZ_KEY_FILE_VERSION) {
-        } else {
-            printf("subghz decode_raw \033[0;31mType or version mismatch\033[0m\r\n");
-            break;
-        }
+static size_t subghz_cli_command_decode_raw_file(
+    SubGhzCliCommandDecodeRaw* instance,
+    SubGhzReceiver* receiver,
+    const char* file_name) {
+    size_t packet_count = instance->packet_count;
+    uint32_t start = furi_get_tick();
 
-        check_file = true;
-    } while(false);
+    if(!subghz_file_decoder_run(instance->decoder, receiver, file_name)) {
+        printf("subghz decode_raw \033[0;31mError decode file\033[0m %s\r\n", file_name);
+        return 0;
+    }
 
-    furi_string_free(temp_str);
-    flipper_format_free(fff_data_file);
-    furi_record_close(RECORD_STORAGE);
+    uint32_t time = furi_get_tick() - start;
+    size_t samples = subghz_file_decoder_get_sample_count(instance->decoder);
+    printf(
+        "\033[0;33m%s\033[0m: pulses %zu, packets %zu, %lums, %lu pulses/s\r\n",
+        file_name,
+        samples,
+        instance->packet_count - packet_count,
+        time,
+        time ? (uint32_t)((uint64_t)samples * furi_kernel_get_tick_frequency() / time) : 0);
+
+    return samples;
+}
 
-    if(check_file) {
-        // Allocate context
-        SubGhzCliCommandRx* instance = malloc(sizeof(SubGhzCliCommandRx));
+static void subghz_cli_command_receiver_stats_print(SubGhzReceiver* receiver) {
+    SubGhzReceiverStats stats;
+    uint64_t cycles_total = 0;
 
-        SubGhzEnvironment* environment = subghz_cli_environment_init();
+    size_t count = subghz_receiver_get_stats_count(receiver);
+    for(size_t i = 0; i < count; i++) {
+        subghz_receiver_get_stats(receiver, i, &stats);
+        cycles_total += stats.cycles;
+    }
 
-        SubGhzReceiver* receiver = subghz_receiver_alloc_init(environment);
-        subghz_receiver_set_filter(receiver, SubGhzProtocolFlag_Decodable);
-        subghz_receiver_set_rx_callback(receiver, subghz_cli_command_rx_callback, instance);
+    printf(
+        "\r\n%-20s %10s %12s %8s %6s %8s\r\n",
+        "Protocol",
+        "Pulses",
+        "Cycles",
+        "Cyc/pls",
+        "%",
+        "Decoded");
+    for(size_t i = 0; i < count; i++) {
+        subghz_receiver_get_stats(receiver, i, &stats);
+        printf(
+            "%-20s %10lu %12llu %8lu %6lu %8lu\r\n",
+            stats.name,
+            stats.feed_count,
+            stats.cycles,
+            stats.feed_count ? (uint32_t)(stats.cycles / stats.feed_count) : 0,
+            cycles_total ? (uint32_t)(stats.cycles * 100 / cycles_total) : 0,
+            stats.decode_count);
+    }
+    printf(
+        "Total %llu cycles, %lu cycles/us\r\n",
+        cycles_total,
+        furi_hal_cortex_instructions_per_microsecond());
+}
+
+static void subghz_cli_command_decode_raw_run(
+    Cli* cli,
+    const char* file_name,
+    const char* output_name,
+    bool stats) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    FileInfo file_info;
+    if(storage_common_stat(storage, file_name, &file_info) != FSE_OK) {
+        printf("subghz decode_raw \033[0;31mError open file\033[0m %s\r\n", file_name);
+        furi_record_close(RECORD_STORAGE);
+        return;
+    }
 
-        SubGhzFileEncoderWorker* file_worker_encoder = subghz_file_encoder_worker_alloc();
-        if(subghz_file_encoder_worker_start(
-               file_worker_encoder, furi_string_get_cstr(file_name), NULL)) {
-            //the worker needs a file in order to open and read part of the file
-            furi_delay_ms(100);
+    // Allocate context
+    SubGhzCliCommandDecodeRaw* instance = malloc(sizeof(SubGhzCliCommandDecodeRaw));
+    instance->decoder = subghz_file_decoder_alloc();
+    instance->serialized = flipper_format_string_alloc();
+    instance->output = NULL;
+    instance->quiet = stats;
+
+    if(output_name) {
+        instance->output = file_stream_alloc(storage);
+        if(!file_stream_open(instance->output, output_name, FSAM_WRITE, FSOM_CREATE_ALWAYS)) {
+            printf("subghz decode_raw \033[0;31mError open file\033[0m %s\r\n", output_name);
+            stream_free(instance->output);
+            instance->output = NULL;
         }
+    }
 
-        printf(
-            "Listening at \033[0;33m%s\033[0m.\r\n\r\nPress CTRL+C to stop\r\n\r\n",
-            furi_string_get_cstr(file_name));
+    SubGhzEnvironment* environment = subghz_cli_environment_init();
 
-        LevelDuration level_duration;
-        while(!cli_cmd_interrupt_received(cli)) {
-            furi_delay_us(500); //you need to have time to read from the file from the SD card
-            level_duration = subghz_file_encoder_worker_get_level_duration(file_worker_encoder);
-            if(!level_duration_is_reset(level_duration)) {
-                bool level = level_duration_get_level(level_duration);
-                uint32_t duration = level_duration_get_duration(level_duration);
-                subghz_receiver_decode(receiver, level, duration);
-            } else {
-                break;
+    SubGhzReceiver* receiver = subghz_receiver_alloc_init(environment);
+    subghz_receiver_set_filter(receiver, SubGhzProtocolFlag_Decodable);
+    subghz_receiver_set_rx_callback(receiver, subghz_cli_command_decode_raw_callback, instance);
+    subghz_receiver_set_stats(receiver, stats);
+
+    uint32_t start = furi_get_tick();
+    size_t samples = 0;
+    size_t file_count = 0;
+
+    if(file_info_is_dir(&file_info)) {
+        // Decode every RAW file of the directory, subdirectories are not visited
+        File* dir = storage_file_alloc(storage);
+        FuriString* path;
+        path = furi_string_alloc();
+        char name[SUBGHZ_DECODE_RAW_NAME_LENGTH];
+
+        if(storage_dir_open(dir, file_name)) {
+            while(!cli_cmd_interrupt_received(cli) &&
+                  storage_dir_read(dir, &file_info, name, sizeof(name))) {
+                path_concat(file_name, name, path);
+                if(file_info_is_dir(&file_info) ||
+                   !furi_string_end_with_str(path, SUBGHZ_APP_FILENAME_EXTENSION)) {
+                    continue;
+                }
+                samples += subghz_cli_command_decode_raw_file(
+                    instance, receiver, furi_string_get_cstr(path));
+                file_count++;
             }
         }
 
-        printf("\r\nPackets received \033[0;32m%zu\033[0m\r\n", instance->packet_count);
+        storage_dir_close(dir);
+        storage_file_free(dir);
+        furi_string_free(path);
+    } else {
+        samples = subghz_cli_command_decode_raw_file(instance, receiver, file_name);
+        file_count = 1;
+    }
+
+    uint32_t time = furi_get_tick() - start;
+    printf(
+        "\r\nFiles \033[0;32m%zu\033[0m, pulses \033[0;32m%zu\033[0m, packets received \033[0;32m%zu\033[0m, %lums\r\n",
+        file_count,
+        samples,
+        instance->packet_count,
+        time);
+
+    if(stats) {
+        subghz_cli_command_receiver_stats_print(receiver);
+    }
+
+    // Cleanup
+    subghz_receiver_free(receiver);
+    subghz_environment_free(environment);
+
+    if(instance->output) {
+        stream_free(instance->output);
+    }
+    flipper_format_free(instance->serialized);
+    subghz_file_decoder_free(instance->decoder);
+    free(instance);
 
-        // Cleanup
-        subghz_receiver_free(receiver);
-        subghz_environment_free(environment);
+    furi_record_close(RECORD_STORAGE);
+}
+
+void subghz_cli_command_decode_raw(Cli* cli, FuriString* args, void* context) {
+    UNUSED(context);
+    FuriString* file_name;
+    FuriString* output_name;
+    file_name = furi_string_alloc();
+    output_name = furi_string_alloc();
+    furi_string_set(file_name, EXT_PATH("subghz/test.sub"));
 
-        if(subghz_file_encoder_worker_is_running(file_worker_encoder)) {
-            subghz_file_encoder_worker_stop(file_worker_encoder);
+    do {
+        if(furi_string_size(args)) {
+            if(!args_read_string_and_trim(args, file_name)) {
+                cli_print_usage(
+                    "subghz decode_raw",
+                    "<path: RAW file or directory> <output: file>",
+                    furi_string_get_cstr(args));
+                break;
+            }
+            args_read_string_and_trim(args, output_name);
         }
-        subghz_file_encoder_worker_free(file_worker_encoder);
-        free(instance);
+
+        subghz_cli_command_decode_raw_run(
+            cli,
+            furi_string_get_cstr(file_name),
+            furi_string_size(output_name) ? furi_string_get_cstr(output_name) : NULL,
+            false);
+    } while(false);
+
+    furi_string_free(output_name);
+    furi_string_free(file_name);
+}
+
+static void subghz_cli_command_receiver_stats(Cli* cli, FuriString* args) {
+    FuriString* file_name;
+    file_name = furi_string_alloc();
+
+    if(!args_read_string_and_trim(args, file_name)) {
+        cli_print_usage(
+            "subghz receiver_stats",
+            "<path: RAW file or directory>",
+            furi_string_get_cstr(args));
+    } else {
+        subghz_cli_command_decode_raw_run(cli, furi_string_get_cstr(file_name), NULL, true);
     }
+
     furi_string_free(file_name);
 }
 
@@ -828,7 +974,12 @@ static void subghz_cli_command_print_usage(void) {
         "\ttx <3 byte Key: in hex> <frequency: in Hz> <te: us> <repeat: count> <device: 0 - CC1101_INT, 1 - CC1101_EXT>\t - Transmitting key\r\n");
     printf("\trx <frequency:in Hz> <device: 0 - CC1101_INT, 1 - CC1101_EXT>\t - Receive\r\n");
     printf("\trx_raw <frequency:in Hz>\t - Receive RAW\r\n");
-    printf("\tdecode_raw <file_name: path_RAW_file>\t - Testing\r\n");
+    printf(
+        "\tdecode_raw <path: RAW file or directory> <output: file>\t - Decode RAW files\r\n");
+    printf(
+        "\treceiver_stats <path: RAW file or directory>\t - Decode RAW files and show time spent in each decoder\r\n");
+    printf(
+        "\traw_convert <path_RAW_file> <path_output_file>\t - Convert RAW samples between text and binary\r\n");
     printf(
         "\ttx_from_file <file_name: path_file> <repeat: count> <device: 0 - CC1101_INT, 1 - CC1101_EXT>\t - Transmitting from file\r\n");
 
@@ -839,6 +990,8 @@ static void subghz_cli_command_print_usage(void) {
         printf("\trx_carrier <frequency:in Hz>\t - Receive carrier\r\n");
         printf(
             "\tencrypt_keeloq <path_decrypted_file> <path_encrypted_file> <IV:16 bytes in hex>\t - Encrypt keeloq manufacture keys\r\n");
+        printf(
+            "\tpack_keeloq <path_keystore_file> <path_binary_file> <IV:16 bytes in hex, optional>\t - Convert keeloq manufacture keys to binary keystore\r\n");
         printf(
             "\tencrypt_raw <path_decrypted_file> <path_encrypted_file> <IV:16 bytes in hex>\t - Encrypt RAW data\r\n");
     }
@@ -887,6 +1040,87 @@ static void subghz_cli_command_encrypt_keeloq(Cli* cli, FuriString* args) {
     furi_string_free(source);
 }
 
+static void subghz_cli_command_pack_keeloq(Cli* cli, FuriString* args) {
+    UNUSED(cli);
+    uint8_t iv[16];
+    bool encrypt = false;
+
+    FuriString* source;
+    FuriString* destination;
+    source = furi_string_alloc();
+    destination = furi_string_alloc();
+
+    SubGhzKeystore* keystore = subghz_keystore_alloc();
+
+    do {
+        if(!args_read_string_and_trim(args, source)) {
+            subghz_cli_command_print_usage();
+            break;
+        }
+
+        if(!args_read_string_and_trim(args, destination)) {
+            subghz_cli_command_print_usage();
+            break;
+        }
+
+        if(furi_string_size(args)) {
+            if(!args_read_hex_bytes(args, iv, 16)) {
+                subghz_cli_command_print_usage();
+                break;
+            }
+            encrypt = true;
+        }
+
+        if(!subghz_keystore_load(keystore, furi_string_get_cstr(source))) {
+            printf("Failed to load Keystore");
+            break;
+        }
+
+        if(!subghz_keystore_save_binary(
+               keystore, furi_string_get_cstr(destination), encrypt ? iv : NULL)) {
+            printf("Failed to save Keystore");
+            break;
+        }
+
+        printf(
+            "Packed %zu keys\r\n", SubGhzKeyArray_size(*subghz_keystore_get_data(keystore)));
+    } while(false);
+
+    subghz_keystore_free(keystore);
+    furi_string_free(destination);
+    furi_string_free(source);
+}
+
+static void subghz_cli_command_raw_convert(Cli* cli, FuriString* args) {
+    UNUSED(cli);
+
+    FuriString* source;
+    FuriString* destination;
+    source = furi_string_alloc();
+    destination = furi_string_alloc();
+
+    do {
+        if(!args_read_string_and_trim(args, source)) {
+            subghz_cli_command_print_usage();
+            break;
+        }
+
+        if(!args_read_string_and_trim(args, destination)) {
+            subghz_cli_command_print_usage();
+            break;
+        }
+
+        if(!subghz_raw_binary_convert(
+               furi_string_get_cstr(source), furi_string_get_cstr(destination))) {
+            printf("Failed to convert RAW file");
+            break;
+        }
+    } while(false);
+
+    furi_string_free(destination);
+    furi_string_free(source);
+}
+
 static void subghz_cli_command_encrypt_raw(Cli* cli, FuriString* args) {
     UNUSED(cli);
     uint8_t iv[16];
@@ -1155,6 +1389,16 @@ static void subghz_cli_command(Cli* cli, FuriString* args, void* context) {
             break;
         }
 
+        if(furi_string_cmp_str(cmd, "receiver_stats") == 0) {
+            subghz_cli_command_receiver_stats(cli, args);
+            break;
+        }
+
+        if(furi_string_cmp_str(cmd, "raw_convert") == 0) {
+            subghz_cli_command_raw_convert(cli, args);
+            break;
+        }
+
         if(furi_string_cmp_str(cmd, "tx_from_file") == 0) {
             subghz_cli_command_tx_from_file(cli, args, context);
             break;
@@ -1166,6 +1410,11 @@ static void subghz_cli_command(Cli* cli, FuriString* args, void* context) {
                 break;
             }
 
+            if(furi_string_cmp_str(cmd, "pack_keeloq") == 0) {
+                subghz_cli_command_pack_keeloq(cli, args);
+                break;
+            }
+
             if(furi_string_cmp_str(cmd, "encrypt_raw") == 0) {
                 subghz_cli_command_encrypt_raw(cli, args);
                 break;
@@ -1,111 +1,287 @@
 #include "subghz_history.h"
 #include <lib/subghz/receiver.h>
 #include <lib/subghz/protocols/came.h>
+#include <lib/flipper_format/flipper_format_i.h>
+#include <storage/storage.h>
+#include <toolbox/path.h>
 
 #include <furi.h>
 
-#define SUBGHZ_HISTORY_MAX       50
-#define SUBGHZ_HISTORY_FREE_HEAP 20480
+#define SUBGHZ_HISTORY_MAX         50
+#define SUBGHZ_HISTORY_MAX_SPILL   500
+#define SUBGHZ_HISTORY_FREE_HEAP   20480
+#define SUBGHZ_HISTORY_ARENA_SIZE  (12 * 1024)
+#define SUBGHZ_HISTORY_RECORD_MIN  256
+#define SUBGHZ_HISTORY_HASH_SIZE   1024
+#define SUBGHZ_HISTORY_TEXT_MAX    UINT8_MAX
+#define SUBGHZ_HISTORY_SPILLED     (1UL << 31)
+#define SUBGHZ_HISTORY_NO_RECORD   UINT16_MAX
+#define SUBGHZ_HISTORY_REPEAT_MAX  UINT8_MAX
+#define SUBGHZ_HISTORY_HASH_OFFSET 2166136261UL
+#define SUBGHZ_HISTORY_HASH_PRIME  16777619UL
+#define SUBGHZ_HISTORY_BURST_MS    500
 
 #define TAG "SubGhzHistory"
 
+/** Record header, followed by preset name, menu text and serialized data */
 typedef struct {
-    FuriString* item_str;
-    FlipperFormat* flipper_string;
+    uint32_t frequency;
+    uint8_t* preset_data;
+    uint16_t preset_data_size;
+    uint8_t preset_name_size;
+    uint8_t text_size;
+    uint16_t data_size;
+} SubGhzHistoryRecord;
+
+/** Decoded key, measured timings like TE are not a part of it */
+typedef struct {
+    uint32_t frequency;
+    uint32_t bit;
+    uint8_t data[sizeof(uint64_t)];
+} SubGhzHistoryKey;
+
+typedef struct {
+    uint32_t hash; // Protocol, decoded data hash and frequency
+    uint32_t offset; // Arena offset, or spill file offset with SUBGHZ_HISTORY_SPILLED set
+    uint16_t size;
     uint8_t type;
-    SubGhzRadioPreset* preset;
+    uint8_t repeat;
 } SubGhzHistoryItem;
 
 ARRAY_DEF(SubGhzHistoryItemArray, SubGhzHistoryItem, M_POD_OPLIST)
 
 #define M_OPL_SubGhzHistoryItemArray_t() ARRAY_OPLIST(SubGhzHistoryItemArray, M_POD_OPLIST)
 
-typedef struct {
-    SubGhzHistoryItemArray_t data;
-} SubGhzHistoryStruct;
-
 struct SubGhzHistory {
-    uint32_t last_update_timestamp;
-    uint16_t last_index_write;
-    uint8_t code_last_hash_data;
+    // Records are added from the worker thread and read from the GUI thread
+    FuriMutex* mutex;
+
+    SubGhzHistoryItemArray_t items;
+    uint16_t hash_table[SUBGHZ_HISTORY_HASH_SIZE]; // Item index + 1, 0 is an empty slot
+
+    uint8_t* arena;
+    size_t arena_used;
+
+    Storage* storage;
+    File* spill_file;
+    FuriString* spill_path;
+    uint32_t spill_used;
+
+    // Last loaded record, only used by getters
+    uint16_t loaded_idx;
+    SubGhzRadioPreset preset;
+    FuriString* text;
+    FlipperFormat* flipper_string;
     FuriString* tmp_string;
-    SubGhzHistoryStruct* history;
+
+    // Serialization buffers, only used by add
+    FlipperFormat* add_flipper_string;
+    FuriString* add_text;
+    FuriString* add_tmp_string;
+    FlipperFormat* add_item_flipper_string;
+    FuriString* add_item_protocol;
+
+    // Last reception, repeats within one burst are not counted
+    uint32_t burst_hash;
+    uint32_t burst_tick;
+    uint16_t burst_idx;
 };
 
 SubGhzHistory* subghz_history_alloc(void) {
     SubGhzHistory* instance = malloc(sizeof(SubGhzHistory));
+    instance->mutex = furi_mutex_alloc(FuriMutexTypeNormal);
+    SubGhzHistoryItemArray_init(instance->items);
+    instance->arena = malloc(SUBGHZ_HISTORY_ARENA_SIZE);
+    instance->spill_path = furi_string_alloc();
+    instance->loaded_idx = SUBGHZ_HISTORY_NO_RECORD;
+    instance->preset.name = furi_string_alloc();
+    instance->text = furi_string_alloc();
+    instance->flipper_string = flipper_format_string_alloc();
     instance->tmp_string = furi_string_alloc();
-    instance->history = malloc(sizeof(SubGhzHistoryStruct));
-    SubGhzHistoryItemArray_init(instance->history->data);
+    instance->add_flipper_string = flipper_format_string_alloc();
+    instance->add_text = furi_string_alloc();
+    instance->add_tmp_string = furi_string_alloc();
+    instance->add_item_flipper_string = flipper_format_string_alloc();
+    instance->add_item_protocol = furi_string_alloc();
+    instance->burst_idx = SUBGHZ_HISTORY_NO_RECORD;
     return instance;
 }
 
+static void subghz_history_spill_close(SubGhzHistory* instance) {
+    if(instance->spill_file) {
+        storage_file_close(instance->spill_file);
+        storage_file_free(instance->spill_file);
+        instance->spill_file = NULL;
+        storage_simply_remove(instance->storage, furi_string_get_cstr(instance->spill_path));
+    }
+    instance->spill_used = 0;
+}
+
 void subghz_history_free(SubGhzHistory* instance) {
     furi_assert(instance);
+    subghz_history_set_spill_file(instance, NULL);
+    furi_string_free(instance->add_item_protocol);
+    flipper_format_free(instance->add_item_flipper_string);
+    furi_string_free(instance->add_tmp_string);
+    furi_string_free(instance->add_text);
+    flipper_format_free(instance->add_flipper_string);
     furi_string_free(instance->tmp_string);
-    for
-        M_EACH(item, instance->history->data, SubGhzHistoryItemArray_t) {
-            furi_string_free(item->item_str);
-            furi_string_free(item->preset->name);
-            free(item->preset);
-            flipper_format_free(item->flipper_string);
-            item->type = 0;
-        }
-    SubGhzHistoryItemArray_clear(instance->history->data);
-    free(instance->history);
+    flipper_format_free(instance->flipper_string);
+    furi_string_free(instance->text);
+    furi_string_free(instance->preset.name);
+    furi_string_free(instance->spill_path);
+    free(instance->arena);
+    SubGhzHistoryItemArray_clear(instance->items);
+    furi_mutex_free(instance->mutex);
     free(instance);
 }
 
+void subghz_history_set_spill_file(SubGhzHistory* instance, const char* path) {
+    furi_assert(instance);
+    furi_check(furi_mutex_acquire(instance->mutex, FuriWaitForever) == FuriStatusOk);
+    subghz_history_spill_close(instance);
+    if(instance->storage) {
+        furi_record_close(RECORD_STORAGE);
+        instance->storage = NULL;
+    }
+
+    if(path) {
+        // File is created on the first spill, so the SD card is only touched when needed
+        instance->storage = furi_record_open(RECORD_STORAGE);
+        furi_string_set(instance->spill_path, path);
+    } else {
+        furi_string_reset(instance->spill_path);
+    }
+    furi_mutex_release(instance->mutex);
+}
+
+static bool subghz_history_has_spill(SubGhzHistory* instance) {
+    return instance->storage != NULL;
+}
+
+static uint16_t subghz_history_get_max(SubGhzHistory* instance) {
+    return subghz_history_has_spill(instance) ? SUBGHZ_HISTORY_MAX_SPILL : SUBGHZ_HISTORY_MAX;
+}
+
+void subghz_history_reset(SubGhzHistory* instance) {
+    furi_assert(instance);
+    furi_check(furi_mutex_acquire(instance->mutex, FuriWaitForever) == FuriStatusOk);
+    furi_string_reset(instance->tmp_string);
+    SubGhzHistoryItemArray_reset(instance->items);
+    memset(instance->hash_table, 0, sizeof(instance->hash_table));
+    instance->arena_used = 0;
+    instance->loaded_idx = SUBGHZ_HISTORY_NO_RECORD;
+    instance->burst_idx = SUBGHZ_HISTORY_NO_RECORD;
+    subghz_history_spill_close(instance);
+    furi_mutex_release(instance->mutex);
+}
+
+static uint32_t subghz_history_hash(uint32_t hash, const void* buffer, size_t size) {
+    // FNV-1a
+    const uint8_t* data = buffer;
+    for(size_t i = 0; i < size; i++) {
+        hash ^= data[i];
+        hash *= SUBGHZ_HISTORY_HASH_PRIME;
+    }
+    return hash;
+}
+
+/** Get record bytes, spilled records are read into a buffer that must be freed */
+static uint8_t* subghz_history_get_record(SubGhzHistory* instance, SubGhzHistoryItem* item) {
+    if(!(item->offset & SUBGHZ_HISTORY_SPILLED)) {
+        return instance->arena + item->offset;
+    }
+
+    uint8_t* record = malloc(item->size);
+    if(!storage_file_seek(instance->spill_file, item->offset & ~SUBGHZ_HISTORY_SPILLED, true) ||
+       storage_file_read(instance->spill_file, record, item->size) != item->size) {
+        FURI_LOG_E(TAG, "Spill read error");
+        memset(record, 0, item->size);
+    }
+    return record;
+}
+
+static void subghz_history_put_record(SubGhzHistoryItem* item, uint8_t* record) {
+    if(item->offset & SUBGHZ_HISTORY_SPILLED) free(record);
+}
+
+static const uint8_t* subghz_history_record_get_data(const SubGhzHistoryRecord* header) {
+    const uint8_t* strings = (const uint8_t*)header + sizeof(SubGhzHistoryRecord);
+    return strings + header->preset_name_size + header->text_size;
+}
+
+static void subghz_history_load(SubGhzHistory* instance, uint16_t idx) {
+    if(instance->loaded_idx == idx) return;
+
+    furi_check(furi_mutex_acquire(instance->mutex, FuriWaitForever) == FuriStatusOk);
+    SubGhzHistoryItem* item = SubGhzHistoryItemArray_get(instance->items, idx);
+    uint8_t* record = subghz_history_get_record(instance, item);
+    const SubGhzHistoryRecord* header = (const SubGhzHistoryRecord*)record;
+    const char* strings = (const char*)record + sizeof(SubGhzHistoryRecord);
+
+    instance->preset.frequency = header->frequency;
+    instance->preset.data = header->preset_data;
+    instance->preset.data_size = header->preset_data_size;
+    furi_string_set_strn(instance->preset.name, strings, header->preset_name_size);
+    furi_string_set_strn(instance->text, strings + header->preset_name_size, header->text_size);
+
+    Stream* stream = flipper_format_get_raw_stream(instance->flipper_string);
+    stream_clean(stream);
+    stream_write(stream, subghz_history_record_get_data(header), header->data_size);
+    flipper_format_rewind(instance->flipper_string);
+
+    subghz_history_put_record(item, record);
+    furi_mutex_release(instance->mutex);
+    instance->loaded_idx = idx;
+}
+
 uint32_t subghz_history_get_frequency(SubGhzHistory* instance, uint16_t idx) {
     furi_assert(instance);
-    SubGhzHistoryItem* item = SubGhzHistoryItemArray_get(instance->history->data, idx);
-    return item->preset->frequency;
+    subghz_history_load(instance, idx);
+    return instance->preset.frequency;
 }
 
 SubGhzRadioPreset* subghz_history_get_radio_preset(SubGhzHistory* instance, uint16_t idx) {
     furi_assert(instance);
-    SubGhzHistoryItem* item = SubGhzHistoryItemArray_get(instance->history->data, idx);
-    return item->preset;
+    subghz_history_load(instance, idx);
+    return &instance->preset;
 }
 
 const char* subghz_history_get_preset(SubGhzHistory* instance, uint16_t idx) {
     furi_assert(instance);
-    SubGhzHistoryItem* item = SubGhzHistoryItemArray_get(instance->history->data, idx);
-    return furi_string_get_cstr(item->preset->name);
+    subghz_history_load(instance, idx);
+    return furi_string_get_cstr(instance->preset.name);
 }
 
-void subghz_history_reset(SubGhzHistory* instance) {
+uint16_t subghz_history_get_item(SubGhzHistory* instance) {
     furi_assert(instance);
-    furi_string_reset(instance->tmp_string);
-    for
-        M_EACH(item, instance->history->data, SubGhzHistoryItemArray_t) {
-            furi_string_free(item->item_str);
-            furi_string_free(item->preset->name);
-            free(item->preset);
-            flipper_format_free(item->flipper_string);
-            item->type = 0;
-        }
-    SubGhzHistoryItemArray_reset(instance->history->data);
-    instance->last_index_write = 0;
-    instance->code_last_hash_data = 0;
+    furi_check(furi_mutex_acquire(instance->mutex, FuriWaitForever) == FuriStatusOk);
+    uint16_t count = SubGhzHistoryItemArray_size(instance->items);
+    furi_mutex_release(instance->mutex);
+    return count;
 }
 
-uint16_t subghz_history_get_item(SubGhzHistory* instance) {
+uint8_t subghz_history_get_type_protocol(SubGhzHistory* instance, uint16_t idx) {
     furi_assert(instance);
-    return instance->last_index_write;
+    furi_check(furi_mutex_acquire(instance->mutex, FuriWaitForever) == FuriStatusOk);
+    uint8_t type = SubGhzHistoryItemArray_get(instance->items, idx)->type;
+    furi_mutex_release(instance->mutex);
+    return type;
 }
 
-uint8_t subghz_history_get_type_protocol(SubGhzHistory* instance, uint16_t idx) {
+uint8_t subghz_history_get_repeat(SubGhzHistory* instance, uint16_t idx) {
     furi_assert(instance);
-    SubGhzHistoryItem* item = SubGhzHistoryItemArray_get(instance->history->data, idx);
-    return item->type;
+    furi_check(furi_mutex_acquire(instance->mutex, FuriWaitForever) == FuriStatusOk);
+    uint8_t repeat = SubGhzHistoryItemArray_get(instance->items, idx)->repeat;
+    furi_mutex_release(instance->mutex);
+    return repeat;
 }
 
 const char* subghz_history_get_protocol_name(SubGhzHistory* instance, uint16_t idx) {
     furi_assert(instance);
-    SubGhzHistoryItem* item = SubGhzHistoryItemArray_get(instance->history->data, idx);
-    flipper_format_rewind(item->flipper_string);
-    if(!flipper_format_read_string(item->flipper_string, "Protocol", instance->tmp_string)) {
+    subghz_history_load(instance, idx);
+    flipper_format_rewind(instance->flipper_string);
+    if(!flipper_format_read_string(instance->flipper_string, "Protocol", instance->tmp_string)) {
         FURI_LOG_E(TAG, "Missing Protocol");
         furi_string_reset(instance->tmp_string);
     }
@@ -114,99 +290,147 @@ const char* subghz_history_get_protocol_name(SubGhzHistory* instance, uint16_t i
 
 FlipperFormat* subghz_history_get_raw_data(SubGhzHistory* instance, uint16_t idx) {
     furi_assert(instance);
-    SubGhzHistoryItem* item = SubGhzHistoryItemArray_get(instance->history->data, idx);
-    if(item->flipper_string) {
-        return item->flipper_string;
-    } else {
-        return NULL;
-    }
+    subghz_history_load(instance, idx);
+    flipper_format_rewind(instance->flipper_string);
+    return instance->flipper_string;
 }
+
 bool subghz_history_get_text_space_left(SubGhzHistory* instance, FuriString* output) {
     furi_assert(instance);
+    furi_check(furi_mutex_acquire(instance->mutex, FuriWaitForever) == FuriStatusOk);
+    uint16_t max = subghz_history_get_max(instance);
+    uint16_t count = SubGhzHistoryItemArray_size(instance->items);
+    bool full = (count == max) || (!subghz_history_has_spill(instance) &&
+                                   (SUBGHZ_HISTORY_ARENA_SIZE - instance->arena_used <
+                                    SUBGHZ_HISTORY_RECORD_MIN));
+    furi_mutex_release(instance->mutex);
+
     if(memmgr_get_free_heap() < SUBGHZ_HISTORY_FREE_HEAP) {
         if(output != NULL) furi_string_printf(output, "    Free heap LOW");
         return true;
     }
-    if(instance->last_index_write == SUBGHZ_HISTORY_MAX) {
+    if(full) {
         if(output != NULL) furi_string_printf(output, "   Memory is FULL");
         return true;
     }
-    if(output != NULL)
-        furi_string_printf(output, "%02u/%02u", instance->last_index_write, SUBGHZ_HISTORY_MAX);
+    if(output != NULL) furi_string_printf(output, "%02u/%02u", count, max);
     return false;
 }
 
 void subghz_history_get_text_item_menu(SubGhzHistory* instance, FuriString* output, uint16_t idx) {
-    SubGhzHistoryItem* item = SubGhzHistoryItemArray_get(instance->history->data, idx);
-    furi_string_set(output, item->item_str);
+    furi_assert(instance);
+    // Called from the worker thread too, so the text is taken from the record directly
+    furi_check(furi_mutex_acquire(instance->mutex, FuriWaitForever) == FuriStatusOk);
+    SubGhzHistoryItem* item = SubGhzHistoryItemArray_get(instance->items, idx);
+    uint8_t* record = subghz_history_get_record(instance, item);
+    const SubGhzHistoryRecord* header = (const SubGhzHistoryRecord*)record;
+    const char* strings = (const char*)record + sizeof(SubGhzHistoryRecord);
+    furi_string_set_strn(output, strings + header->preset_name_size, header->text_size);
+    subghz_history_put_record(item, record);
+    if(item->repeat > 1) {
+        furi_string_cat_printf(output, " x%u", item->repeat);
+    }
+    furi_mutex_release(instance->mutex);
 }
 
-bool subghz_history_add_to_history(
-    SubGhzHistory* instance,
-    void* context,
-    SubGhzRadioPreset* preset) {
-    furi_assert(instance);
-    furi_assert(context);
+/** Read the decoded key, false if the record has no key to compare */
+static bool subghz_history_get_key(
+    FlipperFormat* flipper_format,
+    uint32_t frequency,
+    FuriString* protocol,
+    SubGhzHistoryKey* key) {
+    memset(key, 0, sizeof(SubGhzHistoryKey));
+    key->frequency = frequency;
 
-    if(memmgr_get_free_heap() < SUBGHZ_HISTORY_FREE_HEAP) return false;
-    if(instance->last_index_write >= SUBGHZ_HISTORY_MAX) return false;
+    bool success = false;
+    do {
+        if(!flipper_format_rewind(flipper_format)) break;
+        if(!flipper_format_read_string(flipper_format, "Protocol", protocol)) break;
+        if(!flipper_format_rewind(flipper_format)) break;
+        if(!flipper_format_read_uint32(flipper_format, "Bit", &key->bit, 1)) {
+            key->bit = 0;
+        }
+        if(!flipper_format_rewind(flipper_format)) break;
+        if(!flipper_format_read_hex(flipper_format, "Key", key->data, sizeof(key->data))) break;
+        success = true;
+    } while(false);
 
-    SubGhzProtocolDecoderBase* decoder_base = context;
-    if((instance->code_last_hash_data ==
-        subghz_protocol_decoder_base_get_hash_data(decoder_base)) &&
-       ((furi_get_tick() - instance->last_update_timestamp) < 500)) {
-        instance->last_update_timestamp = furi_get_tick();
-        return false;
-    }
+    return success;
+}
 
-    instance->code_last_hash_data = subghz_protocol_decoder_base_get_hash_data(decoder_base);
-    instance->last_update_timestamp = furi_get_tick();
+/** Look up an item with the same protocol and key, adds it to the hash table if not found */
+static bool subghz_history_find_duplicate(
+    SubGhzHistory* instance,
+    uint32_t hash,
+    const FuriString* protocol,
+    const SubGhzHistoryKey* key,
+    uint16_t** slot) {
+    size_t index = hash & (SUBGHZ_HISTORY_HASH_SIZE - 1);
+    while(instance->hash_table[index]) {
+        SubGhzHistoryItem* item =
+            SubGhzHistoryItemArray_get(instance->items, instance->hash_table[index] - 1);
+        if(key && item->hash == hash) {
+            uint8_t* record = subghz_history_get_record(instance, item);
+            const SubGhzHistoryRecord* header = (const SubGhzHistoryRecord*)record;
+            Stream* stream = flipper_format_get_raw_stream(instance->add_item_flipper_string);
+            stream_clean(stream);
+            stream_write(stream, subghz_history_record_get_data(header), header->data_size);
+            SubGhzHistoryKey item_key;
+            bool equal = subghz_history_get_key(
+                             instance->add_item_flipper_string,
+                             header->frequency,
+                             instance->add_item_protocol,
+                             &item_key) &&
+                         furi_string_equal(instance->add_item_protocol, protocol) &&
+                         !memcmp(&item_key, key, sizeof(SubGhzHistoryKey));
+            subghz_history_put_record(item, record);
+            if(equal) {
+                *slot = &instance->hash_table[index];
+                return true;
+            }
+        }
+        index = (index + 1) & (SUBGHZ_HISTORY_HASH_SIZE - 1);
+    }
+    *slot = &instance->hash_table[index];
+    return false;
+}
 
-    FuriString* text;
-    text = furi_string_alloc();
-    SubGhzHistoryItem* item = SubGhzHistoryItemArray_push_raw(instance->history->data);
-    item->preset = malloc(sizeof(SubGhzRadioPreset));
-    item->type = decoder_base->protocol->type;
-    item->preset->frequency = preset->frequency;
-    item->preset->name = furi_string_alloc();
-    furi_string_set(item->preset->name, preset->name);
-    item->preset->data = preset->data;
-    item->preset->data_size = preset->data_size;
-
-    item->item_str = furi_string_alloc();
-    item->flipper_string = flipper_format_string_alloc();
-    subghz_protocol_decoder_base_serialize(decoder_base, item->flipper_string, preset);
+static void subghz_history_get_text(
+    FlipperFormat* flipper_format,
+    FuriString* text,
+    FuriString* tmp_string) {
+    furi_string_reset(text);
 
     do {
-        if(!flipper_format_rewind(item->flipper_string)) {
+        if(!flipper_format_rewind(flipper_format)) {
             FURI_LOG_E(TAG, "Rewind error");
             break;
         }
-        if(!flipper_format_read_string(item->flipper_string, "Protocol", instance->tmp_string)) {
+        if(!flipper_format_read_string(flipper_format, "Protocol", tmp_string)) {
             FURI_LOG_E(TAG, "Missing Protocol");
             break;
         }
-        if(!strcmp(furi_string_get_cstr(instance->tmp_string), "KeeLoq")) {
-            furi_string_set(instance->tmp_string, "KL ");
-            if(!flipper_format_read_string(item->flipper_string, "Manufacture", text)) {
+        if(!strcmp(furi_string_get_cstr(tmp_string), "KeeLoq")) {
+            furi_string_set(tmp_string, "KL ");
+            if(!flipper_format_read_string(flipper_format, "Manufacture", text)) {
                 FURI_LOG_E(TAG, "Missing Protocol");
                 break;
             }
-            furi_string_cat(instance->tmp_string, text);
-        } else if(!strcmp(furi_string_get_cstr(instance->tmp_string), "Star Line")) {
-            furi_string_set(instance->tmp_string, "SL ");
-            if(!flipper_format_read_string(item->flipper_string, "Manufacture", text)) {
+            furi_string_cat(tmp_string, text);
+        } else if(!strcmp(furi_string_get_cstr(tmp_string), "Star Line")) {
+            furi_string_set(tmp_string, "SL ");
+            if(!flipper_format_read_string(flipper_format, "Manufacture", text)) {
                 FURI_LOG_E(TAG, "Missing Protocol");
                 break;
             }
-            furi_string_cat(instance->tmp_string, text);
+            furi_string_cat(tmp_string, text);
         }
-        if(!flipper_format_rewind(item->flipper_string)) {
+        if(!flipper_format_rewind(flipper_format)) {
             FURI_LOG_E(TAG, "Rewind error");
             break;
         }
         uint8_t key_data[sizeof(uint64_t)] = {0};
-        if(!flipper_format_read_hex(item->flipper_string, "Key", key_data, sizeof(uint64_t))) {
+        if(!flipper_format_read_hex(flipper_format, "Key", key_data, sizeof(uint64_t))) {
             FURI_LOG_D(TAG, "No Key");
         }
         uint64_t data = 0;
@@ -216,25 +440,177 @@ bool subghz_history_add_to_history(
         if(data != 0) {
             if(!(uint32_t)(data >> 32)) {
                 furi_string_printf(
-                    item->item_str,
+                    text,
                     "%s %lX",
-                    furi_string_get_cstr(instance->tmp_string),
+                    furi_string_get_cstr(tmp_string),
                     (uint32_t)(data & 0xFFFFFFFF));
             } else {
                 furi_string_printf(
-                    item->item_str,
+                    text,
                     "%s %lX%08lX",
-                    furi_string_get_cstr(instance->tmp_string),
+                    furi_string_get_cstr(tmp_string),
                     (uint32_t)(data >> 32),
                     (uint32_t)(data & 0xFFFFFFFF));
             }
         } else {
-            furi_string_printf(item->item_str, "%s", furi_string_get_cstr(instance->tmp_string));
+            furi_string_printf(text, "%s", furi_string_get_cstr(tmp_string));
         }
-
     } while(false);
 
-    furi_string_free(text);
-    instance->last_index_write++;
+    furi_string_left(text, SUBGHZ_HISTORY_TEXT_MAX);
+}
+
+static bool subghz_history_spill(
+    SubGhzHistory* instance,
+    SubGhzHistoryItem* item,
+    const uint8_t* record) {
+    if(!instance->spill_file) {
+        FuriString* dir = furi_string_alloc();
+        path_extract_dirname(furi_string_get_cstr(instance->spill_path), dir);
+        storage_simply_mkdir(instance->storage, furi_string_get_cstr(dir));
+        furi_string_free(dir);
+
+        instance->spill_file = storage_file_alloc(instance->storage);
+        if(!storage_file_open(
+               instance->spill_file,
+               furi_string_get_cstr(instance->spill_path),
+               FSAM_READ_WRITE,
+               FSOM_CREATE_ALWAYS)) {
+            FURI_LOG_E(TAG, "Unable to open spill file");
+            storage_file_free(instance->spill_file);
+            instance->spill_file = NULL;
+            return false;
+        }
+    }
+
+    if(!storage_file_seek(instance->spill_file, instance->spill_used, true) ||
+       storage_file_write(instance->spill_file, record, item->size) != item->size) {
+        FURI_LOG_E(TAG, "Spill write error");
+        return false;
+    }
+
+    item->offset = instance->spill_used | SUBGHZ_HISTORY_SPILLED;
+    instance->spill_used += item->size;
     return true;
 }
+
+SubGhzHistoryAddResult subghz_history_add_to_history(
+    SubGhzHistory* instance,
+    void* context,
+    SubGhzRadioPreset* preset,
+    uint16_t* idx) {
+    furi_assert(instance);
+    furi_assert(context);
+    furi_assert(idx);
+
+    if(memmgr_get_free_heap() < SUBGHZ_HISTORY_FREE_HEAP) return SubGhzHistoryAddResultFail;
+
+    SubGhzProtocolDecoderBase* decoder_base = context;
+
+    // Serialized data also holds measured timings, which differ between repeats of one key
+    const char* protocol_name = decoder_base->protocol->name;
+    const uint8_t hash_data = subghz_protocol_decoder_base_get_hash_data(decoder_base);
+    uint32_t hash =
+        subghz_history_hash(SUBGHZ_HISTORY_HASH_OFFSET, protocol_name, strlen(protocol_name));
+    hash = subghz_history_hash(hash, &hash_data, sizeof(hash_data));
+    hash = subghz_history_hash(hash, &preset->frequency, sizeof(preset->frequency));
+
+    FlipperFormat* flipper_format = instance->add_flipper_string;
+    subghz_protocol_decoder_base_serialize(decoder_base, flipper_format, preset);
+    Stream* stream = flipper_format_get_raw_stream(flipper_format);
+    size_t data_size = stream_size(stream);
+
+    uint8_t* data = malloc(data_size);
+    stream_rewind(stream);
+    stream_read(stream, data, data_size);
+
+    // Records without a key (e.g. BinRAW) are never merged, only their bursts are dropped
+    SubGhzHistoryKey key;
+    bool has_key = subghz_history_get_key(
+        flipper_format, preset->frequency, instance->add_tmp_string, &key);
+
+    furi_check(furi_mutex_acquire(instance->mutex, FuriWaitForever) == FuriStatusOk);
+
+    SubGhzHistoryAddResult result = SubGhzHistoryAddResultFail;
+    const uint32_t tick = furi_get_tick();
+    const bool in_burst = (instance->burst_idx != SUBGHZ_HISTORY_NO_RECORD) &&
+                          (hash == instance->burst_hash) &&
+                          (tick - instance->burst_tick < SUBGHZ_HISTORY_BURST_MS);
+    uint16_t* slot;
+    if(subghz_history_find_duplicate(
+           instance, hash, instance->add_tmp_string, has_key ? &key : NULL, &slot)) {
+        SubGhzHistoryItem* item = SubGhzHistoryItemArray_get(instance->items, *slot - 1);
+        *idx = *slot - 1;
+        if(in_burst && (instance->burst_idx == *idx)) {
+            result = SubGhzHistoryAddResultBurst;
+        } else {
+            if(item->repeat < SUBGHZ_HISTORY_REPEAT_MAX) item->repeat++;
+            result = SubGhzHistoryAddResultRepeat;
+        }
+    } else if(in_burst && !has_key) {
+        *idx = instance->burst_idx;
+        result = SubGhzHistoryAddResultBurst;
+    } else if(SubGhzHistoryItemArray_size(instance->items) < subghz_history_get_max(instance)) {
+        FuriString* text = instance->add_text;
+        subghz_history_get_text(flipper_format, text, instance->add_tmp_string);
+
+        SubGhzHistoryRecord header = {
+            .frequency = preset->frequency,
+            .preset_data = preset->data,
+            .preset_data_size = preset->data_size,
+            .preset_name_size = MIN(furi_string_size(preset->name), (size_t)UINT8_MAX),
+            .text_size = furi_string_size(text),
+            .data_size = data_size,
+        };
+        size_t record_size =
+            sizeof(SubGhzHistoryRecord) + header.preset_name_size + header.text_size + data_size;
+
+        SubGhzHistoryItem item = {
+            .hash = hash,
+            .size = record_size,
+            .type = decoder_base->protocol->type,
+            .repeat = 1,
+        };
+
+        bool in_arena = (record_size <= SUBGHZ_HISTORY_ARENA_SIZE - instance->arena_used);
+        uint8_t* record = in_arena ? instance->arena + instance->arena_used :
+                                     malloc(record_size);
+        memcpy(record, &header, sizeof(SubGhzHistoryRecord));
+        uint8_t* record_data = record + sizeof(SubGhzHistoryRecord);
+        memcpy(record_data, furi_string_get_cstr(preset->name), header.preset_name_size);
+        record_data += header.preset_name_size;
+        memcpy(record_data, furi_string_get_cstr(text), header.text_size);
+        record_data += header.text_size;
+        memcpy(record_data, data, data_size);
+
+        bool added = true;
+        if(in_arena) {
+            // Keep records word aligned, so headers can be read in place
+            item.offset = instance->arena_used;
+            instance->arena_used +=
+                ROUND_UP_TO(record_size, sizeof(uint32_t)) * sizeof(uint32_t);
+        } else {
+            added = subghz_history_has_spill(instance) &&
+                    subghz_history_spill(instance, &item, record);
+            free(record);
+        }
+
+        if(added) {
+            SubGhzHistoryItemArray_push_back(instance->items, item);
+            *slot = SubGhzHistoryItemArray_size(instance->items);
+            *idx = *slot - 1;
+            result = SubGhzHistoryAddResultNew;
+        }
+    }
+
+    if(result != SubGhzHistoryAddResultFail) {
+        instance->burst_hash = hash;
+        instance->burst_tick = tick;
+        instance->burst_idx = *idx;
+    }
+
+    furi_mutex_release(instance->mutex);
+    free(data);
+
+    return result;
+}
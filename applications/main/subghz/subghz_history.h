@@ -7,8 +7,17 @@
 #include <lib/flipper_format/flipper_format.h>
 #include <lib/subghz/types.h>
 
+#define SUBGHZ_HISTORY_SPILL_FILE_NAME SUBGHZ_APP_FOLDER "/.history.tmp"
+
 typedef struct SubGhzHistory SubGhzHistory;
 
+typedef enum {
+    SubGhzHistoryAddResultFail, /**< Record was not added, history is full */
+    SubGhzHistoryAddResultNew, /**< New record was added */
+    SubGhzHistoryAddResultRepeat, /**< Same record exists, its repeat count was incremented */
+    SubGhzHistoryAddResultBurst, /**< Same record was just received, it is a part of one burst */
+} SubGhzHistoryAddResult;
+
 /** Allocate SubGhzHistory
  * 
  * @return SubGhzHistory* 
@@ -21,6 +30,17 @@ SubGhzHistory* subghz_history_alloc(void);
  */
 void subghz_history_free(SubGhzHistory* instance);
 
+/** Set file to store records in once the memory arena is full
+ * 
+ * Records with the same protocol, key and frequency are stored once, repeats are counted
+ * instead.
+ * Spill file is created on demand and removed on reset.
+ * 
+ * @param instance  - SubGhzHistory instance
+ * @param path      - spill file path, NULL to keep records in memory only
+ */
+void subghz_history_set_spill_file(SubGhzHistory* instance, const char* path);
+
 /** Clear history
  * 
  * @param instance - SubGhzHistory instance
@@ -60,6 +80,14 @@ uint16_t subghz_history_get_item(SubGhzHistory* instance);
  */
 uint8_t subghz_history_get_type_protocol(SubGhzHistory* instance, uint16_t idx);
 
+/** Get amount of times history[idx] was received
+ * 
+ * @param instance  - SubGhzHistory instance
+ * @param idx       - record index  
+ * @return repeat   - receive count, saturates at 255
+ */
+uint8_t subghz_history_get_repeat(SubGhzHistory* instance, uint16_t idx);
+
 /** Get name protocol to history[idx]
  * 
  * @param instance  - SubGhzHistory instance
@@ -85,16 +113,20 @@ void subghz_history_get_text_item_menu(SubGhzHistory* instance, FuriString* outp
 bool subghz_history_get_text_space_left(SubGhzHistory* instance, FuriString* output);
 
 /** Add protocol to history
+ * 
+ * Safe to call from the worker thread while the GUI thread reads the history.
  * 
  * @param instance  - SubGhzHistory instance
  * @param context    - SubGhzProtocolCommon context
  * @param preset    - SubGhzRadioPreset preset
- * @return bool;
+ * @param idx       - index of the new or repeated record, set unless the result is Fail
+ * @return SubGhzHistoryAddResult
  */
-bool subghz_history_add_to_history(
+SubGhzHistoryAddResult subghz_history_add_to_history(
     SubGhzHistory* instance,
     void* context,
-    SubGhzRadioPreset* preset);
+    SubGhzRadioPreset* preset,
+    uint16_t* idx);
 
 /** Get SubGhzProtocolCommonLoad to load into the protocol decoder bin data
  * 
@@ -156,6 +156,24 @@ void subghz_view_receiver_add_item_to_menu(
     subghz_view_receiver_update_offset(subghz_receiver);
 }
 
+void subghz_view_receiver_set_item_text(
+    SubGhzViewReceiver* subghz_receiver,
+    uint16_t idx,
+    const char* name) {
+    furi_assert(subghz_receiver);
+    with_view_model(
+        subghz_receiver->view,
+        SubGhzViewReceiverModel * model,
+        {
+            if(idx < SubGhzReceiverMenuItemArray_size(model->history->data)) {
+                SubGhzReceiverMenuItem* item_menu =
+                    SubGhzReceiverMenuItemArray_get(model->history->data, idx);
+                furi_string_set(item_menu->item_str, name);
+            }
+        },
+        true);
+}
+
 void subghz_view_receiver_add_data_statusbar(
     SubGhzViewReceiver* subghz_receiver,
     const char* frequency_str,
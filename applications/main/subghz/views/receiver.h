@@ -38,6 +38,11 @@ void subghz_view_receiver_add_item_to_menu(
     const char* name,
     uint8_t type);
 
+void subghz_view_receiver_set_item_text(
+    SubGhzViewReceiver* subghz_receiver,
+    uint16_t idx,
+    const char* name);
+
 uint16_t subghz_view_receiver_get_idx_menu(SubGhzViewReceiver* subghz_receiver);
 
 void subghz_view_receiver_set_idx_menu(SubGhzViewReceiver* subghz_receiver, uint16_t idx);
@@ -20,6 +20,7 @@ struct File {
     FS_Error error_id; /**< Standard API error from FS_Error enum */
     int32_t internal_error_id; /**< Internal API error value */
     void* storage;
+    FuriThreadId lease_owner; /**< Thread that holds direct access lease, NULL if none */
 };
 
 /** File api structure
@@ -34,6 +34,7 @@ static void storage_app_sd_icon_draw_callback(Canvas* canvas, void* context) {
 Storage* storage_app_alloc(void) {
     Storage* app = malloc(sizeof(Storage));
     app->message_queue = furi_message_queue_alloc(8, sizeof(StorageMessage));
+    app->mutex = furi_mutex_alloc(FuriMutexTypeNormal);
     app->pubsub = furi_pubsub_alloc();
 
     for(uint8_t i = 0; i < STORAGE_COUNT; i++) {
@@ -105,9 +106,13 @@ int32_t storage_srv(void* p) {
     StorageMessage message;
     while(1) {
         if(furi_message_queue_get(app->message_queue, &message, STORAGE_TICK) == FuriStatusOk) {
+            furi_check(furi_mutex_acquire(app->mutex, FuriWaitForever) == FuriStatusOk);
             storage_process_message(app, &message);
+            furi_mutex_release(app->mutex);
         } else {
+            furi_check(furi_mutex_acquire(app->mutex, FuriWaitForever) == FuriStatusOk);
             storage_tick(app);
+            furi_mutex_release(app->mutex);
         }
     }
 
@@ -185,6 +185,64 @@ bool storage_file_sync(File* file);
  */
 bool storage_file_eof(File* file);
 
+/**
+ * @brief Type of an operation in a batch.
+ */
+typedef enum {
+    StorageFileOpRead, /**< Read size bytes into buff. */
+    StorageFileOpWrite, /**< Write size bytes from write_buff. */
+    StorageFileOpSeek, /**< Change access position, same as storage_file_seek(). */
+} StorageFileOpType;
+
+/**
+ * @brief Single operation in a batch.
+ */
+typedef struct {
+    StorageFileOpType type; /**< Operation type. */
+    union {
+        void* buff; /**< Destination buffer for read operations. */
+        const void* write_buff; /**< Source buffer for write operations. */
+    };
+    size_t size; /**< Number of bytes to read or write. */
+    uint32_t offset; /**< Seek offset. */
+    bool from_start; /**< Seek relative to the file start instead of current position. */
+    size_t result; /**< Filled by the storage: bytes transferred, 1 for a successful seek. */
+} StorageFileOp;
+
+/**
+ * @brief Execute several operations on a file in one request to the storage service.
+ *
+ * Operations are executed in order. Execution stops at the first operation that
+ * fails or transfers fewer bytes than requested, its result field is still filled.
+ * The file error reflects the last executed operation.
+ *
+ * @param file pointer to the file instance in question.
+ * @param ops pointer to the array of operations.
+ * @param ops_count number of operations in the array.
+ * @return number of operations that were completed in full.
+ */
+size_t storage_file_batch(File* file, StorageFileOp* ops, size_t ops_count);
+
+/**
+ * @brief Get direct access to an open file.
+ *
+ * Until storage_file_lease_release() is called, read, write, seek, tell, truncate,
+ * size, sync, eof and batch calls on this file from the calling thread are executed
+ * in the calling thread, without a round trip to the storage service. The storage
+ * service is blocked for that time, so the lease must be short and the calling
+ * thread must not use any other storage API, including closing this file.
+ *
+ * @param file pointer to an open file instance.
+ */
+void storage_file_lease_acquire(File* file);
+
+/**
+ * @brief Release direct access to a file and unblock the storage service.
+ *
+ * @param file pointer to the file instance leased with storage_file_lease_acquire().
+ */
+void storage_file_lease_release(File* file);
+
 /**
  * @brief Check whether a file exists.
  * 
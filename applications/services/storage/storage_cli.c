@@ -61,6 +61,22 @@ static void storage_cli_info(Cli* cli, FuriString* path, FuriString* args) {
                 sd_info.product_serial_number,
                 sd_info.manufacturing_month,
                 sd_info.manufacturing_year);
+
+            FuriHalSdCacheStats cache_stats;
+            furi_hal_sd_cache_get_stats(&cache_stats);
+            printf(
+                "Cache: %lu blocks, %lu hits, %lu misses, %lu evictions\r\n"
+                "Cache writes: %lu, %lu written back, %lu pending\r\n"
+                "Card reads: %lu, %lu bytes per read\r\n",
+                cache_stats.size,
+                cache_stats.hits,
+                cache_stats.misses,
+                cache_stats.evictions,
+                cache_stats.writes,
+                cache_stats.write_backs,
+                cache_stats.dirty,
+                cache_stats.reads,
+                cache_stats.reads ? cache_stats.read_blocks * 512 / cache_stats.reads : 0);
         }
     } else {
         storage_cli_print_usage();
@@ -485,6 +501,59 @@ static void storage_cli_md5(Cli* cli, FuriString* path, FuriString* args) {
     furi_record_close(RECORD_STORAGE);
 }
 
+static void storage_cli_benchmark(Cli* cli, FuriString* path, FuriString* args) {
+    UNUSED(cli);
+    Storage* api = furi_record_open(RECORD_STORAGE);
+    File* file = storage_file_alloc(api);
+
+    uint32_t buffer_size;
+    if(strint_to_uint32(furi_string_get_cstr(args), NULL, &buffer_size, 10) !=
+           StrintParseNoError ||
+       buffer_size == 0 || buffer_size > UINT16_MAX) {
+        storage_cli_print_usage();
+    } else if(storage_file_open(file, furi_string_get_cstr(path), FSAM_READ, FSOM_OPEN_EXISTING)) {
+        uint8_t* data = malloc(buffer_size);
+        FuriHalSdCacheStats stats_before, stats_after;
+
+        furi_hal_sd_cache_get_stats(&stats_before);
+        uint32_t start_tick = furi_get_tick();
+
+        uint64_t total = 0;
+        size_t read_size;
+        do {
+            read_size = storage_file_read(file, data, buffer_size);
+            total += read_size;
+        } while(read_size == buffer_size);
+
+        uint32_t ticks = furi_get_tick() - start_tick;
+        furi_hal_sd_cache_get_stats(&stats_after);
+
+        uint32_t reads = stats_after.reads - stats_before.reads;
+        uint32_t read_blocks = stats_after.read_blocks - stats_before.read_blocks;
+        printf(
+            "Read %llu bytes in %lu chunks of %lu in %lu ticks, %lu KiB/s\r\n",
+            total,
+            (uint32_t)((total + buffer_size - 1) / buffer_size),
+            buffer_size,
+            ticks,
+            ticks ? (uint32_t)(total * furi_kernel_get_tick_frequency() / ticks / 1024) : 0);
+        printf(
+            "Card reads: %lu, %lu blocks, %lu bytes per read\r\n",
+            reads,
+            read_blocks,
+            reads ? read_blocks * 512 / reads : 0);
+
+        free(data);
+    } else {
+        storage_cli_print_error(storage_file_get_error(file));
+    }
+
+    storage_file_close(file);
+    storage_file_free(file);
+
+    furi_record_close(RECORD_STORAGE);
+}
+
 static bool tar_extract_file_callback(const char* name, bool is_directory, void* context) {
     UNUSED(context);
     printf("\t%s %s\r\n", is_directory ? "D" : "F", name);
@@ -555,6 +624,11 @@ static const StorageCliCommand storage_cli_commands[] = {
         "md5 hash of the file",
         &storage_cli_md5,
     },
+    {
+        "benchmark",
+        "read file to the end and print read speed, <args> should contain chunk size",
+        &storage_cli_benchmark,
+    },
     {
         "stat",
         "info about file or dir",
@@ -3,6 +3,7 @@
 #include "storage.h"
 #include "storage_i.h" // IWYU pragma: keep
 #include "storage_message.h"
+#include "storage_processing.h"
 #include <toolbox/stream/file_stream.h>
 #include <toolbox/dir_walk.h>
 #include "toolbox/path.h"
@@ -20,12 +21,25 @@
     Storage* storage = file->storage; \
     furi_check(storage);
 
-#define S_API_EPILOGUE                                                               \
-    furi_check(                                                                      \
-        furi_message_queue_put(storage->message_queue, &message, FuriWaitForever) == \
-        FuriStatusOk);                                                               \
+#define S_API_EPILOGUE                                                                \
+    furi_check(furi_mutex_get_owner(storage->mutex) != furi_thread_get_current_id()); \
+    furi_check(                                                                       \
+        furi_message_queue_put(storage->message_queue, &message, FuriWaitForever) ==  \
+        FuriStatusOk);                                                                \
     api_lock_wait_unlock_and_free(lock)
 
+// File calls under a lease are processed in the calling thread
+#define S_FILE_API_LEASE_PROLOGUE                                          \
+    const bool leased = file->lease_owner == furi_thread_get_current_id(); \
+    FuriApiLock lock = leased ? NULL : api_lock_alloc_locked();
+
+#define S_FILE_API_LEASE_EPILOGUE                   \
+    if(leased) {                                    \
+        storage_process_message(storage, &message); \
+    } else {                                        \
+        S_API_EPILOGUE;                             \
+    }
+
 #define S_API_MESSAGE(_command)      \
     SAReturn return_data;            \
     StorageMessage message = {       \
@@ -148,7 +162,7 @@ static uint16_t storage_file_read_underlying(File* file, void* buff, uint16_t by
     }
 
     S_FILE_API_PROLOGUE;
-    S_API_PROLOGUE;
+    S_FILE_API_LEASE_PROLOGUE;
 
     SAData data = {
         .fread = {
@@ -158,7 +172,7 @@ static uint16_t storage_file_read_underlying(File* file, void* buff, uint16_t by
         }};
 
     S_API_MESSAGE(StorageCommandFileRead);
-    S_API_EPILOGUE;
+    S_FILE_API_LEASE_EPILOGUE;
     return S_RETURN_UINT16;
 }
 
@@ -169,7 +183,7 @@ static uint16_t
     }
 
     S_FILE_API_PROLOGUE;
-    S_API_PROLOGUE;
+    S_FILE_API_LEASE_PROLOGUE;
 
     SAData data = {
         .fwrite = {
@@ -179,7 +193,7 @@ static uint16_t
         }};
 
     S_API_MESSAGE(StorageCommandFileWrite);
-    S_API_EPILOGUE;
+    S_FILE_API_LEASE_EPILOGUE;
     return S_RETURN_UINT16;
 }
 
@@ -221,7 +235,7 @@ size_t storage_file_write(File* file, const void* buff, size_t to_write) {
 
 bool storage_file_seek(File* file, uint32_t offset, bool from_start) {
     S_FILE_API_PROLOGUE;
-    S_API_PROLOGUE;
+    S_FILE_API_LEASE_PROLOGUE;
 
     SAData data = {
         .fseek = {
@@ -231,55 +245,94 @@ bool storage_file_seek(File* file, uint32_t offset, bool from_start) {
         }};
 
     S_API_MESSAGE(StorageCommandFileSeek);
-    S_API_EPILOGUE;
+    S_FILE_API_LEASE_EPILOGUE;
     return S_RETURN_BOOL;
 }
 
 uint64_t storage_file_tell(File* file) {
     S_FILE_API_PROLOGUE;
-    S_API_PROLOGUE;
+    S_FILE_API_LEASE_PROLOGUE;
     S_API_DATA_FILE;
     S_API_MESSAGE(StorageCommandFileTell);
-    S_API_EPILOGUE;
+    S_FILE_API_LEASE_EPILOGUE;
     return S_RETURN_UINT64;
 }
 
 bool storage_file_truncate(File* file) {
     S_FILE_API_PROLOGUE;
-    S_API_PROLOGUE;
+    S_FILE_API_LEASE_PROLOGUE;
     S_API_DATA_FILE;
     S_API_MESSAGE(StorageCommandFileTruncate);
-    S_API_EPILOGUE;
+    S_FILE_API_LEASE_EPILOGUE;
     return S_RETURN_BOOL;
 }
 
 uint64_t storage_file_size(File* file) {
     S_FILE_API_PROLOGUE;
-    S_API_PROLOGUE;
+    S_FILE_API_LEASE_PROLOGUE;
     S_API_DATA_FILE;
     S_API_MESSAGE(StorageCommandFileSize);
-    S_API_EPILOGUE;
+    S_FILE_API_LEASE_EPILOGUE;
     return S_RETURN_UINT64;
 }
 
 bool storage_file_sync(File* file) {
     S_FILE_API_PROLOGUE;
-    S_API_PROLOGUE;
+    S_FILE_API_LEASE_PROLOGUE;
     S_API_DATA_FILE;
     S_API_MESSAGE(StorageCommandFileSync);
-    S_API_EPILOGUE;
+    S_FILE_API_LEASE_EPILOGUE;
     return S_RETURN_BOOL;
 }
 
 bool storage_file_eof(File* file) {
     S_FILE_API_PROLOGUE;
-    S_API_PROLOGUE;
+    S_FILE_API_LEASE_PROLOGUE;
     S_API_DATA_FILE;
     S_API_MESSAGE(StorageCommandFileEof);
-    S_API_EPILOGUE;
+    S_FILE_API_LEASE_EPILOGUE;
     return S_RETURN_BOOL;
 }
 
+size_t storage_file_batch(File* file, StorageFileOp* ops, size_t ops_count) {
+    furi_check(ops);
+    if(ops_count == 0) {
+        return 0;
+    }
+
+    S_FILE_API_PROLOGUE;
+    S_FILE_API_LEASE_PROLOGUE;
+
+    SAData data = {
+        .fbatch = {
+            .file = file,
+            .ops = ops,
+            .ops_count = ops_count,
+        }};
+
+    S_API_MESSAGE(StorageCommandFileBatch);
+    S_FILE_API_LEASE_EPILOGUE;
+    return return_data.size_value;
+}
+
+void storage_file_lease_acquire(File* file) {
+    S_FILE_API_PROLOGUE;
+    furi_check(file->type == FileTypeOpenFile);
+
+    FuriThreadId thread_id = furi_thread_get_current_id();
+    furi_check(furi_mutex_get_owner(storage->mutex) != thread_id);
+    furi_check(furi_mutex_acquire(storage->mutex, FuriWaitForever) == FuriStatusOk);
+    file->lease_owner = thread_id;
+}
+
+void storage_file_lease_release(File* file) {
+    S_FILE_API_PROLOGUE;
+    furi_check(file->lease_owner == furi_thread_get_current_id());
+
+    file->lease_owner = NULL;
+    furi_check(furi_mutex_release(storage->mutex) == FuriStatusOk);
+}
+
 bool storage_file_exists(Storage* storage, const char* path) {
     furi_check(storage);
 
@@ -22,6 +22,7 @@ typedef struct {
 
 struct Storage {
     FuriMessageQueue* message_queue;
+    FuriMutex* mutex; // Held by storage thread while processing and by direct access leases
     StorageData storage[STORAGE_COUNT];
     StorageSDGui sd_gui;
     FuriPubSub* pubsub;
@@ -32,6 +32,12 @@ typedef struct {
     bool from_start;
 } SADataFSeek;
 
+typedef struct {
+    File* file;
+    StorageFileOp* ops;
+    size_t ops_count;
+} SADataFBatch;
+
 typedef struct {
     File* file;
     const char* path;
@@ -98,6 +104,7 @@ typedef union {
     SADataFRead fread;
     SADataFWrite fwrite;
     SADataFSeek fseek;
+    SADataFBatch fbatch;
 
     SADataDOpen dopen;
     SADataDRead dread;
@@ -119,6 +126,7 @@ typedef union {
 typedef union {
     bool bool_value;
     uint16_t uint16_value;
+    size_t size_value;
     uint64_t uint64_value;
     FS_Error error_value;
     const char* cstring_value;
@@ -151,10 +159,11 @@ typedef enum {
     StorageCommandCommonResolvePath,
     StorageCommandSDMount,
     StorageCommandCommonEquivalentPath,
+    StorageCommandFileBatch,
 } StorageCommand;
 
 typedef struct {
-    FuriApiLock lock;
+    FuriApiLock lock; /**< NULL when message is processed directly under a lease */
     StorageCommand command;
     SAData* data;
     SAReturn* return_data;
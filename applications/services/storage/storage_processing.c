@@ -261,6 +261,50 @@ static bool storage_process_file_eof(Storage* app, File* file) {
     return ret;
 }
 
+static bool storage_process_file_batch_op(Storage* app, File* file, StorageFileOp* op) {
+    const size_t max_chunk = UINT16_MAX;
+    file->error_id = FSE_OK;
+    op->result = 0;
+
+    switch(op->type) {
+    case StorageFileOpRead:
+        while(op->result < op->size) {
+            const uint16_t chunk = MIN(op->size - op->result, max_chunk);
+            uint16_t read =
+                storage_process_file_read(app, file, (uint8_t*)op->buff + op->result, chunk);
+            op->result += read;
+            if(file->error_id != FSE_OK || read != chunk) break;
+        }
+        return file->error_id == FSE_OK && op->result == op->size;
+    case StorageFileOpWrite:
+        while(op->result < op->size) {
+            const uint16_t chunk = MIN(op->size - op->result, max_chunk);
+            uint16_t written = storage_process_file_write(
+                app, file, (const uint8_t*)op->write_buff + op->result, chunk);
+            op->result += written;
+            if(file->error_id != FSE_OK || written != chunk) break;
+        }
+        return file->error_id == FSE_OK && op->result == op->size;
+    case StorageFileOpSeek:
+        op->result = storage_process_file_seek(app, file, op->offset, op->from_start);
+        return op->result;
+    default:
+        file->error_id = FSE_INVALID_PARAMETER;
+        return false;
+    }
+}
+
+static size_t
+    storage_process_file_batch(Storage* app, File* file, StorageFileOp* ops, size_t ops_count) {
+    size_t done = 0;
+
+    while(done < ops_count && storage_process_file_batch_op(app, file, &ops[done])) {
+        done++;
+    }
+
+    return done;
+}
+
 /******************* Dir Functions *******************/
 
 bool storage_process_dir_open(Storage* app, File* file, FuriString* path) {
@@ -628,6 +672,13 @@ void storage_process_message_internal(Storage* app, StorageMessage* message) {
     case StorageCommandFileEof:
         message->return_data->bool_value = storage_process_file_eof(app, message->data->file.file);
         break;
+    case StorageCommandFileBatch:
+        message->return_data->size_value = storage_process_file_batch(
+            app,
+            message->data->fbatch.file,
+            message->data->fbatch.ops,
+            message->data->fbatch.ops_count);
+        break;
 
     // Dir operations
     case StorageCommandDirOpen:
@@ -743,7 +794,9 @@ void storage_process_message_internal(Storage* app, StorageMessage* message) {
         furi_string_free(path);
     }
 
-    api_lock_unlock(message->lock);
+    if(message->lock) {
+        api_lock_unlock(message->lock);
+    }
 }
 
 void storage_process_message(Storage* app, StorageMessage* message) {
@@ -8,25 +8,63 @@
 #include "../filesystem_api_internal.h"
 #include "../storage_internal_dirname_i.h"
 
-typedef FIL SDFile;
 typedef DIR SDDir;
 typedef FILINFO SDFileInfo;
 typedef FRESULT SDError;
 
 #define TAG "StorageExt"
 
+/** Read-ahead buffer size, also the largest read-ahead */
+#define SD_READ_AHEAD_SIZE 4096
+/** First read-ahead size, doubles on each refill */
+#define SD_READ_AHEAD_MIN_SIZE 1024
+/** Read-ahead buffers shared by all open files */
+#define SD_READ_AHEAD_COUNT 2
+/** Sequential reads before read-ahead starts */
+#define SD_READ_AHEAD_THRESHOLD 2
+
 /********************* Definitions ********************/
 
+typedef struct {
+    uint8_t* buffer; // Taken from SDData pool, NULL when not reading ahead
+    uint16_t size; // Bytes in buffer, they end at the FatFs file pointer
+    uint16_t offset; // Bytes already returned to the caller
+    uint16_t window; // Current read-ahead size
+    uint8_t sequential; // Reads that started where the previous one ended
+    FSIZE_t next; // Position after the previous read
+} SDReadAhead;
+
+typedef struct {
+    FIL fil;
+    SDReadAhead read_ahead;
+} SDFile;
+
 typedef struct {
     FATFS* fs;
     const char* path;
     bool sd_was_present;
+
+    uint8_t* read_ahead_pool[SD_READ_AHEAD_COUNT];
+    bool read_ahead_busy[SD_READ_AHEAD_COUNT];
 } SDData;
 
 static FS_Error storage_ext_parse_error(SDError error);
 
 /******************* Core Functions *******************/
 
+static void sd_cache_pin_metadata(FATFS* fs) {
+    // FAT and root directory are read on every path lookup and cluster chain walk
+    furi_hal_sd_cache_pin_range(fs->fatbase, fs->fatbase + fs->fsize * fs->n_fats - 1);
+
+    if(fs->fs_type == FS_FAT12 || fs->fs_type == FS_FAT16) {
+        furi_hal_sd_cache_pin_range(fs->dirbase, fs->database - 1);
+    } else {
+        // Root directory starts at cluster dirbase in the data area
+        uint32_t root_sector = fs->database + (fs->dirbase - 2) * fs->csize;
+        furi_hal_sd_cache_pin_range(root_sector, root_sector + fs->csize - 1);
+    }
+}
+
 static bool sd_mount_card_internal(StorageData* storage, bool notify) {
     bool result = false;
     uint8_t counter = furi_hal_sd_max_mount_retry_count();
@@ -67,6 +105,7 @@ static bool sd_mount_card_internal(StorageData* storage, bool notify) {
 
                 if(status == FR_OK) {
                     storage->status = StorageStatusOK;
+                    sd_cache_pin_metadata(sd_data->fs);
                 } else if(status == FR_NO_FILESYSTEM) {
                     storage->status = StorageStatusNoFS;
                 } else {
@@ -162,6 +201,8 @@ FS_Error sd_unmount_card(StorageData* storage) {
     error = FR_DISK_ERR;
 
     // TODO FL-3522: do i need to close the files?
+    // Write back cached blocks while the card is still there
+    furi_hal_sd_deinit();
     f_mount(0, sd_data->path, 0);
 
     return storage_ext_parse_error(error);
@@ -387,6 +428,54 @@ static FS_Error storage_ext_parse_error(SDError error) {
 
 /******************* File Functions *******************/
 
+static bool sd_read_ahead_acquire(SDData* sd_data, SDReadAhead* read_ahead) {
+    if(read_ahead->buffer) return true;
+
+    for(size_t i = 0; i < SD_READ_AHEAD_COUNT; i++) {
+        if(!sd_data->read_ahead_busy[i]) {
+            if(!sd_data->read_ahead_pool[i]) {
+                sd_data->read_ahead_pool[i] = malloc(SD_READ_AHEAD_SIZE);
+            }
+            sd_data->read_ahead_busy[i] = true;
+            read_ahead->buffer = sd_data->read_ahead_pool[i];
+            return true;
+        }
+    }
+
+    return false;
+}
+
+static void sd_read_ahead_release(SDData* sd_data, SDReadAhead* read_ahead) {
+    for(size_t i = 0; read_ahead->buffer && i < SD_READ_AHEAD_COUNT; i++) {
+        if(read_ahead->buffer == sd_data->read_ahead_pool[i]) {
+            sd_data->read_ahead_busy[i] = false;
+        }
+    }
+
+    read_ahead->buffer = NULL;
+    read_ahead->size = 0;
+    read_ahead->offset = 0;
+    read_ahead->window = 0;
+}
+
+static inline FSIZE_t sd_file_tell(SDFile* file_data) {
+    const SDReadAhead* read_ahead = &file_data->read_ahead;
+    return f_tell(&file_data->fil) - (read_ahead->size - read_ahead->offset);
+}
+
+/** Return FatFs file pointer to the position seen by the caller */
+static SDError sd_read_ahead_drop(SDData* sd_data, SDFile* file_data) {
+    SDReadAhead* read_ahead = &file_data->read_ahead;
+    SDError error = FR_OK;
+
+    if(read_ahead->size != read_ahead->offset) {
+        error = f_lseek(&file_data->fil, sd_file_tell(file_data));
+    }
+    sd_read_ahead_release(sd_data, read_ahead);
+
+    return error;
+}
+
 static bool storage_ext_file_open(
     void* ctx,
     File* file,
@@ -407,7 +496,7 @@ static bool storage_ext_file_open(
     SDFile* file_data = malloc(sizeof(SDFile));
     storage_set_storage_file_data(file, file_data, storage);
 
-    file->internal_error_id = f_open(file_data, path, _mode);
+    file->internal_error_id = f_open(&file_data->fil, path, _mode);
     file->error_id = storage_ext_parse_error(file->internal_error_id);
     return file->error_id == FSE_OK;
 }
@@ -415,7 +504,8 @@ static bool storage_ext_file_open(
 static bool storage_ext_file_close(void* ctx, File* file) {
     StorageData* storage = ctx;
     SDFile* file_data = storage_get_storage_file_data(file, storage);
-    file->internal_error_id = f_close(file_data);
+    sd_read_ahead_release(storage->data, &file_data->read_ahead);
+    file->internal_error_id = f_close(&file_data->fil);
     file->error_id = storage_ext_parse_error(file->internal_error_id);
     free(file_data);
     storage_set_storage_file_data(file, NULL, storage);
@@ -426,8 +516,64 @@ static uint16_t
     storage_ext_file_read(void* ctx, File* file, void* buff, uint16_t const bytes_to_read) {
     StorageData* storage = ctx;
     SDFile* file_data = storage_get_storage_file_data(file, storage);
+    SDReadAhead* read_ahead = &file_data->read_ahead;
+    uint8_t* data = buff;
     uint16_t bytes_read = 0;
-    file->internal_error_id = f_read(file_data, buff, bytes_to_read, &bytes_read);
+    SDError error = FR_OK;
+
+    // Position seen by the caller, FatFs file pointer is ahead of it by the buffered data
+    if(sd_file_tell(file_data) == read_ahead->next) {
+        if(read_ahead->sequential < UINT8_MAX) read_ahead->sequential++;
+    } else {
+        read_ahead->sequential = 0;
+    }
+
+    // Buffered data first, buffer is empty after this unless request is satisfied
+    uint16_t buffered = MIN(bytes_to_read, read_ahead->size - read_ahead->offset);
+    if(buffered) {
+        memcpy(data, &read_ahead->buffer[read_ahead->offset], buffered);
+        read_ahead->offset += buffered;
+        bytes_read = buffered;
+    }
+
+    uint16_t remaining = bytes_to_read - bytes_read;
+    if(remaining) {
+        FSIZE_t position = f_tell(&file_data->fil);
+        if(!read_ahead->sequential) {
+            sd_read_ahead_release(storage->data, read_ahead);
+        }
+
+        // Window holds at least two reads, so larger reads skip the smaller windows
+        uint16_t window = read_ahead->window ? read_ahead->window * 2 : SD_READ_AHEAD_MIN_SIZE;
+        while(window < SD_READ_AHEAD_SIZE && remaining > window / 2) {
+            window *= 2;
+        }
+        window = MIN(window, SD_READ_AHEAD_SIZE);
+
+        if(read_ahead->sequential >= SD_READ_AHEAD_THRESHOLD && remaining <= window / 2 &&
+           sd_read_ahead_acquire(storage->data, read_ahead)) {
+            // End on sector boundary, so the next refill is a multi block read
+            uint16_t size = window - (position + window) % _MIN_SS;
+            read_ahead->window = window;
+            read_ahead->offset = 0;
+            error = f_read(&file_data->fil, read_ahead->buffer, size, &read_ahead->size);
+
+            uint16_t copied = MIN(remaining, read_ahead->size);
+            memcpy(&data[bytes_read], read_ahead->buffer, copied);
+            read_ahead->offset = copied;
+            bytes_read += copied;
+        } else {
+            // Large reads go to FatFs directly, it reads whole sectors into caller buffer
+            uint16_t direct_read = 0;
+            read_ahead->size = 0;
+            read_ahead->offset = 0;
+            error = f_read(&file_data->fil, &data[bytes_read], remaining, &direct_read);
+            bytes_read += direct_read;
+        }
+    }
+
+    read_ahead->next = sd_file_tell(file_data);
+    file->internal_error_id = error;
     file->error_id = storage_ext_parse_error(file->internal_error_id);
     return bytes_read;
 }
@@ -444,7 +590,11 @@ static uint16_t
     StorageData* storage = ctx;
     SDFile* file_data = storage_get_storage_file_data(file, storage);
     uint16_t bytes_written = 0;
-    file->internal_error_id = f_write(file_data, buff, bytes_to_write, &bytes_written);
+    file->internal_error_id = sd_read_ahead_drop(storage->data, file_data);
+    if(file->internal_error_id == FR_OK) {
+        file->internal_error_id =
+            f_write(&file_data->fil, buff, bytes_to_write, &bytes_written);
+    }
     file->error_id = storage_ext_parse_error(file->internal_error_id);
     return bytes_written;
 #endif
@@ -454,13 +604,23 @@ static bool
     storage_ext_file_seek(void* ctx, File* file, const uint32_t offset, const bool from_start) {
     StorageData* storage = ctx;
     SDFile* file_data = storage_get_storage_file_data(file, storage);
+    SDReadAhead* read_ahead = &file_data->read_ahead;
 
-    if(from_start) {
-        file->internal_error_id = f_lseek(file_data, offset);
+    uint64_t position = offset;
+    if(!from_start) {
+        position += sd_file_tell(file_data);
+    }
+
+    // Seeks inside read-ahead buffer keep it
+    uint64_t buffer_end = f_tell(&file_data->fil);
+    uint64_t buffer_start = buffer_end - read_ahead->size;
+    if(read_ahead->buffer && position >= buffer_start && position <= buffer_end) {
+        read_ahead->offset = position - buffer_start;
+        read_ahead->next = position;
+        file->internal_error_id = FR_OK;
     } else {
-        uint64_t position = f_tell(file_data);
-        position += offset;
-        file->internal_error_id = f_lseek(file_data, position);
+        sd_read_ahead_release(storage->data, read_ahead);
+        file->internal_error_id = f_lseek(&file_data->fil, position);
     }
 
     file->error_id = storage_ext_parse_error(file->internal_error_id);
@@ -472,7 +632,7 @@ static uint64_t storage_ext_file_tell(void* ctx, File* file) {
     SDFile* file_data = storage_get_storage_file_data(file, storage);
 
     uint64_t position = 0;
-    position = f_tell(file_data);
+    position = sd_file_tell(file_data);
     file->error_id = FSE_OK;
     return position;
 }
@@ -486,7 +646,10 @@ static bool storage_ext_file_truncate(void* ctx, File* file) {
     StorageData* storage = ctx;
     SDFile* file_data = storage_get_storage_file_data(file, storage);
 
-    file->internal_error_id = f_truncate(file_data);
+    file->internal_error_id = sd_read_ahead_drop(storage->data, file_data);
+    if(file->internal_error_id == FR_OK) {
+        file->internal_error_id = f_truncate(&file_data->fil);
+    }
     file->error_id = storage_ext_parse_error(file->internal_error_id);
     return file->error_id == FSE_OK;
 #endif
@@ -501,7 +664,7 @@ static bool storage_ext_file_sync(void* ctx, File* file) {
     StorageData* storage = ctx;
     SDFile* file_data = storage_get_storage_file_data(file, storage);
 
-    file->internal_error_id = f_sync(file_data);
+    file->internal_error_id = f_sync(&file_data->fil);
     file->error_id = storage_ext_parse_error(file->internal_error_id);
     return file->error_id == FSE_OK;
 #endif
@@ -512,7 +675,7 @@ static uint64_t storage_ext_file_size(void* ctx, File* file) {
     SDFile* file_data = storage_get_storage_file_data(file, storage);
 
     uint64_t size = 0;
-    size = f_size(file_data);
+    size = f_size(&file_data->fil);
     file->error_id = FSE_OK;
     return size;
 }
@@ -521,7 +684,7 @@ static bool storage_ext_file_eof(void* ctx, File* file) {
     StorageData* storage = ctx;
     SDFile* file_data = storage_get_storage_file_data(file, storage);
 
-    bool eof = f_eof(file_data);
+    bool eof = sd_file_tell(file_data) >= f_size(&file_data->fil);
     file->internal_error_id = 0;
     file->error_id = FSE_OK;
     return eof;
@@ -0,0 +1,162 @@
+#include "spsc_ring.h"
+
+#include "check.h"
+#include "common_defines.h"
+#include "kernel.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+struct FuriSpscRing {
+    // Free running indexes, only producer writes head and only consumer writes tail
+    uint32_t head;
+    uint32_t tail;
+    uint32_t overrun_count;
+
+    uint32_t mask;
+    size_t item_size;
+
+    FuriThreadId consumer;
+    uint32_t consumer_flags;
+    size_t watermark;
+
+    uint8_t buffer[];
+};
+
+FuriSpscRing* furi_spsc_ring_alloc(size_t capacity, size_t item_size) {
+    furi_check(capacity > 0);
+    furi_check((capacity & (capacity - 1)) == 0);
+    furi_check(item_size > 0);
+
+    FuriSpscRing* ring = malloc(sizeof(FuriSpscRing) + capacity * item_size);
+    ring->mask = capacity - 1;
+    ring->item_size = item_size;
+    ring->watermark = 1;
+
+    return ring;
+}
+
+void furi_spsc_ring_free(FuriSpscRing* ring) {
+    furi_check(ring);
+    free(ring);
+}
+
+void furi_spsc_ring_set_consumer(
+    FuriSpscRing* ring,
+    FuriThreadId thread_id,
+    uint32_t flags,
+    size_t watermark) {
+    furi_check(ring);
+    furi_check(watermark > 0 && watermark <= ring->mask + 1);
+
+    ring->consumer_flags = flags;
+    ring->watermark = watermark;
+    __atomic_store_n(&ring->consumer, thread_id, __ATOMIC_RELEASE);
+}
+
+static inline void furi_spsc_ring_copy_in(
+    FuriSpscRing* ring,
+    uint32_t index,
+    const uint8_t* items,
+    size_t count) {
+    const size_t capacity = ring->mask + 1;
+    const size_t offset = index & ring->mask;
+    const size_t first = MIN(count, capacity - offset);
+
+    memcpy(&ring->buffer[offset * ring->item_size], items, first * ring->item_size);
+    if(first < count) {
+        memcpy(ring->buffer, &items[first * ring->item_size], (count - first) * ring->item_size);
+    }
+}
+
+static inline void
+    furi_spsc_ring_copy_out(FuriSpscRing* ring, uint32_t index, uint8_t* items, size_t count) {
+    const size_t capacity = ring->mask + 1;
+    const size_t offset = index & ring->mask;
+    const size_t first = MIN(count, capacity - offset);
+
+    memcpy(items, &ring->buffer[offset * ring->item_size], first * ring->item_size);
+    if(first < count) {
+        memcpy(&items[first * ring->item_size], ring->buffer, (count - first) * ring->item_size);
+    }
+}
+
+bool furi_spsc_ring_push(FuriSpscRing* ring, const void* items, size_t count) {
+    furi_check(ring);
+    furi_check(items || !count);
+
+    const uint32_t head = ring->head;
+    const uint32_t tail = __atomic_load_n(&ring->tail, __ATOMIC_ACQUIRE);
+    if(count > (ring->mask + 1) - (head - tail)) {
+        ring->overrun_count++;
+        return false;
+    }
+
+    furi_spsc_ring_copy_in(ring, head, items, count);
+    __atomic_store_n(&ring->head, head + count, __ATOMIC_SEQ_CST);
+
+    // Tail is read again after publishing head: if the consumer has checked the ring
+    // before this point, it is seen here and the crossing below is accurate
+    FuriThreadId consumer = __atomic_load_n(&ring->consumer, __ATOMIC_ACQUIRE);
+    if(consumer) {
+        const uint32_t queued = head + count - __atomic_load_n(&ring->tail, __ATOMIC_SEQ_CST);
+        if(queued >= ring->watermark && queued - count < ring->watermark) {
+            furi_thread_flags_set(consumer, ring->consumer_flags);
+        }
+    }
+
+    return true;
+}
+
+size_t furi_spsc_ring_pop(FuriSpscRing* ring, void* items, size_t count) {
+    furi_check(ring);
+    furi_check(items || !count);
+
+    const uint32_t tail = ring->tail;
+    const uint32_t head = __atomic_load_n(&ring->head, __ATOMIC_ACQUIRE);
+    count = MIN(count, (size_t)(head - tail));
+
+    if(count) {
+        furi_spsc_ring_copy_out(ring, tail, items, count);
+        __atomic_store_n(&ring->tail, tail + count, __ATOMIC_SEQ_CST);
+    }
+
+    return count;
+}
+
+size_t furi_spsc_ring_receive(FuriSpscRing* ring, void* items, size_t count, uint32_t timeout) {
+    furi_check(ring);
+    furi_check(ring->consumer == furi_thread_get_current_id());
+
+    const uint32_t start = furi_get_tick();
+
+    while(furi_spsc_ring_get_count(ring) < ring->watermark) {
+        const uint32_t elapsed = furi_get_tick() - start;
+        if(elapsed >= timeout) break;
+
+        // Stale flags from an earlier crossing only cause an extra check
+        uint32_t flags =
+            furi_thread_flags_wait(ring->consumer_flags, FuriFlagWaitAny, timeout - elapsed);
+        if(flags & FuriFlagError) break;
+    }
+
+    return furi_spsc_ring_pop(ring, items, count);
+}
+
+size_t furi_spsc_ring_get_count(FuriSpscRing* ring) {
+    furi_check(ring);
+
+    const uint32_t tail = __atomic_load_n(&ring->tail, __ATOMIC_SEQ_CST);
+    return __atomic_load_n(&ring->head, __ATOMIC_SEQ_CST) - tail;
+}
+
+uint32_t furi_spsc_ring_get_overrun_count(FuriSpscRing* ring) {
+    furi_check(ring);
+    return __atomic_load_n(&ring->overrun_count, __ATOMIC_RELAXED);
+}
+
+void furi_spsc_ring_flush(FuriSpscRing* ring) {
+    furi_check(ring);
+    __atomic_store_n(
+        &ring->tail, __atomic_load_n(&ring->head, __ATOMIC_ACQUIRE), __ATOMIC_SEQ_CST);
+}
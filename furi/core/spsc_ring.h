@@ -0,0 +1,117 @@
+/**
+ * @file spsc_ring.h
+ * Furi single producer single consumer ring primitive.
+ *
+ * Lock free ring of fixed size items for passing data from an interrupt to
+ * a thread. Producer never blocks and never enters a critical section.
+ * Consumer thread is woken up with thread flags once the amount of queued
+ * items reaches the watermark, not on every item.
+ *
+ * ***NOTE***: exactly one task or interrupt may push to the ring (the producer),
+ * and exactly one thread may pop from it (the consumer).
+ */
+#pragma once
+
+#include "base.h"
+#include "thread.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct FuriSpscRing FuriSpscRing;
+
+/**
+ * @brief Allocate ring instance.
+ *
+ * @param capacity Amount of items the ring can hold, must be a power of two.
+ * @param item_size Size of a single item in bytes.
+ * @return The ring instance.
+ */
+FuriSpscRing* furi_spsc_ring_alloc(size_t capacity, size_t item_size);
+
+/**
+ * @brief Free ring instance.
+ *
+ * @param ring The ring instance.
+ */
+void furi_spsc_ring_free(FuriSpscRing* ring);
+
+/**
+ * @brief Set consumer thread to be woken up by the producer.
+ * Flags are set on the consumer thread when the amount of queued items
+ * reaches the watermark. Consumer thread must reset it to NULL before exit
+ * if the producer may still be running.
+ *
+ * @param ring The ring instance.
+ * @param thread_id Consumer thread id, NULL to disable wakeup.
+ * @param flags Thread flags to set on the consumer thread.
+ * @param watermark Amount of queued items that wakes up the consumer, at least 1.
+ */
+void furi_spsc_ring_set_consumer(
+    FuriSpscRing* ring,
+    FuriThreadId thread_id,
+    uint32_t flags,
+    size_t watermark);
+
+/**
+ * @brief Push items to the ring. Producer side, safe to call from ISR.
+ * Items are written all together or not at all.
+ *
+ * @param ring The ring instance.
+ * @param items Pointer to items to be copied.
+ * @param count Amount of items.
+ * @return true if items were written, false if there is not enough space (overrun).
+ */
+bool furi_spsc_ring_push(FuriSpscRing* ring, const void* items, size_t count);
+
+/**
+ * @brief Pop items from the ring without waiting. Consumer side.
+ *
+ * @param ring The ring instance.
+ * @param items Pointer to the output buffer.
+ * @param count Capacity of the output buffer in items.
+ * @return Amount of items read.
+ */
+size_t furi_spsc_ring_pop(FuriSpscRing* ring, void* items, size_t count);
+
+/**
+ * @brief Pop items from the ring, waiting for the watermark. Consumer side.
+ * Waits until the watermark amount of items is queued or timeout expires,
+ * then reads up to count items.
+ * Must be called from the consumer thread set with furi_spsc_ring_set_consumer.
+ *
+ * @param ring The ring instance.
+ * @param items Pointer to the output buffer.
+ * @param count Capacity of the output buffer in items.
+ * @param timeout Maximum time to wait in ticks.
+ * @return Amount of items read, 0 on timeout with empty ring.
+ */
+size_t furi_spsc_ring_receive(FuriSpscRing* ring, void* items, size_t count, uint32_t timeout);
+
+/**
+ * @brief Get amount of queued items.
+ *
+ * @param ring The ring instance.
+ * @return Amount of items that can be read.
+ */
+size_t furi_spsc_ring_get_count(FuriSpscRing* ring);
+
+/**
+ * @brief Get amount of failed pushes since allocation.
+ *
+ * @param ring The ring instance.
+ * @return Overrun counter, it is never reset.
+ */
+uint32_t furi_spsc_ring_get_overrun_count(FuriSpscRing* ring);
+
+/**
+ * @brief Drop all queued items. Consumer side.
+ *
+ * @param ring The ring instance.
+ */
+void furi_spsc_ring_flush(FuriSpscRing* ring);
+
+#ifdef __cplusplus
+}
+#endif
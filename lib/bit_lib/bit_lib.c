@@ -1,5 +1,6 @@
 #include "bit_lib.h"
 #include <core/check.h>
+#include <toolbox/crc.h>
 #include <stdio.h>
 
 void bit_lib_push_bit(uint8_t* data, size_t data_size, bool bit) {
@@ -367,26 +368,16 @@ uint16_t bit_lib_crc8(
     bool ref_in,
     bool ref_out,
     uint8_t xor_out) {
-    uint8_t crc = init;
-
-    for(size_t i = 0; i < data_size; ++i) {
-        uint8_t byte = data[i];
-        if(ref_in) bit_lib_reverse_bits(&byte, 0, 8);
-        crc ^= byte;
-
-        for(size_t j = 8; j > 0; --j) {
-            if(crc & TOPBIT(8)) {
-                crc = (crc << 1) ^ polynom;
-            } else {
-                crc = (crc << 1);
-            }
-        }
-    }
-
-    if(ref_out) bit_lib_reverse_bits(&crc, 0, 8);
-    crc ^= xor_out;
-
-    return crc;
+    const CrcModel model = {
+        .width = 8,
+        .ref_in = ref_in,
+        .ref_out = ref_out,
+        .poly = polynom,
+        .init = init,
+        .xor_out = xor_out,
+    };
+
+    return crc_calculate(&model, data, data_size);
 }
 
 uint16_t bit_lib_crc16(
@@ -397,24 +388,16 @@ uint16_t bit_lib_crc16(
     bool ref_in,
     bool ref_out,
     uint16_t xor_out) {
-    uint16_t crc = init;
-
-    for(size_t i = 0; i < data_size; ++i) {
-        uint8_t byte = data[i];
-        if(ref_in) byte = bit_lib_reverse_16_fast(byte) >> 8;
-
-        for(size_t j = 0; j < 8; ++j) {
-            bool c15 = (crc >> 15 & 1);
-            bool bit = (byte >> (7 - j) & 1);
-            crc <<= 1;
-            if(c15 ^ bit) crc ^= polynom;
-        }
-    }
-
-    if(ref_out) crc = bit_lib_reverse_16_fast(crc);
-    crc ^= xor_out;
-
-    return crc;
+    const CrcModel model = {
+        .width = 16,
+        .ref_in = ref_in,
+        .ref_out = ref_out,
+        .poly = polynom,
+        .init = init,
+        .xor_out = xor_out,
+    };
+
+    return crc_calculate(&model, data, data_size);
 }
 
 void bit_lib_num_to_bytes_be(uint64_t src, uint8_t len, uint8_t* dest) {
@@ -12,6 +12,7 @@
 struct FlipperFormat {
     Stream* stream;
     bool strict_mode;
+    FlipperStreamKeyIndex* key_index;
 };
 
 static const char* const flipper_format_filetype_key = "Filetype";
@@ -21,6 +22,27 @@ Stream* flipper_format_get_raw_stream(FlipperFormat* flipper_format) {
     return flipper_format->stream;
 }
 
+static void flipper_format_key_index_reset(FlipperFormat* flipper_format) {
+    if(flipper_format->key_index) {
+        flipper_format_stream_key_index_reset(flipper_format->key_index);
+    }
+}
+
+// All writes go through these, so key index is dropped on any content change
+static bool
+    flipper_format_write_value_line(FlipperFormat* flipper_format, FlipperStreamWriteData* data) {
+    flipper_format_key_index_reset(flipper_format);
+    return flipper_format_stream_write_value_line(flipper_format->stream, data);
+}
+
+static bool flipper_format_delete_key_and_write(
+    FlipperFormat* flipper_format,
+    FlipperStreamWriteData* data) {
+    flipper_format_key_index_reset(flipper_format);
+    return flipper_format_stream_delete_key_and_write(
+        flipper_format->stream, data, flipper_format->strict_mode);
+}
+
 /********************************** Public **********************************/
 
 FlipperFormat* flipper_format_string_alloc(void) {
@@ -46,17 +68,20 @@ FlipperFormat* flipper_format_buffered_file_alloc(Storage* storage) {
 
 bool flipper_format_file_open_existing(FlipperFormat* flipper_format, const char* path) {
     furi_check(flipper_format);
+    flipper_format_key_index_reset(flipper_format);
     return file_stream_open(flipper_format->stream, path, FSAM_READ_WRITE, FSOM_OPEN_EXISTING);
 }
 
 bool flipper_format_buffered_file_open_existing(FlipperFormat* flipper_format, const char* path) {
     furi_check(flipper_format);
+    flipper_format_key_index_reset(flipper_format);
     return buffered_file_stream_open(
         flipper_format->stream, path, FSAM_READ_WRITE, FSOM_OPEN_EXISTING);
 }
 
 bool flipper_format_file_open_append(FlipperFormat* flipper_format, const char* path) {
     furi_check(flipper_format);
+    flipper_format_key_index_reset(flipper_format);
 
     bool result =
         file_stream_open(flipper_format->stream, path, FSAM_READ_WRITE, FSOM_OPEN_APPEND);
@@ -88,32 +113,40 @@ bool flipper_format_file_open_append(FlipperFormat* flipper_format, const char*
 
 bool flipper_format_file_open_always(FlipperFormat* flipper_format, const char* path) {
     furi_check(flipper_format);
+    flipper_format_key_index_reset(flipper_format);
     return file_stream_open(flipper_format->stream, path, FSAM_READ_WRITE, FSOM_CREATE_ALWAYS);
 }
 
 bool flipper_format_buffered_file_open_always(FlipperFormat* flipper_format, const char* path) {
     furi_check(flipper_format);
+    flipper_format_key_index_reset(flipper_format);
     return buffered_file_stream_open(
         flipper_format->stream, path, FSAM_READ_WRITE, FSOM_CREATE_ALWAYS);
 }
 
 bool flipper_format_file_open_new(FlipperFormat* flipper_format, const char* path) {
     furi_check(flipper_format);
+    flipper_format_key_index_reset(flipper_format);
     return file_stream_open(flipper_format->stream, path, FSAM_READ_WRITE, FSOM_CREATE_NEW);
 }
 
 bool flipper_format_file_close(FlipperFormat* flipper_format) {
     furi_check(flipper_format);
+    flipper_format_key_index_reset(flipper_format);
     return file_stream_close(flipper_format->stream);
 }
 
 bool flipper_format_buffered_file_close(FlipperFormat* flipper_format) {
     furi_check(flipper_format);
+    flipper_format_key_index_reset(flipper_format);
     return buffered_file_stream_close(flipper_format->stream);
 }
 
 void flipper_format_free(FlipperFormat* flipper_format) {
     furi_check(flipper_format);
+    if(flipper_format->key_index) {
+        flipper_format_stream_key_index_free(flipper_format->key_index);
+    }
     stream_free(flipper_format->stream);
     free(flipper_format);
 }
@@ -122,6 +155,17 @@ void flipper_format_set_strict_mode(FlipperFormat* flipper_format, bool strict_m
     flipper_format->strict_mode = strict_mode;
 }
 
+void flipper_format_set_key_index(FlipperFormat* flipper_format, bool enable) {
+    furi_check(flipper_format);
+
+    if(enable && !flipper_format->key_index) {
+        flipper_format->key_index = flipper_format_stream_key_index_alloc();
+    } else if(!enable && flipper_format->key_index) {
+        flipper_format_stream_key_index_free(flipper_format->key_index);
+        flipper_format->key_index = NULL;
+    }
+}
+
 bool flipper_format_rewind(FlipperFormat* flipper_format) {
     furi_check(flipper_format);
     return stream_rewind(flipper_format->stream);
@@ -135,7 +179,8 @@ bool flipper_format_seek_to_end(FlipperFormat* flipper_format) {
 bool flipper_format_key_exist(FlipperFormat* flipper_format, const char* key) {
     size_t pos = stream_tell(flipper_format->stream);
     stream_seek(flipper_format->stream, 0, StreamOffsetFromStart);
-    bool result = flipper_format_stream_seek_to_key(flipper_format->stream, key, false);
+    bool result = flipper_format_stream_seek_to_key_indexed(
+        flipper_format->stream, flipper_format->key_index, key, false);
     stream_seek(flipper_format->stream, pos, StreamOffsetFromStart);
 
     return result;
@@ -174,14 +219,24 @@ bool flipper_format_get_value_count(
     const char* key,
     uint32_t* count) {
     furi_check(flipper_format);
-    return flipper_format_stream_get_value_count(
-        flipper_format->stream, key, count, flipper_format->strict_mode);
+    return flipper_format_stream_get_value_count_indexed(
+        flipper_format->stream,
+        flipper_format->key_index,
+        key,
+        count,
+        flipper_format->strict_mode);
 }
 
 bool flipper_format_read_string(FlipperFormat* flipper_format, const char* key, FuriString* data) {
     furi_check(flipper_format);
-    return flipper_format_stream_read_value_line(
-        flipper_format->stream, key, FlipperStreamValueStr, data, 1, flipper_format->strict_mode);
+    return flipper_format_stream_read_value_line_indexed(
+        flipper_format->stream,
+        flipper_format->key_index,
+        key,
+        FlipperStreamValueStr,
+        data,
+        1,
+        flipper_format->strict_mode);
 }
 
 bool flipper_format_write_string(FlipperFormat* flipper_format, const char* key, FuriString* data) {
@@ -192,7 +247,7 @@ bool flipper_format_write_string(FlipperFormat* flipper_format, const char* key,
         .data = furi_string_get_cstr(data),
         .data_size = 1,
     };
-    bool result = flipper_format_stream_write_value_line(flipper_format->stream, &write_data);
+    bool result = flipper_format_write_value_line(flipper_format, &write_data);
     return result;
 }
 
@@ -207,7 +262,7 @@ bool flipper_format_write_string_cstr(
         .data = data,
         .data_size = 1,
     };
-    bool result = flipper_format_stream_write_value_line(flipper_format->stream, &write_data);
+    bool result = flipper_format_write_value_line(flipper_format, &write_data);
     return result;
 }
 
@@ -217,8 +272,9 @@ bool flipper_format_read_hex_uint64(
     uint64_t* data,
     const uint16_t data_size) {
     furi_check(flipper_format);
-    return flipper_format_stream_read_value_line(
+    return flipper_format_stream_read_value_line_indexed(
         flipper_format->stream,
+        flipper_format->key_index,
         key,
         FlipperStreamValueHexUint64,
         data,
@@ -238,7 +294,7 @@ bool flipper_format_write_hex_uint64(
         .data = data,
         .data_size = data_size,
     };
-    bool result = flipper_format_stream_write_value_line(flipper_format->stream, &write_data);
+    bool result = flipper_format_write_value_line(flipper_format, &write_data);
     return result;
 }
 
@@ -248,8 +304,9 @@ bool flipper_format_read_uint32(
     uint32_t* data,
     const uint16_t data_size) {
     furi_check(flipper_format);
-    return flipper_format_stream_read_value_line(
+    return flipper_format_stream_read_value_line_indexed(
         flipper_format->stream,
+        flipper_format->key_index,
         key,
         FlipperStreamValueUint32,
         data,
@@ -269,7 +326,7 @@ bool flipper_format_write_uint32(
         .data = data,
         .data_size = data_size,
     };
-    bool result = flipper_format_stream_write_value_line(flipper_format->stream, &write_data);
+    bool result = flipper_format_write_value_line(flipper_format, &write_data);
     return result;
 }
 
@@ -278,8 +335,9 @@ bool flipper_format_read_int32(
     const char* key,
     int32_t* data,
     const uint16_t data_size) {
-    return flipper_format_stream_read_value_line(
+    return flipper_format_stream_read_value_line_indexed(
         flipper_format->stream,
+        flipper_format->key_index,
         key,
         FlipperStreamValueInt32,
         data,
@@ -299,7 +357,7 @@ bool flipper_format_write_int32(
         .data = data,
         .data_size = data_size,
     };
-    bool result = flipper_format_stream_write_value_line(flipper_format->stream, &write_data);
+    bool result = flipper_format_write_value_line(flipper_format, &write_data);
     return result;
 }
 
@@ -308,8 +366,9 @@ bool flipper_format_read_bool(
     const char* key,
     bool* data,
     const uint16_t data_size) {
-    return flipper_format_stream_read_value_line(
+    return flipper_format_stream_read_value_line_indexed(
         flipper_format->stream,
+        flipper_format->key_index,
         key,
         FlipperStreamValueBool,
         data,
@@ -329,7 +388,7 @@ bool flipper_format_write_bool(
         .data = data,
         .data_size = data_size,
     };
-    bool result = flipper_format_stream_write_value_line(flipper_format->stream, &write_data);
+    bool result = flipper_format_write_value_line(flipper_format, &write_data);
     return result;
 }
 
@@ -338,8 +397,9 @@ bool flipper_format_read_float(
     const char* key,
     float* data,
     const uint16_t data_size) {
-    return flipper_format_stream_read_value_line(
+    return flipper_format_stream_read_value_line_indexed(
         flipper_format->stream,
+        flipper_format->key_index,
         key,
         FlipperStreamValueFloat,
         data,
@@ -359,7 +419,7 @@ bool flipper_format_write_float(
         .data = data,
         .data_size = data_size,
     };
-    bool result = flipper_format_stream_write_value_line(flipper_format->stream, &write_data);
+    bool result = flipper_format_write_value_line(flipper_format, &write_data);
     return result;
 }
 
@@ -368,8 +428,9 @@ bool flipper_format_read_hex(
     const char* key,
     uint8_t* data,
     const uint16_t data_size) {
-    return flipper_format_stream_read_value_line(
+    return flipper_format_stream_read_value_line_indexed(
         flipper_format->stream,
+        flipper_format->key_index,
         key,
         FlipperStreamValueHex,
         data,
@@ -389,7 +450,7 @@ bool flipper_format_write_hex(
         .data = data,
         .data_size = data_size,
     };
-    bool result = flipper_format_stream_write_value_line(flipper_format->stream, &write_data);
+    bool result = flipper_format_write_value_line(flipper_format, &write_data);
     return result;
 }
 
@@ -400,6 +461,7 @@ bool flipper_format_write_comment(FlipperFormat* flipper_format, FuriString* dat
 
 bool flipper_format_write_comment_cstr(FlipperFormat* flipper_format, const char* data) {
     furi_check(flipper_format);
+    flipper_format_key_index_reset(flipper_format);
     return flipper_format_stream_write_comment_cstr(flipper_format->stream, data);
 }
 
@@ -411,8 +473,7 @@ bool flipper_format_delete_key(FlipperFormat* flipper_format, const char* key) {
         .data = NULL,
         .data_size = 0,
     };
-    bool result = flipper_format_stream_delete_key_and_write(
-        flipper_format->stream, &write_data, flipper_format->strict_mode);
+    bool result = flipper_format_delete_key_and_write(flipper_format, &write_data);
     return result;
 }
 
@@ -424,8 +485,7 @@ bool flipper_format_update_string(FlipperFormat* flipper_format, const char* key
         .data = furi_string_get_cstr(data),
         .data_size = 1,
     };
-    bool result = flipper_format_stream_delete_key_and_write(
-        flipper_format->stream, &write_data, flipper_format->strict_mode);
+    bool result = flipper_format_delete_key_and_write(flipper_format, &write_data);
     return result;
 }
 
@@ -440,8 +500,7 @@ bool flipper_format_update_string_cstr(
         .data = data,
         .data_size = 1,
     };
-    bool result = flipper_format_stream_delete_key_and_write(
-        flipper_format->stream, &write_data, flipper_format->strict_mode);
+    bool result = flipper_format_delete_key_and_write(flipper_format, &write_data);
     return result;
 }
 
@@ -457,8 +516,7 @@ bool flipper_format_update_uint32(
         .data = data,
         .data_size = data_size,
     };
-    bool result = flipper_format_stream_delete_key_and_write(
-        flipper_format->stream, &write_data, flipper_format->strict_mode);
+    bool result = flipper_format_delete_key_and_write(flipper_format, &write_data);
     return result;
 }
 
@@ -473,8 +531,7 @@ bool flipper_format_update_int32(
         .data = data,
         .data_size = data_size,
     };
-    bool result = flipper_format_stream_delete_key_and_write(
-        flipper_format->stream, &write_data, flipper_format->strict_mode);
+    bool result = flipper_format_delete_key_and_write(flipper_format, &write_data);
     return result;
 }
 
@@ -489,8 +546,7 @@ bool flipper_format_update_bool(
         .data = data,
         .data_size = data_size,
     };
-    bool result = flipper_format_stream_delete_key_and_write(
-        flipper_format->stream, &write_data, flipper_format->strict_mode);
+    bool result = flipper_format_delete_key_and_write(flipper_format, &write_data);
     return result;
 }
 
@@ -505,8 +561,7 @@ bool flipper_format_update_float(
         .data = data,
         .data_size = data_size,
     };
-    bool result = flipper_format_stream_delete_key_and_write(
-        flipper_format->stream, &write_data, flipper_format->strict_mode);
+    bool result = flipper_format_delete_key_and_write(flipper_format, &write_data);
     return result;
 }
 
@@ -521,8 +576,7 @@ bool flipper_format_update_hex(
         .data = data,
         .data_size = data_size,
     };
-    bool result = flipper_format_stream_delete_key_and_write(
-        flipper_format->stream, &write_data, flipper_format->strict_mode);
+    bool result = flipper_format_delete_key_and_write(flipper_format, &write_data);
     return result;
 }
 
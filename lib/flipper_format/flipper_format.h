@@ -208,6 +208,22 @@ void flipper_format_free(FlipperFormat* flipper_format);
  */
 void flipper_format_set_strict_mode(FlipperFormat* flipper_format, bool strict_mode);
 
+/** Enable key index.
+ *
+ * Index of all keys is built with one pass over the file on the first key
+ * lookup, following lookups jump to the key instead of scanning the file.
+ * Useful for files with many keys read out of order or with missing keys.
+ * Index is dropped on every write, so it only costs memory while reading.
+ * Disabled by default.
+ *
+ * @warning    Writes to the raw stream are not tracked, disable the index
+ *             before using flipper_format_get_raw_stream() for writing.
+ *
+ * @param      flipper_format  Pointer to a FlipperFormat instance
+ * @param      enable          True to enable key index
+ */
+void flipper_format_set_key_index(FlipperFormat* flipper_format, bool enable);
+
 /** Rewind the RW pointer.
  *
  * @param      flipper_format  Pointer to a FlipperFormat instance
@@ -98,7 +98,7 @@ static bool flipper_format_stream_read_valid_key(Stream* stream, FuriString* key
     return found;
 }
 
-bool flipper_format_stream_seek_to_key(Stream* stream, const char* key, bool strict_mode) {
+static bool flipper_format_stream_scan_to_key(Stream* stream, const char* key, bool strict_mode) {
     bool found = false;
     FuriString* read_key;
 
@@ -122,73 +122,494 @@ bool flipper_format_stream_seek_to_key(Stream* stream, const char* key, bool str
     return found;
 }
 
-static bool flipper_format_stream_read_value(Stream* stream, FuriString* value, bool* last) {
+/******************************** Key index *********************************/
+
+#define FLIPPER_STREAM_KEY_INDEX_BUCKETS     64
+#define FLIPPER_STREAM_KEY_INDEX_MAX_ENTRIES (UINT16_MAX - 1)
+#define FLIPPER_STREAM_KEY_INDEX_NONE        UINT16_MAX
+
+typedef struct {
+    uint32_t hash;
+    uint32_t line_start; // Offset of the line with the key
+    uint32_t delimiter; // Offset of the delimiter after the key
+    uint16_t key_length; // Key length without CR characters
+    uint16_t next; // Next entry in the same bucket, entries are in file order
+} FlipperStreamKeyIndexEntry;
+
+struct FlipperStreamKeyIndex {
+    FlipperStreamKeyIndexEntry* entries;
+    size_t count;
+    size_t capacity;
+    uint16_t buckets[FLIPPER_STREAM_KEY_INDEX_BUCKETS];
+    bool built;
+    bool usable;
+};
+
+#define FLIPPER_STREAM_KEY_HASH_INIT 2166136261UL
+
+static inline uint32_t flipper_format_stream_key_hash_push(uint32_t hash, char c) {
+    return (hash ^ (uint8_t)c) * 16777619UL;
+}
+
+static uint32_t flipper_format_stream_key_hash(const char* key, size_t* length) {
+    uint32_t hash = FLIPPER_STREAM_KEY_HASH_INIT;
+    const char* c = key;
+    for(; *c; c++) {
+        hash = flipper_format_stream_key_hash_push(hash, *c);
+    }
+    *length = c - key;
+    return hash;
+}
+
+FlipperStreamKeyIndex* flipper_format_stream_key_index_alloc(void) {
+    FlipperStreamKeyIndex* index = malloc(sizeof(FlipperStreamKeyIndex));
+    return index;
+}
+
+void flipper_format_stream_key_index_free(FlipperStreamKeyIndex* index) {
+    furi_check(index);
+    free(index->entries);
+    free(index);
+}
+
+void flipper_format_stream_key_index_reset(FlipperStreamKeyIndex* index) {
+    furi_check(index);
+    index->count = 0;
+    index->built = false;
+}
+
+static bool flipper_format_stream_key_index_add(
+    FlipperStreamKeyIndex* index,
+    uint32_t hash,
+    uint32_t line_start,
+    uint32_t delimiter,
+    size_t key_length,
+    uint16_t* tails) {
+    if(index->count == FLIPPER_STREAM_KEY_INDEX_MAX_ENTRIES || key_length > UINT16_MAX) {
+        return false;
+    }
+
+    if(index->count == index->capacity) {
+        index->capacity = index->capacity ? index->capacity * 2 : 32;
+        index->entries =
+            realloc(index->entries, index->capacity * sizeof(FlipperStreamKeyIndexEntry));
+    }
+
+    uint16_t entry_id = index->count++;
+    FlipperStreamKeyIndexEntry* entry = &index->entries[entry_id];
+    entry->hash = hash;
+    entry->line_start = line_start;
+    entry->delimiter = delimiter;
+    entry->key_length = key_length;
+    entry->next = FLIPPER_STREAM_KEY_INDEX_NONE;
+
+    size_t bucket = hash % FLIPPER_STREAM_KEY_INDEX_BUCKETS;
+    if(tails[bucket] == FLIPPER_STREAM_KEY_INDEX_NONE) {
+        index->buckets[bucket] = entry_id;
+    } else {
+        index->entries[tails[bucket]].next = entry_id;
+    }
+    tails[bucket] = entry_id;
+
+    return true;
+}
+
+/**
+ * Scan the whole stream once, finding keys the same way as
+ * flipper_format_stream_read_valid_key() does when started at a line start
+ */
+static void flipper_format_stream_key_index_build(Stream* stream, FlipperStreamKeyIndex* index) {
+    const size_t buffer_size = 64;
+    uint8_t buffer[buffer_size];
+    uint16_t tails[FLIPPER_STREAM_KEY_INDEX_BUCKETS];
+
+    index->count = 0;
+    index->built = true;
+    index->usable = false;
+    memset(index->buckets, 0xFF, sizeof(index->buckets));
+    memset(tails, 0xFF, sizeof(tails));
+
+    size_t position = stream_tell(stream);
+    if(!stream_rewind(stream)) return;
+
+    bool usable = true;
+    bool accumulate = true;
+    bool new_line = true;
+    uint32_t hash = FLIPPER_STREAM_KEY_HASH_INIT;
+    size_t key_length = 0;
+    uint32_t line_start = 0;
+    uint32_t offset = 0;
+
+    while(usable) {
+        size_t was_read = stream_read(stream, buffer, buffer_size);
+        if(was_read == 0) break;
+
+        for(size_t i = 0; i < was_read && usable; i++, offset++) {
+            uint8_t data = buffer[i];
+            if(data == flipper_format_eoln) {
+                accumulate = true;
+                new_line = true;
+                hash = FLIPPER_STREAM_KEY_HASH_INIT;
+                key_length = 0;
+                line_start = offset + 1;
+            } else if(data == flipper_format_eolr) {
+                // ignore
+            } else if(data == flipper_format_comment && new_line) {
+                accumulate = false;
+                new_line = false;
+            } else if(data == flipper_format_delimiter) {
+                if(accumulate && !new_line) {
+                    usable = flipper_format_stream_key_index_add(
+                        index, hash, line_start, offset, key_length, tails);
+                }
+                // Rest of the line is a value
+                accumulate = false;
+                new_line = false;
+            } else {
+                new_line = false;
+                if(accumulate) {
+                    hash = flipper_format_stream_key_hash_push(hash, data);
+                    key_length++;
+                }
+            }
+        }
+    }
+
+    index->usable = usable && stream_eof(stream);
+    if(!stream_seek(stream, position, StreamOffsetFromStart)) {
+        index->usable = false;
+    }
+}
+
+/** First entry with line_start >= position */
+static size_t flipper_format_stream_key_index_lower_bound(
+    const FlipperStreamKeyIndex* index,
+    size_t position) {
+    size_t low = 0;
+    size_t high = index->count;
+    while(low < high) {
+        size_t middle = (low + high) / 2;
+        if(index->entries[middle].line_start < position) {
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+    return low;
+}
+
+/** Compare key in the stream with the given key, CR characters are skipped as in the scan */
+static bool flipper_format_stream_key_index_verify(
+    Stream* stream,
+    const FlipperStreamKeyIndexEntry* entry,
+    const char* key) {
+    const size_t buffer_size = 32;
+    uint8_t buffer[buffer_size];
+
+    if(!stream_seek(stream, entry->line_start, StreamOffsetFromStart)) return false;
+
+    size_t remaining = entry->delimiter - entry->line_start;
+    while(remaining) {
+        size_t was_read = stream_read(stream, buffer, MIN(remaining, buffer_size));
+        if(was_read == 0) return false;
+        remaining -= was_read;
+
+        for(size_t i = 0; i < was_read; i++) {
+            if(buffer[i] == flipper_format_eolr) continue;
+            if(buffer[i] != (uint8_t)*key) return false;
+            key++;
+        }
+    }
+
+    return *key == '\0';
+}
+
+typedef enum {
+    FlipperStreamKeyIndexFound,
+    FlipperStreamKeyIndexNotFound,
+    FlipperStreamKeyIndexFallback, // Index can't answer, stream position is unchanged
+} FlipperStreamKeyIndexResult;
+
+static FlipperStreamKeyIndexResult flipper_format_stream_key_index_seek(
+    Stream* stream,
+    FlipperStreamKeyIndex* index,
+    const char* key,
+    bool strict_mode) {
+    if(!index->built) flipper_format_stream_key_index_build(stream, index);
+    if(!index->usable) return FlipperStreamKeyIndexFallback;
+
+    // Scan only finds the same keys as the index if it starts at a line boundary
+    size_t position = stream_tell(stream);
+    size_t first = flipper_format_stream_key_index_lower_bound(index, position);
+    if(position != 0) {
+        bool at_line_start = first < index->count &&
+                             index->entries[first].line_start == position;
+        bool at_line_end = first < index->count &&
+                           index->entries[first].line_start == position + 1;
+        if(!at_line_start && !at_line_end) return FlipperStreamKeyIndexFallback;
+    }
+
+    size_t key_length;
+    uint32_t hash = flipper_format_stream_key_hash(key, &key_length);
+
+    const FlipperStreamKeyIndexEntry* entry = NULL;
+    if(strict_mode) {
+        if(first < index->count) entry = &index->entries[first];
+    } else {
+        uint16_t entry_id = index->buckets[hash % FLIPPER_STREAM_KEY_INDEX_BUCKETS];
+        while(entry_id != FLIPPER_STREAM_KEY_INDEX_NONE) {
+            const FlipperStreamKeyIndexEntry* candidate = &index->entries[entry_id];
+            if(candidate->line_start >= position && candidate->hash == hash &&
+               candidate->key_length == key_length) {
+                entry = candidate;
+                break;
+            }
+            entry_id = candidate->next;
+        }
+    }
+
+    if(entry == NULL) {
+        // Scan would stop at the end of the stream
+        stream_seek(stream, 0, StreamOffsetFromEnd);
+        return FlipperStreamKeyIndexNotFound;
+    }
+
+    if(entry->hash == hash && entry->key_length == key_length) {
+        if(!flipper_format_stream_key_index_verify(stream, entry, key)) {
+            // Hash collision, let the scan sort it out
+            stream_seek(stream, position, StreamOffsetFromStart);
+            return FlipperStreamKeyIndexFallback;
+        }
+        if(stream_seek(stream, entry->delimiter + 2, StreamOffsetFromStart)) {
+            return FlipperStreamKeyIndexFound;
+        }
+    }
+
+    // Strict mode mismatch or value past the end: scan would stop at the delimiter
+    stream_seek(stream, entry->delimiter, StreamOffsetFromStart);
+    return FlipperStreamKeyIndexNotFound;
+}
+
+bool flipper_format_stream_seek_to_key_indexed(
+    Stream* stream,
+    FlipperStreamKeyIndex* index,
+    const char* key,
+    bool strict_mode) {
+    if(index) {
+        FlipperStreamKeyIndexResult result =
+            flipper_format_stream_key_index_seek(stream, index, key, strict_mode);
+        if(result != FlipperStreamKeyIndexFallback) {
+            return result == FlipperStreamKeyIndexFound;
+        }
+    }
+
+    return flipper_format_stream_scan_to_key(stream, key, strict_mode);
+}
+
+bool flipper_format_stream_seek_to_key(Stream* stream, const char* key, bool strict_mode) {
+    return flipper_format_stream_seek_to_key_indexed(stream, NULL, key, strict_mode);
+}
+
+#define FLIPPER_STREAM_READER_BUFFER_SIZE 128U
+#define FLIPPER_STREAM_READER_TOKEN_SIZE  32U
+
+/** Value reader, parses values right from a chunk of the stream */
+typedef struct {
+    Stream* stream;
+    size_t size;
+    size_t position;
+    size_t token_length;
+    FuriString* long_token;
+    char token[FLIPPER_STREAM_READER_TOKEN_SIZE];
+    uint8_t buffer[FLIPPER_STREAM_READER_BUFFER_SIZE];
+} FlipperStreamReader;
+
+static void flipper_format_stream_reader_init(FlipperStreamReader* reader, Stream* stream) {
+    reader->stream = stream;
+    reader->size = 0;
+    reader->position = 0;
+    reader->token_length = 0;
+    reader->long_token = NULL;
+}
+
+/** Return the unparsed part of the chunk back to the stream */
+static bool flipper_format_stream_reader_finish(FlipperStreamReader* reader) {
+    bool result = true;
+    if(reader->position < reader->size) {
+        result = stream_seek(
+            reader->stream, -(int32_t)(reader->size - reader->position), StreamOffsetFromCurrent);
+    }
+    reader->size = 0;
+    reader->position = 0;
+
+    if(reader->long_token) {
+        furi_string_free(reader->long_token);
+        reader->long_token = NULL;
+    }
+
+    return result;
+}
+
+static inline void flipper_format_stream_reader_push(FlipperStreamReader* reader, char c) {
+    if(reader->token_length < FLIPPER_STREAM_READER_TOKEN_SIZE - 1) {
+        reader->token[reader->token_length] = c;
+    } else {
+        // Rare long values, keep them whole to get the same result as before
+        if(!reader->long_token) reader->long_token = furi_string_alloc();
+        if(reader->token_length == FLIPPER_STREAM_READER_TOKEN_SIZE - 1) {
+            furi_string_set_strn(reader->long_token, reader->token, reader->token_length);
+        }
+        furi_string_push_back(reader->long_token, c);
+    }
+    reader->token_length++;
+}
+
+static const char* flipper_format_stream_reader_token(FlipperStreamReader* reader) {
+    if(reader->token_length < FLIPPER_STREAM_READER_TOKEN_SIZE) {
+        reader->token[reader->token_length] = '\0';
+        return reader->token;
+    } else {
+        return furi_string_get_cstr(reader->long_token);
+    }
+}
+
+/**
+ * Read next value of the line
+ * @param reader Pointer to a FlipperStreamReader instance
+ * @param store store value characters, otherwise only skip them
+ * @param last set to true if this is the last value of the line
+ * @return true on success, false if there is no value
+ */
+static bool
+    flipper_format_stream_reader_next(FlipperStreamReader* reader, bool store, bool* last) {
     enum {
         LeadingSpace,
         ReadValue,
         TrailingSpace
     } state = LeadingSpace;
-    const size_t buffer_size = 32;
-    uint8_t buffer[buffer_size];
     bool result = false;
-    bool error = false;
 
-    furi_string_reset(value);
+    reader->token_length = 0;
 
     while(true) {
-        size_t was_read = stream_read(stream, buffer, buffer_size);
+        if(reader->position == reader->size) {
+            reader->size =
+                stream_read(reader->stream, reader->buffer, FLIPPER_STREAM_READER_BUFFER_SIZE);
+            reader->position = 0;
 
-        if(was_read == 0) {
-            if(state != LeadingSpace && stream_eof(stream)) {
-                result = true;
-                *last = true;
-            } else {
-                error = true;
+            if(reader->size == 0) {
+                if(state != LeadingSpace && stream_eof(reader->stream)) {
+                    result = true;
+                    *last = true;
+                }
+                break;
             }
         }
 
-        for(uint16_t i = 0; i < was_read; i++) {
-            const uint8_t data = buffer[i];
+        const uint8_t data = reader->buffer[reader->position];
 
-            if(state == LeadingSpace) {
-                if(flipper_format_stream_is_space(data)) {
-                    continue;
-                } else if(data == flipper_format_eoln) {
-                    stream_seek(stream, i - was_read, StreamOffsetFromCurrent);
-                    error = true;
-                    break;
-                } else {
-                    state = ReadValue;
-                    furi_string_push_back(value, data);
-                }
-            } else if(state == ReadValue) {
-                if(flipper_format_stream_is_space(data)) {
-                    state = TrailingSpace;
-                } else if(data == flipper_format_eoln) {
-                    if(!stream_seek(stream, i - was_read, StreamOffsetFromCurrent)) {
-                        error = true;
-                    } else {
-                        result = true;
-                        *last = true;
-                    }
-                    break;
-                } else {
-                    furi_string_push_back(value, data);
-                }
-            } else if(state == TrailingSpace) {
-                if(flipper_format_stream_is_space(data)) {
-                    continue;
-                } else if(!stream_seek(stream, i - was_read, StreamOffsetFromCurrent)) {
-                    error = true;
-                } else {
-                    *last = (data == flipper_format_eoln);
-                    result = true;
-                }
+        if(state == LeadingSpace) {
+            if(data == flipper_format_eoln) break;
+            if(!flipper_format_stream_is_space(data)) {
+                state = ReadValue;
+                if(store) flipper_format_stream_reader_push(reader, data);
+            }
+        } else if(state == ReadValue) {
+            if(data == flipper_format_eoln) {
+                result = true;
+                *last = true;
                 break;
+            } else if(flipper_format_stream_is_space(data)) {
+                state = TrailingSpace;
+            } else {
+                if(store) flipper_format_stream_reader_push(reader, data);
             }
+        } else if(!flipper_format_stream_is_space(data)) {
+            result = true;
+            *last = (data == flipper_format_eoln);
+            break;
         }
 
-        if(error || result) break;
+        reader->position++;
+    }
+
+    return result;
+}
+
+/**
+ * Parse "XX " byte in the middle of a line right from the chunk
+ * @return true on success, false if the generic path must be used
+ */
+static inline bool
+    flipper_format_stream_reader_hex_byte(FlipperStreamReader* reader, uint8_t* value) {
+    if(reader->size - reader->position < 4) return false;
+
+    const uint8_t* data = &reader->buffer[reader->position];
+    if(data[2] != ' ' || data[3] == flipper_format_eoln ||
+       flipper_format_stream_is_space(data[3])) {
+        return false;
+    }
+
+    uint8_t hi, low;
+    if(!hex_char_to_hex_nibble(data[0], &hi) || !hex_char_to_hex_nibble(data[1], &low)) {
+        return false;
+    }
+
+    *value = (hi << 4) | low;
+    reader->position += 3;
+    return true;
+}
+
+static bool flipper_format_stream_parse_value(
+    FlipperStreamValue type,
+    const char* value,
+    size_t value_length,
+    void* _data,
+    size_t index) {
+    bool result = false;
+
+    switch(type) {
+    case FlipperStreamValueHex: {
+        uint8_t* data = _data;
+        if(value_length >= 2) {
+            // sscanf "%02X" does not work here
+            result = hex_char_to_uint8(value[0], value[1], &data[index]);
+        }
+    }; break;
+#ifndef FLIPPER_STREAM_LITE
+    case FlipperStreamValueFloat: {
+        float* data = _data;
+        // newlib-nano does not have sscanf for floats
+        // scan_values = sscanf(value, "%f", &data[index]);
+        char* end_char;
+        data[index] = strtof(value, &end_char);
+        if(*end_char == 0) {
+            // most likely ok
+            result = true;
+        }
+    }; break;
+#endif
+    case FlipperStreamValueInt32: {
+        int32_t* data = _data;
+        result = strint_to_int32(value, NULL, &data[index], 10) == StrintParseNoError;
+    }; break;
+    case FlipperStreamValueUint32: {
+        uint32_t* data = _data;
+        result = strint_to_uint32(value, NULL, &data[index], 10) == StrintParseNoError;
+    }; break;
+    case FlipperStreamValueHexUint64: {
+        uint64_t* data = _data;
+        if(value_length >= 16) {
+            result = hex_chars_to_uint64(value, &data[index]);
+        }
+    }; break;
+    case FlipperStreamValueBool: {
+        bool* data = _data;
+        data[index] = !strcasecmp(value, "true");
+        result = true;
+    }; break;
+    default:
+        furi_crash("Unknown FF type");
     }
 
     return result;
@@ -266,75 +687,110 @@ static bool flipper_format_stream_seek_to_next_line(Stream* stream) {
     return result;
 }
 
+#define FLIPPER_STREAM_WRITER_BUFFER_SIZE 128U
+#define FLIPPER_STREAM_WRITER_VALUE_SIZE  64U
+
+/** Value writer, formats values into a chunk and writes it at once */
+typedef struct {
+    Stream* stream;
+    size_t size;
+    bool error;
+    char buffer[FLIPPER_STREAM_WRITER_BUFFER_SIZE];
+} FlipperStreamWriter;
+
+static void flipper_format_stream_writer_flush(FlipperStreamWriter* writer) {
+    if(writer->size && !writer->error) {
+        writer->error = !flipper_format_stream_write(writer->stream, writer->buffer, writer->size);
+    }
+    writer->size = 0;
+}
+
+/** Get space for a value of up to FLIPPER_STREAM_WRITER_VALUE_SIZE characters */
+static inline char* flipper_format_stream_writer_reserve(FlipperStreamWriter* writer) {
+    if(writer->size + FLIPPER_STREAM_WRITER_VALUE_SIZE > FLIPPER_STREAM_WRITER_BUFFER_SIZE) {
+        flipper_format_stream_writer_flush(writer);
+    }
+    return &writer->buffer[writer->size];
+}
+
 bool flipper_format_stream_write_value_line(Stream* stream, FlipperStreamWriteData* write_data) {
     bool result = false;
 
     if(write_data->type == FlipperStreamValueIgnore) {
         result = true;
     } else {
-        FuriString* value;
-        value = furi_string_alloc();
-
         do {
             if(!flipper_format_stream_write_key(stream, write_data->key)) break;
 
-            if(write_data->type == FlipperStreamValueStr) write_data->data_size = 1;
+            if(write_data->type == FlipperStreamValueStr) {
+                const char* data = write_data->data;
+                if(!flipper_format_stream_write(stream, data, strlen(data))) break;
+                if(!flipper_format_stream_write_eol(stream)) break;
+                result = true;
+                break;
+            }
+
+            FlipperStreamWriter writer = {.stream = stream};
+            const size_t value_size = FLIPPER_STREAM_WRITER_VALUE_SIZE;
+
+            for(size_t i = 0; i < write_data->data_size && !writer.error; i++) {
+                char* value = flipper_format_stream_writer_reserve(&writer);
+                int length = 0;
 
-            bool cycle_error = false;
-            for(uint16_t i = 0; i < write_data->data_size; i++) {
                 switch(write_data->type) {
-                case FlipperStreamValueStr: {
-                    const char* data = write_data->data;
-                    furi_string_printf(value, "%s", data);
-                }; break;
                 case FlipperStreamValueHex: {
                     const uint8_t* data = write_data->data;
-                    furi_string_printf(value, "%02X", data[i]);
+                    const char chars[] = "0123456789ABCDEF";
+                    value[0] = chars[data[i] >> 4];
+                    value[1] = chars[data[i] & 0xF];
+                    length = 2;
                 }; break;
 #ifndef FLIPPER_STREAM_LITE
                 case FlipperStreamValueFloat: {
                     const float* data = write_data->data;
-                    furi_string_printf(value, "%f", (double)data[i]);
+                    length = snprintf(value, value_size, "%f", (double)data[i]);
                 }; break;
 #endif
                 case FlipperStreamValueInt32: {
                     const int32_t* data = write_data->data;
-                    furi_string_printf(value, "%" PRIi32, data[i]);
+                    length = snprintf(value, value_size, "%" PRIi32, data[i]);
                 }; break;
                 case FlipperStreamValueUint32: {
                     const uint32_t* data = write_data->data;
-                    furi_string_printf(value, "%" PRIu32, data[i]);
+                    length = snprintf(value, value_size, "%" PRIu32, data[i]);
                 }; break;
                 case FlipperStreamValueHexUint64: {
                     const uint64_t* data = write_data->data;
-                    furi_string_printf(
-                        value, "%08lX%08lX", (uint32_t)(data[i] >> 32), (uint32_t)data[i]);
+                    length = snprintf(
+                        value,
+                        value_size,
+                        "%08lX%08lX",
+                        (uint32_t)(data[i] >> 32),
+                        (uint32_t)data[i]);
                 }; break;
                 case FlipperStreamValueBool: {
                     const bool* data = write_data->data;
-                    furi_string_printf(value, data[i] ? "true" : "false");
+                    length = snprintf(value, value_size, data[i] ? "true" : "false");
                 }; break;
                 default:
                     furi_crash("Unknown FF type");
                 }
 
-                if(((size_t)i + 1) < write_data->data_size) {
-                    furi_string_cat(value, " ");
-                }
+                // Values are short, the longest one is a float with 39 digits before the point
+                furi_check(length > 0 && (size_t)length < value_size);
+                writer.size += length;
 
-                if(!flipper_format_stream_write(
-                       stream, furi_string_get_cstr(value), furi_string_size(value))) {
-                    cycle_error = true;
-                    break;
+                if((i + 1) < write_data->data_size) {
+                    writer.buffer[writer.size++] = ' ';
                 }
             }
-            if(cycle_error) break;
+
+            flipper_format_stream_writer_flush(&writer);
+            if(writer.error) break;
 
             if(!flipper_format_stream_write_eol(stream)) break;
             result = true;
         } while(false);
-
-        furi_string_free(value);
     }
 
     return result;
@@ -347,10 +803,22 @@ bool flipper_format_stream_read_value_line(
     void* _data,
     size_t data_size,
     bool strict_mode) {
+    return flipper_format_stream_read_value_line_indexed(
+        stream, NULL, key, type, _data, data_size, strict_mode);
+}
+
+bool flipper_format_stream_read_value_line_indexed(
+    Stream* stream,
+    FlipperStreamKeyIndex* index,
+    const char* key,
+    FlipperStreamValue type,
+    void* _data,
+    size_t data_size,
+    bool strict_mode) {
     bool result = false;
 
     do {
-        if(!flipper_format_stream_seek_to_key(stream, key, strict_mode)) break;
+        if(!flipper_format_stream_seek_to_key_indexed(stream, index, key, strict_mode)) break;
 
         if(type == FlipperStreamValueStr) {
             FuriString* data = (FuriString*)_data;
@@ -359,78 +827,25 @@ bool flipper_format_stream_read_value_line(
                 break;
             }
         } else {
-            result = true;
-            FuriString* value;
-            value = furi_string_alloc();
+            FlipperStreamReader reader;
+            flipper_format_stream_reader_init(&reader, stream);
 
+            result = true;
             for(size_t i = 0; i < data_size; i++) {
-                bool last = false;
-                result = flipper_format_stream_read_value(stream, value, &last);
-                if(result) {
-                    int scan_values = 0;
-
-                    switch(type) {
-                    case FlipperStreamValueHex: {
-                        uint8_t* data = _data;
-                        if(furi_string_size(value) >= 2) {
-                            // sscanf "%02X" does not work here
-                            if(hex_char_to_uint8(
-                                   furi_string_get_char(value, 0),
-                                   furi_string_get_char(value, 1),
-                                   &data[i])) {
-                                scan_values = 1;
-                            }
-                        }
-                    }; break;
-#ifndef FLIPPER_STREAM_LITE
-                    case FlipperStreamValueFloat: {
-                        float* data = _data;
-                        // newlib-nano does not have sscanf for floats
-                        // scan_values = sscanf(furi_string_get_cstr(value), "%f", &data[i]);
-                        char* end_char;
-                        data[i] = strtof(furi_string_get_cstr(value), &end_char);
-                        if(*end_char == 0) {
-                            // most likely ok
-                            scan_values = 1;
-                        }
-                    }; break;
-#endif
-                    case FlipperStreamValueInt32: {
-                        int32_t* data = _data;
-                        if(strint_to_int32(furi_string_get_cstr(value), NULL, &data[i], 10) ==
-                           StrintParseNoError) {
-                            scan_values = 1;
-                        }
-                    }; break;
-                    case FlipperStreamValueUint32: {
-                        uint32_t* data = _data;
-                        if(strint_to_uint32(furi_string_get_cstr(value), NULL, &data[i], 10) ==
-                           StrintParseNoError) {
-                            scan_values = 1;
-                        }
-                    }; break;
-                    case FlipperStreamValueHexUint64: {
-                        uint64_t* data = _data;
-                        if(furi_string_size(value) >= 16) {
-                            if(hex_chars_to_uint64(furi_string_get_cstr(value), &data[i])) {
-                                scan_values = 1;
-                            }
-                        }
-                    }; break;
-                    case FlipperStreamValueBool: {
-                        bool* data = _data;
-                        data[i] = !furi_string_cmpi(value, "true");
-                        scan_values = 1;
-                    }; break;
-                    default:
-                        furi_crash("Unknown FF type");
-                    }
+                if(type == FlipperStreamValueHex &&
+                   flipper_format_stream_reader_hex_byte(&reader, &((uint8_t*)_data)[i])) {
+                    continue;
+                }
 
-                    if(scan_values != 1) {
-                        result = false;
-                        break;
-                    }
-                } else {
+                bool last = false;
+                if(!flipper_format_stream_reader_next(&reader, true, &last) ||
+                   !flipper_format_stream_parse_value(
+                       type,
+                       flipper_format_stream_reader_token(&reader),
+                       reader.token_length,
+                       _data,
+                       i)) {
+                    result = false;
                     break;
                 }
 
@@ -440,7 +855,7 @@ bool flipper_format_stream_read_value_line(
                 }
             }
 
-            furi_string_free(value);
+            if(!flipper_format_stream_reader_finish(&reader)) result = false;
         }
     } while(false);
 
@@ -452,20 +867,29 @@ bool flipper_format_stream_get_value_count(
     const char* key,
     uint32_t* count,
     bool strict_mode) {
+    return flipper_format_stream_get_value_count_indexed(stream, NULL, key, count, strict_mode);
+}
+
+bool flipper_format_stream_get_value_count_indexed(
+    Stream* stream,
+    FlipperStreamKeyIndex* index,
+    const char* key,
+    uint32_t* count,
+    bool strict_mode) {
     bool result = false;
     bool last = false;
 
-    FuriString* value;
-    value = furi_string_alloc();
-
     uint32_t position = stream_tell(stream);
     do {
-        if(!flipper_format_stream_seek_to_key(stream, key, strict_mode)) break;
+        if(!flipper_format_stream_seek_to_key_indexed(stream, index, key, strict_mode)) break;
         *count = 0;
 
+        FlipperStreamReader reader;
+        flipper_format_stream_reader_init(&reader, stream);
+
         result = true;
         while(true) {
-            if(!flipper_format_stream_read_value(stream, value, &last)) {
+            if(!flipper_format_stream_reader_next(&reader, false, &last)) {
                 result = false;
                 break;
             }
@@ -474,13 +898,13 @@ bool flipper_format_stream_get_value_count(
             if(last) break;
         }
 
+        flipper_format_stream_reader_finish(&reader);
     } while(false);
 
     if(!stream_seek(stream, position, StreamOffsetFromStart)) {
         result = false;
     }
 
-    furi_string_free(value);
     return result;
 }
 
@@ -29,6 +29,86 @@ bool flipper_format_stream_write_eol(Stream* stream);
  */
 bool flipper_format_stream_seek_to_key(Stream* stream, const char* key, bool strict_mode);
 
+/**
+ * Key index of a stream: key hash to key offset, in file order, so duplicate
+ * keys are found in the same order as by scanning.
+ * Built on the first lookup with a full scan of the stream, must be reset
+ * whenever the stream content changes.
+ */
+typedef struct FlipperStreamKeyIndex FlipperStreamKeyIndex;
+
+/**
+ * Allocate empty key index
+ * @return FlipperStreamKeyIndex* 
+ */
+FlipperStreamKeyIndex* flipper_format_stream_key_index_alloc(void);
+
+/**
+ * Free key index
+ * @param index 
+ */
+void flipper_format_stream_key_index_free(FlipperStreamKeyIndex* index);
+
+/**
+ * Drop key index, it will be rebuilt on the next lookup
+ * @param index 
+ */
+void flipper_format_stream_key_index_reset(FlipperStreamKeyIndex* index);
+
+/**
+ * Same as flipper_format_stream_seek_to_key, but jumps to the key with the index
+ * when the stream is at a line boundary. Falls back to scanning otherwise.
+ * @param stream 
+ * @param index key index of the stream, NULL to scan
+ * @param key 
+ * @param strict_mode 
+ * @return true key is found
+ * @return false key is not found
+ */
+bool flipper_format_stream_seek_to_key_indexed(
+    Stream* stream,
+    FlipperStreamKeyIndex* index,
+    const char* key,
+    bool strict_mode);
+
+/**
+ * Same as flipper_format_stream_read_value_line, with key index
+ * @param stream 
+ * @param index key index of the stream, NULL to scan
+ * @param key 
+ * @param type 
+ * @param _data 
+ * @param data_size 
+ * @param strict_mode 
+ * @return true 
+ * @return false 
+ */
+bool flipper_format_stream_read_value_line_indexed(
+    Stream* stream,
+    FlipperStreamKeyIndex* index,
+    const char* key,
+    FlipperStreamValue type,
+    void* _data,
+    size_t data_size,
+    bool strict_mode);
+
+/**
+ * Same as flipper_format_stream_get_value_count, with key index
+ * @param stream 
+ * @param index key index of the stream, NULL to scan
+ * @param key 
+ * @param count 
+ * @param strict_mode 
+ * @return true 
+ * @return false 
+ */
+bool flipper_format_stream_get_value_count_indexed(
+    Stream* stream,
+    FlipperStreamKeyIndex* index,
+    const char* key,
+    uint32_t* count,
+    bool strict_mode);
+
 #ifdef __cplusplus
 }
 #endif
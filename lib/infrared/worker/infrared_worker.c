@@ -76,6 +76,7 @@ struct InfraredWorker {
         struct {
             InfraredWorkerReceivedSignalCallback received_signal_callback;
             void* received_signal_context;
+            FuriSpscRing* ring;
             bool overrun;
         } rx;
     };
@@ -105,13 +106,12 @@ static void infrared_worker_rx_callback(void* context, bool level, uint32_t dura
     furi_assert(duration != 0);
     LevelDuration level_duration = level_duration_make(level, duration);
 
-    size_t ret =
-        furi_stream_buffer_send(instance->stream, &level_duration, sizeof(LevelDuration), 0);
-    uint32_t events = (ret == sizeof(LevelDuration)) ? INFRARED_WORKER_RX_RECEIVED :
-                                                       INFRARED_WORKER_OVERRUN;
-
-    uint32_t flags_set = furi_thread_flags_set(furi_thread_get_id(instance->thread), events);
-    furi_check(flags_set & events);
+    // Ring sets INFRARED_WORKER_RX_RECEIVED itself once the worker has drained it
+    if(!furi_spsc_ring_push(instance->rx.ring, &level_duration, 1)) {
+        uint32_t flags_set = furi_thread_flags_set(
+            furi_thread_get_id(instance->thread), INFRARED_WORKER_OVERRUN);
+        furi_check(flags_set & INFRARED_WORKER_OVERRUN);
+    }
 }
 
 static void infrared_worker_process_timeout(InfraredWorker* instance) {
@@ -179,9 +179,7 @@ static int32_t infrared_worker_rx_thread(void* thread_context) {
             }
             if(instance->signal.timings_cnt == 0)
                 notification_message(instance->notification, &sequence_display_backlight_on);
-            while(sizeof(LevelDuration) ==
-                  furi_stream_buffer_receive(
-                      instance->stream, &level_duration, sizeof(LevelDuration), 0)) {
+            while(furi_spsc_ring_pop(instance->rx.ring, &level_duration, 1)) {
                 if(!instance->rx.overrun) {
                     bool level = level_duration_get_level(level_duration);
                     uint32_t duration = level_duration_get_duration(level_duration);
@@ -228,9 +226,8 @@ InfraredWorker* infrared_worker_alloc(void) {
 
     instance->thread = furi_thread_alloc_ex("InfraredWorker", 2048, NULL, instance);
 
-    size_t buffer_size =
-        MAX(sizeof(InfraredWorkerTiming) * (MAX_TIMINGS_AMOUNT + 1),
-            sizeof(LevelDuration) * MAX_TIMINGS_AMOUNT);
+    // Stream is used by TX only, RX pulses go through the ring allocated on RX start
+    size_t buffer_size = sizeof(InfraredWorkerTiming) * (MAX_TIMINGS_AMOUNT + 1);
     instance->stream = furi_stream_buffer_alloc(buffer_size, sizeof(InfraredWorkerTiming));
     instance->infrared_decoder = infrared_alloc_decoder();
     instance->infrared_encoder = infrared_alloc_encoder();
@@ -259,11 +256,14 @@ void infrared_worker_rx_start(InfraredWorker* instance) {
     furi_check(instance);
     furi_check(instance->state == InfraredWorkerStateIdle);
 
-    furi_stream_set_trigger_level(instance->stream, sizeof(LevelDuration));
+    instance->rx.ring = furi_spsc_ring_alloc(MAX_TIMINGS_AMOUNT, sizeof(LevelDuration));
 
     furi_thread_set_callback(instance->thread, infrared_worker_rx_thread);
     furi_thread_start(instance->thread);
 
+    furi_spsc_ring_set_consumer(
+        instance->rx.ring, furi_thread_get_id(instance->thread), INFRARED_WORKER_RX_RECEIVED, 1);
+
     furi_hal_infrared_async_rx_set_capture_isr_callback(infrared_worker_rx_callback, instance);
     furi_hal_infrared_async_rx_set_timeout_isr_callback(
         infrared_worker_rx_timeout_callback, instance);
@@ -282,10 +282,12 @@ void infrared_worker_rx_stop(InfraredWorker* instance) {
     furi_hal_infrared_async_rx_set_capture_isr_callback(NULL, NULL);
     furi_hal_infrared_async_rx_stop();
 
+    furi_spsc_ring_set_consumer(instance->rx.ring, NULL, 0, 1);
     furi_thread_flags_set(furi_thread_get_id(instance->thread), INFRARED_WORKER_EXIT);
     furi_thread_join(instance->thread);
 
-    furi_check(furi_stream_buffer_reset(instance->stream) == FuriStatusOk);
+    furi_spsc_ring_free(instance->rx.ring);
+    instance->rx.ring = NULL;
 
     instance->state = InfraredWorkerStateIdle;
 }
@@ -247,6 +247,12 @@ const ProtocolBase protocol_awid = {
     .data_size = AWID_DECODED_DATA_SIZE,
     .features = LFRFIDFeatureASK,
     .validate_count = 3,
+    .timing =
+        {
+            .type = ProtocolTimingPeriod,
+            .min = MIN_TIME,
+            .max = MAX_TIME - 1,
+        },
     .alloc = (ProtocolAlloc)protocol_awid_alloc,
     .free = (ProtocolFree)protocol_awid_free,
     .get_data = (ProtocolGetData)protocol_awid_get_data,
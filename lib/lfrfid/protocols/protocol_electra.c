@@ -421,6 +421,12 @@ const ProtocolBase protocol_electra = {
     .data_size = ELECTRA_DECODED_DATA_SIZE,
     .features = LFRFIDFeatureASK | LFRFIDFeaturePSK,
     .validate_count = 3,
+    .timing =
+        {
+            .type = ProtocolTimingLevel,
+            .min = ELECTRA_READ_SHORT_TIME - ELECTRA_READ_JITTER_TIME,
+            .max = ELECTRA_READ_LONG_TIME + ELECTRA_READ_JITTER_TIME,
+        },
     .alloc = (ProtocolAlloc)protocol_electra_alloc,
     .free = (ProtocolFree)protocol_electra_free,
     .get_data = (ProtocolGetData)protocol_electra_get_data,
@@ -29,6 +29,11 @@ typedef uint64_t EM4100Epilogue;
 #define EM_READ_LONG_TIME_BASE   (512)
 #define EM_READ_JITTER_TIME_BASE (100)
 
+#define EM_READ_DURATION_MIN(divisor) \
+    ((EM_READ_SHORT_TIME_BASE - EM_READ_JITTER_TIME_BASE) / (divisor))
+#define EM_READ_DURATION_MAX(divisor) \
+    ((EM_READ_LONG_TIME_BASE + EM_READ_JITTER_TIME_BASE) / (divisor))
+
 #define EM_ENCODED_DATA_HEADER (0xFF80000000000000ULL)
 
 typedef struct {
@@ -360,6 +365,12 @@ const ProtocolBase protocol_em4100 = {
     .data_size = EM4100_DECODED_DATA_SIZE,
     .features = LFRFIDFeatureASK | LFRFIDFeaturePSK,
     .validate_count = 3,
+    .timing =
+        {
+            .type = ProtocolTimingLevel,
+            .min = EM_READ_DURATION_MIN(1),
+            .max = EM_READ_DURATION_MAX(1),
+        },
     .alloc = (ProtocolAlloc)protocol_em4100_alloc,
     .free = (ProtocolFree)protocol_em4100_free,
     .get_data = (ProtocolGetData)protocol_em4100_get_data,
@@ -384,6 +395,12 @@ const ProtocolBase protocol_em4100_32 = {
     .data_size = EM4100_DECODED_DATA_SIZE,
     .features = LFRFIDFeatureASK | LFRFIDFeaturePSK,
     .validate_count = 3,
+    .timing =
+        {
+            .type = ProtocolTimingLevel,
+            .min = EM_READ_DURATION_MIN(2),
+            .max = EM_READ_DURATION_MAX(2),
+        },
     .alloc = (ProtocolAlloc)protocol_em4100_32_alloc,
     .free = (ProtocolFree)protocol_em4100_free,
     .get_data = (ProtocolGetData)protocol_em4100_get_data,
@@ -408,6 +425,12 @@ const ProtocolBase protocol_em4100_16 = {
     .data_size = EM4100_DECODED_DATA_SIZE,
     .features = LFRFIDFeatureASK | LFRFIDFeaturePSK,
     .validate_count = 3,
+    .timing =
+        {
+            .type = ProtocolTimingLevel,
+            .min = EM_READ_DURATION_MIN(4),
+            .max = EM_READ_DURATION_MAX(4),
+        },
     .alloc = (ProtocolAlloc)protocol_em4100_16_alloc,
     .free = (ProtocolFree)protocol_em4100_free,
     .get_data = (ProtocolGetData)protocol_em4100_get_data,
@@ -229,6 +229,12 @@ const ProtocolBase protocol_fdx_a = {
     .data_size = FDXA_DECODED_DATA_SIZE,
     .features = LFRFIDFeatureASK,
     .validate_count = 3,
+    .timing =
+        {
+            .type = ProtocolTimingPeriod,
+            .min = MIN_TIME,
+            .max = MAX_TIME - 1,
+        },
     .alloc = (ProtocolAlloc)protocol_fdx_a_alloc,
     .free = (ProtocolFree)protocol_fdx_a_free,
     .get_data = (ProtocolGetData)protocol_fdx_a_get_data,
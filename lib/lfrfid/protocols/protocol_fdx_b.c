@@ -379,6 +379,12 @@ const ProtocolBase protocol_fdx_b = {
     .data_size = FDXB_DECODED_DATA_SIZE,
     .features = LFRFIDFeatureASK,
     .validate_count = 3,
+    .timing =
+        {
+            .type = ProtocolTimingLevel,
+            .min = FDX_B_SHORT_TIME - FDX_B_JITTER_TIME,
+            .max = FDX_B_LONG_TIME + FDX_B_JITTER_TIME,
+        },
     .alloc = (ProtocolAlloc)protocol_fdx_b_alloc,
     .free = (ProtocolFree)protocol_fdx_b_free,
     .get_data = (ProtocolGetData)protocol_fdx_b_get_data,
@@ -312,6 +312,12 @@ const ProtocolBase protocol_gallagher = {
     .data_size = GALLAGHER_DECODED_DATA_SIZE,
     .features = LFRFIDFeatureASK,
     .validate_count = 3,
+    .timing =
+        {
+            .type = ProtocolTimingLevel,
+            .min = GALLAGHER_READ_SHORT_TIME - GALLAGHER_READ_JITTER_TIME,
+            .max = GALLAGHER_READ_LONG_TIME + GALLAGHER_READ_JITTER_TIME,
+        },
     .alloc = (ProtocolAlloc)protocol_gallagher_alloc,
     .free = (ProtocolFree)protocol_gallagher_free,
     .get_data = (ProtocolGetData)protocol_gallagher_get_data,
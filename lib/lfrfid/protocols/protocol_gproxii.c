@@ -297,6 +297,12 @@ const ProtocolBase protocol_gproxii = {
     .data_size = GPROXII_DATA_SIZE,
     .features = LFRFIDFeatureASK,
     .validate_count = 3,
+    .timing =
+        {
+            .type = ProtocolTimingLevel,
+            .min = GPROXII_SHORT_TIME - GPROXII_JITTER_TIME,
+            .max = GPROXII_LONG_TIME + GPROXII_JITTER_TIME,
+        },
     .alloc = (ProtocolAlloc)protocol_gproxii_alloc,
     .free = (ProtocolFree)protocol_gproxii_free,
     .get_data = (ProtocolGetData)protocol_gproxii_get_data,
@@ -371,6 +371,12 @@ const ProtocolBase protocol_h10301 = {
     .data_size = H10301_DECODED_DATA_SIZE,
     .features = LFRFIDFeatureASK,
     .validate_count = 3,
+    .timing =
+        {
+            .type = ProtocolTimingPeriod,
+            .min = MIN_TIME,
+            .max = MAX_TIME - 1,
+        },
     .alloc = (ProtocolAlloc)protocol_h10301_alloc,
     .free = (ProtocolFree)protocol_h10301_free,
     .get_data = (ProtocolGetData)protocol_h10301_get_data,
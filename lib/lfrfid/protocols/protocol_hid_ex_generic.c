@@ -208,6 +208,12 @@ const ProtocolBase protocol_hid_ex_generic = {
     .data_size = HID_DECODED_DATA_SIZE,
     .features = LFRFIDFeatureASK,
     .validate_count = 3,
+    .timing =
+        {
+            .type = ProtocolTimingPeriod,
+            .min = MIN_TIME,
+            .max = MAX_TIME - 1,
+        },
     .alloc = (ProtocolAlloc)protocol_hid_ex_generic_alloc,
     .free = (ProtocolFree)protocol_hid_ex_generic_free,
     .get_data = (ProtocolGetData)protocol_hid_ex_generic_get_data,
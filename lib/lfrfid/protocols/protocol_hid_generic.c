@@ -269,6 +269,12 @@ const ProtocolBase protocol_hid_generic = {
     .data_size = HID_DECODED_DATA_SIZE,
     .features = LFRFIDFeatureASK,
     .validate_count = 6,
+    .timing =
+        {
+            .type = ProtocolTimingPeriod,
+            .min = MIN_TIME,
+            .max = MAX_TIME - 1,
+        },
     .alloc = (ProtocolAlloc)protocol_hid_generic_alloc,
     .free = (ProtocolFree)protocol_hid_generic_free,
     .get_data = (ProtocolGetData)protocol_hid_generic_get_data,
@@ -282,6 +282,12 @@ const ProtocolBase protocol_io_prox_xsf = {
     .data_size = IOPROXXSF_DECODED_DATA_SIZE,
     .features = LFRFIDFeatureASK,
     .validate_count = 3,
+    .timing =
+        {
+            .type = ProtocolTimingPeriod,
+            .min = MIN_TIME,
+            .max = MAX_TIME - 1,
+        },
     .alloc = (ProtocolAlloc)protocol_io_prox_xsf_alloc,
     .free = (ProtocolFree)protocol_io_prox_xsf_free,
     .get_data = (ProtocolGetData)protocol_io_prox_xsf_get_data,
@@ -192,6 +192,12 @@ const ProtocolBase protocol_jablotron = {
     .data_size = JABLOTRON_DECODED_DATA_SIZE,
     .features = LFRFIDFeatureASK,
     .validate_count = 3,
+    .timing =
+        {
+            .type = ProtocolTimingLevel,
+            .min = JABLOTRON_SHORT_TIME - JABLOTRON_JITTER_TIME,
+            .max = JABLOTRON_LONG_TIME + JABLOTRON_JITTER_TIME,
+        },
     .alloc = (ProtocolAlloc)protocol_jablotron_alloc,
     .free = (ProtocolFree)protocol_jablotron_free,
     .get_data = (ProtocolGetData)protocol_jablotron_get_data,
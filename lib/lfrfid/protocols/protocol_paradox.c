@@ -230,6 +230,12 @@ const ProtocolBase protocol_paradox = {
     .data_size = PARADOX_DECODED_DATA_SIZE,
     .features = LFRFIDFeatureASK,
     .validate_count = 3,
+    .timing =
+        {
+            .type = ProtocolTimingPeriod,
+            .min = MIN_TIME,
+            .max = MAX_TIME - 1,
+        },
     .alloc = (ProtocolAlloc)protocol_paradox_alloc,
     .free = (ProtocolFree)protocol_paradox_free,
     .get_data = (ProtocolGetData)protocol_paradox_get_data,
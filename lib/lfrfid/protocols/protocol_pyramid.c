@@ -264,6 +264,12 @@ const ProtocolBase protocol_pyramid = {
     .data_size = PYRAMID_DECODED_DATA_SIZE,
     .features = LFRFIDFeatureASK,
     .validate_count = 3,
+    .timing =
+        {
+            .type = ProtocolTimingPeriod,
+            .min = MIN_TIME,
+            .max = MAX_TIME - 1,
+        },
     .alloc = (ProtocolAlloc)protocol_pyramid_alloc,
     .free = (ProtocolFree)protocol_pyramid_free,
     .get_data = (ProtocolGetData)protocol_pyramid_get_data,
@@ -346,6 +346,12 @@ const ProtocolBase protocol_securakey = {
     .data_size = SECURAKEY_DECODED_DATA_SIZE_BYTES,
     .features = LFRFIDFeatureASK,
     .validate_count = 3,
+    .timing =
+        {
+            .type = ProtocolTimingLevel,
+            .min = SECURAKEY_READ_SHORT_TIME - SECURAKEY_READ_JITTER_TIME,
+            .max = SECURAKEY_READ_LONG_TIME + SECURAKEY_READ_JITTER_TIME,
+        },
     .alloc = (ProtocolAlloc)protocol_securakey_alloc,
     .free = (ProtocolFree)protocol_securakey_free,
     .get_data = (ProtocolGetData)protocol_securakey_get_data,
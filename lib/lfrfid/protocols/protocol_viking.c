@@ -185,6 +185,12 @@ const ProtocolBase protocol_viking = {
     .data_size = VIKING_DECODED_DATA_SIZE,
     .features = LFRFIDFeatureASK,
     .validate_count = 3,
+    .timing =
+        {
+            .type = ProtocolTimingLevel,
+            .min = VIKING_READ_SHORT_TIME - VIKING_READ_JITTER_TIME,
+            .max = VIKING_READ_LONG_TIME + VIKING_READ_JITTER_TIME,
+        },
     .alloc = (ProtocolAlloc)protocol_viking_alloc,
     .free = (ProtocolFree)protocol_viking_free,
     .get_data = (ProtocolGetData)protocol_viking_get_data,
@@ -11,8 +11,6 @@
 #define LF_POLY_ODD  (0x29CE5C)
 #define LF_POLY_EVEN (0x870804)
 
-#define BEBIT(x, n) FURI_BIT(x, (n) ^ 24)
-
 Crypto1* crypto1_alloc(void) {
     Crypto1* instance = malloc(sizeof(Crypto1));
 
@@ -41,43 +39,105 @@ void crypto1_init(Crypto1* crypto1, uint64_t key) {
     }
 }
 
-static uint32_t crypto1_filter(uint32_t in) {
+// The filter function takes five nibbles of the odd register. Each table maps two of them at
+// once to their bits of the output function index.
+static const uint8_t crypto1_filter_lo[256] = {
+    0x00, 0x00, 0x10, 0x10, 0x00, 0x10, 0x00, 0x00, 0x00, 0x10, 0x00, 0x00, 0x10, 0x10, 0x10, 0x10,
+    0x00, 0x00, 0x10, 0x10, 0x00, 0x10, 0x00, 0x00, 0x00, 0x10, 0x00, 0x00, 0x10, 0x10, 0x10, 0x10,
+    0x00, 0x00, 0x10, 0x10, 0x00, 0x10, 0x00, 0x00, 0x00, 0x10, 0x00, 0x00, 0x10, 0x10, 0x10, 0x10,
+    0x08, 0x08, 0x18, 0x18, 0x08, 0x18, 0x08, 0x08, 0x08, 0x18, 0x08, 0x08, 0x18, 0x18, 0x18, 0x18,
+    0x08, 0x08, 0x18, 0x18, 0x08, 0x18, 0x08, 0x08, 0x08, 0x18, 0x08, 0x08, 0x18, 0x18, 0x18, 0x18,
+    0x08, 0x08, 0x18, 0x18, 0x08, 0x18, 0x08, 0x08, 0x08, 0x18, 0x08, 0x08, 0x18, 0x18, 0x18, 0x18,
+    0x00, 0x00, 0x10, 0x10, 0x00, 0x10, 0x00, 0x00, 0x00, 0x10, 0x00, 0x00, 0x10, 0x10, 0x10, 0x10,
+    0x00, 0x00, 0x10, 0x10, 0x00, 0x10, 0x00, 0x00, 0x00, 0x10, 0x00, 0x00, 0x10, 0x10, 0x10, 0x10,
+    0x08, 0x08, 0x18, 0x18, 0x08, 0x18, 0x08, 0x08, 0x08, 0x18, 0x08, 0x08, 0x18, 0x18, 0x18, 0x18,
+    0x00, 0x00, 0x10, 0x10, 0x00, 0x10, 0x00, 0x00, 0x00, 0x10, 0x00, 0x00, 0x10, 0x10, 0x10, 0x10,
+    0x00, 0x00, 0x10, 0x10, 0x00, 0x10, 0x00, 0x00, 0x00, 0x10, 0x00, 0x00, 0x10, 0x10, 0x10, 0x10,
+    0x08, 0x08, 0x18, 0x18, 0x08, 0x18, 0x08, 0x08, 0x08, 0x18, 0x08, 0x08, 0x18, 0x18, 0x18, 0x18,
+    0x08, 0x08, 0x18, 0x18, 0x08, 0x18, 0x08, 0x08, 0x08, 0x18, 0x08, 0x08, 0x18, 0x18, 0x18, 0x18,
+    0x00, 0x00, 0x10, 0x10, 0x00, 0x10, 0x00, 0x00, 0x00, 0x10, 0x00, 0x00, 0x10, 0x10, 0x10, 0x10,
+    0x08, 0x08, 0x18, 0x18, 0x08, 0x18, 0x08, 0x08, 0x08, 0x18, 0x08, 0x08, 0x18, 0x18, 0x18, 0x18,
+    0x08, 0x08, 0x18, 0x18, 0x08, 0x18, 0x08, 0x08, 0x08, 0x18, 0x08, 0x08, 0x18, 0x18, 0x18, 0x18,
+};
+
+static const uint8_t crypto1_filter_mid[256] = {
+    0x00, 0x00, 0x04, 0x04, 0x00, 0x04, 0x00, 0x00, 0x00, 0x04, 0x00, 0x00, 0x04, 0x04, 0x04, 0x04,
+    0x00, 0x00, 0x04, 0x04, 0x00, 0x04, 0x00, 0x00, 0x00, 0x04, 0x00, 0x00, 0x04, 0x04, 0x04, 0x04,
+    0x02, 0x02, 0x06, 0x06, 0x02, 0x06, 0x02, 0x02, 0x02, 0x06, 0x02, 0x02, 0x06, 0x06, 0x06, 0x06,
+    0x02, 0x02, 0x06, 0x06, 0x02, 0x06, 0x02, 0x02, 0x02, 0x06, 0x02, 0x02, 0x06, 0x06, 0x06, 0x06,
+    0x00, 0x00, 0x04, 0x04, 0x00, 0x04, 0x00, 0x00, 0x00, 0x04, 0x00, 0x00, 0x04, 0x04, 0x04, 0x04,
+    0x02, 0x02, 0x06, 0x06, 0x02, 0x06, 0x02, 0x02, 0x02, 0x06, 0x02, 0x02, 0x06, 0x06, 0x06, 0x06,
+    0x00, 0x00, 0x04, 0x04, 0x00, 0x04, 0x00, 0x00, 0x00, 0x04, 0x00, 0x00, 0x04, 0x04, 0x04, 0x04,
+    0x00, 0x00, 0x04, 0x04, 0x00, 0x04, 0x00, 0x00, 0x00, 0x04, 0x00, 0x00, 0x04, 0x04, 0x04, 0x04,
+    0x00, 0x00, 0x04, 0x04, 0x00, 0x04, 0x00, 0x00, 0x00, 0x04, 0x00, 0x00, 0x04, 0x04, 0x04, 0x04,
+    0x02, 0x02, 0x06, 0x06, 0x02, 0x06, 0x02, 0x02, 0x02, 0x06, 0x02, 0x02, 0x06, 0x06, 0x06, 0x06,
+    0x00, 0x00, 0x04, 0x04, 0x00, 0x04, 0x00, 0x00, 0x00, 0x04, 0x00, 0x00, 0x04, 0x04, 0x04, 0x04,
+    0x00, 0x00, 0x04, 0x04, 0x00, 0x04, 0x00, 0x00, 0x00, 0x04, 0x00, 0x00, 0x04, 0x04, 0x04, 0x04,
+    0x02, 0x02, 0x06, 0x06, 0x02, 0x06, 0x02, 0x02, 0x02, 0x06, 0x02, 0x02, 0x06, 0x06, 0x06, 0x06,
+    0x02, 0x02, 0x06, 0x06, 0x02, 0x06, 0x02, 0x02, 0x02, 0x06, 0x02, 0x02, 0x06, 0x06, 0x06, 0x06,
+    0x02, 0x02, 0x06, 0x06, 0x02, 0x06, 0x02, 0x02, 0x02, 0x06, 0x02, 0x02, 0x06, 0x06, 0x06, 0x06,
+    0x02, 0x02, 0x06, 0x06, 0x02, 0x06, 0x02, 0x02, 0x02, 0x06, 0x02, 0x02, 0x06, 0x06, 0x06, 0x06,
+};
+
+static inline uint32_t crypto1_filter(uint32_t in) {
+    uint32_t index = crypto1_filter_lo[in & 0xff] | crypto1_filter_mid[in >> 8 & 0xff] |
+                     (0x0d938 >> (in >> 16 & 0xf) & 1);
+    return FURI_BIT(0xEC57E80A, index);
+}
+
+static inline uint32_t crypto1_parity(uint32_t in) {
+    in ^= in >> 16;
+    in ^= in >> 8;
+    in ^= in >> 4;
+    return FURI_BIT(0x6996, in & 0xf);
+}
+
+// Clocks the LFSR once. The halves are not swapped here, so two calls with swapped
+// arguments make two full clocks and leave odd and even in place.
+static inline uint32_t
+    crypto1_step(uint32_t* odd, uint32_t* even, uint32_t in, uint32_t is_encrypted) {
+    uint32_t out = crypto1_filter(*odd);
+    uint32_t feed = (out & is_encrypted) ^ in;
+    feed ^= crypto1_parity((*odd & LF_POLY_ODD) ^ (*even & LF_POLY_EVEN));
+    *even = *even << 1 | feed;
+    return out;
+}
+
+// Clocks the LFSR an even number of times, input and output bits are LSB first
+static inline uint32_t
+    crypto1_clock(Crypto1* crypto1, uint32_t in, size_t bits, uint32_t is_encrypted) {
+    uint32_t odd = crypto1->odd;
+    uint32_t even = crypto1->even;
     uint32_t out = 0;
-    out = 0xf22c0 >> (in & 0xf) & 16;
-    out |= 0x6c9c0 >> (in >> 4 & 0xf) & 8;
-    out |= 0x3c8b0 >> (in >> 8 & 0xf) & 4;
-    out |= 0x1e458 >> (in >> 12 & 0xf) & 2;
-    out |= 0x0d938 >> (in >> 16 & 0xf) & 1;
-    return FURI_BIT(0xEC57E80A, out);
+
+    for(size_t i = 0; i < bits; i += 2) {
+        out |= crypto1_step(&odd, &even, FURI_BIT(in, i), is_encrypted) << i;
+        out |= crypto1_step(&even, &odd, FURI_BIT(in, i + 1), is_encrypted) << (i + 1);
+    }
+
+    crypto1->odd = odd;
+    crypto1->even = even;
+    return out;
 }
 
 uint8_t crypto1_bit(Crypto1* crypto1, uint8_t in, int is_encrypted) {
     furi_assert(crypto1);
-    uint8_t out = crypto1_filter(crypto1->odd);
-    uint32_t feed = out & (!!is_encrypted);
-    feed ^= !!in;
-    feed ^= LF_POLY_ODD & crypto1->odd;
-    feed ^= LF_POLY_EVEN & crypto1->even;
-    crypto1->even = crypto1->even << 1 | (nfc_util_even_parity32(feed));
-
+    uint8_t out = crypto1_step(&crypto1->odd, &crypto1->even, !!in, !!is_encrypted);
     FURI_SWAP(crypto1->odd, crypto1->even);
     return out;
 }
 
 uint8_t crypto1_byte(Crypto1* crypto1, uint8_t in, int is_encrypted) {
     furi_assert(crypto1);
-    uint8_t out = 0;
-    for(uint8_t i = 0; i < 8; i++) {
-        out |= crypto1_bit(crypto1, FURI_BIT(in, i), is_encrypted) << i;
-    }
-    return out;
+    return crypto1_clock(crypto1, in, 8, !!is_encrypted);
 }
 
 uint32_t crypto1_word(Crypto1* crypto1, uint32_t in, int is_encrypted) {
     furi_assert(crypto1);
     uint32_t out = 0;
-    for(uint8_t i = 0; i < 32; i++) {
-        out |= (uint32_t)crypto1_bit(crypto1, BEBIT(in, i), is_encrypted) << (24 ^ i);
+    // Bytes go MSB first, bits of each byte LSB first
+    for(int8_t shift = 24; shift >= 0; shift -= 8) {
+        out |= crypto1_clock(crypto1, (in >> shift) & 0xff, 8, !!is_encrypted) << shift;
     }
     return out;
 }
@@ -99,16 +159,11 @@ void crypto1_decrypt(Crypto1* crypto, const BitBuffer* buff, BitBuffer* out) {
     bit_buffer_set_size(out, bits);
     const uint8_t* encrypted_data = bit_buffer_get_data(buff);
     if(bits < 8) {
-        uint8_t decrypted_byte = 0;
-        uint8_t encrypted_byte = encrypted_data[0];
-        decrypted_byte |= (crypto1_bit(crypto, 0, 0) ^ FURI_BIT(encrypted_byte, 0)) << 0;
-        decrypted_byte |= (crypto1_bit(crypto, 0, 0) ^ FURI_BIT(encrypted_byte, 1)) << 1;
-        decrypted_byte |= (crypto1_bit(crypto, 0, 0) ^ FURI_BIT(encrypted_byte, 2)) << 2;
-        decrypted_byte |= (crypto1_bit(crypto, 0, 0) ^ FURI_BIT(encrypted_byte, 3)) << 3;
+        uint8_t decrypted_byte = (crypto1_clock(crypto, 0, 4, 0) ^ encrypted_data[0]) & 0x0f;
         bit_buffer_set_byte(out, 0, decrypted_byte);
     } else {
         for(size_t i = 0; i < bits / 8; i++) {
-            uint8_t decrypted_byte = crypto1_byte(crypto, 0, 0) ^ encrypted_data[i];
+            uint8_t decrypted_byte = crypto1_clock(crypto, 0, 8, 0) ^ encrypted_data[i];
             bit_buffer_set_byte(out, i, decrypted_byte);
         }
     }
@@ -130,7 +185,7 @@ void crypto1_encrypt(Crypto1* crypto, uint8_t* keystream, const BitBuffer* buff,
         bit_buffer_set_byte(out, 0, encrypted_byte);
     } else {
         for(size_t i = 0; i < bits / 8; i++) {
-            uint8_t encrypted_byte = crypto1_byte(crypto, keystream ? keystream[i] : 0, 0) ^
+            uint8_t encrypted_byte = crypto1_clock(crypto, keystream ? keystream[i] : 0, 8, 0) ^
                                      plain_data[i];
             bool parity_bit =
                 ((crypto1_filter(crypto->odd) ^ nfc_util_odd_parity8(plain_data[i])) & 0x01);
@@ -6,6 +6,7 @@
 #include <lib/nfc/protocols/felica/felica.h>
 #include <lib/nfc/helpers/felica_crc.h>
 #include <lib/nfc/protocols/felica/felica_poller_sync.h>
+#include <lib/nfc/protocols/felica/felica_poller_i.h>
 
 #include <furi/furi.h>
 
@@ -32,6 +33,7 @@ typedef struct {
 
 typedef struct {
     NfcMessageType type;
+    NfcTech tech;
     NfcMessageData data;
 } NfcMessage;
 
@@ -84,6 +86,7 @@ struct Nfc {
     void* context;
 
     NfcMode mode;
+    NfcTech tech;
 
     FuriThread* worker_thread;
 };
@@ -152,10 +155,10 @@ void nfc_free(Nfc* instance) {
 }
 
 void nfc_config(Nfc* instance, NfcMode mode, NfcTech tech) {
-    UNUSED(instance);
-    UNUSED(tech);
+    furi_check(instance);
 
     instance->mode = mode;
+    instance->tech = tech;
 }
 
 void nfc_set_fdt_poll_fc(Nfc* instance, uint32_t fdt_poll_fc) {
@@ -294,6 +297,19 @@ static void nfc_worker_listener_pass_col_res(Nfc* instance, uint8_t* rx_data, ui
     bit_buffer_free(tx_buffer);
 }
 
+static bool nfc_worker_listener_is_poll_request(Nfc* instance, const NfcMessageData* data) {
+    bool is_poll_request = false;
+
+    if((data->data_bits == 7) && (data->data[0] == 0x52)) {
+        is_poll_request = true;
+    } else if((instance->tech == NfcTechFelica) && (data->data_bits == 8 * 8)) {
+        const FelicaPollingRequest* request = (const FelicaPollingRequest*)data->data;
+        is_poll_request = (request->polling_cmd == FELICA_POLLER_CMD_POLLING_REQ_CODE);
+    }
+
+    return is_poll_request;
+}
+
 static int32_t nfc_worker_listener(void* context) {
     Nfc* instance = context;
     furi_check(instance->callback);
@@ -307,13 +323,18 @@ static int32_t nfc_worker_listener(void* context) {
     while(true) {
         furi_message_queue_get(listener_queue, &message, FuriWaitForever);
         bit_buffer_copy_bits(event_data.buffer, message.data.data, message.data.data_bits);
-        if((message.data.data[0] == 0x52) && (message.data.data_bits == 7)) {
-            instance->col_res_status = Iso14443_3aColResStatusIdle;
-        }
 
         if(message.type == NfcMessageTypeAbort) {
             break;
+        } else if(message.tech != instance->tech) {
+            // Listener doesn't hear the pollers of other technologies
+            message.type = NfcMessageTypeTimeout;
+            furi_message_queue_put(poller_queue, &message, FuriWaitForever);
         } else if(message.type == NfcMessageTypeTx) {
+            if(nfc_worker_listener_is_poll_request(instance, &message.data)) {
+                instance->col_res_status = Iso14443_3aColResStatusIdle;
+            }
+
             nfc_test_print(
                 NfcTransportLogLevelInfo, "RDR", message.data.data, message.data.data_bits);
             if(instance->software_col_res_required &&
@@ -410,6 +431,7 @@ NfcError nfc_listener_tx(Nfc* instance, const BitBuffer* tx_buffer) {
 
     NfcMessage message = {};
     message.type = NfcMessageTypeTx;
+    message.tech = instance->tech;
     message.data.data_bits = bit_buffer_get_size(tx_buffer);
     bit_buffer_write_bytes(tx_buffer, message.data.data, bit_buffer_get_size_bytes(tx_buffer));
 
@@ -435,6 +457,7 @@ NfcError
 
     NfcMessage message = {};
     message.type = NfcMessageTypeTx;
+    message.tech = instance->tech;
     message.data.data_bits = bit_buffer_get_size(tx_buffer);
     bit_buffer_write_bytes(tx_buffer, message.data.data, bit_buffer_get_size_bytes(tx_buffer));
     // Tx
@@ -2,11 +2,21 @@
 #include "nfc_poller.h"
 
 #include <nfc/protocols/nfc_poller_defs.h>
+#include <nfc/protocols/nfc_device_defs.h>
 
 #include <furi/furi.h>
 
 #define TAG "NfcScanner"
 
+/** Fast mode base protocol order, protocols sharing a technology are probed one after another */
+static const NfcProtocol nfc_scanner_fast_base_protocols[] = {
+    NfcProtocolIso14443_3a,
+    NfcProtocolIso14443_3b,
+    NfcProtocolSt25tb,
+    NfcProtocolIso15693_3,
+    NfcProtocolFelica,
+};
+
 typedef enum {
     NfcScannerStateIdle,
     NfcScannerStateTryBasePollers,
@@ -23,6 +33,15 @@ typedef enum {
     NfcScannerSessionStateStopRequest,
 } NfcScannerSessionState;
 
+typedef struct {
+    size_t base_protocols_num;
+    NfcProtocol base_protocols[NfcProtocolNum];
+    NfcDeviceData* base_data[NfcProtocolNum];
+
+    size_t protocols_num;
+    NfcProtocol protocols[NfcProtocolNum];
+} NfcScannerCache;
+
 struct NfcScanner {
     Nfc* nfc;
     NfcScannerState state;
@@ -32,6 +51,7 @@ struct NfcScanner {
     void* context;
 
     NfcEvent nfc_event;
+    NfcScannerMode mode;
 
     NfcProtocol first_detected_protocol;
 
@@ -51,6 +71,9 @@ struct NfcScanner {
 
     NfcProtocol current_protocol;
 
+    NfcDeviceData* base_data[NfcProtocolNum];
+    NfcScannerCache cache;
+
     FuriThread* scan_worker;
 };
 
@@ -69,14 +92,117 @@ static void nfc_scanner_reset(NfcScanner* instance) {
 
 typedef void (*NfcScannerStateHandler)(NfcScanner* instance);
 
-void nfc_scanner_state_handler_idle(NfcScanner* instance) {
+static bool nfc_scanner_protocol_in_list(
+    NfcProtocol protocol,
+    const NfcProtocol* protocols,
+    size_t protocols_num) {
+    bool found = false;
+
+    for(size_t i = 0; i < protocols_num; i++) {
+        if(protocols[i] == protocol) {
+            found = true;
+            break;
+        }
+    }
+
+    return found;
+}
+
+static void nfc_scanner_add_base_protocol(NfcScanner* instance, NfcProtocol protocol) {
+    if(nfc_protocol_get_parent(protocol) != NfcProtocolInvalid) return;
+    if(nfc_scanner_protocol_in_list(
+           protocol, instance->base_protocols, instance->base_protocols_num))
+        return;
+
+    instance->base_protocols[instance->base_protocols_num] = protocol;
+    instance->base_protocols_num++;
+}
+
+static void nfc_scanner_set_data(
+    NfcDeviceData** data,
+    NfcProtocol protocol,
+    const NfcDeviceData* other) {
+    if(data[protocol] == NULL) {
+        data[protocol] = nfc_devices[protocol]->alloc();
+    }
+    nfc_devices[protocol]->copy(data[protocol], other);
+}
+
+static void nfc_scanner_free_data(NfcDeviceData** data) {
     for(size_t i = 0; i < NfcProtocolNum; i++) {
-        NfcProtocol parent_protocol = nfc_protocol_get_parent(i);
-        if(parent_protocol == NfcProtocolInvalid) {
-            instance->base_protocols[instance->base_protocols_num] = i;
-            instance->base_protocols_num++;
+        if(data[i]) {
+            nfc_devices[i]->free(data[i]);
+            data[i] = NULL;
+        }
+    }
+}
+
+static const NfcDeviceData*
+    nfc_scanner_get_parent_data(NfcScanner* instance, NfcProtocol protocol) {
+    const NfcDeviceData* parent_data = NULL;
+
+    NfcProtocol parent_protocol = nfc_protocol_get_parent(protocol);
+    if(nfc_scanner_protocol_in_list(
+           parent_protocol,
+           instance->detected_base_protocols,
+           instance->detected_base_protocols_num)) {
+        parent_data = instance->base_data[parent_protocol];
+    }
+
+    return parent_data;
+}
+
+static bool nfc_scanner_cache_is_hit(NfcScanner* instance) {
+    NfcScannerCache* cache = &instance->cache;
+
+    if(cache->base_protocols_num != instance->detected_base_protocols_num) return false;
+
+    bool is_hit = true;
+    for(size_t i = 0; i < instance->detected_base_protocols_num; i++) {
+        NfcProtocol protocol = instance->detected_base_protocols[i];
+        is_hit = nfc_scanner_protocol_in_list(
+                     protocol, cache->base_protocols, cache->base_protocols_num) &&
+                 nfc_devices[protocol]->is_equal(
+                     instance->base_data[protocol], cache->base_data[protocol]);
+        if(!is_hit) break;
+    }
+
+    return is_hit;
+}
+
+static void nfc_scanner_cache_update(NfcScanner* instance) {
+    NfcScannerCache* cache = &instance->cache;
+
+    cache->base_protocols_num = instance->detected_base_protocols_num;
+    for(size_t i = 0; i < instance->detected_base_protocols_num; i++) {
+        NfcProtocol protocol = instance->detected_base_protocols[i];
+        cache->base_protocols[i] = protocol;
+        nfc_scanner_set_data(cache->base_data, protocol, instance->base_data[protocol]);
+    }
+
+    cache->protocols_num = instance->detected_protocols_num;
+    memcpy(
+        cache->protocols,
+        instance->detected_protocols,
+        instance->detected_protocols_num * sizeof(NfcProtocol));
+}
+
+static void nfc_scanner_detection_complete(NfcScanner* instance) {
+    if(instance->mode == NfcScannerModeFast) {
+        nfc_scanner_cache_update(instance);
+    }
+    instance->state = NfcScannerStateComplete;
+}
+
+void nfc_scanner_state_handler_idle(NfcScanner* instance) {
+    if(instance->mode == NfcScannerModeFast) {
+        for(size_t i = 0; i < COUNT_OF(nfc_scanner_fast_base_protocols); i++) {
+            nfc_scanner_add_base_protocol(instance, nfc_scanner_fast_base_protocols[i]);
         }
     }
+    for(size_t i = 0; i < NfcProtocolNum; i++) {
+        nfc_scanner_add_base_protocol(instance, i);
+    }
     FURI_LOG_D(TAG, "Found %zu base protocols", instance->base_protocols_num);
 
     instance->first_detected_protocol = NfcProtocolInvalid;
@@ -94,6 +220,10 @@ void nfc_scanner_state_handler_try_base_pollers(NfcScanner* instance) {
 
         NfcPoller* poller = nfc_poller_alloc(instance->nfc, instance->current_protocol);
         bool protocol_detected = nfc_poller_detect(poller);
+        if(protocol_detected && (instance->mode == NfcScannerModeFast)) {
+            nfc_scanner_set_data(
+                instance->base_data, instance->current_protocol, nfc_poller_get_data(poller));
+        }
         nfc_poller_free(poller);
 
         if(protocol_detected) {
@@ -117,6 +247,17 @@ void nfc_scanner_state_handler_try_base_pollers(NfcScanner* instance) {
 }
 
 void nfc_scanner_state_handler_find_children_protocols(NfcScanner* instance) {
+    if((instance->mode == NfcScannerModeFast) && nfc_scanner_cache_is_hit(instance)) {
+        instance->detected_protocols_num = instance->cache.protocols_num;
+        memcpy(
+            instance->detected_protocols,
+            instance->cache.protocols,
+            instance->cache.protocols_num * sizeof(NfcProtocol));
+        instance->state = NfcScannerStateComplete;
+        FURI_LOG_D(TAG, "Same card, cached result is used");
+        return;
+    }
+
     for(size_t i = 0; i < NfcProtocolNum; i++) {
         for(size_t j = 0; j < instance->detected_base_protocols_num; j++) {
             if(nfc_protocol_has_parent(i, instance->detected_base_protocols[j])) {
@@ -129,7 +270,7 @@ void nfc_scanner_state_handler_find_children_protocols(NfcScanner* instance) {
     if(instance->children_protocols_num > 0) {
         instance->state = NfcScannerStateDetectChildrenProtocols;
     } else {
-        instance->state = NfcScannerStateComplete;
+        nfc_scanner_detection_complete(instance);
     }
     FURI_LOG_D(TAG, "Found %zu children", instance->children_protocols_num);
 }
@@ -139,9 +280,20 @@ void nfc_scanner_state_handler_detect_children_protocols(NfcScanner* instance) {
 
     instance->current_protocol = instance->children_protocols[instance->children_protocols_idx];
 
-    NfcPoller* poller = nfc_poller_alloc(instance->nfc, instance->current_protocol);
-    bool protocol_detected = nfc_poller_detect(poller);
-    nfc_poller_free(poller);
+    const NfcPollerBase* poller_api = nfc_pollers_api[instance->current_protocol];
+    const NfcDeviceData* parent_data = NULL;
+    if((instance->mode == NfcScannerModeFast) && poller_api->detect_from_parent) {
+        parent_data = nfc_scanner_get_parent_data(instance, instance->current_protocol);
+    }
+
+    bool protocol_detected = false;
+    if(parent_data) {
+        protocol_detected = poller_api->detect_from_parent(parent_data);
+    } else {
+        NfcPoller* poller = nfc_poller_alloc(instance->nfc, instance->current_protocol);
+        protocol_detected = nfc_poller_detect(poller);
+        nfc_poller_free(poller);
+    }
 
     if(protocol_detected) {
         instance->detected_protocols[instance->detected_protocols_num] =
@@ -151,7 +303,7 @@ void nfc_scanner_state_handler_detect_children_protocols(NfcScanner* instance) {
 
     instance->children_protocols_idx++;
     if(instance->children_protocols_idx == instance->children_protocols_num) {
-        instance->state = NfcScannerStateComplete;
+        nfc_scanner_detection_complete(instance);
     }
 }
 
@@ -230,9 +382,29 @@ void nfc_scanner_free(NfcScanner* instance) {
     furi_check(instance);
     furi_check(instance->state == NfcScannerStateIdle);
 
+    nfc_scanner_free_data(instance->base_data);
+    nfc_scanner_free_data(instance->cache.base_data);
+
     free(instance);
 }
 
+void nfc_scanner_set_mode(NfcScanner* instance, NfcScannerMode mode) {
+    furi_check(instance);
+    furi_check(mode < NfcScannerModeNum);
+    furi_check(instance->scan_worker == NULL);
+
+    instance->mode = mode;
+}
+
+void nfc_scanner_reset_cache(NfcScanner* instance) {
+    furi_check(instance);
+    furi_check(instance->scan_worker == NULL);
+
+    instance->cache.base_protocols_num = 0;
+    instance->cache.protocols_num = 0;
+    nfc_scanner_free_data(instance->cache.base_data);
+}
+
 void nfc_scanner_start(NfcScanner* instance, NfcScannerCallback callback, void* context) {
     furi_check(instance);
     furi_check(callback);
@@ -11,6 +11,12 @@
  *
  * If no supported cards are in the vicinity, the scanning process will continue
  * until stopped explicitly.
+ *
+ * In the fast mode (see nfc_scanner_set_mode()) the detection result is the same, but it is
+ * obtained with fewer poller sessions: base protocols are probed grouped by technology,
+ * child protocols which can be told apart by the data received during the base protocol
+ * activation (e.g. SAK or ATQB) are detected without polling the card again, and the last
+ * result is reused when the same card is presented again.
  */
 #pragma once
 
@@ -26,6 +32,16 @@ extern "C" {
  */
 typedef struct NfcScanner NfcScanner;
 
+/**
+ * @brief Scanning mode.
+ */
+typedef enum {
+    NfcScannerModeDefault, /**< Each protocol is detected in its own poller session. */
+    NfcScannerModeFast, /**< Reuse base protocol data and cache the last result. */
+
+    NfcScannerModeNum, /**< Special value representing the number of available modes. */
+} NfcScannerMode;
+
 /**
  * @brief Event type passed to the user callback.
  */
@@ -76,6 +92,32 @@ NfcScanner* nfc_scanner_alloc(Nfc* nfc);
  */
 void nfc_scanner_free(NfcScanner* instance);
 
+/**
+ * @brief Set the NfcScanner mode.
+ *
+ * Must be called when the scanner is stopped. The default mode is NfcScannerModeDefault.
+ *
+ * The fast mode cache is kept for the lifetime of the instance, so the scanner should
+ * be allocated once and restarted in order to benefit from it.
+ *
+ * @param[in,out] instance pointer to the instance to be configured.
+ * @param[in] mode scanning mode to be used.
+ */
+void nfc_scanner_set_mode(NfcScanner* instance, NfcScannerMode mode);
+
+/**
+ * @brief Forget the last result kept by the fast mode.
+ *
+ * The cached result is reused as long as the card answers with the same base protocol data,
+ * which a different card may also do. Call this function when the detected protocol turns
+ * out to be wrong (e.g. reading the card fails), so that the next scan detects it again.
+ *
+ * Must be called when the scanner is stopped.
+ *
+ * @param[in,out] instance pointer to the instance to be reset.
+ */
+void nfc_scanner_reset_cache(NfcScanner* instance);
+
 /**
  * @brief Start an NfcScanner.
  *
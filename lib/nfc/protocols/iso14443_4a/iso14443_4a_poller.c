@@ -143,6 +143,12 @@ static bool iso14443_4a_poller_detect(NfcGenericEvent event, void* context) {
     return protocol_detected;
 }
 
+static bool iso14443_4a_poller_detect_from_parent(const Iso14443_3aData* iso14443_3a_data) {
+    furi_assert(iso14443_3a_data);
+
+    return iso14443_3a_supports_iso14443_4(iso14443_3a_data);
+}
+
 const NfcPollerBase nfc_poller_iso14443_4a = {
     .alloc = (NfcPollerAlloc)iso14443_4a_poller_alloc,
     .free = (NfcPollerFree)iso14443_4a_poller_free,
@@ -150,4 +156,5 @@ const NfcPollerBase nfc_poller_iso14443_4a = {
     .run = (NfcPollerRun)iso14443_4a_poller_run,
     .detect = (NfcPollerDetect)iso14443_4a_poller_detect,
     .get_data = (NfcPollerGetData)iso14443_4a_poller_get_data,
+    .detect_from_parent = (NfcPollerDetectFromParent)iso14443_4a_poller_detect_from_parent,
 };
@@ -128,6 +128,12 @@ static bool iso14443_4b_poller_detect(NfcGenericEvent event, void* context) {
     return protocol_detected;
 }
 
+static bool iso14443_4b_poller_detect_from_parent(const Iso14443_3bData* iso14443_3b_data) {
+    furi_assert(iso14443_3b_data);
+
+    return iso14443_3b_supports_iso14443_4(iso14443_3b_data);
+}
+
 const NfcPollerBase nfc_poller_iso14443_4b = {
     .alloc = (NfcPollerAlloc)iso14443_4b_poller_alloc,
     .free = (NfcPollerFree)iso14443_4b_poller_free,
@@ -135,4 +141,5 @@ const NfcPollerBase nfc_poller_iso14443_4b = {
     .run = (NfcPollerRun)iso14443_4b_poller_run,
     .detect = (NfcPollerDetect)iso14443_4b_poller_detect,
     .get_data = (NfcPollerGetData)iso14443_4b_poller_get_data,
+    .detect_from_parent = (NfcPollerDetectFromParent)iso14443_4b_poller_detect_from_parent,
 };
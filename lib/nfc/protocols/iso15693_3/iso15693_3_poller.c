@@ -104,8 +104,8 @@ static bool iso15693_3_poller_detect(NfcGenericEvent event, void* context) {
     furi_assert(instance->state == Iso15693_3PollerStateIdle);
 
     if(nfc_event->type == NfcEventTypePollerReady) {
-        uint8_t uid[ISO15693_3_UID_SIZE];
-        Iso15693_3Error error = iso15693_3_poller_inventory(instance, uid);
+        // Keep the UID so that child protocols can be detected from it
+        Iso15693_3Error error = iso15693_3_poller_inventory(instance, instance->data->uid);
         protocol_detected = (error == Iso15693_3ErrorNone);
     }
 
@@ -505,14 +505,30 @@ NfcCommand mf_classic_poller_handler_request_read_sector_blocks(MfClassicPoller*
     return command;
 }
 
+static bool mf_classic_poller_dict_attack_is_key_reused(
+    MfClassicPollerDictAttackContext* dict_attack_ctx,
+    const MfClassicKey* key) {
+    for(size_t i = 0; i < dict_attack_ctx->reused_keys_num; i++) {
+        if(memcmp(&dict_attack_ctx->reused_keys[i], key, sizeof(MfClassicKey)) == 0) return true;
+    }
+
+    return false;
+}
+
 NfcCommand mf_classic_poller_handler_request_key(MfClassicPoller* instance) {
     NfcCommand command = NfcCommandContinue;
     MfClassicPollerDictAttackContext* dict_attack_ctx = &instance->mode_ctx.dict_attack_ctx;
+    MfClassicPollerEventDataKeyRequest* key_request = &instance->mfc_event_data.key_request_data;
 
-    instance->mfc_event.type = MfClassicPollerEventTypeRequestKey;
-    command = instance->callback(instance->general_event, instance->context);
-    if(instance->mfc_event_data.key_request_data.key_provided) {
-        dict_attack_ctx->current_key = instance->mfc_event_data.key_request_data.key;
+    // Keys already reused on this and all following sectors are skipped without auth
+    do {
+        instance->mfc_event.type = MfClassicPollerEventTypeRequestKey;
+        command = instance->callback(instance->general_event, instance->context);
+    } while(command == NfcCommandContinue && key_request->key_provided &&
+            mf_classic_poller_dict_attack_is_key_reused(dict_attack_ctx, &key_request->key));
+
+    if(key_request->key_provided) {
+        dict_attack_ctx->current_key = key_request->key;
         instance->state = MfClassicPollerStateAuthKeyA;
     } else {
         instance->state = MfClassicPollerStateNextSector;
@@ -664,6 +680,12 @@ NfcCommand mf_classic_poller_handler_read_sector(MfClassicPoller* instance) {
         if(dict_attack_ctx->current_sector == instance->sectors_total) {
             instance->state = MfClassicPollerStateNextSector;
         } else {
+            if(!mf_classic_poller_dict_attack_is_key_reused(
+                   dict_attack_ctx, &dict_attack_ctx->current_key) &&
+               dict_attack_ctx->reused_keys_num < COUNT_OF(dict_attack_ctx->reused_keys)) {
+                dict_attack_ctx->reused_keys[dict_attack_ctx->reused_keys_num++] =
+                    dict_attack_ctx->current_key;
+            }
             dict_attack_ctx->reuse_key_sector = dict_attack_ctx->current_sector;
             instance->mfc_event.type = MfClassicPollerEventTypeKeyAttackStart;
             instance->mfc_event_data.key_attack_data.current_sector =
@@ -70,6 +70,8 @@ typedef struct {
     bool auth_passed;
     uint16_t current_block;
     uint8_t reuse_key_sector;
+    MfClassicKey reused_keys[MF_CLASSIC_TOTAL_SECTORS_MAX];
+    uint8_t reused_keys_num;
 } MfClassicPollerDictAttackContext;
 
 typedef struct {
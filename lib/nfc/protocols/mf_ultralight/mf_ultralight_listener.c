@@ -2,6 +2,7 @@
 #include "mf_ultralight_listener_defs.h"
 
 #include <lib/nfc/protocols/iso14443_3a/iso14443_3a_listener_i.h>
+#include <nfc/helpers/iso14443_crc.h>
 
 #include <furi.h>
 #include <furi_hal.h>
@@ -40,13 +41,15 @@ static void mf_ultralight_listener_send_short_resp(MfUltralightListener* instanc
     iso14443_3a_listener_tx(instance->iso14443_3a_listener, instance->tx_buffer);
 }
 
-static void mf_ultralight_listener_perform_read(
+// Returns true if every page was served from its own place, without restricted page rollover
+static bool mf_ultralight_listener_perform_read(
     MfUltralightPage* pages,
     MfUltralightListener* instance,
     uint16_t start_page,
     uint8_t page_cnt,
     bool do_i2c_page_check) {
     uint16_t pages_total = instance->data->pages_total;
+    bool direct = true;
     mf_ultralight_mirror_read_prepare(start_page, instance);
     for(uint8_t i = 0, rollover = 0; i < page_cnt; i++) {
         uint16_t page = start_page + i;
@@ -64,11 +67,84 @@ static void mf_ultralight_listener_perform_read(
 
             page = page_restricted ? rollover++ : page % pages_total;
             pages[i] = instance->data->page[page];
+            direct &= !page_restricted;
 
             mf_ultralight_mirror_read_handler(page, pages[i].data, instance);
         }
     }
-    mf_ultralight_single_counter_try_increase(instance);
+
+    return direct;
+}
+
+static MfUltralightListenerCacheWindow*
+    mf_ultralight_listener_cache_provide(MfUltralightListener* instance, uint16_t page) {
+    MfUltralightListenerCacheWindow* window =
+        mf_ultralight_listener_cache_get_window(instance, page);
+
+    if(window && !window->valid) {
+        uint16_t start_page = page - page % MF_ULTRALIGHT_LISTENER_CACHE_WINDOW_PAGES;
+        MfUltralightPage pages[MF_ULTRALIGHT_LISTENER_CACHE_WINDOW_PAGES] = {};
+        window->direct = mf_ultralight_listener_perform_read(
+            pages, instance, start_page, COUNT_OF(pages), false);
+
+        bit_buffer_copy_bytes(instance->tx_buffer, (uint8_t*)pages, sizeof(pages));
+        iso14443_crc_append(Iso14443CrcTypeA, instance->tx_buffer);
+        bit_buffer_write_bytes(instance->tx_buffer, window->frame, sizeof(window->frame));
+        window->valid = true;
+    }
+
+    return window;
+}
+
+static bool mf_ultralight_listener_cache_read(MfUltralightListener* instance, uint16_t page) {
+    bool cached = false;
+
+    if(page % MF_ULTRALIGHT_LISTENER_CACHE_WINDOW_PAGES == 0) {
+        MfUltralightListenerCacheWindow* window =
+            mf_ultralight_listener_cache_provide(instance, page);
+        if(window) {
+            bit_buffer_copy_bytes(instance->tx_buffer, window->frame, sizeof(window->frame));
+            iso14443_3a_listener_tx(instance->iso14443_3a_listener, instance->tx_buffer);
+            cached = true;
+        }
+    }
+
+    return cached;
+}
+
+static bool mf_ultralight_listener_cache_fast_read(
+    MfUltralightListener* instance,
+    uint16_t start_page,
+    uint16_t end_page) {
+    bool cached = true;
+
+    uint16_t start_window = start_page / MF_ULTRALIGHT_LISTENER_CACHE_WINDOW_PAGES;
+    uint16_t end_window = end_page / MF_ULTRALIGHT_LISTENER_CACHE_WINDOW_PAGES;
+    for(uint16_t i = start_window; i <= end_window; i++) {
+        MfUltralightListenerCacheWindow* window = mf_ultralight_listener_cache_provide(
+            instance, i * MF_ULTRALIGHT_LISTENER_CACHE_WINDOW_PAGES);
+        if(!window || !window->direct) {
+            cached = false;
+            break;
+        }
+    }
+
+    if(cached) {
+        bit_buffer_reset(instance->tx_buffer);
+        for(uint16_t page = start_page; page <= end_page; page++) {
+            MfUltralightListenerCacheWindow* window =
+                mf_ultralight_listener_cache_get_window(instance, page);
+            uint8_t offset = page % MF_ULTRALIGHT_LISTENER_CACHE_WINDOW_PAGES;
+            bit_buffer_append_bytes(
+                instance->tx_buffer,
+                &window->frame[offset * MF_ULTRALIGHT_PAGE_SIZE],
+                MF_ULTRALIGHT_PAGE_SIZE);
+        }
+        iso14443_3a_listener_send_standard_frame(
+            instance->iso14443_3a_listener, instance->tx_buffer);
+    }
+
+    return cached;
 }
 
 static MfUltralightCommand mf_ultralight_listener_perform_write(
@@ -93,6 +169,11 @@ static MfUltralightCommand mf_ultralight_listener_perform_write(
         memcpy(instance->data->page[page].data, rx_data, sizeof(MfUltralightPage));
     }
 
+    // Lock and configuration pages change access to the others, drop every window
+    if(command == MfUltralightCommandProcessedACK) {
+        mf_ultralight_listener_cache_invalidate(instance);
+    }
+
     return command;
 }
 
@@ -118,12 +199,15 @@ static MfUltralightCommand
             break;
         }
 
-        MfUltralightPage pages[4] = {};
-        mf_ultralight_listener_perform_read(pages, instance, start_page, 4, do_i2c_check);
+        if(!mf_ultralight_listener_cache_read(instance, start_page)) {
+            MfUltralightPage pages[4] = {};
+            mf_ultralight_listener_perform_read(pages, instance, start_page, 4, do_i2c_check);
 
-        bit_buffer_copy_bytes(instance->tx_buffer, (uint8_t*)pages, sizeof(pages));
-        iso14443_3a_listener_send_standard_frame(
-            instance->iso14443_3a_listener, instance->tx_buffer);
+            bit_buffer_copy_bytes(instance->tx_buffer, (uint8_t*)pages, sizeof(pages));
+            iso14443_3a_listener_send_standard_frame(
+                instance->iso14443_3a_listener, instance->tx_buffer);
+        }
+        mf_ultralight_single_counter_try_increase(instance);
         command = MfUltralightCommandProcessed;
 
     } while(false);
@@ -167,13 +251,17 @@ static MfUltralightCommand
             break;
         }
 
-        MfUltralightPage pages[64] = {};
-        uint8_t page_cnt = (end_page - start_page) + 1;
-        mf_ultralight_listener_perform_read(pages, instance, start_page, page_cnt, do_i2c_check);
+        if(!mf_ultralight_listener_cache_fast_read(instance, start_page, end_page)) {
+            MfUltralightPage pages[64] = {};
+            uint8_t page_cnt = (end_page - start_page) + 1;
+            mf_ultralight_listener_perform_read(
+                pages, instance, start_page, page_cnt, do_i2c_check);
 
-        bit_buffer_copy_bytes(instance->tx_buffer, (uint8_t*)pages, page_cnt * 4);
-        iso14443_3a_listener_send_standard_frame(
-            instance->iso14443_3a_listener, instance->tx_buffer);
+            bit_buffer_copy_bytes(instance->tx_buffer, (uint8_t*)pages, page_cnt * 4);
+            iso14443_3a_listener_send_standard_frame(
+                instance->iso14443_3a_listener, instance->tx_buffer);
+        }
+        mf_ultralight_single_counter_try_increase(instance);
         command = MfUltralightCommandProcessed;
     } while(false);
 
@@ -343,6 +431,7 @@ static MfUltralightCommand mf_ultralight_listener_increase_counter_handler(
             break;
 
         instance->data->counter[counter_num].counter += incr_value;
+        mf_ultralight_listener_cache_invalidate(instance);
         command = MfUltralightCommandProcessedACK;
     } while(false);
 
@@ -700,6 +789,7 @@ static void mf_ultralight_listener_prepare_emulation(MfUltralightListener* insta
     mf_ultralight_mirror_prepare_emulation(instance);
     mf_ultralight_static_lock_bytes_prepare(instance);
     mf_ultralight_dynamic_lock_bytes_prepare(instance);
+    mf_ultralight_listener_cache_alloc(instance);
 }
 
 static NfcCommand mf_ultralight_command_postprocess(
@@ -765,6 +855,7 @@ void mf_ultralight_listener_free(MfUltralightListener* instance) {
     furi_assert(instance->data);
     furi_assert(instance->tx_buffer);
 
+    mf_ultralight_listener_cache_free(instance);
     bit_buffer_free(instance->tx_buffer);
     furi_string_free(instance->mirror.ascii_mirror_data);
     mbedtls_des3_free(&instance->des_context);
@@ -206,6 +206,53 @@ void mf_ultraligt_mirror_format_counter(MfUltralightListener* instance) {
     furi_string_cat_printf(instance->mirror.ascii_mirror_data, "%02X%02X%02X", c[2], c[1], c[0]);
 }
 
+void mf_ultralight_listener_cache_alloc(MfUltralightListener* instance) {
+    MfUltralightListenerCache* cache = &instance->cache;
+
+    // I2C tags remap pages depending on the selected sector, keep them on the direct path
+    cache->windows_count = 0;
+    cache->windows = NULL;
+    if(!mf_ultralight_is_i2c_tag(instance->data->type)) {
+        cache->windows_count = (instance->data->pages_total +
+                                MF_ULTRALIGHT_LISTENER_CACHE_WINDOW_PAGES - 1) /
+                               MF_ULTRALIGHT_LISTENER_CACHE_WINDOW_PAGES;
+    }
+    if(cache->windows_count) {
+        cache->windows = malloc(cache->windows_count * sizeof(MfUltralightListenerCacheWindow));
+    }
+    mf_ultralight_listener_cache_invalidate(instance);
+}
+
+void mf_ultralight_listener_cache_free(MfUltralightListener* instance) {
+    free(instance->cache.windows);
+    instance->cache.windows = NULL;
+    instance->cache.windows_count = 0;
+}
+
+void mf_ultralight_listener_cache_invalidate(MfUltralightListener* instance) {
+    MfUltralightListenerCache* cache = &instance->cache;
+
+    for(size_t i = 0; i < cache->windows_count; i++) {
+        cache->windows[i].valid = false;
+    }
+    cache->auth_state = instance->auth_state;
+}
+
+MfUltralightListenerCacheWindow*
+    mf_ultralight_listener_cache_get_window(MfUltralightListener* instance, uint16_t page) {
+    MfUltralightListenerCache* cache = &instance->cache;
+    uint16_t window = page / MF_ULTRALIGHT_LISTENER_CACHE_WINDOW_PAGES;
+
+    if(window >= cache->windows_count) return NULL;
+
+    // Access checks and mirror mode depend on authentication, so do cached responses
+    if(cache->auth_state != instance->auth_state) {
+        mf_ultralight_listener_cache_invalidate(instance);
+    }
+
+    return &cache->windows[window];
+}
+
 bool mf_ultralight_composite_command_in_progress(MfUltralightListener* instance) {
     return instance->composite_cmd.callback != NULL;
 }
@@ -234,6 +281,7 @@ void mf_ultralight_single_counter_try_increase(MfUltralightListener* instance) {
         if(instance->data->counter[2].counter < MF_ULTRALIGHT_MAX_CNTR_VAL) {
             instance->data->counter[2].counter++;
             mf_ultraligt_mirror_format_counter(instance);
+            mf_ultralight_listener_cache_invalidate(instance);
         }
         instance->single_counter_increased = true;
     }
@@ -47,6 +47,22 @@ typedef struct {
     FuriString* ascii_mirror_data;
 } MfUltralightMirrorMode;
 
+#define MF_ULTRALIGHT_LISTENER_CACHE_WINDOW_PAGES (4)
+#define MF_ULTRALIGHT_LISTENER_CACHE_FRAME_SIZE \
+    (MF_ULTRALIGHT_LISTENER_CACHE_WINDOW_PAGES * MF_ULTRALIGHT_PAGE_SIZE + 2)
+
+typedef struct {
+    uint8_t frame[MF_ULTRALIGHT_LISTENER_CACHE_FRAME_SIZE];
+    bool valid;
+    bool direct;
+} MfUltralightListenerCacheWindow;
+
+typedef struct {
+    MfUltralightListenerCacheWindow* windows;
+    uint16_t windows_count;
+    MfUltralightListenerAuthState auth_state;
+} MfUltralightListenerCache;
+
 typedef uint16_t MfUltralightStaticLockData;
 typedef uint32_t MfUltralightDynamicLockData;
 
@@ -68,6 +84,7 @@ struct MfUltralightListener {
     bool single_counter_increased;
     MfUltralightMirrorMode mirror;
     MfUltralightListenerCompositeCommandContext composite_cmd;
+    MfUltralightListenerCache cache;
     mbedtls_des3_context des_context;
     uint8_t rndB[MF_ULTRALIGHT_C_AUTH_RND_BLOCK_SIZE];
     uint8_t encB[MF_ULTRALIGHT_C_AUTH_RND_BLOCK_SIZE];
@@ -79,6 +96,12 @@ void mf_ultralight_single_counter_try_to_unlock(
     MfUltralightListener* instance,
     Iso14443_3aListenerEventType type);
 
+void mf_ultralight_listener_cache_alloc(MfUltralightListener* instance);
+void mf_ultralight_listener_cache_free(MfUltralightListener* instance);
+void mf_ultralight_listener_cache_invalidate(MfUltralightListener* instance);
+MfUltralightListenerCacheWindow*
+    mf_ultralight_listener_cache_get_window(MfUltralightListener* instance, uint16_t page);
+
 void mf_ultralight_mirror_prepare_emulation(MfUltralightListener* instance);
 void mf_ultraligt_mirror_format_counter(MfUltralightListener* instance);
 void mf_ultralight_mirror_read_prepare(uint8_t start_page, MfUltralightListener* instance);
@@ -110,6 +110,20 @@ typedef bool (*NfcPollerDetect)(NfcGenericEvent event, void* context);
  */
 typedef const NfcDeviceData* (*NfcPollerGetData)(const NfcGenericInstance* instance);
 
+/**
+ * @brief Determine whether a card supports the protocol based on the parent protocol data.
+ *
+ * Optional. Implemented by child protocols whose NfcPollerDetect only inspects data
+ * that the parent poller has already gathered during activation (e.g. SAK or UID), so that
+ * a detection result can be reused without starting another poller session.
+ *
+ * The result must be the same as returned by NfcPollerDetect for the same card.
+ *
+ * @param[in] parent_data pointer to the parent protocol data gathered by the parent poller.
+ * @returns true if a supported card was detected, false otherwise.
+ */
+typedef bool (*NfcPollerDetectFromParent)(const NfcDeviceData* parent_data);
+
 /**
  * @brief Generic NFC poller interface.
  *
@@ -125,6 +139,7 @@ typedef struct {
     NfcPollerRun run; /**< Pointer to the run() function. */
     NfcPollerDetect detect; /**< Pointer to the detect() function. */
     NfcPollerGetData get_data; /**< Pointer to the get_data() function. */
+    NfcPollerDetectFromParent detect_from_parent; /**< Optional, may be NULL. */
 } NfcPollerBase;
 
 #ifdef __cplusplus
@@ -1,19 +1,10 @@
 #include "maxim_crc.h"
 #include <furi.h>
+#include <toolbox/crc.h>
 
 uint8_t maxim_crc8(const uint8_t* data, const uint8_t data_size, const uint8_t crc_init) {
     furi_check(data);
 
-    uint8_t crc = crc_init;
-
-    for(uint8_t index = 0; index < data_size; ++index) {
-        uint8_t input_byte = data[index];
-        for(uint8_t bit_position = 0; bit_position < 8; ++bit_position) {
-            const uint8_t mix = (crc ^ input_byte) & (uint8_t)(0x01);
-            crc >>= 1;
-            if(mix != 0) crc ^= 0x8C;
-            input_byte >>= 1;
-        }
-    }
-    return crc;
+    // Model has no final XOR, so the register is the CRC and can be chained
+    return crc_update(&crc_model_maxim, crc_init, data, data_size);
 }
@@ -20,6 +20,22 @@ void subghz_block_generic_get_preset_name(const char* preset_name, FuriString* p
     furi_string_set(preset_str, preset_name_temp);
 }
 
+const char* subghz_block_generic_get_preset_short_name(const char* preset_name) {
+    const char* preset_name_temp = NULL;
+    if(!strcmp(preset_name, "FuriHalSubGhzPresetOok270Async")) {
+        preset_name_temp = "AM270";
+    } else if(!strcmp(preset_name, "FuriHalSubGhzPresetOok650Async")) {
+        preset_name_temp = "AM650";
+    } else if(!strcmp(preset_name, "FuriHalSubGhzPreset2FSKDev238Async")) {
+        preset_name_temp = "FM238";
+    } else if(!strcmp(preset_name, "FuriHalSubGhzPreset2FSKDev476Async")) {
+        preset_name_temp = "FM476";
+    } else if(!strcmp(preset_name, "FuriHalSubGhzPresetCustom")) {
+        preset_name_temp = "CUSTOM";
+    }
+    return preset_name_temp;
+}
+
 SubGhzProtocolStatus subghz_block_generic_serialize(
     SubGhzBlockGeneric* instance,
     FlipperFormat* flipper_format,
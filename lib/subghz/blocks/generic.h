@@ -31,6 +31,13 @@ struct SubGhzBlockGeneric {
  */
 void subghz_block_generic_get_preset_name(const char* preset_name, FuriString* preset_str);
 
+/**
+ * Get short name preset, inverse of subghz_block_generic_get_preset_name.
+ * @param preset_name Full name preset, as stored in a file
+ * @return Short name preset, NULL if preset is unknown
+ */
+const char* subghz_block_generic_get_preset_short_name(const char* preset_name);
+
 /**
  * Serialize data SubGhzBlockGeneric.
  * @param instance Pointer to a SubGhzBlockGeneric instance
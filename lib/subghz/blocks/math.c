@@ -1,5 +1,7 @@
 #include "math.h"
 
+#include <toolbox/crc.h>
+
 uint64_t subghz_protocol_blocks_reverse_key(uint64_t key, uint8_t bit_count) {
     uint64_t reverse_key = 0;
     for(uint8_t i = 0; i < bit_count; i++) {
@@ -64,19 +66,8 @@ uint8_t subghz_protocol_blocks_crc8(
     size_t size,
     uint8_t polynomial,
     uint8_t init) {
-    uint8_t remainder = init;
-
-    for(size_t byte = 0; byte < size; ++byte) {
-        remainder ^= message[byte];
-        for(uint8_t bit = 0; bit < 8; ++bit) {
-            if(remainder & 0x80) {
-                remainder = (remainder << 1) ^ polynomial;
-            } else {
-                remainder = (remainder << 1);
-            }
-        }
-    }
-    return remainder;
+    const CrcModel model = {.width = 8, .poly = polynomial, .init = init};
+    return crc_calculate(&model, message, size);
 }
 
 uint8_t subghz_protocol_blocks_crc8le(
@@ -84,20 +75,14 @@ uint8_t subghz_protocol_blocks_crc8le(
     size_t size,
     uint8_t polynomial,
     uint8_t init) {
-    uint8_t remainder = subghz_protocol_blocks_reverse_key(init, 8);
-    polynomial = subghz_protocol_blocks_reverse_key(polynomial, 8);
-
-    for(size_t byte = 0; byte < size; ++byte) {
-        remainder ^= message[byte];
-        for(uint8_t bit = 0; bit < 8; ++bit) {
-            if(remainder & 1) {
-                remainder = (remainder >> 1) ^ polynomial;
-            } else {
-                remainder = (remainder >> 1);
-            }
-        }
-    }
-    return remainder;
+    const CrcModel model = {
+        .width = 8,
+        .ref_in = true,
+        .ref_out = true,
+        .poly = polynomial,
+        .init = init,
+    };
+    return crc_calculate(&model, message, size);
 }
 
 uint16_t subghz_protocol_blocks_crc16lsb(
@@ -105,19 +90,14 @@ uint16_t subghz_protocol_blocks_crc16lsb(
     size_t size,
     uint16_t polynomial,
     uint16_t init) {
-    uint16_t remainder = init;
-
-    for(size_t byte = 0; byte < size; ++byte) {
-        remainder ^= message[byte];
-        for(uint8_t bit = 0; bit < 8; ++bit) {
-            if(remainder & 1) {
-                remainder = (remainder >> 1) ^ polynomial;
-            } else {
-                remainder = (remainder >> 1);
-            }
-        }
-    }
-    return remainder;
+    // Polynomial and init are given reflected, init is the register value
+    const CrcModel model = {
+        .width = 16,
+        .ref_in = true,
+        .ref_out = true,
+        .poly = subghz_protocol_blocks_reverse_key(polynomial, 16),
+    };
+    return crc_update(&model, init, message, size);
 }
 
 uint16_t subghz_protocol_blocks_crc16(
@@ -125,19 +105,8 @@ uint16_t subghz_protocol_blocks_crc16(
     size_t size,
     uint16_t polynomial,
     uint16_t init) {
-    uint16_t remainder = init;
-
-    for(size_t byte = 0; byte < size; ++byte) {
-        remainder ^= message[byte] << 8;
-        for(uint8_t bit = 0; bit < 8; ++bit) {
-            if(remainder & 0x8000) {
-                remainder = (remainder << 1) ^ polynomial;
-            } else {
-                remainder = (remainder << 1);
-            }
-        }
-    }
-    return remainder;
+    const CrcModel model = {.width = 16, .poly = polynomial, .init = init};
+    return crc_calculate(&model, message, size);
 }
 
 uint8_t subghz_protocol_blocks_lfsr_digest8(
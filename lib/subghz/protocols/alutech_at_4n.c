@@ -207,6 +207,12 @@ void* subghz_protocol_decoder_alutech_at_4n_alloc(SubGhzEnvironment* environment
         FURI_LOG_I(
             TAG, "Loading rainbow table from %s", instance->alutech_at_4n_rainbow_table_file_name);
     }
+    subghz_protocol_decoder_base_set_start_pulse(
+        &instance->base,
+        &instance->decoder.parser_step,
+        true,
+        subghz_protocol_alutech_at_4n_const.te_short,
+        subghz_protocol_alutech_at_4n_const.te_delta);
     return instance;
 }
 
@@ -192,6 +192,12 @@ void* subghz_protocol_decoder_ansonic_alloc(SubGhzEnvironment* environment) {
     SubGhzProtocolDecoderAnsonic* instance = malloc(sizeof(SubGhzProtocolDecoderAnsonic));
     instance->base.protocol = &subghz_protocol_ansonic;
     instance->generic.protocol_name = instance->base.protocol->name;
+    subghz_protocol_decoder_base_set_start_pulse(
+        &instance->base,
+        &instance->decoder.parser_step,
+        false,
+        subghz_protocol_ansonic_const.te_short * 35,
+        subghz_protocol_ansonic_const.te_delta * 35);
     return instance;
 }
 
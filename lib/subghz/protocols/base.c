@@ -11,6 +11,22 @@ void subghz_protocol_decoder_base_set_decoder_callback(
     decoder_base->context = context;
 }
 
+void subghz_protocol_decoder_base_set_start_pulse(
+    SubGhzProtocolDecoderBase* decoder_base,
+    const uint32_t* parser_step,
+    bool level,
+    uint32_t duration_center,
+    uint32_t duration_delta) {
+    furi_check(decoder_base);
+    furi_check(parser_step);
+
+    decoder_base->start_pulse.parser_step = parser_step;
+    decoder_base->start_pulse.level = level;
+    decoder_base->start_pulse.duration_min =
+        (duration_center > duration_delta) ? (duration_center - duration_delta) : 0;
+    decoder_base->start_pulse.duration_max = duration_center + duration_delta;
+}
+
 bool subghz_protocol_decoder_base_get_string(
     SubGhzProtocolDecoderBase* decoder_base,
     FuriString* output) {
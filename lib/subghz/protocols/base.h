@@ -15,6 +15,14 @@ typedef void (*SubGhzProtocolDecoderBaseSerialize)(
     SubGhzProtocolDecoderBase* decoder_base,
     FuriString* output);
 
+/** Pulse that can move an idle decoder out of its reset step */
+typedef struct {
+    const uint32_t* parser_step; ///< Decoder parser step, decoder is idle while it is 0
+    bool level; ///< Level of the start pulse
+    uint32_t duration_min; ///< Shortest accepted duration, us
+    uint32_t duration_max; ///< Longest accepted duration, us
+} SubGhzProtocolDecoderStartPulse;
+
 struct SubGhzProtocolDecoderBase {
     // Decoder general section
     const SubGhzProtocol* protocol;
@@ -22,6 +30,9 @@ struct SubGhzProtocolDecoderBase {
     // Callback section
     SubGhzProtocolDecoderBaseRxCallback callback;
     void* context;
+
+    // Receiver pre-filter section, optional
+    SubGhzProtocolDecoderStartPulse start_pulse;
 };
 
 /**
@@ -35,6 +46,26 @@ void subghz_protocol_decoder_base_set_decoder_callback(
     SubGhzProtocolDecoderBaseRxCallback callback,
     void* context);
 
+/**
+ * Declare the pulse that takes the decoder out of its reset step.
+ *
+ * SubGhzReceiver uses it to skip feeding idle decoders with pulses they would ignore anyway.
+ * Must only be used by decoders whose reset step does nothing but wait for a single
+ * `DURATION_DIFF(duration, duration_center) < duration_delta` pulse of the given level.
+ *
+ * @param decoder_base Pointer to a SubGhzProtocolDecoderBase instance
+ * @param parser_step Pointer to the decoder parser step, reset step must be 0
+ * @param level Level of the start pulse
+ * @param duration_center Center of the start pulse duration window, us
+ * @param duration_delta Allowed deviation from the center, us
+ */
+void subghz_protocol_decoder_base_set_start_pulse(
+    SubGhzProtocolDecoderBase* decoder_base,
+    const uint32_t* parser_step,
+    bool level,
+    uint32_t duration_center,
+    uint32_t duration_delta);
+
 /**
  * Getting a textual representation of the received data.
  * @param decoder_base Pointer to a SubGhzProtocolDecoderBase instance
@@ -211,6 +211,12 @@ void* subghz_protocol_decoder_bett_alloc(SubGhzEnvironment* environment) {
     SubGhzProtocolDecoderBETT* instance = malloc(sizeof(SubGhzProtocolDecoderBETT));
     instance->base.protocol = &subghz_protocol_bett;
     instance->generic.protocol_name = instance->base.protocol->name;
+    subghz_protocol_decoder_base_set_start_pulse(
+        &instance->base,
+        &instance->decoder.parser_step,
+        false,
+        subghz_protocol_bett_const.te_short * 44,
+        subghz_protocol_bett_const.te_delta * 15);
     return instance;
 }
 
@@ -6,6 +6,7 @@
 #include "../blocks/generic.h"
 #include "../blocks/math.h"
 #include <lib/toolbox/float_tools.h>
+#include <lib/toolbox/varint.h>
 #include <lib/toolbox/stream/stream.h>
 #include <lib/flipper_format/flipper_format_i.h>
 
@@ -16,6 +17,9 @@
 //change very carefully, RAM ends at the most inopportune moment
 #define BIN_RAW_BUF_RAW_SIZE  2048
 #define BIN_RAW_BUF_DATA_SIZE 512
+//durations are stored as varint, 3 bytes are enough for anything shorter than 1 second
+#define BIN_RAW_BUF_RAW_BYTES (BIN_RAW_BUF_RAW_SIZE * 3)
+#define BIN_RAW_VARINT_MAX    5
 
 #define BIN_RAW_THRESHOLD_RSSI     -85.0f
 #define BIN_RAW_DELTA_RSSI         7.0f
@@ -23,6 +27,9 @@
 #define BIN_RAW_TE_MIN_COUNT       40
 #define BIN_RAW_BUF_MIN_DATA_COUNT 128
 #define BIN_RAW_MAX_MARKUP_COUNT   20
+//classifier takes the first durations and skips garbage at the end of a short record
+#define BIN_RAW_CLASSIFY_COUNT     512
+#define BIN_RAW_CLASSIFY_SKIP_TAIL 100
 
 //#define BIN_RAW_DEBUG
 
@@ -65,15 +72,26 @@ struct BinRAW_Markup {
 };
 typedef struct BinRAW_Markup BinRAW_Markup;
 
+struct BinRAW_Class {
+    float data;
+    uint16_t count;
+};
+typedef struct BinRAW_Class BinRAW_Class;
+
 struct SubGhzProtocolDecoderBinRAW {
     SubGhzProtocolDecoderBase base;
 
     SubGhzBlockDecoder decoder;
     SubGhzBlockGeneric generic;
-    int32_t* data_raw;
+    uint8_t* data_raw;
     uint8_t* data;
     BinRAW_Markup data_markup[BIN_RAW_MAX_MARKUP_COUNT];
     size_t data_raw_ind;
+    size_t data_raw_size;
+    // Duration classifier, fed while recording
+    BinRAW_Class classes[BIN_RAW_SEARCH_CLASSES];
+    size_t classes_ind;
+    size_t classes_pos;
     uint32_t te;
     float adaptive_threshold_rssi;
 };
@@ -354,8 +372,8 @@ void* subghz_protocol_decoder_bin_raw_alloc(SubGhzEnvironment* environment) {
     instance->base.protocol = &subghz_protocol_bin_raw;
     instance->generic.protocol_name = instance->base.protocol->name;
     instance->data_raw_ind = 0;
-    instance->data_raw = malloc(BIN_RAW_BUF_RAW_SIZE * sizeof(int32_t));
-    instance->data = malloc(BIN_RAW_BUF_RAW_SIZE * sizeof(uint8_t));
+    instance->data_raw = malloc(BIN_RAW_BUF_RAW_BYTES * sizeof(uint8_t));
+    instance->data = malloc(BIN_RAW_BUF_DATA_SIZE * sizeof(uint8_t));
     memset(instance->data_markup, 0x00, BIN_RAW_MAX_MARKUP_COUNT * sizeof(BinRAW_Markup));
     instance->adaptive_threshold_rssi = BIN_RAW_THRESHOLD_RSSI;
     return instance;
@@ -377,65 +395,135 @@ void subghz_protocol_decoder_bin_raw_reset(void* context) {
 #else
     instance->decoder.parser_step = BinRAWDecoderStepNoParse;
     instance->data_raw_ind = 0;
+    instance->data_raw_size = 0;
 #endif
 }
 
+/**
+ * Read recorded duration and move to the next one
+ * @param instance Pointer to a SubGhzProtocolDecoderBinRAW* instance
+ * @param pos Byte offset of the duration, updated to the offset of the next one
+ * @return Duration, positive high, negative low
+ */
+static int32_t
+    subghz_protocol_bin_raw_get_raw_next(SubGhzProtocolDecoderBinRAW* instance, size_t* pos) {
+    int32_t duration;
+    *pos += varint_int32_unpack(
+        &duration, instance->data_raw + *pos, instance->data_raw_size - *pos);
+    return duration;
+}
+
+/**
+ * Move to the previous recorded duration and read it
+ * @param instance Pointer to a SubGhzProtocolDecoderBinRAW* instance
+ * @param pos Byte offset after the duration, updated to the offset of the duration
+ * @return Duration, positive high, negative low
+ */
+static int32_t
+    subghz_protocol_bin_raw_get_raw_prev(SubGhzProtocolDecoderBinRAW* instance, size_t* pos) {
+    //every varint byte except the last one has the continuation bit set
+    size_t start = *pos - 1;
+    while((start > 0) && (instance->data_raw[start - 1] & 0x80)) {
+        start--;
+    }
+    *pos = start;
+    return subghz_protocol_bin_raw_get_raw_next(instance, &start);
+}
+
+/**
+ * Put the next recorded duration into the classifier
+ * @param instance Pointer to a SubGhzProtocolDecoderBinRAW* instance
+ */
+static void subghz_protocol_bin_raw_classify_next(SubGhzProtocolDecoderBinRAW* instance) {
+    BinRAW_Class* classes = instance->classes;
+    float duration =
+        (float)(abs(subghz_protocol_bin_raw_get_raw_next(instance, &instance->classes_pos)));
+    instance->classes_ind++;
+
+    //sort the durations to find the shortest correlated interval
+    for(size_t k = 0; k < BIN_RAW_SEARCH_CLASSES; k++) {
+        if(classes[k].count == 0) {
+            classes[k].data = duration;
+            classes[k].count++;
+            break;
+        } else if(DURATION_DIFF(duration, (classes[k].data)) < (classes[k].data / 4)) {
+            //if the test value does not differ by more than 25%
+            classes[k].data += (duration - classes[k].data) * 0.05f; //running average k=0.05
+            classes[k].count++;
+            break;
+        }
+    }
+}
+
 void subghz_protocol_decoder_bin_raw_feed(void* context, bool level, uint32_t duration) {
     furi_assert(context);
     SubGhzProtocolDecoderBinRAW* instance = context;
 
     if(instance->decoder.parser_step == BinRAWDecoderStepWrite) {
-        if(instance->data_raw_ind == BIN_RAW_BUF_RAW_SIZE) {
+        if((instance->data_raw_ind == BIN_RAW_BUF_RAW_SIZE) ||
+           (instance->data_raw_size + BIN_RAW_VARINT_MAX > BIN_RAW_BUF_RAW_BYTES)) {
             instance->decoder.parser_step = BinRAWDecoderStepBufFull;
         } else {
-            instance->data_raw[instance->data_raw_ind++] = (level ? duration : -duration);
+            instance->data_raw_size += varint_int32_pack(
+                (level ? duration : -duration), instance->data_raw + instance->data_raw_size);
+            instance->data_raw_ind++;
+
+            //classify durations as they come, lagging behind to skip the end of the record
+            if((instance->classes_ind < BIN_RAW_CLASSIFY_COUNT) &&
+               (instance->classes_ind + BIN_RAW_CLASSIFY_SKIP_TAIL < instance->data_raw_ind)) {
+                subghz_protocol_bin_raw_classify_next(instance);
+            }
         }
     }
 }
 
+/**
+ * Compare two pieces of decoded data, bytes past the end of the buffer are read as zero
+ * @param instance Pointer to a SubGhzProtocolDecoderBinRAW* instance
+ * @param bias_1 Byte offset of the first piece
+ * @param bias_2 Byte offset of the second piece
+ * @param size Amount of bytes to compare
+ * @return true if pieces are equal
+ */
+static bool subghz_protocol_bin_raw_data_equal(
+    SubGhzProtocolDecoderBinRAW* instance,
+    size_t bias_1,
+    size_t bias_2,
+    size_t size) {
+    for(size_t i = 0; i < size; i++) {
+        if((bias_1 + i >= BIN_RAW_BUF_DATA_SIZE) && (bias_2 + i >= BIN_RAW_BUF_DATA_SIZE)) break;
+        uint8_t byte_1 = (bias_1 + i < BIN_RAW_BUF_DATA_SIZE) ? instance->data[bias_1 + i] : 0;
+        uint8_t byte_2 = (bias_2 + i < BIN_RAW_BUF_DATA_SIZE) ? instance->data[bias_2 + i] : 0;
+        if(byte_1 != byte_2) return false;
+    }
+    return true;
+}
+
 /** 
  * Analysis of received data
  * @param instance Pointer to a SubGhzProtocolDecoderBinRAW* instance
  */
 static bool
     subghz_protocol_bin_raw_check_remote_controller(SubGhzProtocolDecoderBinRAW* instance) {
-    struct {
-        float data;
-        uint16_t count;
-    } classes[BIN_RAW_SEARCH_CLASSES];
+    BinRAW_Class classes[BIN_RAW_SEARCH_CLASSES];
 
     size_t ind = 0;
-
-    memset(classes, 0x00, sizeof(classes));
+    size_t pos = 0;
 
     uint16_t data_markup_ind = 0;
     memset(instance->data_markup, 0x00, BIN_RAW_MAX_MARKUP_COUNT * sizeof(BinRAW_Markup));
 
-    if(instance->data_raw_ind < 512) {
-        ind =
-            instance->data_raw_ind -
-            100; //there is usually garbage at the end of the record, we exclude it from the classification
+    //most of the durations are already classified while recording, finish the rest
+    if(instance->data_raw_ind < BIN_RAW_CLASSIFY_COUNT) {
+        //there is usually garbage at the end of the record, we exclude it from the classification
+        ind = instance->data_raw_ind - BIN_RAW_CLASSIFY_SKIP_TAIL;
     } else {
-        ind = 512;
+        ind = BIN_RAW_CLASSIFY_COUNT;
     }
-
-    //sort the durations to find the shortest correlated interval
-    for(size_t i = 0; i < ind; i++) {
-        for(size_t k = 0; k < BIN_RAW_SEARCH_CLASSES; k++) {
-            if(classes[k].count == 0) {
-                classes[k].data = (float)(abs(instance->data_raw[i]));
-                classes[k].count++;
-                break;
-            } else if(
-                DURATION_DIFF((float)(abs(instance->data_raw[i])), (classes[k].data)) <
-                (classes[k].data / 4)) { //if the test value does not differ by more than 25%
-                classes[k].data += ((float)(abs(instance->data_raw[i])) - classes[k].data) *
-                                   0.05f; //running average k=0.05
-                classes[k].count++;
-                break;
-            }
-        }
+    while(instance->classes_ind < ind) {
+        subghz_protocol_bin_raw_classify_next(instance);
     }
+    memcpy(classes, instance->classes, sizeof(classes));
 
     // if(classes[BIN_RAW_SEARCH_CLASSES - 1].count != 0) {
     //     //filling the classifier, it means that they received an unclean signal
@@ -529,11 +617,15 @@ static bool
             bin_raw_type = BinRAWTypeGap;
             //looking for the last occurrence of gap
             ind = instance->data_raw_ind - 1;
-            while((ind > 0) &&
-                  (DURATION_DIFF(abs(instance->data_raw[ind]), (int32_t)gap) > gap_delta)) {
+            pos = instance->data_raw_size;
+            while(true) {
+                int32_t duration = abs(subghz_protocol_bin_raw_get_raw_prev(instance, &pos));
+                if((DURATION_DIFF(duration, (int32_t)gap) <= gap_delta) || (ind == 0)) break;
                 ind--;
             }
             gap_ind = ind;
+            //gap at the very beginning, there is nothing before it
+            if(gap_ind == 0) return false;
         }
     }
 
@@ -545,7 +637,8 @@ static bool
         uint16_t bit_count = 0;
         do {
             gap_ind--;
-            data_temp = (int)(roundf((float)(instance->data_raw[gap_ind]) / instance->te));
+            int32_t duration = subghz_protocol_bin_raw_get_raw_prev(instance, &pos);
+            data_temp = (int)(roundf((float)(duration) / instance->te));
             bin_raw_debug("%d ", data_temp);
             if(data_temp == 0) bit_count++; //there is noise in the package
             for(size_t i = 0; i < (size_t)abs(data_temp); i++) {
@@ -564,7 +657,7 @@ static bool
                 }
             }
             //split into full bytes if gap is caught
-            if(DURATION_DIFF(abs(instance->data_raw[gap_ind]), (int32_t)gap) < gap_delta) {
+            if(DURATION_DIFF(abs(duration), (int32_t)gap) < gap_delta) {
                 instance->data_markup[data_markup_ind].byte_bias = ind >> 3;
                 instance->data_markup[data_markup_ind++].bit_count = bit_count;
                 bit_count = 0;
@@ -666,10 +759,11 @@ static bool
 
                     uint16_t byte_count =
                         subghz_protocol_bin_raw_get_full_byte(instance->data_markup[i].bit_count);
-                    if(memcmp(
-                           instance->data + instance->data_markup[i].byte_bias,
-                           instance->data + instance->data_markup[i + 1].byte_bias,
-                           byte_count - 1) == 0) {
+                    if(subghz_protocol_bin_raw_data_equal(
+                           instance,
+                           instance->data_markup[i].byte_bias,
+                           instance->data_markup[i + 1].byte_bias,
+                           byte_count - 1)) {
                         bin_raw_debug_tag(
                             TAG, "Match found bin_raw_type=BinRAWTypeGapRecurring\r\n\r\n");
 
@@ -716,14 +810,16 @@ static bool
                        subghz_protocol_bin_raw_get_full_byte(
                            instance->data_markup[y].bit_count)) { //if the length in bytes matches
 
-                        if((memcmp(
-                                instance->data + instance->data_markup[i].byte_bias,
-                                instance->data + instance->data_markup[y].byte_bias,
-                                byte_count - 1) == 0) &&
-                           (memcmp(
-                                instance->data + instance->data_markup[i + 1].byte_bias,
-                                instance->data + instance->data_markup[y + 1].byte_bias,
-                                byte_count - 1) == 0)) {
+                        if(subghz_protocol_bin_raw_data_equal(
+                               instance,
+                               instance->data_markup[i].byte_bias,
+                               instance->data_markup[y].byte_bias,
+                               byte_count - 1) &&
+                           subghz_protocol_bin_raw_data_equal(
+                               instance,
+                               instance->data_markup[i + 1].byte_bias,
+                               instance->data_markup[y + 1].byte_bias,
+                               byte_count - 1)) {
                             uint8_t index = 0;
 #ifdef BIN_RAW_DEBUG
                             bin_raw_debug_tag(
@@ -807,8 +903,10 @@ static bool
         // if bin_raw_type == BinRAWTypeGap
         bin_raw_debug_tag(TAG, "Sequence analysis without gap\r\n");
         ind = 0;
+        pos = 0;
         for(size_t i = 0; i < instance->data_raw_ind; i++) {
-            int data_temp = (int)(roundf((float)(instance->data_raw[i]) / instance->te));
+            int data_temp = (int)(roundf(
+                (float)(subghz_protocol_bin_raw_get_raw_next(instance, &pos)) / instance->te));
             if(data_temp == 0) break; //found an interval 2 times shorter than TE, this is noise
             bin_raw_debug("%d  ", data_temp);
 
@@ -890,8 +988,11 @@ void subghz_protocol_decoder_bin_raw_data_input_rssi(
         bin_raw_debug("%ld %ld :", (int32_t)rssi, (int32_t)instance->adaptive_threshold_rssi);
         if(rssi > (instance->adaptive_threshold_rssi + BIN_RAW_DELTA_RSSI)) {
             instance->data_raw_ind = 0;
-            memset(instance->data_raw, 0x00, BIN_RAW_BUF_RAW_SIZE * sizeof(int32_t));
-            memset(instance->data, 0x00, BIN_RAW_BUF_RAW_SIZE * sizeof(uint8_t));
+            instance->data_raw_size = 0;
+            instance->classes_ind = 0;
+            instance->classes_pos = 0;
+            memset(instance->classes, 0x00, sizeof(instance->classes));
+            memset(instance->data, 0x00, BIN_RAW_BUF_DATA_SIZE * sizeof(uint8_t));
             instance->decoder.parser_step = BinRAWDecoderStepWrite;
             bin_raw_debug_tag(TAG, "RSSI\r\n");
         } else {
@@ -913,8 +1014,9 @@ void subghz_protocol_decoder_bin_raw_data_input_rssi(
 #ifdef BIN_RAW_DEBUG
             bin_raw_debug("\r\n\r\n");
             bin_raw_debug_tag(TAG, "Data for analysis, positive high, negative low, us\r\n");
+            size_t pos = 0;
             for(size_t i = 0; i < instance->data_raw_ind; i++) {
-                bin_raw_debug("%ld ", instance->data_raw[i]);
+                bin_raw_debug("%ld ", subghz_protocol_bin_raw_get_raw_next(instance, &pos));
             }
             bin_raw_debug("\r\n\t count data= %zu\r\n\r\n", instance->data_raw_ind);
 #endif
@@ -964,9 +1066,42 @@ void subghz_protocol_decoder_bin_raw_data_input_rssi(
 uint8_t subghz_protocol_decoder_bin_raw_get_hash_data(void* context) {
     furi_assert(context);
     SubGhzProtocolDecoderBinRAW* instance = context;
-    return subghz_protocol_blocks_add_bytes(
-        instance->data + instance->data_markup[0].byte_bias,
-        subghz_protocol_bin_raw_get_full_byte(instance->data_markup[0].bit_count));
+    size_t byte_bias = instance->data_markup[0].byte_bias;
+    size_t byte_count = subghz_protocol_bin_raw_get_full_byte(instance->data_markup[0].bit_count);
+    // Bytes past the end of the buffer are read as zero and add nothing
+    if(byte_bias + byte_count > BIN_RAW_BUF_DATA_SIZE) {
+        byte_count = (byte_bias < BIN_RAW_BUF_DATA_SIZE) ? BIN_RAW_BUF_DATA_SIZE - byte_bias : 0;
+    }
+    return subghz_protocol_blocks_add_bytes(instance->data + byte_bias, byte_count);
+}
+
+/**
+ * Write one piece of decoded data, bytes past the end of the buffer are written as zero
+ * @param instance Pointer to a SubGhzProtocolDecoderBinRAW* instance
+ * @param flipper_format Pointer to a FlipperFormat instance
+ * @param markup Piece of decoded data
+ * @return true On success
+ */
+static bool subghz_protocol_bin_raw_write_data(
+    SubGhzProtocolDecoderBinRAW* instance,
+    FlipperFormat* flipper_format,
+    const BinRAW_Markup* markup) {
+    size_t byte_count = subghz_protocol_bin_raw_get_full_byte(markup->bit_count);
+    if(markup->byte_bias + byte_count <= BIN_RAW_BUF_DATA_SIZE) {
+        return flipper_format_write_hex(
+            flipper_format, "Data_RAW", instance->data + markup->byte_bias, byte_count);
+    }
+
+    // Gap analysis may mark up a piece running past the end of the buffer
+    uint8_t* data = malloc(byte_count);
+    size_t in_buffer =
+        (markup->byte_bias < BIN_RAW_BUF_DATA_SIZE) ? BIN_RAW_BUF_DATA_SIZE - markup->byte_bias :
+                                                      0;
+    memcpy(data, instance->data + markup->byte_bias, in_buffer);
+    memset(data + in_buffer, 0x00, byte_count - in_buffer);
+    bool result = flipper_format_write_hex(flipper_format, "Data_RAW", data, byte_count);
+    free(data);
+    return result;
 }
 
 SubGhzProtocolStatus subghz_protocol_decoder_bin_raw_serialize(
@@ -1043,11 +1178,8 @@ SubGhzProtocolStatus subghz_protocol_decoder_bin_raw_serialize(
                 res = SubGhzProtocolStatusErrorParserOthers;
                 break;
             }
-            if(!flipper_format_write_hex(
-                   flipper_format,
-                   "Data_RAW",
-                   instance->data + instance->data_markup[i].byte_bias,
-                   subghz_protocol_bin_raw_get_full_byte(instance->data_markup[i].bit_count))) {
+            if(!subghz_protocol_bin_raw_write_data(
+                   instance, flipper_format, &instance->data_markup[i])) {
                 FURI_LOG_E(TAG, "Unable to add Data_RAW");
                 res = SubGhzProtocolStatusErrorParserOthers;
                 break;
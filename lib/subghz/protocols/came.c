@@ -221,6 +221,12 @@ void* subghz_protocol_decoder_came_alloc(SubGhzEnvironment* environment) {
     SubGhzProtocolDecoderCame* instance = malloc(sizeof(SubGhzProtocolDecoderCame));
     instance->base.protocol = &subghz_protocol_came;
     instance->generic.protocol_name = instance->base.protocol->name;
+    subghz_protocol_decoder_base_set_start_pulse(
+        &instance->base,
+        &instance->decoder.parser_step,
+        false,
+        subghz_protocol_came_const.te_short * 56,
+        subghz_protocol_came_const.te_delta * 47);
     return instance;
 }
 
@@ -80,6 +80,12 @@ void* subghz_protocol_decoder_came_atomo_alloc(SubGhzEnvironment* environment) {
         FURI_LOG_I(
             TAG, "Loading rainbow table from %s", instance->came_atomo_rainbow_table_file_name);
     }
+    subghz_protocol_decoder_base_set_start_pulse(
+        &instance->base,
+        &instance->decoder.parser_step,
+        false,
+        subghz_protocol_came_atomo_const.te_long * 60,
+        subghz_protocol_came_atomo_const.te_delta * 40);
     return instance;
 }
 
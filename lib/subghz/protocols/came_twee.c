@@ -294,6 +294,12 @@ void* subghz_protocol_decoder_came_twee_alloc(SubGhzEnvironment* environment) {
     SubGhzProtocolDecoderCameTwee* instance = malloc(sizeof(SubGhzProtocolDecoderCameTwee));
     instance->base.protocol = &subghz_protocol_came_twee;
     instance->generic.protocol_name = instance->base.protocol->name;
+    subghz_protocol_decoder_base_set_start_pulse(
+        &instance->base,
+        &instance->decoder.parser_step,
+        false,
+        subghz_protocol_came_twee_const.te_long * 51,
+        subghz_protocol_came_twee_const.te_delta * 20);
     return instance;
 }
 
@@ -266,6 +266,12 @@ void* subghz_protocol_decoder_chamb_code_alloc(SubGhzEnvironment* environment) {
     SubGhzProtocolDecoderChamb_Code* instance = malloc(sizeof(SubGhzProtocolDecoderChamb_Code));
     instance->base.protocol = &subghz_protocol_chamb_code;
     instance->generic.protocol_name = instance->base.protocol->name;
+    subghz_protocol_decoder_base_set_start_pulse(
+        &instance->base,
+        &instance->decoder.parser_step,
+        false,
+        subghz_protocol_chamb_code_const.te_short * 39,
+        subghz_protocol_chamb_code_const.te_delta * 20);
     return instance;
 }
 
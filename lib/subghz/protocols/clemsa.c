@@ -211,6 +211,12 @@ void* subghz_protocol_decoder_clemsa_alloc(SubGhzEnvironment* environment) {
     SubGhzProtocolDecoderClemsa* instance = malloc(sizeof(SubGhzProtocolDecoderClemsa));
     instance->base.protocol = &subghz_protocol_clemsa;
     instance->generic.protocol_name = instance->base.protocol->name;
+    subghz_protocol_decoder_base_set_start_pulse(
+        &instance->base,
+        &instance->decoder.parser_step,
+        false,
+        subghz_protocol_clemsa_const.te_short * 51,
+        subghz_protocol_clemsa_const.te_delta * 25);
     return instance;
 }
 
@@ -191,6 +191,12 @@ void* subghz_protocol_decoder_doitrand_alloc(SubGhzEnvironment* environment) {
     SubGhzProtocolDecoderDoitrand* instance = malloc(sizeof(SubGhzProtocolDecoderDoitrand));
     instance->base.protocol = &subghz_protocol_doitrand;
     instance->generic.protocol_name = instance->base.protocol->name;
+    subghz_protocol_decoder_base_set_start_pulse(
+        &instance->base,
+        &instance->decoder.parser_step,
+        false,
+        subghz_protocol_doitrand_const.te_short * 62,
+        subghz_protocol_doitrand_const.te_delta * 30);
     return instance;
 }
 
@@ -201,6 +201,12 @@ void* subghz_protocol_decoder_dooya_alloc(SubGhzEnvironment* environment) {
     SubGhzProtocolDecoderDooya* instance = malloc(sizeof(SubGhzProtocolDecoderDooya));
     instance->base.protocol = &subghz_protocol_dooya;
     instance->generic.protocol_name = instance->base.protocol->name;
+    subghz_protocol_decoder_base_set_start_pulse(
+        &instance->base,
+        &instance->decoder.parser_step,
+        false,
+        subghz_protocol_dooya_const.te_long * 12,
+        subghz_protocol_dooya_const.te_delta * 20);
     return instance;
 }
 
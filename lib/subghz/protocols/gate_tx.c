@@ -184,6 +184,12 @@ void* subghz_protocol_decoder_gate_tx_alloc(SubGhzEnvironment* environment) {
     SubGhzProtocolDecoderGateTx* instance = malloc(sizeof(SubGhzProtocolDecoderGateTx));
     instance->base.protocol = &subghz_protocol_gate_tx;
     instance->generic.protocol_name = instance->base.protocol->name;
+    subghz_protocol_decoder_base_set_start_pulse(
+        &instance->base,
+        &instance->decoder.parser_step,
+        false,
+        subghz_protocol_gate_tx_const.te_short * 47,
+        subghz_protocol_gate_tx_const.te_delta * 47);
     return instance;
 }
 
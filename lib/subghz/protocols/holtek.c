@@ -197,6 +197,12 @@ void* subghz_protocol_decoder_holtek_alloc(SubGhzEnvironment* environment) {
     SubGhzProtocolDecoderHoltek* instance = malloc(sizeof(SubGhzProtocolDecoderHoltek));
     instance->base.protocol = &subghz_protocol_holtek;
     instance->generic.protocol_name = instance->base.protocol->name;
+    subghz_protocol_decoder_base_set_start_pulse(
+        &instance->base,
+        &instance->decoder.parser_step,
+        false,
+        subghz_protocol_holtek_const.te_short * 36,
+        subghz_protocol_holtek_const.te_delta * 36);
     return instance;
 }
 
@@ -213,6 +213,12 @@ void* subghz_protocol_decoder_holtek_th12x_alloc(SubGhzEnvironment* environment)
         malloc(sizeof(SubGhzProtocolDecoderHoltek_HT12X));
     instance->base.protocol = &subghz_protocol_holtek_th12x;
     instance->generic.protocol_name = instance->base.protocol->name;
+    subghz_protocol_decoder_base_set_start_pulse(
+        &instance->base,
+        &instance->decoder.parser_step,
+        false,
+        subghz_protocol_holtek_th12x_const.te_short * 36,
+        subghz_protocol_holtek_th12x_const.te_delta * 36);
     return instance;
 }
 
@@ -199,6 +199,12 @@ void* subghz_protocol_decoder_honeywell_wdb_alloc(SubGhzEnvironment* environment
         malloc(sizeof(SubGhzProtocolDecoderHoneywell_WDB));
     instance->base.protocol = &subghz_protocol_honeywell_wdb;
     instance->generic.protocol_name = instance->base.protocol->name;
+    subghz_protocol_decoder_base_set_start_pulse(
+        &instance->base,
+        &instance->decoder.parser_step,
+        false,
+        subghz_protocol_honeywell_wdb_const.te_short * 3,
+        subghz_protocol_honeywell_wdb_const.te_delta);
     return instance;
 }
 
@@ -195,6 +195,12 @@ void* subghz_protocol_decoder_hormann_alloc(SubGhzEnvironment* environment) {
     SubGhzProtocolDecoderHormann* instance = malloc(sizeof(SubGhzProtocolDecoderHormann));
     instance->base.protocol = &subghz_protocol_hormann;
     instance->generic.protocol_name = instance->base.protocol->name;
+    subghz_protocol_decoder_base_set_start_pulse(
+        &instance->base,
+        &instance->decoder.parser_step,
+        true,
+        subghz_protocol_hormann_const.te_short * 24,
+        subghz_protocol_hormann_const.te_delta * 24);
     return instance;
 }
 
@@ -73,6 +73,13 @@ void* subghz_protocol_decoder_ido_alloc(SubGhzEnvironment* environment) {
     instance->base.protocol = &subghz_protocol_ido;
     instance->generic.protocol_name = instance->base.protocol->name;
 
+    subghz_protocol_decoder_base_set_start_pulse(
+        &instance->base,
+        &instance->decoder.parser_step,
+        true,
+        subghz_protocol_ido_const.te_short * 10,
+        subghz_protocol_ido_const.te_delta * 5);
+
     return instance;
 }
 
@@ -219,6 +219,12 @@ void* subghz_protocol_decoder_intertechno_v3_alloc(SubGhzEnvironment* environmen
         malloc(sizeof(SubGhzProtocolDecoderIntertechno_V3));
     instance->base.protocol = &subghz_protocol_intertechno_v3;
     instance->generic.protocol_name = instance->base.protocol->name;
+    subghz_protocol_decoder_base_set_start_pulse(
+        &instance->base,
+        &instance->decoder.parser_step,
+        false,
+        subghz_protocol_intertechno_v3_const.te_short * 37,
+        subghz_protocol_intertechno_v3_const.te_delta * 15);
     return instance;
 }
 
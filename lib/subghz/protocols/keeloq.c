@@ -130,7 +130,7 @@ static bool subghz_protocol_keeloq_gen_data(SubGhzProtocolEncoderKeeloq* instanc
 
     for
         M_EACH(manufacture_code, *subghz_keystore_get_data(instance->keystore), SubGhzKeyArray_t) {
-            res = strcmp(furi_string_get_cstr(manufacture_code->name), instance->manufacture_name);
+            res = strcmp(manufacture_code->name, instance->manufacture_name);
             if(res == 0) {
                 switch(manufacture_code->type) {
                 case KEELOQ_LEARNING_SIMPLE:
@@ -335,6 +335,13 @@ void* subghz_protocol_decoder_keeloq_alloc(SubGhzEnvironment* environment) {
     instance->generic.protocol_name = instance->base.protocol->name;
     instance->keystore = subghz_environment_get_keystore(environment);
 
+    subghz_protocol_decoder_base_set_start_pulse(
+        &instance->base,
+        &instance->decoder.parser_step,
+        true,
+        subghz_protocol_keeloq_const.te_short,
+        subghz_protocol_keeloq_const.te_delta);
+
     return instance;
 }
 
@@ -480,8 +487,129 @@ static inline bool subghz_protocol_keeloq_check_decrypt_centurion(
     return false;
 }
 
+/** Batched manufacture key search state */
+typedef struct {
+    SubGhzBlockGeneric* instance;
+    uint32_t hop;
+    uint8_t btn;
+    uint16_t end_serial;
+    const char** manufacture_name;
+
+    // Keys of the current group and their derived manufacture keys
+    const SubGhzKey* manufacture_code[KEELOQ_DECRYPT_BATCH_SIZE];
+    size_t count;
+    uint64_t key[KEELOQ_DECRYPT_BATCH_SIZE];
+    uint64_t key_rev[KEELOQ_DECRYPT_BATCH_SIZE];
+    uint64_t normal[KEELOQ_DECRYPT_BATCH_SIZE];
+    uint64_t normal_rev[KEELOQ_DECRYPT_BATCH_SIZE];
+    uint64_t secure[KEELOQ_DECRYPT_BATCH_SIZE];
+    uint64_t secure_rev[KEELOQ_DECRYPT_BATCH_SIZE];
+    uint32_t k1[KEELOQ_DECRYPT_BATCH_SIZE];
+    uint32_t k2[KEELOQ_DECRYPT_BATCH_SIZE];
+
+    // Pending hop decrypt candidates, in the order they have to be checked
+    uint64_t candidate_man[KEELOQ_DECRYPT_BATCH_SIZE];
+    const SubGhzKey* candidate_code[KEELOQ_DECRYPT_BATCH_SIZE];
+    bool candidate_centurion[KEELOQ_DECRYPT_BATCH_SIZE];
+    uint32_t candidate_decrypt[KEELOQ_DECRYPT_BATCH_SIZE];
+    size_t candidate_count;
+} SubGhzProtocolKeeloqSearch;
+
+/** 
+ * Derive normal and secure learning manufacture keys for the whole group
+ * @param search Pointer to a SubGhzProtocolKeeloqSearch instance
+ * @param fix Fix part of the parcel
+ * @param keys Group keys
+ * @param normal Output for normal learning keys, NULL to skip
+ * @param secure Output for secure learning keys, NULL to skip
+ */
+static void subghz_protocol_keeloq_search_learning(
+    SubGhzProtocolKeeloqSearch* search,
+    uint32_t fix,
+    const uint64_t* keys,
+    uint64_t* normal,
+    uint64_t* secure) {
+    uint32_t serial = fix & 0x0FFFFFFF;
+    uint32_t seed = 0;
+
+    if(normal) {
+        subghz_protocol_keeloq_common_decrypt_batch(
+            serial | 0x20000000, keys, search->k1, search->count);
+        subghz_protocol_keeloq_common_decrypt_batch(
+            serial | 0x60000000, keys, search->k2, search->count);
+        for(size_t i = 0; i < search->count; i++) {
+            normal[i] = ((uint64_t)search->k2[i] << 32) | search->k1[i];
+        }
+    }
+
+    if(secure) {
+        subghz_protocol_keeloq_common_decrypt_batch(serial, keys, search->k1, search->count);
+        subghz_protocol_keeloq_common_decrypt_batch(seed, keys, search->k2, search->count);
+        for(size_t i = 0; i < search->count; i++) {
+            secure[i] = ((uint64_t)search->k1[i] << 32) | search->k2[i];
+        }
+    }
+}
+
+/** 
+ * Decrypt all pending candidates in one pass and check them in order
+ * @param search Pointer to a SubGhzProtocolKeeloqSearch instance
+ * @return true on successful search
+ */
+static bool subghz_protocol_keeloq_search_flush(SubGhzProtocolKeeloqSearch* search) {
+    size_t count = search->candidate_count;
+    search->candidate_count = 0;
+    if(!count) return false;
+
+    subghz_protocol_keeloq_common_decrypt_batch(
+        search->hop, search->candidate_man, search->candidate_decrypt, count);
+
+    for(size_t i = 0; i < count; i++) {
+        bool found;
+        if(search->candidate_centurion[i]) {
+            found = subghz_protocol_keeloq_check_decrypt_centurion(
+                search->instance, search->candidate_decrypt[i], search->btn);
+        } else {
+            found = subghz_protocol_keeloq_check_decrypt(
+                search->instance, search->candidate_decrypt[i], search->btn, search->end_serial);
+        }
+        if(found) {
+            *search->manufacture_name = search->candidate_code[i]->name;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/** 
+ * Queue manufacture key candidate, flushes the queue when it is full
+ * @param search Pointer to a SubGhzProtocolKeeloqSearch instance
+ * @param man Manufacture key to decrypt hop with
+ * @param manufacture_code Keystore entry the candidate is derived from
+ * @param centurion Use Centurion decrypt check
+ * @return true on successful search
+ */
+static bool subghz_protocol_keeloq_search_push(
+    SubGhzProtocolKeeloqSearch* search,
+    uint64_t man,
+    const SubGhzKey* manufacture_code,
+    bool centurion) {
+    size_t index = search->candidate_count++;
+    search->candidate_man[index] = man;
+    search->candidate_code[index] = manufacture_code;
+    search->candidate_centurion[index] = centurion;
+
+    if(search->candidate_count == KEELOQ_DECRYPT_BATCH_SIZE) {
+        return subghz_protocol_keeloq_search_flush(search);
+    }
+    return false;
+}
+
 /** 
  * Checking the accepted code against the database manafacture key
+ * Candidates are checked in the same order as keystore and learning types go,
+ * but decrypted 32 at a time with bitsliced KeeLoq.
  * @param instance Pointer to a SubGhzBlockGeneric* instance
  * @param fix Fix part of the parcel
  * @param hop Hop encrypted part of the parcel
@@ -499,166 +627,158 @@ static uint8_t subghz_protocol_keeloq_check_remote_controller_selector(
     // HCS300 -> uint16_t end_serial = (uint16_t)(fix & 0x3FF);
     // HCS200 -> uint16_t end_serial = (uint16_t)(fix & 0xFF);
 
-    uint16_t end_serial = (uint16_t)(fix & 0xFF);
-    uint8_t btn = (uint8_t)(fix >> 28);
-    uint32_t decrypt = 0;
-    uint64_t man;
-    uint32_t seed = 0;
+    SubGhzProtocolKeeloqSearch* search = malloc(sizeof(SubGhzProtocolKeeloqSearch));
+    search->instance = instance;
+    search->hop = hop;
+    search->btn = (uint8_t)(fix >> 28);
+    search->end_serial = (uint16_t)(fix & 0xFF);
+    search->manufacture_name = manufacture_name;
+    search->candidate_count = 0;
+
+    SubGhzKeyArray_t* keys = subghz_keystore_get_data(keystore);
+    size_t keys_count = SubGhzKeyArray_size(*keys);
+    bool found = false;
+
+    for(size_t offset = 0; offset < keys_count && !found; offset += KEELOQ_DECRYPT_BATCH_SIZE) {
+        search->count = MIN(keys_count - offset, (size_t)KEELOQ_DECRYPT_BATCH_SIZE);
+
+        bool need_normal = false;
+        bool need_secure = false;
+        bool need_rev = false;
+        for(size_t i = 0; i < search->count; i++) {
+            const SubGhzKey* manufacture_code = SubGhzKeyArray_get(*keys, offset + i);
+            search->manufacture_code[i] = manufacture_code;
+            search->key[i] = manufacture_code->key;
+
+            switch(manufacture_code->type) {
+            case KEELOQ_LEARNING_NORMAL:
+                need_normal = true;
+                break;
+            case KEELOQ_LEARNING_SECURE:
+                need_secure = true;
+                break;
+            case KEELOQ_LEARNING_UNKNOWN:
+                need_normal = true;
+                need_secure = true;
+                need_rev = true;
+                break;
+            }
+
+            // Mirrored man
+            uint64_t man_rev = 0;
+            uint64_t man_rev_byte = 0;
+            for(uint8_t j = 0; j < 64; j += 8) {
+                man_rev_byte = (uint8_t)(manufacture_code->key >> j);
+                man_rev = man_rev | man_rev_byte << (56 - j);
+            }
+            search->key_rev[i] = man_rev;
+        }
+
+        subghz_protocol_keeloq_search_learning(
+            search,
+            fix,
+            search->key,
+            need_normal ? search->normal : NULL,
+            need_secure ? search->secure : NULL);
+        if(need_rev) {
+            subghz_protocol_keeloq_search_learning(
+                search, fix, search->key_rev, search->normal_rev, search->secure_rev);
+        }
+
+        for(size_t i = 0; i < search->count && !found; i++) {
+            const SubGhzKey* manufacture_code = search->manufacture_code[i];
+            uint64_t key = search->key[i];
 
-    for
-        M_EACH(manufacture_code, *subghz_keystore_get_data(keystore), SubGhzKeyArray_t) {
             switch(manufacture_code->type) {
             case KEELOQ_LEARNING_SIMPLE:
                 // Simple Learning
-                decrypt = subghz_protocol_keeloq_common_decrypt(hop, manufacture_code->key);
-                if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
-                    *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                    return 1;
-                }
+                found = subghz_protocol_keeloq_search_push(search, key, manufacture_code, false);
                 break;
             case KEELOQ_LEARNING_NORMAL:
                 // Normal Learning
                 // https://phreakerclub.com/forum/showpost.php?p=43557&postcount=37
-                man = subghz_protocol_keeloq_common_normal_learning(fix, manufacture_code->key);
-                decrypt = subghz_protocol_keeloq_common_decrypt(hop, man);
-                if(strcmp(furi_string_get_cstr(manufacture_code->name), "Centurion") == 0) {
-                    if(subghz_protocol_keeloq_check_decrypt_centurion(instance, decrypt, btn)) {
-                        *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                        return 1;
-                    }
-                } else {
-                    if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
-                        *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                        return 1;
-                    }
-                }
+                found = subghz_protocol_keeloq_search_push(
+                    search,
+                    search->normal[i],
+                    manufacture_code,
+                    manufacture_code->flags & SubGhzKeyFlagCenturion);
                 break;
             case KEELOQ_LEARNING_SECURE:
-                man = subghz_protocol_keeloq_common_secure_learning(
-                    fix, seed, manufacture_code->key);
-                decrypt = subghz_protocol_keeloq_common_decrypt(hop, man);
-                if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
-                    *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                    return 1;
-                }
+                found = subghz_protocol_keeloq_search_push(
+                    search, search->secure[i], manufacture_code, false);
                 break;
             case KEELOQ_LEARNING_MAGIC_XOR_TYPE_1:
-                man = subghz_protocol_keeloq_common_magic_xor_type1_learning(
-                    fix, manufacture_code->key);
-                decrypt = subghz_protocol_keeloq_common_decrypt(hop, man);
-                if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
-                    *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                    return 1;
-                }
+                found = subghz_protocol_keeloq_search_push(
+                    search,
+                    subghz_protocol_keeloq_common_magic_xor_type1_learning(fix, key),
+                    manufacture_code,
+                    false);
                 break;
             case KEELOQ_LEARNING_MAGIC_SERIAL_TYPE_1:
-                man = subghz_protocol_keeloq_common_magic_serial_type1_learning(
-                    fix, manufacture_code->key);
-                decrypt = subghz_protocol_keeloq_common_decrypt(hop, man);
-                if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
-                    *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                    return 1;
-                }
+                found = subghz_protocol_keeloq_search_push(
+                    search,
+                    subghz_protocol_keeloq_common_magic_serial_type1_learning(fix, key),
+                    manufacture_code,
+                    false);
                 break;
             case KEELOQ_LEARNING_MAGIC_SERIAL_TYPE_2:
-                man = subghz_protocol_keeloq_common_magic_serial_type2_learning(
-                    fix, manufacture_code->key);
-                decrypt = subghz_protocol_keeloq_common_decrypt(hop, man);
-                if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
-                    *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                    return 1;
-                }
+                found = subghz_protocol_keeloq_search_push(
+                    search,
+                    subghz_protocol_keeloq_common_magic_serial_type2_learning(fix, key),
+                    manufacture_code,
+                    false);
                 break;
             case KEELOQ_LEARNING_MAGIC_SERIAL_TYPE_3:
-                man = subghz_protocol_keeloq_common_magic_serial_type3_learning(
-                    fix, manufacture_code->key);
-                decrypt = subghz_protocol_keeloq_common_decrypt(hop, man);
-                if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
-                    *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                    return 1;
-                }
+                found = subghz_protocol_keeloq_search_push(
+                    search,
+                    subghz_protocol_keeloq_common_magic_serial_type3_learning(fix, key),
+                    manufacture_code,
+                    false);
                 break;
             case KEELOQ_LEARNING_UNKNOWN:
-                // Simple Learning
-                decrypt = subghz_protocol_keeloq_common_decrypt(hop, manufacture_code->key);
-                if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
-                    *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                    return 1;
-                }
-
-                // Check for mirrored man
-                uint64_t man_rev = 0;
-                uint64_t man_rev_byte = 0;
-                for(uint8_t i = 0; i < 64; i += 8) {
-                    man_rev_byte = (uint8_t)(manufacture_code->key >> i);
-                    man_rev = man_rev | man_rev_byte << (56 - i);
-                }
-
-                decrypt = subghz_protocol_keeloq_common_decrypt(hop, man_rev);
-                if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
-                    *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                    return 1;
-                }
-
-                //###########################
-                // Normal Learning
-                // https://phreakerclub.com/forum/showpost.php?p=43557&postcount=37
-                man = subghz_protocol_keeloq_common_normal_learning(fix, manufacture_code->key);
-                decrypt = subghz_protocol_keeloq_common_decrypt(hop, man);
-                if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
-                    *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                    return 1;
-                }
-
-                // Check for mirrored man
-                man = subghz_protocol_keeloq_common_normal_learning(fix, man_rev);
-                decrypt = subghz_protocol_keeloq_common_decrypt(hop, man);
-                if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
-                    *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                    return 1;
-                }
-
-                // Secure Learning
-                man = subghz_protocol_keeloq_common_secure_learning(
-                    fix, seed, manufacture_code->key);
-                decrypt = subghz_protocol_keeloq_common_decrypt(hop, man);
-                if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
-                    *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                    return 1;
-                }
-
-                // Check for mirrored man
-                man = subghz_protocol_keeloq_common_secure_learning(fix, seed, man_rev);
-                decrypt = subghz_protocol_keeloq_common_decrypt(hop, man);
-                if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
-                    *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                    return 1;
-                }
-
-                // Magic xor type1 learning
-                man = subghz_protocol_keeloq_common_magic_xor_type1_learning(
-                    fix, manufacture_code->key);
-                decrypt = subghz_protocol_keeloq_common_decrypt(hop, man);
-                if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
-                    *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                    return 1;
-                }
-
-                // Check for mirrored man
-                man = subghz_protocol_keeloq_common_magic_xor_type1_learning(fix, man_rev);
-                decrypt = subghz_protocol_keeloq_common_decrypt(hop, man);
-                if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
-                    *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                    return 1;
-                }
+                // Simple Learning, then mirrored man
+                // Normal Learning, then mirrored man
+                // Secure Learning, then mirrored man
+                // Magic xor type1 learning, then mirrored man
+                found =
+                    subghz_protocol_keeloq_search_push(search, key, manufacture_code, false) ||
+                    subghz_protocol_keeloq_search_push(
+                        search, search->key_rev[i], manufacture_code, false) ||
+                    subghz_protocol_keeloq_search_push(
+                        search, search->normal[i], manufacture_code, false) ||
+                    subghz_protocol_keeloq_search_push(
+                        search, search->normal_rev[i], manufacture_code, false) ||
+                    subghz_protocol_keeloq_search_push(
+                        search, search->secure[i], manufacture_code, false) ||
+                    subghz_protocol_keeloq_search_push(
+                        search, search->secure_rev[i], manufacture_code, false) ||
+                    subghz_protocol_keeloq_search_push(
+                        search,
+                        subghz_protocol_keeloq_common_magic_xor_type1_learning(fix, key),
+                        manufacture_code,
+                        false) ||
+                    subghz_protocol_keeloq_search_push(
+                        search,
+                        subghz_protocol_keeloq_common_magic_xor_type1_learning(
+                            fix, search->key_rev[i]),
+                        manufacture_code,
+                        false);
                 break;
             }
         }
 
-    *manufacture_name = "Unknown";
-    instance->cnt = 0;
+        // Candidates refer to the current group, check them before moving on
+        if(!found) found = subghz_protocol_keeloq_search_flush(search);
+    }
+
+    free(search);
+
+    if(!found) {
+        *manufacture_name = "Unknown";
+        instance->cnt = 0;
+    }
 
-    return 0;
+    return found;
 }
 
 static void subghz_protocol_keeloq_check_remote_controller(
@@ -35,6 +35,65 @@ inline uint32_t subghz_protocol_keeloq_common_decrypt(const uint32_t data, const
     return x;
 }
 
+/** Bitsliced KeeLoq NLF, one bit of 32 independent lanes per argument
+ * Algebraic normal form of 0x3A5C742E over (a, b, c, d, e) = (x0, x8, x19, x25, x30)
+ */
+static inline uint32_t
+    keeloq_common_nlf_sliced(uint32_t a, uint32_t b, uint32_t c, uint32_t d, uint32_t e) {
+    uint32_t low = (a | b) ^ (b & c) ^ (d & (a ^ c));
+    uint32_t high = a ^ c ^ (a & (b ^ c)) ^ (d & (b ^ c));
+    return low ^ (e & high);
+}
+
+/** Simple Learning Decrypt of the same data with several keys at once
+ * @param data - keeloq encrypt data, shared by all keys
+ * @param keys - manufacture keys (64bit), count items
+ * @param result - output, result[i] is the decrypted data for keys[i]
+ * @param count - amount of keys, up to KEELOQ_DECRYPT_BATCH_SIZE
+ */
+void subghz_protocol_keeloq_common_decrypt_batch(
+    const uint32_t data,
+    const uint64_t* keys,
+    uint32_t* result,
+    size_t count) {
+    furi_check(keys);
+    furi_check(result);
+    furi_check(count <= KEELOQ_DECRYPT_BATCH_SIZE);
+
+    // Key bit planes: bit j of key_plane[i] is bit i of keys[j]
+    uint32_t key_plane[64] = {0};
+    for(size_t j = 0; j < count; j++) {
+        uint64_t key = keys[j];
+        for(size_t i = 0; i < 64; i++) {
+            key_plane[i] |= (uint32_t)bit(key, i) << j;
+        }
+    }
+
+    // State bit planes, shift register is emulated by moving the head index
+    uint32_t x[32];
+    for(size_t i = 0; i < 32; i++) {
+        x[i] = bit(data, i) ? UINT32_MAX : 0;
+    }
+
+    uint32_t head = 0;
+    for(uint32_t r = 0; r < 528; r++) {
+#define xs(n) x[(head + (n)) & 31]
+        uint32_t new_bit = xs(31) ^ xs(15) ^ key_plane[(15 - r) & 63] ^
+                           keeloq_common_nlf_sliced(xs(0), xs(8), xs(19), xs(25), xs(30));
+#undef xs
+        head = (head - 1) & 31;
+        x[head] = new_bit;
+    }
+
+    for(size_t j = 0; j < count; j++) {
+        uint32_t value = 0;
+        for(size_t i = 0; i < 32; i++) {
+            value |= bit(x[(head + i) & 31], j) << i;
+        }
+        result[j] = value;
+    }
+}
+
 /** Normal Learning
  * @param data - serial number (28bit)
  * @param key - manufacture (64bit)
@@ -12,6 +12,9 @@
  */
 #define KEELOQ_NLF 0x3A5C742E
 
+/** Maximum amount of keys processed by one bitsliced decrypt pass */
+#define KEELOQ_DECRYPT_BATCH_SIZE 32u
+
 /*
  * KeeLoq learning types
  * https://phreakerclub.com/forum/showthread.php?t=67
@@ -41,6 +44,21 @@ uint32_t subghz_protocol_keeloq_common_encrypt(const uint32_t data, const uint64
  */
 uint32_t subghz_protocol_keeloq_common_decrypt(const uint32_t data, const uint64_t key);
 
+/**
+ * Simple Learning Decrypt of the same data with several keys at once.
+ * Keys are bitsliced into 32 lanes, so one pass costs about as much as a
+ * handful of scalar decrypts regardless of the key count.
+ * @param data - keeloq encrypt data, shared by all keys
+ * @param keys - manufacture keys (64bit), count items
+ * @param result - output, result[i] is the decrypted data for keys[i]
+ * @param count - amount of keys, up to KEELOQ_DECRYPT_BATCH_SIZE
+ */
+void subghz_protocol_keeloq_common_decrypt_batch(
+    const uint32_t data,
+    const uint64_t* keys,
+    uint32_t* result,
+    size_t count);
+
 /** 
  * Normal Learning
  * @param data - serial number (28bit)
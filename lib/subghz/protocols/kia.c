@@ -75,6 +75,13 @@ void* subghz_protocol_decoder_kia_alloc(SubGhzEnvironment* environment) {
     instance->base.protocol = &subghz_protocol_kia;
     instance->generic.protocol_name = instance->base.protocol->name;
 
+    subghz_protocol_decoder_base_set_start_pulse(
+        &instance->base,
+        &instance->decoder.parser_step,
+        true,
+        subghz_protocol_kia_const.te_short,
+        subghz_protocol_kia_const.te_delta);
+
     return instance;
 }
 
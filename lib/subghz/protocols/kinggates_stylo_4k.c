@@ -80,6 +80,12 @@ void* subghz_protocol_decoder_kinggates_stylo_4k_alloc(SubGhzEnvironment* enviro
     instance->base.protocol = &subghz_protocol_kinggates_stylo_4k;
     instance->generic.protocol_name = instance->base.protocol->name;
     instance->keystore = subghz_environment_get_keystore(environment);
+    subghz_protocol_decoder_base_set_start_pulse(
+        &instance->base,
+        &instance->decoder.parser_step,
+        true,
+        subghz_protocol_kinggates_stylo_4k_const.te_short,
+        subghz_protocol_kinggates_stylo_4k_const.te_delta);
     return instance;
 }
 
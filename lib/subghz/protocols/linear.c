@@ -202,6 +202,12 @@ void* subghz_protocol_decoder_linear_alloc(SubGhzEnvironment* environment) {
     SubGhzProtocolDecoderLinear* instance = malloc(sizeof(SubGhzProtocolDecoderLinear));
     instance->base.protocol = &subghz_protocol_linear;
     instance->generic.protocol_name = instance->base.protocol->name;
+    subghz_protocol_decoder_base_set_start_pulse(
+        &instance->base,
+        &instance->decoder.parser_step,
+        false,
+        subghz_protocol_linear_const.te_short * 42,
+        subghz_protocol_linear_const.te_delta * 20);
     return instance;
 }
 
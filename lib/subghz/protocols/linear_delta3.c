@@ -207,6 +207,12 @@ void* subghz_protocol_decoder_linear_delta3_alloc(SubGhzEnvironment* environment
         malloc(sizeof(SubGhzProtocolDecoderLinearDelta3));
     instance->base.protocol = &subghz_protocol_linear_delta3;
     instance->generic.protocol_name = instance->base.protocol->name;
+    subghz_protocol_decoder_base_set_start_pulse(
+        &instance->base,
+        &instance->decoder.parser_step,
+        false,
+        subghz_protocol_linear_delta3_const.te_short * 70,
+        subghz_protocol_linear_delta3_const.te_delta * 24);
     return instance;
 }
 
@@ -205,6 +205,12 @@ void* subghz_protocol_decoder_magellan_alloc(SubGhzEnvironment* environment) {
     SubGhzProtocolDecoderMagellan* instance = malloc(sizeof(SubGhzProtocolDecoderMagellan));
     instance->base.protocol = &subghz_protocol_magellan;
     instance->generic.protocol_name = instance->base.protocol->name;
+    subghz_protocol_decoder_base_set_start_pulse(
+        &instance->base,
+        &instance->decoder.parser_step,
+        true,
+        subghz_protocol_magellan_const.te_short,
+        subghz_protocol_magellan_const.te_delta);
     return instance;
 }
 
@@ -241,6 +241,12 @@ void* subghz_protocol_decoder_marantec_alloc(SubGhzEnvironment* environment) {
     SubGhzProtocolDecoderMarantec* instance = malloc(sizeof(SubGhzProtocolDecoderMarantec));
     instance->base.protocol = &subghz_protocol_marantec;
     instance->generic.protocol_name = instance->base.protocol->name;
+    subghz_protocol_decoder_base_set_start_pulse(
+        &instance->base,
+        &instance->decoder.parser_step,
+        false,
+        subghz_protocol_marantec_const.te_long * 5,
+        subghz_protocol_marantec_const.te_delta * 8);
     return instance;
 }
 
@@ -211,6 +211,12 @@ void* subghz_protocol_decoder_mastercode_alloc(SubGhzEnvironment* environment) {
     SubGhzProtocolDecoderMastercode* instance = malloc(sizeof(SubGhzProtocolDecoderMastercode));
     instance->base.protocol = &subghz_protocol_mastercode;
     instance->generic.protocol_name = instance->base.protocol->name;
+    subghz_protocol_decoder_base_set_start_pulse(
+        &instance->base,
+        &instance->decoder.parser_step,
+        false,
+        subghz_protocol_mastercode_const.te_short * 15,
+        subghz_protocol_mastercode_const.te_delta * 15);
     return instance;
 }
 
@@ -230,6 +230,12 @@ void* subghz_protocol_decoder_megacode_alloc(SubGhzEnvironment* environment) {
     SubGhzProtocolDecoderMegaCode* instance = malloc(sizeof(SubGhzProtocolDecoderMegaCode));
     instance->base.protocol = &subghz_protocol_megacode;
     instance->generic.protocol_name = instance->base.protocol->name;
+    subghz_protocol_decoder_base_set_start_pulse(
+        &instance->base,
+        &instance->decoder.parser_step,
+        false,
+        subghz_protocol_megacode_const.te_short * 13,
+        subghz_protocol_megacode_const.te_delta * 17);
     return instance;
 }
 
@@ -209,6 +209,12 @@ void* subghz_protocol_decoder_nero_radio_alloc(SubGhzEnvironment* environment) {
     SubGhzProtocolDecoderNeroRadio* instance = malloc(sizeof(SubGhzProtocolDecoderNeroRadio));
     instance->base.protocol = &subghz_protocol_nero_radio;
     instance->generic.protocol_name = instance->base.protocol->name;
+    subghz_protocol_decoder_base_set_start_pulse(
+        &instance->base,
+        &instance->decoder.parser_step,
+        true,
+        subghz_protocol_nero_radio_const.te_short,
+        subghz_protocol_nero_radio_const.te_delta);
     return instance;
 }
 
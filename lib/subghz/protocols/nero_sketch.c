@@ -203,6 +203,12 @@ void* subghz_protocol_decoder_nero_sketch_alloc(SubGhzEnvironment* environment)
     SubGhzProtocolDecoderNeroSketch* instance = malloc(sizeof(SubGhzProtocolDecoderNeroSketch));
     instance->base.protocol = &subghz_protocol_nero_sketch;
     instance->generic.protocol_name = instance->base.protocol->name;
+    subghz_protocol_decoder_base_set_start_pulse(
+        &instance->base,
+        &instance->decoder.parser_step,
+        true,
+        subghz_protocol_nero_sketch_const.te_short,
+        subghz_protocol_nero_sketch_const.te_delta);
     return instance;
 }
 
@@ -189,6 +189,12 @@ void* subghz_protocol_decoder_nice_flo_alloc(SubGhzEnvironment* environment) {
     SubGhzProtocolDecoderNiceFlo* instance = malloc(sizeof(SubGhzProtocolDecoderNiceFlo));
     instance->base.protocol = &subghz_protocol_nice_flo;
     instance->generic.protocol_name = instance->base.protocol->name;
+    subghz_protocol_decoder_base_set_start_pulse(
+        &instance->base,
+        &instance->decoder.parser_step,
+        false,
+        subghz_protocol_nice_flo_const.te_short * 36,
+        subghz_protocol_nice_flo_const.te_delta * 36);
     return instance;
 }
 
@@ -245,6 +245,12 @@ void* subghz_protocol_decoder_nice_flor_s_alloc(SubGhzEnvironment* environment)
         FURI_LOG_I(
             TAG, "Loading rainbow table from %s", instance->nice_flor_s_rainbow_table_file_name);
     }
+    subghz_protocol_decoder_base_set_start_pulse(
+        &instance->base,
+        &instance->decoder.parser_step,
+        false,
+        subghz_protocol_nice_flor_s_const.te_short * 38,
+        subghz_protocol_nice_flor_s_const.te_delta * 38);
     return instance;
 }
 
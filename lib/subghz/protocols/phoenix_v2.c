@@ -187,6 +187,12 @@ void* subghz_protocol_decoder_phoenix_v2_alloc(SubGhzEnvironment* environment) {
     SubGhzProtocolDecoderPhoenix_V2* instance = malloc(sizeof(SubGhzProtocolDecoderPhoenix_V2));
     instance->base.protocol = &subghz_protocol_phoenix_v2;
     instance->generic.protocol_name = instance->base.protocol->name;
+    subghz_protocol_decoder_base_set_start_pulse(
+        &instance->base,
+        &instance->decoder.parser_step,
+        false,
+        subghz_protocol_phoenix_v2_const.te_short * 60,
+        subghz_protocol_phoenix_v2_const.te_delta * 30);
     return instance;
 }
 
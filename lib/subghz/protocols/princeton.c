@@ -222,6 +222,12 @@ void* subghz_protocol_decoder_princeton_alloc(SubGhzEnvironment* environment) {
     SubGhzProtocolDecoderPrinceton* instance = malloc(sizeof(SubGhzProtocolDecoderPrinceton));
     instance->base.protocol = &subghz_protocol_princeton;
     instance->generic.protocol_name = instance->base.protocol->name;
+    subghz_protocol_decoder_base_set_start_pulse(
+        &instance->base,
+        &instance->decoder.parser_step,
+        false,
+        subghz_protocol_princeton_const.te_short * 36,
+        subghz_protocol_princeton_const.te_delta * 36);
     return instance;
 }
 
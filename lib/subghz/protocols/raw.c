@@ -1,6 +1,7 @@
 #include "raw.h"
 #include <lib/flipper_format/flipper_format.h>
 #include "../subghz_file_encoder_worker.h"
+#include "../subghz_raw_binary.h"
 
 #include "../blocks/const.h"
 #include "../blocks/generic.h"
@@ -31,6 +32,8 @@ struct SubGhzProtocolDecoderRAW {
     size_t sample_write;
     bool last_level;
     bool pause;
+    bool binary;
+    SubGhzRawBinaryWriter* binary_writer;
 };
 
 struct SubGhzProtocolEncoderRAW {
@@ -156,6 +159,15 @@ bool subghz_protocol_raw_save_to_file_init(
             break;
         }
 
+        if(instance->binary) {
+            Stream* stream = flipper_format_get_raw_stream(instance->flipper_file);
+            if(!subghz_raw_binary_write_marker(stream)) {
+                FURI_LOG_E(TAG, "Unable to add " SUBGHZ_RAW_BINARY_KEY);
+                break;
+            }
+            instance->binary_writer = subghz_raw_binary_writer_alloc(stream);
+        }
+
         instance->upload_raw = malloc(SUBGHZ_DOWNLOAD_MAX_SIZE * sizeof(int32_t));
         instance->file_is_open = RAWFileIsOpenWrite;
         instance->sample_write = 0;
@@ -174,8 +186,16 @@ static bool subghz_protocol_raw_save_to_file_write(SubGhzProtocolDecoderRAW* ins
 
     bool is_write = false;
     if(instance->file_is_open == RAWFileIsOpenWrite) {
-        if(!flipper_format_write_int32(
-               instance->flipper_file, "RAW_Data", instance->upload_raw, instance->ind_write)) {
+        bool written;
+        if(instance->binary_writer) {
+            written = subghz_raw_binary_writer_write(
+                instance->binary_writer, instance->upload_raw, instance->ind_write);
+        } else {
+            written = flipper_format_write_int32(
+                instance->flipper_file, "RAW_Data", instance->upload_raw, instance->ind_write);
+        }
+
+        if(!written) {
             FURI_LOG_E(TAG, "Unable to add RAW_Data");
         } else {
             instance->sample_write += instance->ind_write;
@@ -194,6 +214,10 @@ void subghz_protocol_raw_save_to_file_stop(SubGhzProtocolDecoderRAW* instance) {
     if(instance->file_is_open != RAWFileIsOpenClose) {
         free(instance->upload_raw);
         instance->upload_raw = NULL;
+        if(instance->binary_writer) {
+            subghz_raw_binary_writer_free(instance->binary_writer);
+            instance->binary_writer = NULL;
+        }
         flipper_format_file_close(instance->flipper_file);
         flipper_format_free(instance->flipper_file);
         furi_record_close(RECORD_STORAGE);
@@ -210,6 +234,13 @@ void subghz_protocol_raw_save_to_file_pause(SubGhzProtocolDecoderRAW* instance,
     }
 }
 
+void subghz_protocol_raw_save_to_file_set_binary(SubGhzProtocolDecoderRAW* instance, bool binary) {
+    furi_check(instance);
+    furi_check(instance->file_is_open == RAWFileIsOpenClose);
+
+    instance->binary = binary;
+}
+
 size_t subghz_protocol_raw_get_sample_write(SubGhzProtocolDecoderRAW* instance) {
     furi_check(instance);
     return instance->sample_write + instance->ind_write;
@@ -224,6 +255,8 @@ void* subghz_protocol_decoder_raw_alloc(SubGhzEnvironment* environment) {
     instance->last_level = false;
     instance->file_is_open = RAWFileIsOpenClose;
     instance->file_name = furi_string_alloc();
+    instance->binary = false;
+    instance->binary_writer = NULL;
 
     return instance;
 }
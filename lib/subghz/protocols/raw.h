@@ -35,6 +35,13 @@ bool subghz_protocol_raw_save_to_file_init(
  */
 void subghz_protocol_raw_save_to_file_stop(SubGhzProtocolDecoderRAW* instance);
 
+/**
+ * Select samples format for the next file, must be called while no file is open
+ * @param instance Pointer to a SubGhzProtocolDecoderRAW instance
+ * @param binary true - compact binary samples, false - RAW_Data text lines
+ */
+void subghz_protocol_raw_save_to_file_set_binary(SubGhzProtocolDecoderRAW* instance, bool binary);
+
 /**
  * Get the number of samples received SubGhzProtocolDecoderRAW.
  * @param instance Pointer to a SubGhzProtocolDecoderRAW instance
@@ -81,6 +81,13 @@ void* subghz_protocol_decoder_scher_khan_alloc(SubGhzEnvironment* environment) {
     instance->base.protocol = &subghz_protocol_scher_khan;
     instance->generic.protocol_name = instance->base.protocol->name;
 
+    subghz_protocol_decoder_base_set_start_pulse(
+        &instance->base,
+        &instance->decoder.parser_step,
+        true,
+        subghz_protocol_scher_khan_const.te_short * 2,
+        subghz_protocol_scher_khan_const.te_delta);
+
     return instance;
 }
 
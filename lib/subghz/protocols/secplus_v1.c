@@ -336,6 +336,13 @@ void* subghz_protocol_decoder_secplus_v1_alloc(SubGhzEnvironment* environment) {
     instance->base.protocol = &subghz_protocol_secplus_v1;
     instance->generic.protocol_name = instance->base.protocol->name;
 
+    subghz_protocol_decoder_base_set_start_pulse(
+        &instance->base,
+        &instance->decoder.parser_step,
+        false,
+        subghz_protocol_secplus_v1_const.te_short * 120,
+        subghz_protocol_secplus_v1_const.te_delta * 120);
+
     return instance;
 }
 
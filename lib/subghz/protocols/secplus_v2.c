@@ -621,6 +621,13 @@ void* subghz_protocol_decoder_secplus_v2_alloc(SubGhzEnvironment* environment) {
     instance->base.protocol = &subghz_protocol_secplus_v2;
     instance->generic.protocol_name = instance->base.protocol->name;
 
+    subghz_protocol_decoder_base_set_start_pulse(
+        &instance->base,
+        &instance->decoder.parser_step,
+        false,
+        subghz_protocol_secplus_v2_const.te_long * 130,
+        subghz_protocol_secplus_v2_const.te_delta * 100);
+
     return instance;
 }
 
@@ -220,6 +220,12 @@ void* subghz_protocol_decoder_smc5326_alloc(SubGhzEnvironment* environment) {
     SubGhzProtocolDecoderSMC5326* instance = malloc(sizeof(SubGhzProtocolDecoderSMC5326));
     instance->base.protocol = &subghz_protocol_smc5326;
     instance->generic.protocol_name = instance->base.protocol->name;
+    subghz_protocol_decoder_base_set_start_pulse(
+        &instance->base,
+        &instance->decoder.parser_step,
+        false,
+        subghz_protocol_smc5326_const.te_short * 24,
+        subghz_protocol_smc5326_const.te_delta * 12);
     return instance;
 }
 
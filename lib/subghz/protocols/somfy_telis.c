@@ -79,6 +79,13 @@ void* subghz_protocol_decoder_somfy_telis_alloc(SubGhzEnvironment* environment)
     instance->base.protocol = &subghz_protocol_somfy_telis;
     instance->generic.protocol_name = instance->base.protocol->name;
 
+    subghz_protocol_decoder_base_set_start_pulse(
+        &instance->base,
+        &instance->decoder.parser_step,
+        true,
+        subghz_protocol_somfy_telis_const.te_short * 4,
+        subghz_protocol_somfy_telis_const.te_delta * 4);
+
     return instance;
 }
 
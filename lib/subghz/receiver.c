@@ -2,10 +2,23 @@
 
 #include "registry.h"
 
+#include <furi_hal.h>
 #include <m-array.h>
 
+#define SUBGHZ_RECEIVER_START_PULSE_BUCKET_SHIFT (9U) // 512us per bucket
+#define SUBGHZ_RECEIVER_START_PULSE_BUCKET_COUNT (128U)
+#define SUBGHZ_RECEIVER_START_PULSE_SLOT_MAX     (64U)
+
 typedef struct {
-    SubGhzProtocolEncoderBase* base;
+    SubGhzProtocolDecoderBase* base;
+    SubGhzProtocolFlag flag;
+    // Set only for decoders that declared start pulse, NULL otherwise
+    const uint32_t* parser_step;
+    uint64_t start_pulse_bit;
+    // Profiling counters, updated only when stats are enabled
+    uint32_t feed_count;
+    uint32_t decode_count;
+    uint64_t cycles;
 } SubGhzReceiverSlot;
 
 ARRAY_DEF(SubGhzReceiverSlotArray, SubGhzReceiverSlot, M_POD_OPLIST);
@@ -15,10 +28,56 @@ struct SubGhzReceiver {
     SubGhzReceiverSlotArray_t slots;
     SubGhzProtocolFlag filter;
 
+    // Start pulse index: [level][bucket] -> mask of decoders that may leave reset step
+    uint64_t* start_pulse_index;
+    bool start_pulse_filter;
+
+    bool stats_enabled;
+
     SubGhzReceiverCallback callback;
     void* context;
 };
 
+static inline size_t subghz_receiver_start_pulse_bucket(uint32_t duration) {
+    size_t bucket = duration >> SUBGHZ_RECEIVER_START_PULSE_BUCKET_SHIFT;
+    return (bucket < SUBGHZ_RECEIVER_START_PULSE_BUCKET_COUNT) ?
+               bucket :
+               (SUBGHZ_RECEIVER_START_PULSE_BUCKET_COUNT - 1);
+}
+
+static void subghz_receiver_start_pulse_index_build(SubGhzReceiver* instance) {
+    size_t start_pulse_count = 0;
+
+    for
+        M_EACH(slot, instance->slots, SubGhzReceiverSlotArray_t) {
+            const SubGhzProtocolDecoderStartPulse* start_pulse = &slot->base->start_pulse;
+            if(!start_pulse->parser_step ||
+               (start_pulse_count == SUBGHZ_RECEIVER_START_PULSE_SLOT_MAX)) {
+                // Decoder without start pulse or out of index capacity: always fed
+                continue;
+            }
+
+            if(!instance->start_pulse_index) {
+                instance->start_pulse_index =
+                    malloc(sizeof(uint64_t) * SUBGHZ_RECEIVER_START_PULSE_BUCKET_COUNT * 2);
+            }
+
+            slot->parser_step = start_pulse->parser_step;
+            slot->start_pulse_bit = 1ULL << start_pulse_count++;
+
+            uint64_t* level_index = &instance->start_pulse_index
+                                         [start_pulse->level ?
+                                              SUBGHZ_RECEIVER_START_PULSE_BUCKET_COUNT :
+                                              0];
+            size_t bucket_last = subghz_receiver_start_pulse_bucket(start_pulse->duration_max);
+            for(size_t bucket = subghz_receiver_start_pulse_bucket(start_pulse->duration_min);
+                bucket <= bucket_last;
+                bucket++) {
+                level_index[bucket] |= slot->start_pulse_bit;
+            }
+        }
+}
+
 SubGhzReceiver* subghz_receiver_alloc_init(SubGhzEnvironment* environment) {
     SubGhzReceiver* instance = malloc(sizeof(SubGhzReceiver));
     SubGhzReceiverSlotArray_init(instance->slots);
@@ -32,9 +91,20 @@ SubGhzReceiver* subghz_receiver_alloc_init(SubGhzEnvironment* environment) {
         if(protocol->decoder && protocol->decoder->alloc) {
             SubGhzReceiverSlot* slot = SubGhzReceiverSlotArray_push_new(instance->slots);
             slot->base = protocol->decoder->alloc(environment);
+            slot->flag = protocol->flag;
+            slot->parser_step = NULL;
+            slot->start_pulse_bit = 0;
+            slot->feed_count = 0;
+            slot->decode_count = 0;
+            slot->cycles = 0;
         }
     }
 
+    instance->start_pulse_index = NULL;
+    subghz_receiver_start_pulse_index_build(instance);
+    instance->start_pulse_filter = true;
+    instance->stats_enabled = false;
+
     instance->callback = NULL;
     instance->context = NULL;
     return instance;
@@ -54,21 +124,65 @@ void subghz_receiver_free(SubGhzReceiver* instance) {
         }
     SubGhzReceiverSlotArray_clear(instance->slots);
 
+    free(instance->start_pulse_index);
     free(instance);
 }
 
-void subghz_receiver_decode(SubGhzReceiver* instance, bool level, uint32_t duration) {
-    furi_check(instance);
-    furi_check(instance->slots);
+static inline void subghz_receiver_feed(SubGhzReceiver* instance, bool level, uint32_t duration) {
+    uint64_t start_pulse_mask = UINT64_MAX;
+    if(instance->start_pulse_index && instance->start_pulse_filter) {
+        start_pulse_mask =
+            instance->start_pulse_index
+                [(level ? SUBGHZ_RECEIVER_START_PULSE_BUCKET_COUNT : 0) +
+                 subghz_receiver_start_pulse_bucket(duration)];
+    }
 
     for
         M_EACH(slot, instance->slots, SubGhzReceiverSlotArray_t) {
-            if((slot->base->protocol->flag & instance->filter) != 0) {
+            if((slot->flag & instance->filter) == 0) {
+                continue;
+            }
+            // Idle decoder that can't be started by this pulse
+            if(slot->parser_step && (*slot->parser_step == 0) &&
+               !(slot->start_pulse_bit & start_pulse_mask)) {
+                continue;
+            }
+            if(instance->stats_enabled) {
+                uint32_t cycles = DWT->CYCCNT;
+                slot->base->protocol->decoder->feed(slot->base, level, duration);
+                slot->cycles += DWT->CYCCNT - cycles;
+                slot->feed_count++;
+            } else {
                 slot->base->protocol->decoder->feed(slot->base, level, duration);
             }
         }
 }
 
+void subghz_receiver_decode(SubGhzReceiver* instance, bool level, uint32_t duration) {
+    furi_check(instance);
+    furi_check(instance->slots);
+
+    subghz_receiver_feed(instance, level, duration);
+}
+
+void subghz_receiver_decode_batch(
+    SubGhzReceiver* instance,
+    const LevelDuration* pulses,
+    size_t count) {
+    furi_check(instance);
+    furi_check(instance->slots);
+    furi_check(pulses || !count);
+
+    // Pulse by pulse, not decoder by decoder: a decoded packet resets all decoders
+    // right away, the same as with subghz_receiver_decode
+    for(size_t i = 0; i < count; i++) {
+        subghz_receiver_feed(
+            instance,
+            level_duration_get_level(pulses[i]),
+            level_duration_get_duration(pulses[i]));
+    }
+}
+
 void subghz_receiver_reset(SubGhzReceiver* instance) {
     furi_check(instance);
     furi_check(instance->slots);
@@ -81,6 +195,15 @@ void subghz_receiver_reset(SubGhzReceiver* instance) {
 
 static void subghz_receiver_rx_callback(SubGhzProtocolDecoderBase* decoder_base, void* context) {
     SubGhzReceiver* instance = context;
+    if(instance->stats_enabled) {
+        for
+            M_EACH(slot, instance->slots, SubGhzReceiverSlotArray_t) {
+                if(slot->base == decoder_base) {
+                    slot->decode_count++;
+                    break;
+                }
+            }
+    }
     if(instance->callback) {
         instance->callback(instance, decoder_base, instance->context);
     }
@@ -95,7 +218,7 @@ void subghz_receiver_set_rx_callback(
     for
         M_EACH(slot, instance->slots, SubGhzReceiverSlotArray_t) {
             subghz_protocol_decoder_base_set_decoder_callback(
-                (SubGhzProtocolDecoderBase*)slot->base, subghz_receiver_rx_callback, instance);
+                slot->base, subghz_receiver_rx_callback, instance);
         }
 
     instance->callback = callback;
@@ -107,6 +230,47 @@ void subghz_receiver_set_filter(SubGhzReceiver* instance, SubGhzProtocolFlag fil
     instance->filter = filter;
 }
 
+void subghz_receiver_set_start_pulse_filter(SubGhzReceiver* instance, bool enable) {
+    furi_check(instance);
+    instance->start_pulse_filter = enable;
+}
+
+void subghz_receiver_set_stats(SubGhzReceiver* instance, bool enable) {
+    furi_check(instance);
+    instance->stats_enabled = enable;
+}
+
+void subghz_receiver_reset_stats(SubGhzReceiver* instance) {
+    furi_check(instance);
+
+    for
+        M_EACH(slot, instance->slots, SubGhzReceiverSlotArray_t) {
+            slot->feed_count = 0;
+            slot->decode_count = 0;
+            slot->cycles = 0;
+        }
+}
+
+size_t subghz_receiver_get_stats_count(SubGhzReceiver* instance) {
+    furi_check(instance);
+    return SubGhzReceiverSlotArray_size(instance->slots);
+}
+
+void subghz_receiver_get_stats(
+    SubGhzReceiver* instance,
+    size_t index,
+    SubGhzReceiverStats* stats) {
+    furi_check(instance);
+    furi_check(stats);
+    furi_check(index < SubGhzReceiverSlotArray_size(instance->slots));
+
+    const SubGhzReceiverSlot* slot = SubGhzReceiverSlotArray_get(instance->slots, index);
+    stats->name = slot->base->protocol->name;
+    stats->feed_count = slot->feed_count;
+    stats->decode_count = slot->decode_count;
+    stats->cycles = slot->cycles;
+}
+
 SubGhzProtocolDecoderBase* subghz_receiver_search_decoder_base_by_name(
     SubGhzReceiver* instance,
     const char* decoder_name) {
@@ -117,7 +281,7 @@ SubGhzProtocolDecoderBase* subghz_receiver_search_decoder_base_by_name(
     for
         M_EACH(slot, instance->slots, SubGhzReceiverSlotArray_t) {
             if(strcmp(slot->base->protocol->name, decoder_name) == 0) {
-                result = (SubGhzProtocolDecoderBase*)slot->base;
+                result = slot->base;
                 break;
             }
         }
@@ -14,6 +14,14 @@ typedef void (*SubGhzReceiverCallback)(
     SubGhzProtocolDecoderBase* decoder_base,
     void* context);
 
+// Decoder profiling counters
+typedef struct {
+    const char* name; ///< Protocol name
+    uint32_t feed_count; ///< Pulses fed into the decoder
+    uint32_t decode_count; ///< Successfully decoded packets
+    uint64_t cycles; ///< CPU cycles spent in the decoder
+} SubGhzReceiverStats;
+
 /**
  * Allocate and init SubGhzReceiver.
  * @param environment Pointer to a SubGhzEnvironment instance
@@ -35,6 +43,20 @@ void subghz_receiver_free(SubGhzReceiver* instance);
  */
 void subghz_receiver_decode(SubGhzReceiver* instance, bool level, uint32_t duration);
 
+/**
+ * Parse a block of levels and durations received from the air.
+ *
+ * Same result as calling subghz_receiver_decode for every element of the block.
+ *
+ * @param instance Pointer to a SubGhzReceiver instance
+ * @param pulses Array of LevelDuration
+ * @param count Number of elements in pulses
+ */
+void subghz_receiver_decode_batch(
+    SubGhzReceiver* instance,
+    const LevelDuration* pulses,
+    size_t count);
+
 /**
  * Reset decoder SubGhzReceiver.
  * @param instance Pointer to a SubGhzReceiver instance
@@ -59,6 +81,46 @@ void subghz_receiver_set_rx_callback(
  */
 void subghz_receiver_set_filter(SubGhzReceiver* instance, SubGhzProtocolFlag filter);
 
+/**
+ * Enable or disable skipping of idle decoders that can't be started by the current pulse.
+ * Enabled by default, decoding result is the same in both modes.
+ * @param instance Pointer to a SubGhzReceiver instance
+ * @param enable true to feed only decoders that can use the pulse
+ */
+void subghz_receiver_set_start_pulse_filter(SubGhzReceiver* instance, bool enable);
+
+/**
+ * Enable or disable per decoder profiling counters.
+ * Counters keep their values while disabled, use subghz_receiver_reset_stats to clear them.
+ * @param instance Pointer to a SubGhzReceiver instance
+ * @param enable true to count pulses, CPU cycles and decoded packets of every decoder
+ */
+void subghz_receiver_set_stats(SubGhzReceiver* instance, bool enable);
+
+/**
+ * Clear per decoder profiling counters.
+ * @param instance Pointer to a SubGhzReceiver instance
+ */
+void subghz_receiver_reset_stats(SubGhzReceiver* instance);
+
+/**
+ * Get amount of decoders in SubGhzReceiver.
+ * @param instance Pointer to a SubGhzReceiver instance
+ * @return Amount of decoders, valid indexes for subghz_receiver_get_stats
+ */
+size_t subghz_receiver_get_stats_count(SubGhzReceiver* instance);
+
+/**
+ * Get profiling counters of a decoder.
+ * @param instance Pointer to a SubGhzReceiver instance
+ * @param index Decoder index, less than subghz_receiver_get_stats_count
+ * @param stats Pointer to a SubGhzReceiverStats to fill
+ */
+void subghz_receiver_get_stats(
+    SubGhzReceiver* instance,
+    size_t index,
+    SubGhzReceiverStats* stats);
+
 /**
  * Search for a cattery by his name.
  * @param instance Pointer to a SubGhzReceiver instance
@@ -0,0 +1,219 @@
+#include "subghz_file_decoder.h"
+#include "subghz_raw_binary.h"
+#include "blocks/generic.h"
+
+#include <storage/storage.h>
+#include <flipper_format/flipper_format.h>
+#include <flipper_format/flipper_format_i.h>
+#include <lib/toolbox/strint.h>
+
+#define TAG "SubGhzFileDecoder"
+
+#define SUBGHZ_FILE_DECODER_LOAD 256
+
+struct SubGhzFileDecoder {
+    Storage* storage;
+    FlipperFormat* flipper_format;
+    FuriString* str_data;
+
+    SubGhzRadioPreset preset;
+    size_t sample_count;
+    bool end_of_data;
+
+    int32_t samples[SUBGHZ_FILE_DECODER_LOAD];
+};
+
+SubGhzFileDecoder* subghz_file_decoder_alloc(void) {
+    SubGhzFileDecoder* instance = malloc(sizeof(SubGhzFileDecoder));
+
+    instance->storage = furi_record_open(RECORD_STORAGE);
+    instance->flipper_format = flipper_format_file_alloc(instance->storage);
+    instance->str_data = furi_string_alloc();
+    instance->preset.name = furi_string_alloc();
+
+    return instance;
+}
+
+void subghz_file_decoder_free(SubGhzFileDecoder* instance) {
+    furi_check(instance);
+
+    free(instance->preset.data);
+    furi_string_free(instance->preset.name);
+    furi_string_free(instance->str_data);
+    flipper_format_free(instance->flipper_format);
+    furi_record_close(RECORD_STORAGE);
+
+    free(instance);
+}
+
+SubGhzRadioPreset* subghz_file_decoder_get_preset(SubGhzFileDecoder* instance) {
+    furi_check(instance);
+    return &instance->preset;
+}
+
+size_t subghz_file_decoder_get_sample_count(SubGhzFileDecoder* instance) {
+    furi_check(instance);
+    return instance->sample_count;
+}
+
+static bool subghz_file_decoder_read_header(SubGhzFileDecoder* instance) {
+    FlipperFormat* flipper_format = instance->flipper_format;
+    SubGhzRadioPreset* preset = &instance->preset;
+    uint32_t temp_data32;
+
+    if(!flipper_format_read_header(flipper_format, instance->str_data, &temp_data32)) {
+        FURI_LOG_E(TAG, "Missing or incorrect header");
+        return false;
+    }
+    if(strcmp(furi_string_get_cstr(instance->str_data), SUBGHZ_RAW_FILE_TYPE) ||
+       temp_data32 != SUBGHZ_KEY_FILE_VERSION) {
+        FURI_LOG_E(TAG, "Type or version mismatch");
+        return false;
+    }
+
+    if(!flipper_format_read_uint32(flipper_format, "Frequency", &preset->frequency, 1)) {
+        FURI_LOG_E(TAG, "Missing Frequency");
+        return false;
+    }
+
+    if(!flipper_format_read_string(flipper_format, "Preset", instance->str_data)) {
+        FURI_LOG_E(TAG, "Missing Preset");
+        return false;
+    }
+    const char* preset_name =
+        subghz_block_generic_get_preset_short_name(furi_string_get_cstr(instance->str_data));
+    if(!preset_name) {
+        FURI_LOG_E(TAG, "Unknown preset");
+        return false;
+    }
+    furi_string_set(preset->name, preset_name);
+
+    if(!strcmp(preset_name, "CUSTOM")) {
+        if(!flipper_format_get_value_count(flipper_format, "Custom_preset_data", &temp_data32) ||
+           !temp_data32 || (temp_data32 % 2)) {
+            FURI_LOG_E(TAG, "Integrity error Custom_preset_data");
+            return false;
+        }
+        preset->data_size = temp_data32;
+        preset->data = malloc(preset->data_size);
+        if(!flipper_format_read_hex(
+               flipper_format, "Custom_preset_data", preset->data, preset->data_size)) {
+            FURI_LOG_E(TAG, "Missing Custom_preset_data");
+            return false;
+        }
+    }
+
+    if(!flipper_format_read_string(flipper_format, "Protocol", instance->str_data)) {
+        FURI_LOG_E(TAG, "Missing Protocol");
+        return false;
+    }
+
+    return true;
+}
+
+static void subghz_file_decoder_feed(
+    SubGhzFileDecoder* instance,
+    SubGhzReceiver* receiver,
+    const int32_t* samples,
+    size_t count) {
+    for(size_t i = 0; i < count; i++) {
+        int32_t duration = samples[i];
+        if(duration == 0) {
+            // Same as playback, zero duration terminates the record
+            instance->end_of_data = true;
+            break;
+        }
+        if(duration > 0) {
+            subghz_receiver_decode(receiver, true, duration);
+        } else {
+            subghz_receiver_decode(receiver, false, -duration);
+        }
+        instance->sample_count++;
+    }
+}
+
+static void subghz_file_decoder_run_binary(
+    SubGhzFileDecoder* instance,
+    SubGhzReceiver* receiver,
+    Stream* stream) {
+    SubGhzRawBinaryReader* reader = subghz_raw_binary_reader_alloc(stream);
+
+    size_t count;
+    while(!instance->end_of_data &&
+          (count = subghz_raw_binary_reader_read(
+               reader, instance->samples, SUBGHZ_FILE_DECODER_LOAD)) > 0) {
+        subghz_file_decoder_feed(instance, receiver, instance->samples, count);
+    }
+
+    subghz_raw_binary_reader_free(reader);
+}
+
+static void subghz_file_decoder_run_text(
+    SubGhzFileDecoder* instance,
+    SubGhzReceiver* receiver,
+    Stream* stream) {
+    // Line sample: "RAW_Data: -1, 2, -2..."
+    while(!instance->end_of_data && stream_read_line(stream, instance->str_data)) {
+        furi_string_trim(instance->str_data);
+        char* str = strstr(furi_string_get_cstr(instance->str_data), "RAW_Data: ");
+        if(!str) break;
+
+        // Skip key
+        str = strchr(str, ' ');
+
+        size_t count = 0;
+        int32_t duration;
+        while(strint_to_int32(str, &str, &duration, 10) == StrintParseNoError) {
+            instance->samples[count++] = duration;
+            if(count == SUBGHZ_FILE_DECODER_LOAD) {
+                subghz_file_decoder_feed(instance, receiver, instance->samples, count);
+                count = 0;
+            }
+            if(*str == ',') str++; // could also be `\0`
+        }
+        subghz_file_decoder_feed(instance, receiver, instance->samples, count);
+    }
+}
+
+bool subghz_file_decoder_run(
+    SubGhzFileDecoder* instance,
+    SubGhzReceiver* receiver,
+    const char* file_path) {
+    furi_check(instance);
+    furi_check(receiver);
+    furi_check(file_path);
+
+    instance->sample_count = 0;
+    instance->end_of_data = false;
+    free(instance->preset.data);
+    instance->preset.data = NULL;
+    instance->preset.data_size = 0;
+    instance->preset.frequency = 0;
+    furi_string_reset(instance->preset.name);
+
+    bool result = false;
+    do {
+        if(!flipper_format_file_open_existing(instance->flipper_format, file_path)) {
+            FURI_LOG_E(TAG, "Unable to open file for read: %s", file_path);
+            break;
+        }
+        if(!subghz_file_decoder_read_header(instance)) break;
+
+        Stream* stream = flipper_format_get_raw_stream(instance->flipper_format);
+        //skip the end of the previous line "\n"
+        stream_seek(stream, 1, StreamOffsetFromCurrent);
+
+        subghz_receiver_reset(receiver);
+        if(subghz_raw_binary_read_marker(stream)) {
+            subghz_file_decoder_run_binary(instance, receiver, stream);
+        } else {
+            subghz_file_decoder_run_text(instance, receiver, stream);
+        }
+
+        result = true;
+    } while(false);
+
+    flipper_format_file_close(instance->flipper_format);
+
+    return result;
+}
@@ -0,0 +1,61 @@
+#pragma once
+
+#include "receiver.h"
+#include "types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Synchronous RAW file decoder
+ *
+ * Reads samples of a RAW file, text or binary, and feeds them straight into
+ * SubGhzReceiver without worker thread and playback pacing. Samples are fed
+ * one by one, so decoded results are the same as on air.
+ */
+typedef struct SubGhzFileDecoder SubGhzFileDecoder;
+
+/**
+ * Allocate SubGhzFileDecoder
+ * @return SubGhzFileDecoder* pointer to a SubGhzFileDecoder instance
+ */
+SubGhzFileDecoder* subghz_file_decoder_alloc(void);
+
+/**
+ * Free SubGhzFileDecoder
+ * @param instance Pointer to a SubGhzFileDecoder instance
+ */
+void subghz_file_decoder_free(SubGhzFileDecoder* instance);
+
+/**
+ * Decode RAW file
+ * Receiver is reset before decoding, preset of the file is available from
+ * the receiver callback via subghz_file_decoder_get_preset.
+ * @param instance Pointer to a SubGhzFileDecoder instance
+ * @param receiver Pointer to a SubGhzReceiver instance
+ * @param file_path Full path to the RAW file
+ * @return true On success
+ */
+bool subghz_file_decoder_run(
+    SubGhzFileDecoder* instance,
+    SubGhzReceiver* receiver,
+    const char* file_path);
+
+/**
+ * Get preset of the last decoded file
+ * @param instance Pointer to a SubGhzFileDecoder instance
+ * @return SubGhzRadioPreset* pointer to the preset, owned by the decoder
+ */
+SubGhzRadioPreset* subghz_file_decoder_get_preset(SubGhzFileDecoder* instance);
+
+/**
+ * Get amount of samples fed from the last decoded file
+ * @param instance Pointer to a SubGhzFileDecoder instance
+ * @return Amount of samples
+ */
+size_t subghz_file_decoder_get_sample_count(SubGhzFileDecoder* instance);
+
+#ifdef __cplusplus
+}
+#endif
@@ -5,10 +5,12 @@
 #include <flipper_format/flipper_format_i.h>
 #include <lib/subghz/devices/devices.h>
 #include <lib/toolbox/strint.h>
+#include "subghz_raw_binary.h"
 
 #define TAG "SubGhzFileEncoderWorker"
 
-#define SUBGHZ_FILE_ENCODER_LOAD 512
+#define SUBGHZ_FILE_ENCODER_LOAD        512
+#define SUBGHZ_FILE_ENCODER_BINARY_LOAD 64
 
 struct SubGhzFileEncoderWorker {
     FuriThread* thread;
@@ -16,6 +18,7 @@ struct SubGhzFileEncoderWorker {
 
     Storage* storage;
     FlipperFormat* flipper_format;
+    SubGhzRawBinaryReader* binary_reader;
 
     volatile bool worker_running;
     volatile bool worker_stoping;
@@ -119,6 +122,9 @@ static int32_t subghz_file_encoder_worker_thread(void* context) {
 
         //skip the end of the previous line "\n"
         stream_seek(stream, 1, StreamOffsetFromCurrent);
+        if(subghz_raw_binary_read_marker(stream)) {
+            instance->binary_reader = subghz_raw_binary_reader_alloc(stream);
+        }
         res = true;
         instance->worker_stoping = false;
         FURI_LOG_I(TAG, "Start transmission");
@@ -126,7 +132,22 @@ static int32_t subghz_file_encoder_worker_thread(void* context) {
 
     while(res && instance->worker_running) {
         size_t stream_free_byte = furi_stream_buffer_spaces_available(instance->stream);
-        if((stream_free_byte / sizeof(int32_t)) >= SUBGHZ_FILE_ENCODER_LOAD) {
+        if(instance->binary_reader) {
+            if((stream_free_byte / sizeof(int32_t)) >= SUBGHZ_FILE_ENCODER_BINARY_LOAD) {
+                int32_t samples[SUBGHZ_FILE_ENCODER_BINARY_LOAD];
+                size_t count = subghz_raw_binary_reader_read(
+                    instance->binary_reader, samples, SUBGHZ_FILE_ENCODER_BINARY_LOAD);
+                if(count) {
+                    furi_stream_buffer_send(
+                        instance->stream, samples, count * sizeof(int32_t), 100);
+                } else {
+                    subghz_file_encoder_worker_add_level_duration(instance, LEVEL_DURATION_RESET);
+                    break;
+                }
+            } else {
+                furi_delay_ms(1);
+            }
+        } else if((stream_free_byte / sizeof(int32_t)) >= SUBGHZ_FILE_ENCODER_LOAD) {
             if(stream_read_line(stream, instance->str_data)) {
                 furi_string_trim(instance->str_data);
                 if(!subghz_file_encoder_worker_data_parse(
@@ -160,6 +181,10 @@ static int32_t subghz_file_encoder_worker_thread(void* context) {
         }
         furi_delay_ms(50);
     }
+    if(instance->binary_reader) {
+        subghz_raw_binary_reader_free(instance->binary_reader);
+        instance->binary_reader = NULL;
+    }
     flipper_format_file_close(instance->flipper_format);
 
     FURI_LOG_I(TAG, "Worker stop");
@@ -175,6 +200,7 @@ SubGhzFileEncoderWorker* subghz_file_encoder_worker_alloc(void) {
 
     instance->storage = furi_record_open(RECORD_STORAGE);
     instance->flipper_format = flipper_format_file_alloc(instance->storage);
+    instance->binary_reader = NULL;
 
     instance->str_data = furi_string_alloc();
     instance->file_path = furi_string_alloc();
@@ -21,19 +21,57 @@
 #define SUBGHZ_KEYSTORE_FILE_DECRYPTED_LINE_SIZE 512
 #define SUBGHZ_KEYSTORE_FILE_ENCRYPTED_LINE_SIZE (SUBGHZ_KEYSTORE_FILE_DECRYPTED_LINE_SIZE * 2)
 
+#define SUBGHZ_KEYSTORE_NAME_POOL_SIZE 1024
+
+#define SUBGHZ_KEYSTORE_BINARY_MAGIC   (0x424B4753) // "SGKB"
+#define SUBGHZ_KEYSTORE_BINARY_VERSION 1
+
 typedef enum {
     SubGhzKeystoreEncryptionNone,
     SubGhzKeystoreEncryptionAES256,
 } SubGhzKeystoreEncryption;
 
+/** Binary keystore file header, followed by payload_size bytes of payload:
+ * key_count records, then string table with zero terminated names.
+ * Encrypted payload is padded with zeros to the AES block size.
+ */
+typedef struct {
+    uint32_t magic;
+    uint8_t version;
+    uint8_t encryption;
+    uint16_t reserved;
+    uint32_t key_count;
+    uint32_t payload_size;
+    uint8_t iv[16];
+} FURI_PACKED SubGhzKeystoreBinaryHeader;
+
+typedef struct {
+    uint64_t key;
+    uint16_t type;
+    uint16_t reserved;
+    uint32_t name_offset;
+} FURI_PACKED SubGhzKeystoreBinaryRecord;
+
+ARRAY_DEF(SubGhzKeystoreBufferArray, char*, M_PTR_OPLIST)
+
 struct SubGhzKeystore {
     SubGhzKeyArray_t data;
+
+    // Storage for manufacture names: text pools and binary payloads
+    SubGhzKeystoreBufferArray_t buffers;
+    char* pool;
+    size_t pool_free;
+    const char* last_name;
 };
 
 SubGhzKeystore* subghz_keystore_alloc(void) {
     SubGhzKeystore* instance = malloc(sizeof(SubGhzKeystore));
 
     SubGhzKeyArray_init(instance->data);
+    SubGhzKeystoreBufferArray_init(instance->buffers);
+    instance->pool = NULL;
+    instance->pool_free = 0;
+    instance->last_name = NULL;
 
     return instance;
 }
@@ -43,23 +81,62 @@ void subghz_keystore_free(SubGhzKeystore* instance) {
 
     for
         M_EACH(manufacture_code, instance->data, SubGhzKeyArray_t) {
-            furi_string_free(manufacture_code->name);
             manufacture_code->key = 0;
         }
     SubGhzKeyArray_clear(instance->data);
 
+    for
+        M_EACH(buffer, instance->buffers, SubGhzKeystoreBufferArray_t) {
+            free(*buffer);
+        }
+    SubGhzKeystoreBufferArray_clear(instance->buffers);
+
     free(instance);
 }
 
+static uint16_t subghz_keystore_get_flags(const char* name) {
+    uint16_t flags = SubGhzKeyFlagNone;
+    if(strcmp(name, "Centurion") == 0) {
+        flags |= SubGhzKeyFlagCenturion;
+    }
+    return flags;
+}
+
+/** Copy name into the keystore name pool, consecutive keys of the same
+ * manufacture share one copy
+ */
+static const char* subghz_keystore_intern_name(SubGhzKeystore* instance, const char* name) {
+    if(instance->last_name && strcmp(instance->last_name, name) == 0) {
+        return instance->last_name;
+    }
+
+    size_t len = strlen(name) + 1;
+    if(instance->pool_free < len) {
+        size_t pool_size = MAX((size_t)SUBGHZ_KEYSTORE_NAME_POOL_SIZE, len);
+        instance->pool = malloc(pool_size);
+        instance->pool_free = pool_size;
+        SubGhzKeystoreBufferArray_push_back(instance->buffers, instance->pool);
+    }
+
+    char* interned = instance->pool;
+    memcpy(interned, name, len);
+    instance->pool += len;
+    instance->pool_free -= len;
+    instance->last_name = interned;
+
+    return interned;
+}
+
 static void subghz_keystore_add_key(
     SubGhzKeystore* instance,
     const char* name,
     uint64_t key,
     uint16_t type) {
     SubGhzKey* manufacture_code = SubGhzKeyArray_push_raw(instance->data);
-    manufacture_code->name = furi_string_alloc_set(name);
+    manufacture_code->name = subghz_keystore_intern_name(instance, name);
     manufacture_code->key = key;
     manufacture_code->type = type;
+    manufacture_code->flags = subghz_keystore_get_flags(name);
 }
 
 static bool subghz_keystore_process_line(SubGhzKeystore* instance, char* line) {
@@ -184,8 +261,99 @@ static bool subghz_keystore_read_file(SubGhzKeystore* instance, Stream* stream,
     return result;
 }
 
-bool subghz_keystore_load(SubGhzKeystore* instance, const char* file_name) {
-    furi_assert(instance);
+static bool subghz_keystore_load_binary(
+    SubGhzKeystore* instance,
+    File* file,
+    const SubGhzKeystoreBinaryHeader* header) {
+    bool result = false;
+    uint32_t iv[4];
+    char* payload = NULL;
+
+    do {
+        if(header->version != SUBGHZ_KEYSTORE_BINARY_VERSION) {
+            FURI_LOG_E(TAG, "Version mismatch");
+            break;
+        }
+
+        size_t payload_size = header->payload_size;
+        size_t records_size = header->key_count * sizeof(SubGhzKeystoreBinaryRecord);
+        if(storage_file_size(file) != sizeof(SubGhzKeystoreBinaryHeader) + payload_size ||
+           header->key_count > payload_size / sizeof(SubGhzKeystoreBinaryRecord) ||
+           records_size == payload_size) {
+            FURI_LOG_E(TAG, "Malformed file");
+            break;
+        }
+
+        // Whole payload with a single read into a single allocation
+        payload = malloc(payload_size);
+        if(storage_file_read(file, payload, payload_size) != payload_size) {
+            FURI_LOG_E(TAG, "Unable to read payload");
+            break;
+        }
+
+        if(header->encryption == SubGhzKeystoreEncryptionAES256) {
+            if(payload_size % 16 != 0) {
+                FURI_LOG_E(TAG, "Invalid encrypted data");
+                break;
+            }
+            memcpy(iv, header->iv, sizeof(iv));
+            subghz_keystore_mess_with_iv((uint8_t*)iv);
+            if(!furi_hal_crypto_enclave_load_key(
+                   SUBGHZ_KEYSTORE_FILE_ENCRYPTION_KEY_SLOT, (uint8_t*)iv)) {
+                FURI_LOG_E(TAG, "Unable to load decryption key");
+                break;
+            }
+            bool decrypted =
+                furi_hal_crypto_decrypt((uint8_t*)payload, (uint8_t*)payload, payload_size);
+            furi_hal_crypto_enclave_unload_key(SUBGHZ_KEYSTORE_FILE_ENCRYPTION_KEY_SLOT);
+            if(!decrypted) {
+                FURI_LOG_E(TAG, "Decryption failed");
+                break;
+            }
+        } else if(header->encryption != SubGhzKeystoreEncryptionNone) {
+            FURI_LOG_E(TAG, "Unknown encryption");
+            break;
+        }
+
+        // String table must be terminated, so every name in it is
+        const char* names = payload + records_size;
+        size_t names_size = payload_size - records_size;
+        if(names[names_size - 1] != '\0') {
+            FURI_LOG_E(TAG, "Malformed string table");
+            break;
+        }
+
+        SubGhzKeyArray_reserve(
+            instance->data, SubGhzKeyArray_size(instance->data) + header->key_count);
+
+        result = true;
+        for(size_t i = 0; i < header->key_count; i++) {
+            SubGhzKeystoreBinaryRecord record;
+            memcpy(&record, payload + i * sizeof(record), sizeof(record));
+            if(record.name_offset >= names_size) {
+                FURI_LOG_E(TAG, "Malformed record %zu", i);
+                result = false;
+                break;
+            }
+
+            SubGhzKey* manufacture_code = SubGhzKeyArray_push_raw(instance->data);
+            manufacture_code->name = names + record.name_offset;
+            manufacture_code->key = record.key;
+            manufacture_code->type = record.type;
+            manufacture_code->flags = subghz_keystore_get_flags(manufacture_code->name);
+        }
+
+        // Records which were added refer to the payload, keep it even on failure
+        SubGhzKeystoreBufferArray_push_back(instance->buffers, payload);
+        payload = NULL;
+    } while(false);
+
+    if(payload) free(payload);
+
+    return result;
+}
+
+static bool subghz_keystore_load_text(SubGhzKeystore* instance, const char* file_name) {
     bool result = false;
     uint8_t iv[16];
     uint32_t version;
@@ -194,8 +362,6 @@ bool subghz_keystore_load(SubGhzKeystore* instance, const char* file_name) {
     FuriString* filetype;
     filetype = furi_string_alloc();
 
-    FURI_LOG_I(TAG, "Loading keystore %s", file_name);
-
     Storage* storage = furi_record_open(RECORD_STORAGE);
 
     FlipperFormat* flipper_format = flipper_format_file_alloc(storage);
@@ -243,6 +409,36 @@ bool subghz_keystore_load(SubGhzKeystore* instance, const char* file_name) {
     return result;
 }
 
+bool subghz_keystore_load(SubGhzKeystore* instance, const char* file_name) {
+    furi_assert(instance);
+    bool result = false;
+    bool binary = false;
+
+    FURI_LOG_I(TAG, "Loading keystore %s", file_name);
+
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    File* file = storage_file_alloc(storage);
+
+    // Binary keystore is recognized by magic, anything else goes to the text parser
+    if(storage_file_open(file, file_name, FSAM_READ, FSOM_OPEN_EXISTING)) {
+        SubGhzKeystoreBinaryHeader header;
+        if(storage_file_read(file, &header, sizeof(header)) == sizeof(header) &&
+           header.magic == SUBGHZ_KEYSTORE_BINARY_MAGIC) {
+            binary = true;
+            result = subghz_keystore_load_binary(instance, file, &header);
+        }
+    }
+
+    storage_file_free(file);
+    furi_record_close(RECORD_STORAGE);
+
+    if(!binary) {
+        result = subghz_keystore_load_text(instance, file_name);
+    }
+
+    return result;
+}
+
 bool subghz_keystore_save(SubGhzKeystore* instance, const char* file_name, uint8_t* iv) {
     furi_assert(instance);
     bool result = false;
@@ -294,7 +490,7 @@ bool subghz_keystore_save(SubGhzKeystore* instance, const char* file_name, uint8
                     (uint32_t)(key->key >> 32),
                     (uint32_t)key->key,
                     key->type,
-                    furi_string_get_cstr(key->name));
+                    key->name);
                 // Verify length and align
                 furi_assert(len > 0);
                 if(len % 16 != 0) {
@@ -338,6 +534,110 @@ bool subghz_keystore_save(SubGhzKeystore* instance, const char* file_name, uint8
     return result;
 }
 
+bool subghz_keystore_save_binary(SubGhzKeystore* instance, const char* file_name, uint8_t* iv) {
+    furi_assert(instance);
+    bool result = false;
+
+    SubGhzKeystoreBinaryHeader header = {
+        .magic = SUBGHZ_KEYSTORE_BINARY_MAGIC,
+        .version = SUBGHZ_KEYSTORE_BINARY_VERSION,
+        .encryption = iv ? SubGhzKeystoreEncryptionAES256 : SubGhzKeystoreEncryptionNone,
+        .reserved = 0,
+        .key_count = SubGhzKeyArray_size(instance->data),
+    };
+    if(iv) memcpy(header.iv, iv, sizeof(header.iv));
+
+    // String table size, consecutive keys of the same manufacture share one name
+    size_t records_size = header.key_count * sizeof(SubGhzKeystoreBinaryRecord);
+    size_t names_size = 0;
+    const char* last_name = NULL;
+    for
+        M_EACH(manufacture_code, instance->data, SubGhzKeyArray_t) {
+            if(!last_name || strcmp(last_name, manufacture_code->name) != 0) {
+                names_size += strlen(manufacture_code->name) + 1;
+                last_name = manufacture_code->name;
+            }
+        }
+
+    size_t payload_size = records_size + MAX(names_size, (size_t)1);
+    if(iv && payload_size % 16 != 0) {
+        payload_size += 16 - payload_size % 16;
+    }
+    header.payload_size = payload_size;
+
+    char* payload = malloc(payload_size);
+    memset(payload, 0, payload_size);
+
+    char* names = payload + records_size;
+    size_t name_offset = 0;
+    size_t names_cursor = 0;
+    last_name = NULL;
+    size_t index = 0;
+    for
+        M_EACH(manufacture_code, instance->data, SubGhzKeyArray_t) {
+            if(!last_name || strcmp(last_name, manufacture_code->name) != 0) {
+                size_t len = strlen(manufacture_code->name) + 1;
+                memcpy(names + names_cursor, manufacture_code->name, len);
+                name_offset = names_cursor;
+                names_cursor += len;
+                last_name = manufacture_code->name;
+            }
+
+            SubGhzKeystoreBinaryRecord record = {
+                .key = manufacture_code->key,
+                .type = manufacture_code->type,
+                .reserved = 0,
+                .name_offset = name_offset,
+            };
+            memcpy(payload + index * sizeof(record), &record, sizeof(record));
+            index++;
+        }
+
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    File* file = storage_file_alloc(storage);
+
+    do {
+        if(iv) {
+            uint32_t iv_aligned[4];
+            memcpy(iv_aligned, iv, sizeof(iv_aligned));
+            subghz_keystore_mess_with_iv((uint8_t*)iv_aligned);
+            if(!furi_hal_crypto_enclave_load_key(
+                   SUBGHZ_KEYSTORE_FILE_ENCRYPTION_KEY_SLOT, (uint8_t*)iv_aligned)) {
+                FURI_LOG_E(TAG, "Unable to load encryption key");
+                break;
+            }
+            bool encrypted =
+                furi_hal_crypto_encrypt((uint8_t*)payload, (uint8_t*)payload, payload_size);
+            furi_hal_crypto_enclave_unload_key(SUBGHZ_KEYSTORE_FILE_ENCRYPTION_KEY_SLOT);
+            if(!encrypted) {
+                FURI_LOG_E(TAG, "Encryption failed");
+                break;
+            }
+        }
+
+        if(!storage_file_open(file, file_name, FSAM_WRITE, FSOM_CREATE_ALWAYS)) {
+            FURI_LOG_E(TAG, "Unable to open file for write: %s", file_name);
+            break;
+        }
+        if(storage_file_write(file, &header, sizeof(header)) != sizeof(header) ||
+           storage_file_write(file, payload, payload_size) != payload_size) {
+            FURI_LOG_E(TAG, "Unable to write file");
+            break;
+        }
+
+        FURI_LOG_I(
+            TAG, "Packed %lu keys, %zu bytes of names", header.key_count, names_cursor);
+        result = true;
+    } while(false);
+
+    storage_file_free(file);
+    furi_record_close(RECORD_STORAGE);
+
+    free(payload);
+
+    return result;
+}
+
 SubGhzKeyArray_t* subghz_keystore_get_data(SubGhzKeystore* instance) {
     furi_assert(instance);
     return &instance->data;
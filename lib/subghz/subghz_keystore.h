@@ -8,10 +8,16 @@
 extern "C" {
 #endif
 
+typedef enum {
+    SubGhzKeyFlagNone = 0,
+    SubGhzKeyFlagCenturion = (1 << 0), /**< Centurion KeeLoq, hop has no serial discriminator */
+} SubGhzKeyFlag;
+
 typedef struct {
-    FuriString* name;
+    const char* name; /**< Manufacture name, owned by the keystore */
     uint64_t key;
     uint16_t type;
+    uint16_t flags; /**< SubGhzKeyFlag, resolved from the name when the key is added */
 } SubGhzKey;
 
 ARRAY_DEF(SubGhzKeyArray, SubGhzKey, M_POD_OPLIST)
@@ -47,6 +53,17 @@ bool subghz_keystore_load(SubGhzKeystore* instance, const char* filename);
  */
 bool subghz_keystore_save(SubGhzKeystore* instance, const char* filename, uint8_t* iv);
 
+/** 
+ * Save manufacture keys to binary keystore file
+ * Binary keystore is loaded by subghz_keystore_load with a single read,
+ * without per line parsing and per key allocations.
+ * @param instance Pointer to a SubGhzKeystore instance
+ * @param filename Full path to the file
+ * @param iv IV, 16 bytes, NULL to save without encryption
+ * @return true On success
+ */
+bool subghz_keystore_save_binary(SubGhzKeystore* instance, const char* filename, uint8_t* iv);
+
 /** 
  * Get array of keys and names manufacture
  * @param instance Pointer to a SubGhzKeystore instance
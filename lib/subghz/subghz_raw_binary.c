@@ -0,0 +1,342 @@
+#include "subghz_raw_binary.h"
+
+#include <flipper_format/flipper_format.h>
+#include <flipper_format/flipper_format_i.h>
+#include <lib/toolbox/varint.h>
+#include <lib/toolbox/strint.h>
+
+#define TAG "SubGhzRawBinary"
+
+#define SUBGHZ_RAW_BINARY_MARKER       SUBGHZ_RAW_BINARY_KEY ": " SUBGHZ_RAW_BINARY_VALUE
+#define SUBGHZ_RAW_BINARY_HEADER_SIZE  4
+#define SUBGHZ_RAW_BINARY_VARINT_MAX   5
+#define SUBGHZ_RAW_BINARY_BLOCK_MAX \
+    (SUBGHZ_RAW_BINARY_BLOCK_SAMPLES * SUBGHZ_RAW_BINARY_VARINT_MAX)
+#define SUBGHZ_RAW_BINARY_TEXT_KEY     "RAW_Data"
+#define SUBGHZ_RAW_BINARY_TEXT_PATTERN SUBGHZ_RAW_BINARY_TEXT_KEY ": "
+
+struct SubGhzRawBinaryWriter {
+    Stream* stream;
+    uint8_t block[SUBGHZ_RAW_BINARY_HEADER_SIZE + SUBGHZ_RAW_BINARY_BLOCK_MAX];
+};
+
+struct SubGhzRawBinaryReader {
+    Stream* stream;
+    size_t data_start;
+
+    uint8_t block[SUBGHZ_RAW_BINARY_BLOCK_MAX];
+    size_t block_size;
+    size_t block_position;
+    size_t block_samples_left;
+};
+
+bool subghz_raw_binary_write_marker(Stream* stream) {
+    furi_check(stream);
+
+    const char* marker = SUBGHZ_RAW_BINARY_MARKER "\n";
+    return stream_write_cstring(stream, marker) == strlen(marker);
+}
+
+bool subghz_raw_binary_read_marker(Stream* stream) {
+    furi_check(stream);
+
+    size_t position = stream_tell(stream);
+    FuriString* line = furi_string_alloc();
+
+    bool found = false;
+    if(stream_read_line(stream, line)) {
+        furi_string_trim(line);
+        found = furi_string_equal_str(line, SUBGHZ_RAW_BINARY_MARKER);
+    }
+    if(!found) {
+        stream_seek(stream, position, StreamOffsetFromStart);
+    }
+
+    furi_string_free(line);
+    return found;
+}
+
+SubGhzRawBinaryWriter* subghz_raw_binary_writer_alloc(Stream* stream) {
+    furi_check(stream);
+
+    SubGhzRawBinaryWriter* instance = malloc(sizeof(SubGhzRawBinaryWriter));
+    instance->stream = stream;
+
+    return instance;
+}
+
+void subghz_raw_binary_writer_free(SubGhzRawBinaryWriter* instance) {
+    furi_check(instance);
+    free(instance);
+}
+
+bool subghz_raw_binary_writer_write(
+    SubGhzRawBinaryWriter* instance,
+    const int32_t* samples,
+    size_t count) {
+    furi_check(instance);
+    furi_check(samples || !count);
+
+    while(count) {
+        size_t block_samples = MIN(count, (size_t)SUBGHZ_RAW_BINARY_BLOCK_SAMPLES);
+        uint8_t* data = instance->block + SUBGHZ_RAW_BINARY_HEADER_SIZE;
+        size_t data_size = 0;
+
+        for(size_t i = 0; i < block_samples; i++) {
+            data_size += varint_int32_pack(samples[i], data + data_size);
+        }
+
+        instance->block[0] = block_samples & 0xFF;
+        instance->block[1] = block_samples >> 8;
+        instance->block[2] = data_size & 0xFF;
+        instance->block[3] = data_size >> 8;
+
+        size_t block_size = SUBGHZ_RAW_BINARY_HEADER_SIZE + data_size;
+        if(stream_write(instance->stream, instance->block, block_size) != block_size) {
+            FURI_LOG_E(TAG, "Unable to write block");
+            return false;
+        }
+
+        samples += block_samples;
+        count -= block_samples;
+    }
+
+    return true;
+}
+
+SubGhzRawBinaryReader* subghz_raw_binary_reader_alloc(Stream* stream) {
+    furi_check(stream);
+
+    SubGhzRawBinaryReader* instance = malloc(sizeof(SubGhzRawBinaryReader));
+    instance->stream = stream;
+    instance->data_start = stream_tell(stream);
+    instance->block_size = 0;
+    instance->block_position = 0;
+    instance->block_samples_left = 0;
+
+    return instance;
+}
+
+void subghz_raw_binary_reader_free(SubGhzRawBinaryReader* instance) {
+    furi_check(instance);
+    free(instance);
+}
+
+static bool subghz_raw_binary_reader_read_header(
+    SubGhzRawBinaryReader* instance,
+    size_t* samples,
+    size_t* data_size) {
+    uint8_t header[SUBGHZ_RAW_BINARY_HEADER_SIZE];
+    if(stream_read(instance->stream, header, sizeof(header)) != sizeof(header)) {
+        return false;
+    }
+
+    *samples = header[0] | (header[1] << 8);
+    *data_size = header[2] | (header[3] << 8);
+    if(*samples == 0 || *samples > SUBGHZ_RAW_BINARY_BLOCK_SAMPLES ||
+       *data_size < *samples || *data_size > SUBGHZ_RAW_BINARY_BLOCK_MAX) {
+        FURI_LOG_E(TAG, "Malformed block");
+        return false;
+    }
+
+    return true;
+}
+
+static bool subghz_raw_binary_reader_load_block(SubGhzRawBinaryReader* instance) {
+    size_t samples, data_size;
+    if(!subghz_raw_binary_reader_read_header(instance, &samples, &data_size)) {
+        return false;
+    }
+    if(stream_read(instance->stream, instance->block, data_size) != data_size) {
+        FURI_LOG_E(TAG, "Truncated block");
+        return false;
+    }
+
+    instance->block_size = data_size;
+    instance->block_position = 0;
+    instance->block_samples_left = samples;
+    return true;
+}
+
+size_t subghz_raw_binary_reader_read(
+    SubGhzRawBinaryReader* instance,
+    int32_t* samples,
+    size_t count) {
+    furi_check(instance);
+    furi_check(samples || !count);
+
+    size_t read = 0;
+    while(read < count) {
+        if(!instance->block_samples_left) {
+            if(!subghz_raw_binary_reader_load_block(instance)) break;
+        }
+
+        size_t available = instance->block_size - instance->block_position;
+        size_t used = varint_int32_unpack(
+            &samples[read], instance->block + instance->block_position, available);
+        if(!available || used > available) {
+            FURI_LOG_E(TAG, "Malformed block data");
+            instance->block_samples_left = 0;
+            break;
+        }
+        instance->block_position += used;
+        instance->block_samples_left--;
+        read++;
+    }
+
+    return read;
+}
+
+bool subghz_raw_binary_reader_seek(SubGhzRawBinaryReader* instance, size_t sample_index) {
+    furi_check(instance);
+
+    instance->block_samples_left = 0;
+    if(!stream_seek(instance->stream, instance->data_start, StreamOffsetFromStart)) {
+        return false;
+    }
+
+    size_t block_first = 0;
+    while(true) {
+        size_t samples, data_size;
+        if(!subghz_raw_binary_reader_read_header(instance, &samples, &data_size)) {
+            return false;
+        }
+
+        if(sample_index < block_first + samples) {
+            // Rewind to the header of the block and skip samples before the target
+            stream_seek(
+                instance->stream, -SUBGHZ_RAW_BINARY_HEADER_SIZE, StreamOffsetFromCurrent);
+            if(!subghz_raw_binary_reader_load_block(instance)) return false;
+
+            int32_t skip;
+            for(size_t i = block_first; i < sample_index; i++) {
+                subghz_raw_binary_reader_read(instance, &skip, 1);
+            }
+            return true;
+        }
+
+        if(!stream_seek(instance->stream, data_size, StreamOffsetFromCurrent)) {
+            return false;
+        }
+        block_first += samples;
+    }
+}
+
+static bool subghz_raw_binary_convert_to_text(Stream* input, FlipperFormat* output) {
+    SubGhzRawBinaryReader* reader = subghz_raw_binary_reader_alloc(input);
+    int32_t* samples = malloc(SUBGHZ_RAW_BINARY_BLOCK_SAMPLES * sizeof(int32_t));
+    bool result = true;
+
+    size_t count;
+    while((count = subghz_raw_binary_reader_read(
+               reader, samples, SUBGHZ_RAW_BINARY_BLOCK_SAMPLES)) > 0) {
+        if(!flipper_format_write_int32(output, SUBGHZ_RAW_BINARY_TEXT_KEY, samples, count)) {
+            FURI_LOG_E(TAG, "Unable to add " SUBGHZ_RAW_BINARY_TEXT_KEY);
+            result = false;
+            break;
+        }
+    }
+
+    free(samples);
+    subghz_raw_binary_reader_free(reader);
+    return result;
+}
+
+static bool
+    subghz_raw_binary_convert_to_binary(Stream* input, FuriString* line, Stream* output) {
+    if(!subghz_raw_binary_write_marker(output)) return false;
+
+    SubGhzRawBinaryWriter* writer = subghz_raw_binary_writer_alloc(output);
+    int32_t* samples = malloc(SUBGHZ_RAW_BINARY_BLOCK_SAMPLES * sizeof(int32_t));
+    size_t count = 0;
+    bool result = true;
+
+    // First data line is already read by the caller
+    do {
+        const char* str = strstr(furi_string_get_cstr(line), SUBGHZ_RAW_BINARY_TEXT_PATTERN);
+        if(!str) continue;
+        str += strlen(SUBGHZ_RAW_BINARY_TEXT_PATTERN);
+
+        char* end = (char*)str;
+        int32_t duration;
+        while(strint_to_int32(end, &end, &duration, 10) == StrintParseNoError) {
+            samples[count++] = duration;
+            if(count == SUBGHZ_RAW_BINARY_BLOCK_SAMPLES) {
+                result = subghz_raw_binary_writer_write(writer, samples, count);
+                count = 0;
+                if(!result) break;
+            }
+            if(*end == ',') end++;
+        }
+    } while(result && stream_read_line(input, line));
+
+    if(result && count) {
+        result = subghz_raw_binary_writer_write(writer, samples, count);
+    }
+
+    free(samples);
+    subghz_raw_binary_writer_free(writer);
+    return result;
+}
+
+bool subghz_raw_binary_convert(const char* source_path, const char* destination_path) {
+    furi_check(source_path);
+    furi_check(destination_path);
+
+    bool result = false;
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    FlipperFormat* input_ff = flipper_format_file_alloc(storage);
+    FlipperFormat* output_ff = flipper_format_file_alloc(storage);
+    FuriString* line = furi_string_alloc();
+
+    do {
+        if(!flipper_format_file_open_existing(input_ff, source_path)) {
+            FURI_LOG_E(TAG, "Unable to open file for read: %s", source_path);
+            break;
+        }
+        if(!flipper_format_file_open_always(output_ff, destination_path)) {
+            FURI_LOG_E(TAG, "Unable to open file for write: %s", destination_path);
+            break;
+        }
+
+        Stream* input = flipper_format_get_raw_stream(input_ff);
+        Stream* output = flipper_format_get_raw_stream(output_ff);
+
+        // Copy header lines until samples start
+        bool header_copied = true;
+        bool binary = false;
+        bool text = false;
+        while(!binary && !text) {
+            if(subghz_raw_binary_read_marker(input)) {
+                binary = true;
+            } else if(stream_read_line(input, line)) {
+                if(furi_string_start_with_str(line, SUBGHZ_RAW_BINARY_TEXT_PATTERN)) {
+                    text = true;
+                } else if(stream_write_string(output, line) != furi_string_size(line)) {
+                    header_copied = false;
+                    break;
+                }
+            } else {
+                break;
+            }
+        }
+
+        if(!header_copied || (!binary && !text)) {
+            FURI_LOG_E(TAG, "Missing RAW data");
+            break;
+        }
+
+        if(binary) {
+            result = subghz_raw_binary_convert_to_text(input, output_ff);
+        } else {
+            result = subghz_raw_binary_convert_to_binary(input, line, output);
+        }
+    } while(false);
+
+    furi_string_free(line);
+    flipper_format_free(output_ff);
+    flipper_format_free(input_ff);
+    furi_record_close(RECORD_STORAGE);
+
+    return result;
+}
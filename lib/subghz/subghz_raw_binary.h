@@ -0,0 +1,108 @@
+#pragma once
+
+#include <furi.h>
+#include <toolbox/stream/stream.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Binary RAW samples container
+ *
+ * RAW file keeps its text header, after the "RAW_Format: Binary" line
+ * samples are stored as blocks until the end of file:
+ * uint16 sample count, uint16 data size, data size bytes of signed varints
+ */
+#define SUBGHZ_RAW_BINARY_KEY           "RAW_Format"
+#define SUBGHZ_RAW_BINARY_VALUE         "Binary"
+#define SUBGHZ_RAW_BINARY_BLOCK_SAMPLES 512
+
+typedef struct SubGhzRawBinaryWriter SubGhzRawBinaryWriter;
+typedef struct SubGhzRawBinaryReader SubGhzRawBinaryReader;
+
+/**
+ * Write binary samples marker line
+ * @param stream Pointer to a Stream instance, positioned after the text header
+ * @return true On success
+ */
+bool subghz_raw_binary_write_marker(Stream* stream);
+
+/**
+ * Check for binary samples marker line at the current position
+ * Stream is left after the marker if it is found, unchanged otherwise.
+ * @param stream Pointer to a Stream instance
+ * @return true If binary samples follow
+ */
+bool subghz_raw_binary_read_marker(Stream* stream);
+
+/**
+ * Allocate SubGhzRawBinaryWriter
+ * @param stream Pointer to a Stream instance, positioned after the marker
+ * @return SubGhzRawBinaryWriter* pointer to a SubGhzRawBinaryWriter instance
+ */
+SubGhzRawBinaryWriter* subghz_raw_binary_writer_alloc(Stream* stream);
+
+/**
+ * Free SubGhzRawBinaryWriter
+ * @param instance Pointer to a SubGhzRawBinaryWriter instance
+ */
+void subghz_raw_binary_writer_free(SubGhzRawBinaryWriter* instance);
+
+/**
+ * Append samples to the stream
+ * @param instance Pointer to a SubGhzRawBinaryWriter instance
+ * @param samples Signed durations, positive for high level, negative for low
+ * @param count Amount of samples
+ * @return true On success
+ */
+bool subghz_raw_binary_writer_write(
+    SubGhzRawBinaryWriter* instance,
+    const int32_t* samples,
+    size_t count);
+
+/**
+ * Allocate SubGhzRawBinaryReader
+ * @param stream Pointer to a Stream instance, positioned after the marker
+ * @return SubGhzRawBinaryReader* pointer to a SubGhzRawBinaryReader instance
+ */
+SubGhzRawBinaryReader* subghz_raw_binary_reader_alloc(Stream* stream);
+
+/**
+ * Free SubGhzRawBinaryReader
+ * @param instance Pointer to a SubGhzRawBinaryReader instance
+ */
+void subghz_raw_binary_reader_free(SubGhzRawBinaryReader* instance);
+
+/**
+ * Read next samples
+ * @param instance Pointer to a SubGhzRawBinaryReader instance
+ * @param samples Output buffer
+ * @param count Output buffer capacity in samples
+ * @return Amount of samples read, 0 at the end of data or on error
+ */
+size_t subghz_raw_binary_reader_read(
+    SubGhzRawBinaryReader* instance,
+    int32_t* samples,
+    size_t count);
+
+/**
+ * Seek to sample, only block headers are read on the way
+ * @param instance Pointer to a SubGhzRawBinaryReader instance
+ * @param sample_index Index of the sample to be read next
+ * @return true On success, false if sample_index is out of range
+ */
+bool subghz_raw_binary_reader_seek(SubGhzRawBinaryReader* instance, size_t sample_index);
+
+/**
+ * Convert RAW file between text and binary samples formats
+ * Header is copied as is, the format of samples is flipped.
+ * @param source_path Full path to the source RAW file
+ * @param destination_path Full path to the destination file
+ * @return true On success
+ */
+bool subghz_raw_binary_convert(const char* source_path, const char* destination_path);
+
+#ifdef __cplusplus
+}
+#endif
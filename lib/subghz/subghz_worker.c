@@ -4,9 +4,18 @@
 
 #define TAG "SubGhzWorker"
 
+#define SUBGHZ_WORKER_BATCH_SIZE     128
+#define SUBGHZ_WORKER_RING_SIZE      4096
+#define SUBGHZ_WORKER_RING_WATERMARK (SUBGHZ_WORKER_BATCH_SIZE / 2)
+#define SUBGHZ_WORKER_RING_FLAG      (1UL << 0)
+
 struct SubGhzWorker {
     FuriThread* thread;
-    FuriStreamBuffer* stream;
+    FuriSpscRing* ring;
+
+    LevelDuration rx_batch[SUBGHZ_WORKER_BATCH_SIZE];
+    LevelDuration pair_batch[SUBGHZ_WORKER_BATCH_SIZE];
+    size_t pair_batch_count;
 
     volatile bool running;
     volatile bool overrun;
@@ -16,6 +25,7 @@ struct SubGhzWorker {
 
     SubGhzWorkerOverrunCallback overrun_callback;
     SubGhzWorkerPairCallback pair_callback;
+    SubGhzWorkerPairBatchCallback pair_batch_callback;
     void* context;
 };
 
@@ -33,9 +43,29 @@ void subghz_worker_rx_callback(bool level, uint32_t duration, void* context) {
         instance->overrun = false;
         level_duration = level_duration_reset();
     }
-    size_t ret =
-        furi_stream_buffer_send(instance->stream, &level_duration, sizeof(LevelDuration), 0);
-    if(sizeof(LevelDuration) != ret) instance->overrun = true;
+    if(!furi_spsc_ring_push(instance->ring, &level_duration, 1)) instance->overrun = true;
+}
+
+/** Deliver collected pairs to the consumer
+ * 
+ * @param instance Pointer to a SubGhzWorker instance
+ */
+static void subghz_worker_pair_batch_flush(SubGhzWorker* instance) {
+    if(!instance->pair_batch_count) return;
+
+    if(instance->pair_batch_callback) {
+        instance->pair_batch_callback(
+            instance->context, instance->pair_batch, instance->pair_batch_count);
+    } else if(instance->pair_callback) {
+        for(size_t i = 0; i < instance->pair_batch_count; i++) {
+            instance->pair_callback(
+                instance->context,
+                level_duration_get_level(instance->pair_batch[i]),
+                level_duration_get_duration(instance->pair_batch[i]));
+        }
+    }
+
+    instance->pair_batch_count = 0;
 }
 
 /** Worker callback thread
@@ -46,12 +76,23 @@ void subghz_worker_rx_callback(bool level, uint32_t duration, void* context) {
 static int32_t subghz_worker_thread_callback(void* context) {
     SubGhzWorker* instance = context;
 
-    LevelDuration level_duration;
+    // Woken up once per watermark of pulses instead of every pulse
+    furi_spsc_ring_set_consumer(
+        instance->ring,
+        furi_thread_get_current_id(),
+        SUBGHZ_WORKER_RING_FLAG,
+        SUBGHZ_WORKER_RING_WATERMARK);
+
     while(instance->running) {
-        int ret = furi_stream_buffer_receive(
-            instance->stream, &level_duration, sizeof(LevelDuration), 10);
-        if(ret == sizeof(LevelDuration)) {
+        // Drain everything available in one call, up to batch size
+        size_t count = furi_spsc_ring_receive(
+            instance->ring, instance->rx_batch, SUBGHZ_WORKER_BATCH_SIZE, 10);
+
+        for(size_t i = 0; i < count; i++) {
+            LevelDuration level_duration = instance->rx_batch[i];
             if(level_duration_is_reset(level_duration)) {
+                // Pairs received before overrun go first
+                subghz_worker_pair_batch_flush(instance);
                 FURI_LOG_E(TAG, "Overrun buffer");
                 if(instance->overrun_callback) instance->overrun_callback(instance->context);
             } else {
@@ -63,19 +104,21 @@ static int32_t subghz_worker_thread_callback(void* context) {
                     instance->filter_level_duration.duration += duration;
 
                 } else if(instance->filter_level_duration.level != level) {
-                    if(instance->pair_callback)
-                        instance->pair_callback(
-                            instance->context,
-                            instance->filter_level_duration.level,
-                            instance->filter_level_duration.duration);
+                    instance->pair_batch[instance->pair_batch_count++] = level_duration_make(
+                        instance->filter_level_duration.level,
+                        instance->filter_level_duration.duration);
 
                     instance->filter_level_duration.duration = duration;
                     instance->filter_level_duration.level = level;
                 }
             }
         }
+
+        subghz_worker_pair_batch_flush(instance);
     }
 
+    furi_spsc_ring_set_consumer(instance->ring, NULL, 0, 1);
+
     return 0;
 }
 
@@ -85,8 +128,7 @@ SubGhzWorker* subghz_worker_alloc(void) {
     instance->thread =
         furi_thread_alloc_ex("SubGhzWorker", 2048, subghz_worker_thread_callback, instance);
 
-    instance->stream =
-        furi_stream_buffer_alloc(sizeof(LevelDuration) * 4096, sizeof(LevelDuration));
+    instance->ring = furi_spsc_ring_alloc(SUBGHZ_WORKER_RING_SIZE, sizeof(LevelDuration));
 
     //setting default filter in us
     instance->filter_duration = 30;
@@ -97,7 +139,7 @@ SubGhzWorker* subghz_worker_alloc(void) {
 void subghz_worker_free(SubGhzWorker* instance) {
     furi_check(instance);
 
-    furi_stream_buffer_free(instance->stream);
+    furi_spsc_ring_free(instance->ring);
     furi_thread_free(instance->thread);
 
     free(instance);
@@ -115,6 +157,13 @@ void subghz_worker_set_pair_callback(SubGhzWorker* instance, SubGhzWorkerPairCal
     instance->pair_callback = callback;
 }
 
+void subghz_worker_set_pair_batch_callback(
+    SubGhzWorker* instance,
+    SubGhzWorkerPairBatchCallback callback) {
+    furi_check(instance);
+    instance->pair_batch_callback = callback;
+}
+
 void subghz_worker_set_context(SubGhzWorker* instance, void* context) {
     furi_check(instance);
     instance->context = context;
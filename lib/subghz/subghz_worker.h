@@ -1,6 +1,7 @@
 #pragma once
 
 #include <furi_hal.h>
+#include <lib/toolbox/level_duration.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -12,6 +13,9 @@ typedef void (*SubGhzWorkerOverrunCallback)(void* context);
 
 typedef void (*SubGhzWorkerPairCallback)(void* context, bool level, uint32_t duration);
 
+typedef void (
+    *SubGhzWorkerPairBatchCallback)(void* context, const LevelDuration* pairs, size_t count);
+
 void subghz_worker_rx_callback(bool level, uint32_t duration, void* context);
 
 /** 
@@ -42,6 +46,16 @@ void subghz_worker_set_overrun_callback(
  */
 void subghz_worker_set_pair_callback(SubGhzWorker* instance, SubGhzWorkerPairCallback callback);
 
+/** 
+ * Pair batch callback SubGhzWorker.
+ * Receives all pairs collected from one stream buffer read, takes precedence over pair callback.
+ * @param instance Pointer to a SubGhzWorker instance
+ * @param callback SubGhzWorkerPairBatchCallback callback
+ */
+void subghz_worker_set_pair_batch_callback(
+    SubGhzWorker* instance,
+    SubGhzWorkerPairBatchCallback callback);
+
 /** 
  * Context callback SubGhzWorker.
  * @param instance Pointer to a SubGhzWorker instance
@@ -0,0 +1,113 @@
+/**
+ * @file crc.h
+ * Table driven CRC engine
+ *
+ * CRC algorithms are described with the Rocksoft model: width, polynomial in normal (MSB first)
+ * form, initial value, input and output reflection and final XOR. Models with a lookup table
+ * process a byte per step, models without one fall back to the bitwise calculation, so any
+ * parameter set can be computed without allocating anything.
+ *
+ * Calculation can be done at once with crc_calculate() or incrementally:
+ * crc_init(), any number of crc_update() calls and crc_finish(). Values passed between them are
+ * raw CRC registers, which are stored reflected for reflected models.
+ */
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct {
+    uint8_t width; /**< CRC width in bits: 8, 16 or 32 */
+    bool ref_in; /**< Input bytes are processed LSB first */
+    bool ref_out; /**< Register is reflected before the final XOR */
+    uint32_t poly; /**< Polynomial in normal form, without the top bit */
+    uint32_t init; /**< Initial value, not reflected */
+    uint32_t xor_out; /**< Value XORed with the result */
+    const void* table; /**< Lookup tables of width sized entries, NULL for bitwise calculation */
+    uint8_t slices; /**< Number of 256 entry tables, 4 or 8 enable slice-by-N */
+} CrcModel;
+
+/** CRC-8/MAXIM-DOW, 1-Wire ROM and memory */
+extern const CrcModel crc_model_maxim;
+
+/** CRC-16/ISO-IEC-14443-3-A */
+extern const CrcModel crc_model_iso14443a;
+
+/** CRC-16/IBM-SDLC, also known as X-25: ISO14443-3B and ISO13239 */
+extern const CrcModel crc_model_x25;
+
+/** ISO13239 variant used by Picopass */
+extern const CrcModel crc_model_picopass;
+
+/** CRC-16/XMODEM: FeliCa (transmitted MSB first), FDX-B */
+extern const CrcModel crc_model_xmodem;
+
+/** CRC-32/ISO-HDLC, as used by zlib. Processes 4 bytes per step */
+extern const CrcModel crc_model_crc32;
+
+/** Get initial CRC register value
+ *
+ * @param      model  CRC model
+ *
+ * @return     CRC register
+ */
+uint32_t crc_init(const CrcModel* model);
+
+/** Feed data into CRC register
+ *
+ * @param      model  CRC model
+ * @param      crc    CRC register from crc_init() or previous crc_update()
+ * @param      data   data to process
+ * @param      size   data size in bytes
+ *
+ * @return     CRC register
+ */
+uint32_t crc_update(const CrcModel* model, uint32_t crc, const void* data, size_t size);
+
+/** Get CRC value from CRC register
+ *
+ * @param      model  CRC model
+ * @param      crc    CRC register
+ *
+ * @return     CRC value
+ */
+uint32_t crc_finish(const CrcModel* model, uint32_t crc);
+
+/** Calculate CRC of a buffer
+ *
+ * @param      model  CRC model
+ * @param      data   data to process
+ * @param      size   data size in bytes
+ *
+ * @return     CRC value
+ */
+uint32_t crc_calculate(const CrcModel* model, const void* data, size_t size);
+
+/** Get lookup table size for a model
+ *
+ * Slice-by-N tables are only supported for reflected 32 bit models.
+ *
+ * @param      model  CRC model, width and slices are used
+ *
+ * @return     table size in bytes
+ */
+size_t crc_table_size(const CrcModel* model);
+
+/** Generate lookup table for a model
+ *
+ * Allows custom models to use table driven calculation: allocate crc_table_size() bytes,
+ * fill them and set the model table.
+ *
+ * @param      model  CRC model, table is ignored
+ * @param      table  buffer of crc_table_size() bytes
+ */
+void crc_table_fill(const CrcModel* model, void* table);
+
+#ifdef __cplusplus
+}
+#endif
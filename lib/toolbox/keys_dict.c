@@ -8,11 +8,42 @@
 
 #define TAG "KeysDict"
 
+#define KEYS_DICT_INDEX_EXTENSION  ".idx"
+#define KEYS_DICT_INDEX_MAGIC      (0x5844494BUL)
+#define KEYS_DICT_INDEX_VERSION    (1U)
+#define KEYS_DICT_INDEX_MOVE_CHUNK (256U)
+
+typedef enum {
+    KeysDictIndexStateUnknown,
+    KeysDictIndexStateValid,
+    KeysDictIndexStateUnavailable,
+} KeysDictIndexState;
+
+/** Sidecar index header, followed by total_keys binary keys sorted with memcmp */
+typedef struct {
+    uint32_t magic;
+    uint8_t version;
+    uint8_t key_size;
+    uint16_t reserved;
+    uint32_t dict_size;
+    uint32_t dict_timestamp;
+    uint32_t total_keys;
+} KeysDictIndexHeader;
+
 struct KeysDict {
     Stream* stream;
     size_t key_size;
     size_t key_size_symbols;
     size_t total_keys;
+
+    Storage* storage;
+    FuriString* path;
+    FuriString* index_path;
+    File* index;
+    KeysDictIndexState index_state;
+    KeysDictIndexHeader index_header;
+    uint8_t* key_buffer;
+    bool is_modified;
 };
 
 static inline void keys_dict_add_ending_new_line(KeysDict* instance) {
@@ -23,6 +54,7 @@ static inline void keys_dict_add_ending_new_line(KeysDict* instance) {
         if(stream_read(instance->stream, &last_char, 1) == 1 && last_char != '\n') {
             FURI_LOG_D(TAG, "Adding new line ending");
             stream_write_char(instance->stream, '\n');
+            instance->is_modified = true;
         }
 
         stream_rewind(instance->stream);
@@ -52,6 +84,308 @@ static bool keys_dict_read_key_line(KeysDict* instance, FuriString* line, bool*
     return false;
 }
 
+static void keys_dict_parse_key(KeysDict* instance, FuriString* line, uint8_t* key) {
+    const char* key_str = furi_string_get_cstr(line);
+    uint8_t key_byte = 0;
+
+    // Invalid symbols keep the value of the previous byte, as the text parser always did
+    for(size_t i = 0; i < instance->key_size; i++) {
+        args_char_to_hex(key_str[i * 2], key_str[i * 2 + 1], &key_byte);
+        key[i] = key_byte;
+    }
+}
+
+static size_t
+    keys_dict_read_keys(KeysDict* instance, uint8_t* keys, size_t count, FuriString* line) {
+    size_t keys_read = 0;
+    bool is_endfile = false;
+
+    while(keys_read < count && !is_endfile) {
+        if(keys_dict_read_key_line(instance, line, &is_endfile)) {
+            keys_dict_parse_key(instance, line, &keys[keys_read * instance->key_size]);
+            keys_read++;
+        }
+    }
+
+    return keys_read;
+}
+
+static void keys_dict_swap_keys(uint8_t* a, uint8_t* b, size_t key_size, uint8_t* temp) {
+    memcpy(temp, a, key_size);
+    memcpy(a, b, key_size);
+    memcpy(b, temp, key_size);
+}
+
+static void keys_dict_sift_down(
+    uint8_t* keys,
+    size_t root,
+    size_t count,
+    size_t key_size,
+    uint8_t* temp) {
+    while(root * 2 + 1 < count) {
+        size_t child = root * 2 + 1;
+        if(child + 1 < count &&
+           memcmp(&keys[child * key_size], &keys[(child + 1) * key_size], key_size) < 0) {
+            child++;
+        }
+        if(memcmp(&keys[root * key_size], &keys[child * key_size], key_size) >= 0) break;
+
+        keys_dict_swap_keys(&keys[root * key_size], &keys[child * key_size], key_size, temp);
+        root = child;
+    }
+}
+
+// Heap sort: in place, no recursion and no comparator context needed for the key size
+static void keys_dict_sort_keys(uint8_t* keys, size_t count, size_t key_size, uint8_t* temp) {
+    for(size_t i = count / 2; i-- > 0;) {
+        keys_dict_sift_down(keys, i, count, key_size, temp);
+    }
+
+    for(size_t end = count; end-- > 1;) {
+        keys_dict_swap_keys(keys, &keys[end * key_size], key_size, temp);
+        keys_dict_sift_down(keys, 0, end, key_size, temp);
+    }
+}
+
+static bool keys_dict_index_stat(KeysDict* instance, uint32_t* size, uint32_t* timestamp) {
+    const char* path = furi_string_get_cstr(instance->path);
+    FileInfo info;
+
+    if(storage_common_stat(instance->storage, path, &info) != FSE_OK) return false;
+    if(storage_common_timestamp(instance->storage, path, timestamp) != FSE_OK) return false;
+
+    *size = info.size;
+    return true;
+}
+
+static inline uint32_t keys_dict_index_offset(KeysDict* instance, size_t position) {
+    return sizeof(KeysDictIndexHeader) + position * instance->key_size;
+}
+
+static bool keys_dict_index_write_header(KeysDict* instance) {
+    return storage_file_seek(instance->index, 0, true) &&
+           storage_file_write(
+               instance->index, &instance->index_header, sizeof(KeysDictIndexHeader)) ==
+               sizeof(KeysDictIndexHeader);
+}
+
+static void keys_dict_index_drop(KeysDict* instance) {
+    if(storage_file_is_open(instance->index)) {
+        storage_file_close(instance->index);
+    }
+    storage_common_remove(instance->storage, furi_string_get_cstr(instance->index_path));
+    instance->index_state = KeysDictIndexStateUnavailable;
+}
+
+static bool keys_dict_index_load(KeysDict* instance) {
+    KeysDictIndexHeader* header = &instance->index_header;
+    uint32_t dict_size = 0;
+    uint32_t dict_timestamp = 0;
+    bool index_loaded = false;
+
+    do {
+        // Changes made by this instance are not visible in the stat until the dict is closed
+        if(instance->is_modified) break;
+        if(!keys_dict_index_stat(instance, &dict_size, &dict_timestamp)) break;
+        if(!storage_file_open(
+               instance->index,
+               furi_string_get_cstr(instance->index_path),
+               FSAM_READ_WRITE,
+               FSOM_OPEN_EXISTING))
+            break;
+        if(storage_file_read(instance->index, header, sizeof(KeysDictIndexHeader)) !=
+           sizeof(KeysDictIndexHeader))
+            break;
+        if(header->magic != KEYS_DICT_INDEX_MAGIC || header->version != KEYS_DICT_INDEX_VERSION ||
+           header->key_size != instance->key_size)
+            break;
+        if(header->dict_size != dict_size || header->dict_timestamp != dict_timestamp) break;
+        if(header->total_keys != instance->total_keys) break;
+        if(storage_file_size(instance->index) !=
+           keys_dict_index_offset(instance, header->total_keys))
+            break;
+
+        index_loaded = true;
+    } while(false);
+
+    if(!index_loaded && storage_file_is_open(instance->index)) {
+        storage_file_close(instance->index);
+    }
+
+    return index_loaded;
+}
+
+static bool keys_dict_index_build(KeysDict* instance) {
+    KeysDictIndexHeader* header = &instance->index_header;
+    const size_t keys_size = instance->total_keys * instance->key_size;
+
+    // Keys are sorted in RAM, leave most of the heap to the application
+    if(keys_size > memmgr_heap_get_max_free_block() / 2) {
+        FURI_LOG_W(TAG, "Not enough memory to index %zu keys", instance->total_keys);
+        return false;
+    }
+
+    uint8_t* keys = malloc(MAX(keys_size, 1U));
+    FuriString* line = furi_string_alloc();
+
+    size_t actual_pos = stream_tell(instance->stream);
+    stream_rewind(instance->stream);
+    size_t keys_read = keys_dict_read_keys(instance, keys, instance->total_keys, line);
+    stream_seek(instance->stream, actual_pos, StreamOffsetFromStart);
+
+    furi_string_free(line);
+
+    keys_dict_sort_keys(keys, keys_read, instance->key_size, instance->key_buffer);
+
+    memset(header, 0, sizeof(KeysDictIndexHeader));
+    header->magic = KEYS_DICT_INDEX_MAGIC;
+    header->version = KEYS_DICT_INDEX_VERSION;
+    header->key_size = instance->key_size;
+    header->total_keys = keys_read;
+
+    bool index_built = false;
+
+    do {
+        if(keys_read != instance->total_keys) break;
+        // Modified dict is stamped on free, when its size and timestamp are final
+        if(!instance->is_modified &&
+           !keys_dict_index_stat(instance, &header->dict_size, &header->dict_timestamp))
+            break;
+        if(!storage_file_open(
+               instance->index,
+               furi_string_get_cstr(instance->index_path),
+               FSAM_READ_WRITE,
+               FSOM_CREATE_ALWAYS))
+            break;
+        if(!keys_dict_index_write_header(instance)) break;
+        if(storage_file_write(instance->index, keys, keys_size) != keys_size) break;
+
+        index_built = true;
+    } while(false);
+
+    free(keys);
+
+    if(!index_built) {
+        keys_dict_index_drop(instance);
+    }
+
+    FURI_LOG_D(TAG, "Index of %zu keys %s", keys_read, index_built ? "built" : "failed");
+
+    return index_built;
+}
+
+static bool keys_dict_index_open(KeysDict* instance) {
+    if(instance->index_state == KeysDictIndexStateUnknown) {
+        bool index_ready = instance->key_size <= UINT8_MAX &&
+                           (keys_dict_index_load(instance) || keys_dict_index_build(instance));
+        instance->index_state = index_ready ? KeysDictIndexStateValid :
+                                              KeysDictIndexStateUnavailable;
+    }
+
+    return instance->index_state == KeysDictIndexStateValid;
+}
+
+// Lower bound binary search, position is the first key not less than the given one
+static bool keys_dict_index_find(
+    KeysDict* instance,
+    const uint8_t* key,
+    size_t* position,
+    bool* is_found) {
+    size_t low = 0;
+    size_t high = instance->index_header.total_keys;
+    bool is_read = true;
+
+    *is_found = false;
+
+    storage_file_lease_acquire(instance->index);
+
+    while(is_read && low < high) {
+        size_t middle = low + (high - low) / 2;
+        is_read = storage_file_seek(
+                      instance->index, keys_dict_index_offset(instance, middle), true) &&
+                  storage_file_read(instance->index, instance->key_buffer, instance->key_size) ==
+                      instance->key_size;
+
+        if(!is_read) break;
+        int result = memcmp(instance->key_buffer, key, instance->key_size);
+        if(result < 0) {
+            low = middle + 1;
+        } else {
+            high = middle;
+            *is_found |= (result == 0);
+        }
+    }
+
+    storage_file_lease_release(instance->index);
+
+    *position = low;
+    return is_read;
+}
+
+static bool keys_dict_index_move(File* file, uint32_t source, uint32_t destination, size_t size) {
+    uint8_t* buffer = malloc(KEYS_DICT_INDEX_MOVE_CHUNK);
+    bool is_moved = true;
+
+    for(size_t done = 0; is_moved && done < size;) {
+        size_t chunk = MIN(size - done, KEYS_DICT_INDEX_MOVE_CHUNK);
+        // Move the tail first when shifting right, so data is read before it's overwritten
+        size_t offset = destination > source ? size - done - chunk : done;
+
+        is_moved = storage_file_seek(file, source + offset, true) &&
+                   storage_file_read(file, buffer, chunk) == chunk &&
+                   storage_file_seek(file, destination + offset, true) &&
+                   storage_file_write(file, buffer, chunk) == chunk;
+        done += chunk;
+    }
+
+    free(buffer);
+    return is_moved;
+}
+
+static bool keys_dict_index_insert(KeysDict* instance, const uint8_t* key) {
+    KeysDictIndexHeader* header = &instance->index_header;
+    size_t position = 0;
+    bool is_found = false;
+
+    if(!keys_dict_index_find(instance, key, &position, &is_found)) return false;
+
+    uint32_t offset = keys_dict_index_offset(instance, position);
+    size_t tail_size = (header->total_keys - position) * instance->key_size;
+    header->total_keys++;
+
+    storage_file_lease_acquire(instance->index);
+    bool is_inserted =
+        keys_dict_index_move(instance->index, offset, offset + instance->key_size, tail_size) &&
+        storage_file_seek(instance->index, offset, true) &&
+        storage_file_write(instance->index, key, instance->key_size) == instance->key_size &&
+        keys_dict_index_write_header(instance);
+    storage_file_lease_release(instance->index);
+
+    return is_inserted;
+}
+
+static bool keys_dict_index_remove(KeysDict* instance, const uint8_t* key) {
+    KeysDictIndexHeader* header = &instance->index_header;
+    size_t position = 0;
+    bool is_found = false;
+
+    if(!keys_dict_index_find(instance, key, &position, &is_found) || !is_found) return false;
+
+    uint32_t offset = keys_dict_index_offset(instance, position);
+    size_t tail_size = (header->total_keys - position - 1) * instance->key_size;
+    header->total_keys--;
+
+    storage_file_lease_acquire(instance->index);
+    bool is_removed =
+        keys_dict_index_move(instance->index, offset + instance->key_size, offset, tail_size) &&
+        storage_file_seek(
+            instance->index, keys_dict_index_offset(instance, header->total_keys), true) &&
+        storage_file_truncate(instance->index) && keys_dict_index_write_header(instance);
+    storage_file_lease_release(instance->index);
+
+    return is_removed;
+}
+
 bool keys_dict_check_presence(const char* path) {
     furi_check(path);
 
@@ -73,6 +407,14 @@ KeysDict* keys_dict_alloc(const char* path, KeysDictMode mode, size_t key_size)
     Storage* storage = furi_record_open(RECORD_STORAGE);
     instance->stream = buffered_file_stream_alloc(storage);
 
+    instance->storage = storage;
+    instance->path = furi_string_alloc_set(path);
+    instance->index_path = furi_string_alloc_printf("%s%s", path, KEYS_DICT_INDEX_EXTENSION);
+    instance->index = storage_file_alloc(storage);
+    instance->index_state = KeysDictIndexStateUnknown;
+    instance->key_buffer = malloc(key_size);
+    instance->is_modified = false;
+
     FS_OpenMode open_mode = (mode == KeysDictModeOpenAlways) ? FSOM_OPEN_ALWAYS :
                                                                FSOM_OPEN_EXISTING;
 
@@ -118,6 +460,23 @@ void keys_dict_free(KeysDict* instance) {
 
     buffered_file_stream_close(instance->stream);
     stream_free(instance->stream);
+
+    if(instance->is_modified) {
+        // Size and timestamp of the dict are only final once it is closed
+        KeysDictIndexHeader* header = &instance->index_header;
+        bool is_stamped = instance->index_state == KeysDictIndexStateValid &&
+                          keys_dict_index_stat(
+                              instance, &header->dict_size, &header->dict_timestamp) &&
+                          keys_dict_index_write_header(instance);
+        if(!is_stamped) {
+            keys_dict_index_drop(instance);
+        }
+    }
+
+    storage_file_free(instance->index);
+    furi_string_free(instance->index_path);
+    furi_string_free(instance->path);
+    free(instance->key_buffer);
     free(instance);
 
     furi_record_close(RECORD_STORAGE);
@@ -134,25 +493,6 @@ static void keys_dict_int_to_str(KeysDict* instance, const uint8_t* key_int, Fur
         furi_string_cat_printf(key_str, "%02X", key_int[i]);
 }
 
-static void keys_dict_str_to_int(KeysDict* instance, FuriString* key_str, uint64_t* key_int) {
-    furi_assert(instance);
-    furi_assert(key_str);
-    furi_assert(key_int);
-
-    uint8_t key_byte_tmp;
-    char h, l;
-
-    *key_int = 0ULL;
-
-    for(size_t i = 0; i < instance->key_size_symbols - 1; i += 2) {
-        h = furi_string_get_char(key_str, i);
-        l = furi_string_get_char(key_str, i + 1);
-
-        args_char_to_hex(h, l, &key_byte_tmp);
-        *key_int |= (uint64_t)key_byte_tmp << (8 * (instance->key_size - 1 - i / 2));
-    }
-}
-
 size_t keys_dict_get_total_keys(KeysDict* instance) {
     furi_check(instance);
 
@@ -166,65 +506,37 @@ bool keys_dict_rewind(KeysDict* instance) {
     return stream_rewind(instance->stream);
 }
 
-static bool keys_dict_get_next_key_str(KeysDict* instance, FuriString* key) {
-    furi_assert(instance);
-    furi_assert(instance->stream);
-    furi_assert(key);
-
-    bool key_read = false;
-    bool is_endfile = false;
-
-    furi_string_reset(key);
-
-    while(!key_read && !is_endfile)
-        key_read = keys_dict_read_key_line(instance, key, &is_endfile);
-
-    return key_read;
+bool keys_dict_get_next_key(KeysDict* instance, uint8_t* key, size_t key_size) {
+    return keys_dict_get_next_keys(instance, key, key_size, 1) == 1;
 }
 
-bool keys_dict_get_next_key(KeysDict* instance, uint8_t* key, size_t key_size) {
+size_t keys_dict_get_next_keys(KeysDict* instance, uint8_t* keys, size_t key_size, size_t count) {
     furi_check(instance);
     furi_check(instance->stream);
     furi_check(instance->key_size == key_size);
-    furi_check(key);
-
-    FuriString* temp_key = furi_string_alloc();
-
-    bool key_read = keys_dict_get_next_key_str(instance, temp_key);
-
-    if(key_read) {
-        size_t tmp_len = key_size;
-        uint64_t key_int = 0;
+    furi_check(keys);
 
-        keys_dict_str_to_int(instance, temp_key, &key_int);
-
-        while(tmp_len--) {
-            key[tmp_len] = (uint8_t)key_int;
-            key_int >>= 8;
-        }
-    }
+    FuriString* line = furi_string_alloc();
+    size_t keys_read = keys_dict_read_keys(instance, keys, count, line);
+    furi_string_free(line);
 
-    furi_string_free(temp_key);
-    return key_read;
+    return keys_read;
 }
 
-static bool keys_dict_is_key_present_str(KeysDict* instance, FuriString* key) {
+static bool keys_dict_is_key_present_scan(KeysDict* instance, const uint8_t* key) {
     furi_assert(instance);
     furi_assert(instance->stream);
     furi_assert(key);
 
     FuriString* line = furi_string_alloc();
 
-    bool is_endfile = false;
     bool line_found = false;
 
     uint32_t actual_pos = stream_tell(instance->stream);
     stream_rewind(instance->stream);
 
-    while(!line_found && !is_endfile)
-        line_found = // The line is found if the line was read and the key is equal to the line
-            (keys_dict_read_key_line(instance, line, &is_endfile)) &&
-            (furi_string_equal(key, line));
+    while(!line_found && keys_dict_read_keys(instance, instance->key_buffer, 1, line))
+        line_found = memcmp(instance->key_buffer, key, instance->key_size) == 0;
 
     furi_string_free(line);
 
@@ -240,11 +552,13 @@ bool keys_dict_is_key_present(KeysDict* instance, const uint8_t* key, size_t key
     furi_check(instance->key_size == key_size);
     furi_check(key);
 
-    FuriString* temp_key = furi_string_alloc();
+    size_t position = 0;
+    bool key_found = false;
 
-    keys_dict_int_to_str(instance, key, temp_key);
-    bool key_found = keys_dict_is_key_present_str(instance, temp_key);
-    furi_string_free(temp_key);
+    if(!keys_dict_index_open(instance) ||
+       !keys_dict_index_find(instance, key, &position, &key_found)) {
+        key_found = keys_dict_is_key_present_scan(instance, key);
+    }
 
     return key_found;
 }
@@ -263,6 +577,7 @@ static bool keys_dict_add_key_str(KeysDict* instance, FuriString* key) {
     if(stream_seek(instance->stream, 0, StreamOffsetFromEnd) &&
        stream_insert_string(instance->stream, key)) {
         instance->total_keys++;
+        instance->is_modified = true;
         key_added = true;
     }
 
@@ -282,6 +597,12 @@ bool keys_dict_add_key(KeysDict* instance, const uint8_t* key, size_t key_size)
     keys_dict_int_to_str(instance, key, temp_key);
     bool key_added = keys_dict_add_key_str(instance, temp_key);
 
+    // Index is only kept up to date once it's in use, otherwise it's rebuilt on demand
+    if(key_added && instance->index_state == KeysDictIndexStateValid &&
+       !keys_dict_index_insert(instance, key)) {
+        keys_dict_index_drop(instance);
+    }
+
     FURI_LOG_I(TAG, "Added key %s", furi_string_get_cstr(temp_key));
 
     furi_string_free(temp_key);
@@ -296,36 +617,47 @@ bool keys_dict_delete_key(KeysDict* instance, const uint8_t* key, size_t key_siz
     furi_check(key);
 
     bool key_removed = false;
+    bool key_found = true;
+    size_t position = 0;
 
-    uint8_t* temp_key = malloc(key_size);
+    // With an index in use, a missing key doesn't need a full scan
+    if(instance->index_state == KeysDictIndexStateValid &&
+       !keys_dict_index_find(instance, key, &position, &key_found)) {
+        key_found = true;
+    }
+
+    FuriString* line = furi_string_alloc();
 
     stream_rewind(instance->stream);
 
-    while(!key_removed) {
-        if(!keys_dict_get_next_key(instance, temp_key, key_size)) {
+    while(key_found && !key_removed) {
+        if(!keys_dict_read_keys(instance, instance->key_buffer, 1, line)) {
             break;
         }
 
-        if(memcmp(temp_key, key, key_size) == 0) {
+        if(memcmp(instance->key_buffer, key, key_size) == 0) {
             stream_seek(instance->stream, -instance->key_size_symbols, StreamOffsetFromCurrent);
             if(stream_delete(instance->stream, instance->key_size_symbols) == false) {
                 break;
             }
             instance->total_keys--;
+            instance->is_modified = true;
             key_removed = true;
         }
     }
 
-    FuriString* tmp = furi_string_alloc();
+    if(key_removed && instance->index_state == KeysDictIndexStateValid &&
+       !keys_dict_index_remove(instance, key)) {
+        keys_dict_index_drop(instance);
+    }
 
-    keys_dict_int_to_str(instance, key, tmp);
+    keys_dict_int_to_str(instance, key, line);
 
-    FURI_LOG_I(TAG, "Removed key %s", furi_string_get_cstr(tmp));
+    FURI_LOG_I(TAG, "Removed key %s", furi_string_get_cstr(line));
 
-    furi_string_free(tmp);
+    furi_string_free(line);
 
     stream_rewind(instance->stream);
-    free(temp_key);
 
     return key_removed;
 }
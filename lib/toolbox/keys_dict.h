@@ -57,6 +57,9 @@ size_t keys_dict_get_total_keys(KeysDict* instance);
 bool keys_dict_rewind(KeysDict* instance);
 
 /** Check if key is present in list
+ * Lookups use a sorted binary index stored next to the list with ".idx" appended to
+ * the path. It's built on the first lookup, kept up to date by add and delete, and
+ * rebuilt when the list size or modification time no longer match.
  *
  * @param instance  - KeysDict list instance
  * @param key       - key to check
@@ -78,6 +81,18 @@ bool keys_dict_is_key_present(KeysDict* instance, const uint8_t* key, size_t key
 */
 bool keys_dict_get_next_key(KeysDict* instance, uint8_t* key, size_t key_size);
 
+/** Get next keys from the list
+ * Same as keys_dict_get_next_key(), but reads up to count keys in one call.
+ *
+ * @param instance  - KeysDict list instance
+ * @param keys      - Array of count * key_size bytes where to store keys
+ * @param key_size  - Size of each key in bytes
+ * @param count     - Maximum number of keys to read
+ *
+ * @return Returns number of keys read, less than count at the end of the list
+*/
+size_t keys_dict_get_next_keys(KeysDict* instance, uint8_t* keys, size_t key_size, size_t count);
+
 /** Add key to list
  *
  * @param instance  - KeysDict list instance
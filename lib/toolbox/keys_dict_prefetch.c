@@ -0,0 +1,243 @@
+#include "keys_dict_prefetch.h"
+
+#include <furi.h>
+
+#define TAG "KeysDictPrefetch"
+
+#define KEYS_DICT_PREFETCH_STACK_SIZE  (2048U)
+#define KEYS_DICT_PREFETCH_QUEUE_SIZE  (32U)
+#define KEYS_DICT_PREFETCH_BLOCK_SIZE  (16U)
+#define KEYS_DICT_PREFETCH_PUT_TIMEOUT (10U)
+#define KEYS_DICT_PREFETCH_SKIP_MAX    (1024U)
+
+typedef enum {
+    KeysDictPrefetchFlagRewind = (1 << 0),
+    KeysDictPrefetchFlagStop = (1 << 1),
+} KeysDictPrefetchFlag;
+
+#define KEYS_DICT_PREFETCH_FLAGS_ALL (KeysDictPrefetchFlagRewind | KeysDictPrefetchFlagStop)
+
+typedef struct {
+    uint32_t generation;
+    uint32_t position;
+    bool is_end;
+    uint8_t key[];
+} KeysDictPrefetchItem;
+
+struct KeysDictPrefetch {
+    KeysDict* dict;
+    size_t key_size;
+    size_t item_size;
+
+    FuriThread* thread;
+    FuriMessageQueue* queue;
+    KeysDictPrefetchItem* item;
+
+    volatile uint32_t generation;
+    volatile bool is_running;
+    bool is_end;
+    size_t position;
+
+    // Open addressing hash set of keys to skip
+    uint8_t* skip_keys;
+    uint32_t* skip_used;
+    size_t skip_capacity;
+};
+
+static size_t keys_dict_prefetch_skip_hash(KeysDictPrefetch* instance, const uint8_t* key) {
+    uint32_t hash = 2166136261UL;
+    for(size_t i = 0; i < instance->key_size; i++) {
+        hash = (hash ^ key[i]) * 16777619UL;
+    }
+    return hash & (instance->skip_capacity - 1);
+}
+
+// Returns true if the key is in the set, otherwise adds it when add is requested
+static bool
+    keys_dict_prefetch_skip_lookup(KeysDictPrefetch* instance, const uint8_t* key, bool add) {
+    if(instance->skip_capacity == 0) return false;
+
+    size_t slot = keys_dict_prefetch_skip_hash(instance, key);
+    while(instance->skip_used[slot / 32] & (1UL << (slot % 32))) {
+        if(memcmp(&instance->skip_keys[slot * instance->key_size], key, instance->key_size) ==
+           0) {
+            return true;
+        }
+        slot = (slot + 1) & (instance->skip_capacity - 1);
+    }
+
+    if(add) {
+        memcpy(&instance->skip_keys[slot * instance->key_size], key, instance->key_size);
+        instance->skip_used[slot / 32] |= 1UL << (slot % 32);
+    }
+
+    return false;
+}
+
+static void keys_dict_prefetch_skip_load(KeysDictPrefetch* instance, KeysDict* skip_dict) {
+    size_t keys_total = MIN(keys_dict_get_total_keys(skip_dict), KEYS_DICT_PREFETCH_SKIP_MAX);
+    if(keys_total == 0) return;
+
+    // At most half full, so that probe sequences stay short
+    instance->skip_capacity = 32;
+    while(instance->skip_capacity < keys_total * 2) {
+        instance->skip_capacity *= 2;
+    }
+    instance->skip_keys = malloc(instance->skip_capacity * instance->key_size);
+    instance->skip_used = malloc(instance->skip_capacity / 32 * sizeof(uint32_t));
+
+    uint8_t* keys = malloc(KEYS_DICT_PREFETCH_BLOCK_SIZE * instance->key_size);
+
+    keys_dict_rewind(skip_dict);
+    for(size_t keys_loaded = 0; keys_loaded < keys_total;) {
+        size_t keys_read = keys_dict_get_next_keys(
+            skip_dict,
+            keys,
+            instance->key_size,
+            MIN(keys_total - keys_loaded, KEYS_DICT_PREFETCH_BLOCK_SIZE));
+        if(keys_read == 0) break;
+
+        for(size_t i = 0; i < keys_read; i++) {
+            keys_dict_prefetch_skip_lookup(instance, &keys[i * instance->key_size], true);
+        }
+        keys_loaded += keys_read;
+    }
+    keys_dict_rewind(skip_dict);
+
+    free(keys);
+
+    FURI_LOG_D(TAG, "Skipping %zu keys", keys_total);
+}
+
+static bool keys_dict_prefetch_put(KeysDictPrefetch* instance, KeysDictPrefetchItem* item) {
+    while(furi_message_queue_put(instance->queue, item, KEYS_DICT_PREFETCH_PUT_TIMEOUT) !=
+          FuriStatusOk) {
+        if(!instance->is_running || item->generation != instance->generation) return false;
+    }
+
+    return true;
+}
+
+static int32_t keys_dict_prefetch_worker(void* context) {
+    KeysDictPrefetch* instance = context;
+
+    uint8_t* keys = malloc(KEYS_DICT_PREFETCH_BLOCK_SIZE * instance->key_size);
+    KeysDictPrefetchItem* item = malloc(instance->item_size);
+    item->generation = instance->generation;
+
+    while(instance->is_running) {
+        size_t keys_read = keys_dict_get_next_keys(
+            instance->dict, keys, instance->key_size, KEYS_DICT_PREFETCH_BLOCK_SIZE);
+
+        bool is_queued = true;
+        for(size_t i = 0; i < keys_read && is_queued; i++) {
+            const uint8_t* key = &keys[i * instance->key_size];
+            item->position++;
+            if(keys_dict_prefetch_skip_lookup(instance, key, false)) continue;
+
+            memcpy(item->key, key, instance->key_size);
+            is_queued = keys_dict_prefetch_put(instance, item);
+        }
+
+        if(is_queued && keys_read < KEYS_DICT_PREFETCH_BLOCK_SIZE) {
+            item->is_end = true;
+            if(keys_dict_prefetch_put(instance, item)) {
+                while(instance->is_running && item->generation == instance->generation) {
+                    furi_thread_flags_wait(
+                        KEYS_DICT_PREFETCH_FLAGS_ALL, FuriFlagWaitAny, FuriWaitForever);
+                }
+            }
+        }
+
+        if(item->generation != instance->generation) {
+            keys_dict_rewind(instance->dict);
+            item->generation = instance->generation;
+            item->position = 0;
+            item->is_end = false;
+        }
+    }
+
+    free(item);
+    free(keys);
+
+    return 0;
+}
+
+KeysDictPrefetch* keys_dict_prefetch_alloc(KeysDict* dict, KeysDict* skip_dict, size_t key_size) {
+    furi_check(dict);
+    furi_check(key_size > 0);
+
+    KeysDictPrefetch* instance = malloc(sizeof(KeysDictPrefetch));
+    instance->dict = dict;
+    instance->key_size = key_size;
+    instance->item_size = sizeof(KeysDictPrefetchItem) + key_size;
+    instance->item = malloc(instance->item_size);
+    instance->queue = furi_message_queue_alloc(KEYS_DICT_PREFETCH_QUEUE_SIZE, instance->item_size);
+
+    if(skip_dict) {
+        keys_dict_prefetch_skip_load(instance, skip_dict);
+    }
+
+    keys_dict_rewind(dict);
+    instance->is_running = true;
+    instance->thread = furi_thread_alloc_ex(
+        TAG, KEYS_DICT_PREFETCH_STACK_SIZE, keys_dict_prefetch_worker, instance);
+    furi_thread_start(instance->thread);
+
+    return instance;
+}
+
+void keys_dict_prefetch_free(KeysDictPrefetch* instance) {
+    furi_check(instance);
+
+    instance->is_running = false;
+    furi_thread_flags_set(furi_thread_get_id(instance->thread), KeysDictPrefetchFlagStop);
+    furi_thread_join(instance->thread);
+    furi_thread_free(instance->thread);
+
+    furi_message_queue_free(instance->queue);
+    free(instance->item);
+    free(instance->skip_keys);
+    free(instance->skip_used);
+    free(instance);
+}
+
+bool keys_dict_prefetch_get_next_key(KeysDictPrefetch* instance, uint8_t* key, size_t key_size) {
+    furi_check(instance);
+    furi_check(key);
+    furi_check(instance->key_size == key_size);
+
+    KeysDictPrefetchItem* item = instance->item;
+
+    while(!instance->is_end) {
+        furi_check(
+            furi_message_queue_get(instance->queue, item, FuriWaitForever) == FuriStatusOk);
+        // Left in the queue from before the last rewind
+        if(item->generation != instance->generation) continue;
+
+        instance->position = item->position;
+        if(item->is_end) {
+            instance->is_end = true;
+        } else {
+            memcpy(key, item->key, key_size);
+            return true;
+        }
+    }
+
+    return false;
+}
+
+size_t keys_dict_prefetch_get_position(KeysDictPrefetch* instance) {
+    furi_check(instance);
+
+    return instance->position;
+}
+
+void keys_dict_prefetch_rewind(KeysDictPrefetch* instance) {
+    furi_check(instance);
+
+    instance->generation++;
+    instance->is_end = false;
+    instance->position = 0;
+    furi_thread_flags_set(furi_thread_get_id(instance->thread), KeysDictPrefetchFlagRewind);
+}
@@ -0,0 +1,70 @@
+/**
+ * @file keys_dict_prefetch.h
+ * @brief Background key reader for KeysDict.
+ *
+ * Keys are read and decoded in blocks by a worker thread and queued, so that
+ * storage access and parsing happen while the consumer is busy or waiting for
+ * I/O, not in between its requests.
+ */
+#pragma once
+
+#include "keys_dict.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct KeysDictPrefetch KeysDictPrefetch;
+
+/** Allocate prefetcher and start reading keys from the beginning of the list
+ * The list is used by the worker thread until keys_dict_prefetch_free() is called
+ * and must not be accessed in the meantime.
+ *
+ * @param dict      - KeysDict list instance to read keys from
+ * @param skip_dict - Optional KeysDict list instance with keys to leave out, it's
+ *                    only read in this call
+ * @param key_size  - Size of each key in bytes
+ *
+ * @return Returns KeysDictPrefetch instance
+*/
+KeysDictPrefetch* keys_dict_prefetch_alloc(KeysDict* dict, KeysDict* skip_dict, size_t key_size);
+
+/** Stop the worker thread and free prefetcher
+ * The list itself is not freed.
+ *
+ * @param instance  - KeysDictPrefetch instance
+*/
+void keys_dict_prefetch_free(KeysDictPrefetch* instance);
+
+/** Get next key
+ * Blocks until the worker thread reads the key. If there are no more keys,
+ * it will return false, and keys_dict_prefetch_rewind() should be called.
+ *
+ * @param instance  - KeysDictPrefetch instance
+ * @param key       - Array where to store key
+ * @param key_size  - Size of key in bytes
+ *
+ * @return Returns true if key was successfully retrieved, false otherwise
+*/
+bool keys_dict_prefetch_get_next_key(KeysDictPrefetch* instance, uint8_t* key, size_t key_size);
+
+/** Get list position of the last retrieved key
+ * Skipped keys are counted as well, so the position can be compared with
+ * keys_dict_get_total_keys().
+ *
+ * @param instance  - KeysDictPrefetch instance
+ *
+ * @return Returns number of list keys up to and including the last retrieved one
+*/
+size_t keys_dict_prefetch_get_position(KeysDictPrefetch* instance);
+
+/** Restart reading keys from the beginning of the list
+ * Keys that were already prefetched are dropped.
+ *
+ * @param instance  - KeysDictPrefetch instance
+*/
+void keys_dict_prefetch_rewind(KeysDictPrefetch* instance);
+
+#ifdef __cplusplus
+}
+#endif
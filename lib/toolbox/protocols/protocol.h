@@ -28,6 +28,26 @@ typedef struct {
     ProtocolEncoderYield yield;
 } ProtocolEncoder;
 
+typedef enum {
+    ProtocolTimingNone, /**< no timing class, decoder gets every period */
+    ProtocolTimingPeriod, /**< range of whole periods (high + low), others reset the decoder */
+    ProtocolTimingLevel, /**< range of level durations, others reset the decoder */
+} ProtocolTimingType;
+
+/**
+ * Timing class of a decoder, used by ProtocolDict pair feeding to skip decoders
+ * that can't act on a captured period.
+ * ProtocolTimingPeriod: period outside of the range is not fed.
+ * ProtocolTimingLevel: period with both levels outside of the range is not fed.
+ * Decoder must handle such periods as a reset that can be repeated: instead of
+ * them it gets a single zero length period before the next fed one.
+ */
+typedef struct {
+    const ProtocolTimingType type;
+    const uint32_t min;
+    const uint32_t max;
+} ProtocolTiming;
+
 typedef struct {
     const size_t data_size;
     const char* name;
@@ -44,4 +64,6 @@ typedef struct {
     ProtocolRenderData render_data;
     ProtocolRenderData render_brief_data;
     ProtocolWriteData write_data;
+    // Last, so protocols built against older API keep their layout
+    const ProtocolTiming timing;
 } ProtocolBase;
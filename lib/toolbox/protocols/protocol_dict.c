@@ -4,6 +4,11 @@
 struct ProtocolDict {
     const ProtocolBase** base;
     size_t count;
+    ProtocolId lock;
+    uint32_t lock_timeout;
+    uint32_t lock_time;
+    // Decoders that skipped an out of range period and must be reset before the next feed
+    bool* reset;
     void* data[];
 };
 
@@ -13,6 +18,8 @@ ProtocolDict* protocol_dict_alloc(const ProtocolBase** protocols, size_t count)
     ProtocolDict* dict = malloc(sizeof(ProtocolDict) + (sizeof(void*) * count));
     dict->base = protocols;
     dict->count = count;
+    dict->lock = PROTOCOL_NO;
+    dict->reset = malloc(sizeof(bool) * count);
 
     for(size_t i = 0; i < dict->count; i++) {
         dict->data[i] = dict->base[i]->alloc();
@@ -28,6 +35,7 @@ void protocol_dict_free(ProtocolDict* dict) {
         dict->base[i]->free(dict->data[i]);
     }
 
+    free(dict->reset);
     free(dict);
 }
 
@@ -99,18 +107,45 @@ void protocol_dict_decoders_start(ProtocolDict* dict) {
     }
 }
 
+void protocol_dict_decoders_lock(ProtocolDict* dict, ProtocolId protocol_index) {
+    furi_check(dict);
+    furi_check(protocol_index == PROTOCOL_NO || (size_t)protocol_index < dict->count);
+    dict->lock = protocol_index;
+}
+
+ProtocolId protocol_dict_decoders_get_lock(ProtocolDict* dict) {
+    furi_check(dict);
+    return dict->lock;
+}
+
+void protocol_dict_decoders_set_lock_timeout(ProtocolDict* dict, uint32_t timeout) {
+    furi_check(dict);
+    dict->lock_timeout = timeout;
+    dict->lock_time = 0;
+    dict->lock = PROTOCOL_NO;
+}
+
 uint32_t protocol_dict_get_features(ProtocolDict* dict, size_t protocol_index) {
     furi_check(protocol_index < dict->count);
     return dict->base[protocol_index]->features;
 }
 
+static inline size_t protocol_dict_decoders_first(ProtocolDict* dict) {
+    return dict->lock == PROTOCOL_NO ? 0 : (size_t)dict->lock;
+}
+
+static inline size_t protocol_dict_decoders_last(ProtocolDict* dict) {
+    return dict->lock == PROTOCOL_NO ? dict->count : (size_t)dict->lock + 1;
+}
+
 ProtocolId protocol_dict_decoders_feed(ProtocolDict* dict, bool level, uint32_t duration) {
     furi_check(dict);
 
     bool done = false;
     ProtocolId ready_protocol_id = PROTOCOL_NO;
+    const size_t last = protocol_dict_decoders_last(dict);
 
-    for(size_t i = 0; i < dict->count; i++) {
+    for(size_t i = protocol_dict_decoders_first(dict); i < last; i++) {
         ProtocolDecoderFeed fn = dict->base[i]->decoder.feed;
 
         if(fn) {
@@ -135,8 +170,9 @@ ProtocolId protocol_dict_decoders_feed_by_feature(
 
     bool done = false;
     ProtocolId ready_protocol_id = PROTOCOL_NO;
+    const size_t last = protocol_dict_decoders_last(dict);
 
-    for(size_t i = 0; i < dict->count; i++) {
+    for(size_t i = protocol_dict_decoders_first(dict); i < last; i++) {
         uint32_t features = dict->base[i]->features;
         if(features & feature) {
             ProtocolDecoderFeed fn = dict->base[i]->decoder.feed;
@@ -155,6 +191,84 @@ ProtocolId protocol_dict_decoders_feed_by_feature(
     return ready_protocol_id;
 }
 
+static ProtocolId protocol_dict_decoders_feed_pass(
+    ProtocolDict* dict,
+    uint32_t feature,
+    bool level,
+    uint32_t value,
+    uint32_t pulse,
+    uint32_t period) {
+    ProtocolId ready_protocol_id = PROTOCOL_NO;
+    const size_t last = protocol_dict_decoders_last(dict);
+
+    for(size_t i = protocol_dict_decoders_first(dict); i < last; i++) {
+        const ProtocolBase* base = dict->base[i];
+        ProtocolDecoderFeed fn = base->decoder.feed;
+        if(!(base->features & feature) || !fn) continue;
+
+        const ProtocolTiming* timing = &base->timing;
+        if(timing->type == ProtocolTimingPeriod) {
+            if(period < timing->min || period > timing->max) {
+                // Decoder would only reset on the low level, which is not fed if someone is ready
+                if(!level) dict->reset[i] = true;
+                continue;
+            }
+        } else if(timing->type == ProtocolTimingLevel) {
+            const uint32_t low = period - pulse;
+            if((pulse < timing->min || pulse > timing->max) &&
+               (low < timing->min || low > timing->max)) {
+                dict->reset[i] = true;
+                continue;
+            }
+        }
+
+        if(dict->reset[i]) {
+            dict->reset[i] = false;
+            fn(dict->data[i], true, 0);
+            fn(dict->data[i], false, 0);
+        }
+
+        if(fn(dict->data[i], level, value) && ready_protocol_id == PROTOCOL_NO) {
+            ready_protocol_id = i;
+        }
+    }
+
+    return ready_protocol_id;
+}
+
+ProtocolId protocol_dict_decoders_feed_pair_by_feature(
+    ProtocolDict* dict,
+    uint32_t feature,
+    uint32_t pulse,
+    uint32_t duration) {
+    furi_check(dict);
+
+    // Same order as two feed_by_feature calls: high level first, low level only if no one is ready
+    ProtocolId ready_protocol_id =
+        protocol_dict_decoders_feed_pass(dict, feature, true, pulse, pulse, duration);
+    if(ready_protocol_id == PROTOCOL_NO) {
+        ready_protocol_id = protocol_dict_decoders_feed_pass(
+            dict, feature, false, duration - pulse, pulse, duration);
+    }
+
+    if(dict->lock_timeout) {
+        if(ready_protocol_id != PROTOCOL_NO) {
+            // Only the synchronized decoder is fed until it stops reporting
+            dict->lock = ready_protocol_id;
+            dict->lock_time = 0;
+        } else if(dict->lock != PROTOCOL_NO) {
+            // Locked decoder lost the card, give the others a chance
+            dict->lock_time += duration;
+            if(dict->lock_time > dict->lock_timeout) {
+                dict->lock = PROTOCOL_NO;
+                protocol_dict_decoders_start(dict);
+            }
+        }
+    }
+
+    return ready_protocol_id;
+}
+
 ProtocolId protocol_dict_decoders_feed_by_id(
     ProtocolDict* dict,
     size_t protocol_index,
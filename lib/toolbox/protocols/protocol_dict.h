@@ -38,6 +38,27 @@ const char* protocol_dict_get_manufacturer(ProtocolDict* dict, size_t protocol_i
 
 void protocol_dict_decoders_start(ProtocolDict* dict);
 
+/**
+ * Lock decoders feeding to one protocol. While locked, decoders_feed functions feed only the
+ * locked decoder, the others are left as is and should be restarted after unlock.
+ *
+ * @param dict ProtocolDict instance
+ * @param protocol_index protocol to lock to, PROTOCOL_NO to unlock
+ */
+void protocol_dict_decoders_lock(ProtocolDict* dict, ProtocolId protocol_index);
+
+ProtocolId protocol_dict_decoders_get_lock(ProtocolDict* dict);
+
+/**
+ * Lock decoders automatically in protocol_dict_decoders_feed_pair_by_feature. A decoder that
+ * reports locks feeding to itself, the lock is released and all decoders are restarted once
+ * the fed periods sum up to the timeout without a report. Also releases the current lock.
+ *
+ * @param dict ProtocolDict instance
+ * @param timeout lock timeout in period duration units, 0 disables automatic locking
+ */
+void protocol_dict_decoders_set_lock_timeout(ProtocolDict* dict, uint32_t timeout);
+
 uint32_t protocol_dict_get_features(ProtocolDict* dict, size_t protocol_index);
 
 ProtocolId protocol_dict_decoders_feed(ProtocolDict* dict, bool level, uint32_t duration);
@@ -48,6 +69,24 @@ ProtocolId protocol_dict_decoders_feed_by_feature(
     bool level,
     uint32_t duration);
 
+/**
+ * Feed one captured period (high level pulse followed by low level) to decoders with given
+ * features. Equivalent to feeding the pulse and then, if no decoder is ready, the low level
+ * with protocol_dict_decoders_feed_by_feature, except that decoders with a timing class are
+ * skipped for periods outside of it.
+ *
+ * @param dict ProtocolDict instance
+ * @param feature features mask
+ * @param pulse high level duration
+ * @param duration whole period duration, pulse included
+ * @return ready protocol id or PROTOCOL_NO
+ */
+ProtocolId protocol_dict_decoders_feed_pair_by_feature(
+    ProtocolDict* dict,
+    uint32_t feature,
+    uint32_t pulse,
+    uint32_t duration);
+
 ProtocolId protocol_dict_decoders_feed_by_id(
     ProtocolDict* dict,
     size_t protocol_index,
@@ -9,6 +9,7 @@ typedef struct {
     Stream* file_stream;
     StreamCache* cache;
     bool sync_pending;
+    BufferedFileStreamStats stats;
 } BufferedFileStream;
 
 static void buffered_file_stream_free(BufferedFileStream* stream);
@@ -46,7 +47,7 @@ Stream* buffered_file_stream_alloc(Storage* storage) {
     BufferedFileStream* stream = malloc(sizeof(BufferedFileStream));
 
     stream->file_stream = file_stream_alloc(storage);
-    stream->cache = stream_cache_alloc();
+    stream->cache = stream_cache_alloc(BUFFERED_FILE_STREAM_CACHE_SIZE);
     stream->sync_pending = false;
 
     stream->stream_base.vtable = &buffered_file_stream_vtable;
@@ -54,13 +55,32 @@ Stream* buffered_file_stream_alloc(Storage* storage) {
 }
 
 bool buffered_file_stream_open(
-    Stream* _stream,
+    Stream* stream,
     const char* path,
     FS_AccessMode access_mode,
     FS_OpenMode open_mode) {
+    return buffered_file_stream_open_ex(
+        stream, path, access_mode, open_mode, BUFFERED_FILE_STREAM_CACHE_SIZE);
+}
+
+bool buffered_file_stream_open_ex(
+    Stream* _stream,
+    const char* path,
+    FS_AccessMode access_mode,
+    FS_OpenMode open_mode,
+    size_t cache_size) {
     furi_check(_stream);
     BufferedFileStream* stream = (BufferedFileStream*)_stream;
     furi_check(stream->stream_base.vtable == &buffered_file_stream_vtable);
+
+    if(stream_cache_capacity(stream->cache) != cache_size) {
+        stream_cache_free(stream->cache);
+        stream->cache = stream_cache_alloc(cache_size);
+    } else {
+        stream_cache_drop(stream->cache);
+    }
+    memset(&stream->stats, 0, sizeof(BufferedFileStreamStats));
+
     return file_stream_open(stream->file_stream, path, access_mode, open_mode);
 }
 
@@ -93,6 +113,14 @@ FS_Error buffered_file_stream_get_error(Stream* _stream) {
     return file_stream_get_error(stream->file_stream);
 }
 
+void buffered_file_stream_get_stats(Stream* _stream, BufferedFileStreamStats* stats) {
+    furi_check(_stream);
+    furi_check(stats);
+    BufferedFileStream* stream = (BufferedFileStream*)_stream;
+    furi_check(stream->stream_base.vtable == &buffered_file_stream_vtable);
+    *stats = stream->stats;
+}
+
 static void buffered_file_stream_free(BufferedFileStream* stream) {
     furi_check(stream);
     buffered_file_stream_sync((Stream*)stream);
@@ -103,15 +131,14 @@ static void buffered_file_stream_free(BufferedFileStream* stream) {
 
 static bool buffered_file_stream_eof(BufferedFileStream* stream) {
     bool ret;
-    const bool file_stream_eof = stream_eof(stream->file_stream);
     const bool cache_at_end = stream_cache_at_end(stream->cache);
     if(!stream->sync_pending) {
-        ret = file_stream_eof && cache_at_end;
+        ret = cache_at_end && stream_eof(stream->file_stream);
     } else {
+        // Write cache covers the end of the file and the cursor is at its end
         const size_t remaining_size =
             stream_size(stream->file_stream) - stream_tell(stream->file_stream);
-        ret = stream_cache_size(stream->cache) >=
-              (remaining_size ? cache_at_end : file_stream_eof);
+        ret = (stream_cache_size(stream->cache) >= remaining_size) && cache_at_end;
     }
     return ret;
 }
@@ -128,17 +155,34 @@ static bool buffered_file_stream_seek(
     int32_t offset,
     StreamOffset offset_type) {
     bool success = true;
+    bool cache_hit = false;
     int32_t new_offset = offset;
+    // Stream position after the seek, to serve later seeks from the cache
+    size_t position = 0;
+    bool position_known = false;
 
     if(offset_type == StreamOffsetFromCurrent) {
         new_offset -= stream_cache_seek(stream->cache, offset);
-        if(new_offset < 0) {
-            new_offset -= (int32_t)stream_cache_size(stream->cache);
+        cache_hit = (new_offset == 0);
+        if(!cache_hit && !stream->sync_pending) {
+            position_known = stream_cache_tell(stream->cache, &position);
+            position += new_offset;
+            // Read cache ends at the file position
+            new_offset -=
+                (int32_t)(stream_cache_size(stream->cache) - stream_cache_pos(stream->cache));
         }
+    } else if(offset_type == StreamOffsetFromStart && offset >= 0) {
+        position = offset;
+        position_known = true;
+        cache_hit = !stream->sync_pending && stream_cache_seek_to(stream->cache, position);
     }
 
-    if((new_offset != 0) || (offset_type != StreamOffsetFromCurrent)) {
+    if(cache_hit) {
+        stream->stats.seek_hits++;
+    } else {
+        stream->stats.seek_misses++;
         if(stream->sync_pending) {
+            // Leaves the file at the cursor
             success = buffered_file_stream_sync((Stream*)stream);
         } else {
             stream_cache_drop(stream->cache);
@@ -146,15 +190,21 @@ static bool buffered_file_stream_seek(
         if(success) {
             success = stream_seek(stream->file_stream, new_offset, offset_type);
         }
+        if(success && position_known) {
+            stream_cache_reset(stream->cache, position);
+        }
     }
 
     return success;
 }
 
 static size_t buffered_file_stream_tell(BufferedFileStream* stream) {
-    size_t pos = stream_tell(stream->file_stream) + stream_cache_pos(stream->cache);
-    if(!stream->sync_pending) {
-        pos -= stream_cache_size(stream->cache);
+    size_t pos;
+    if(stream->sync_pending || !stream_cache_tell(stream->cache, &pos)) {
+        pos = stream_tell(stream->file_stream) + stream_cache_pos(stream->cache);
+        if(!stream->sync_pending) {
+            pos -= stream_cache_size(stream->cache);
+        }
     }
     return pos;
 }
@@ -184,6 +234,7 @@ static size_t
                 stream_cache_write(stream->cache, data + (size - need_to_write), need_to_write);
             if(need_to_write) {
                 stream->sync_pending = false;
+                stream->stats.cache_flushes++;
                 if(!stream_cache_flush(stream->cache, stream->file_stream)) break;
             }
         }
@@ -200,7 +251,10 @@ static size_t buffered_file_stream_read(BufferedFileStream* stream, uint8_t* dat
             if(stream->sync_pending) {
                 if(!buffered_file_stream_flush(stream)) break;
             }
-            if(!stream_cache_fill(stream->cache, stream->file_stream)) break;
+            const size_t size_read = stream_cache_fill(stream->cache, stream->file_stream);
+            stream->stats.cache_fills++;
+            stream->stats.fill_bytes += size_read;
+            if(!size_read) break;
         }
     }
     return size - need_to_read;
@@ -227,6 +281,7 @@ static bool buffered_file_stream_flush(BufferedFileStream* stream) {
     bool success = false;
     do {
         const int32_t offset = stream_cache_size(stream->cache) - stream_cache_pos(stream->cache);
+        stream->stats.cache_flushes++;
         if(!stream_cache_flush(stream->cache, stream->file_stream)) break;
         if(offset > 0) {
             if(!stream_seek(stream->file_stream, -offset, StreamOffsetFromCurrent)) break;
@@ -241,13 +296,13 @@ static bool buffered_file_stream_flush(BufferedFileStream* stream) {
 static bool buffered_file_stream_unread(BufferedFileStream* stream) {
     bool success = true;
     const size_t cache_size = stream_cache_size(stream->cache);
-    if(cache_size > 0) {
-        const size_t cache_pos = stream_cache_pos(stream->cache);
-        if(cache_pos < cache_size) {
-            const int32_t offset = cache_size - cache_pos;
-            success = stream_seek(stream->file_stream, -offset, StreamOffsetFromCurrent);
-        }
-        stream_cache_drop(stream->cache);
+    const size_t cache_pos = stream_cache_pos(stream->cache);
+    if(cache_pos < cache_size) {
+        const int32_t offset = cache_size - cache_pos;
+        success = stream_seek(stream->file_stream, -offset, StreamOffsetFromCurrent);
     }
+    // An empty cache may still hold the position after a seek, the caller is about to move
+    // the underlying stream, so the position is unknown from now on
+    stream_cache_drop(stream->cache);
     return success;
 }
@@ -7,6 +7,17 @@
 extern "C" {
 #endif
 
+/** Default cache size: one SD card sector kept for backward seeks and two read ahead */
+#define BUFFERED_FILE_STREAM_CACHE_SIZE (1536U)
+
+typedef struct {
+    uint32_t cache_fills; /*!< cache refills from the file */
+    uint32_t fill_bytes; /*!< bytes read from the file by refills */
+    uint32_t cache_flushes; /*!< cache writes to the file */
+    uint32_t seek_hits; /*!< seeks served from the cache */
+    uint32_t seek_misses; /*!< seeks passed to the file */
+} BufferedFileStreamStats;
+
 /**
  * Allocate a file stream with buffered read operations
  * @return Stream*
@@ -27,6 +38,24 @@ bool buffered_file_stream_open(
     FS_AccessMode access_mode,
     FS_OpenMode open_mode);
 
+/**
+ * Opens an existing file or creates a new one with a specific cache size.
+ * Larger cache means less file reads for sequential access and more previous data
+ * kept for seeks.
+ * @param stream pointer to file stream object.
+ * @param path path to file
+ * @param access_mode access mode from FS_AccessMode
+ * @param open_mode open mode from FS_OpenMode
+ * @param cache_size cache size in bytes, multiple of 512
+ * @return True on success, False on failure. You need to close the file even if the open operation failed.
+ */
+bool buffered_file_stream_open_ex(
+    Stream* stream,
+    const char* path,
+    FS_AccessMode access_mode,
+    FS_OpenMode open_mode,
+    size_t cache_size);
+
 /**
  * Closes the file.
  * @param stream pointer to file stream object.
@@ -48,6 +77,13 @@ bool buffered_file_stream_sync(Stream* stream);
  */
 FS_Error buffered_file_stream_get_error(Stream* stream);
 
+/**
+ * Get cache statistics of the file, reset when the file is opened
+ * @param stream pointer to stream object.
+ * @param stats pointer to statistics
+ */
+void buffered_file_stream_get_stats(Stream* stream, BufferedFileStreamStats* stats);
+
 #ifdef __cplusplus
 }
 #endif
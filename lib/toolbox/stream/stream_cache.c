@@ -1,29 +1,48 @@
 #include "stream_cache.h"
 
-#define STREAM_CACHE_MAX_SIZE 1024U
+#define STREAM_CACHE_POSITION_UNKNOWN SIZE_MAX
 
 struct StreamCache {
-    uint8_t data[STREAM_CACHE_MAX_SIZE];
+    uint8_t* data;
+    size_t capacity;
     size_t data_size;
     size_t position;
+    // Stream position of data[0]
+    size_t offset;
 };
 
-StreamCache* stream_cache_alloc(void) {
+StreamCache* stream_cache_alloc(size_t size) {
+    furi_check(size >= STREAM_CACHE_PAGE_SIZE && (size % STREAM_CACHE_PAGE_SIZE) == 0);
     StreamCache* cache = malloc(sizeof(StreamCache));
+    cache->data = malloc(size);
+    cache->capacity = size;
     cache->data_size = 0;
     cache->position = 0;
+    cache->offset = STREAM_CACHE_POSITION_UNKNOWN;
     return cache;
 }
 void stream_cache_free(StreamCache* cache) {
     furi_assert(cache);
     cache->data_size = 0;
     cache->position = 0;
+    free(cache->data);
     free(cache);
 }
 
 void stream_cache_drop(StreamCache* cache) {
     cache->data_size = 0;
     cache->position = 0;
+    cache->offset = STREAM_CACHE_POSITION_UNKNOWN;
+}
+
+void stream_cache_reset(StreamCache* cache, size_t position) {
+    cache->data_size = 0;
+    cache->position = 0;
+    cache->offset = position;
+}
+
+size_t stream_cache_capacity(StreamCache* cache) {
+    return cache->capacity;
 }
 
 bool stream_cache_at_end(StreamCache* cache) {
@@ -39,18 +58,40 @@ size_t stream_cache_pos(StreamCache* cache) {
     return cache->position;
 }
 
+bool stream_cache_tell(StreamCache* cache, size_t* position) {
+    if(cache->offset == STREAM_CACHE_POSITION_UNKNOWN) return false;
+    *position = cache->offset + cache->position;
+    return true;
+}
+
 size_t stream_cache_fill(StreamCache* cache, Stream* stream) {
-    const size_t size_read = stream_read(stream, cache->data, STREAM_CACHE_MAX_SIZE);
-    cache->data_size = size_read;
-    cache->position = 0;
+    size_t keep = 0;
+
+    if(cache->offset == STREAM_CACHE_POSITION_UNKNOWN) {
+        cache->offset = stream_tell(stream);
+    } else {
+        // Keep the last page for backward seeks, it is right before the stream position
+        if(cache->capacity >= STREAM_CACHE_PAGE_SIZE * 2) {
+            keep = MIN(cache->data_size, STREAM_CACHE_PAGE_SIZE);
+            memmove(cache->data, cache->data + cache->data_size - keep, keep);
+        }
+        cache->offset += cache->data_size - keep;
+    }
+
+    size_t size = cache->capacity - keep;
+    const size_t tail = (cache->offset + keep + size) % STREAM_CACHE_PAGE_SIZE;
+    if(tail < size) size -= tail;
+
+    const size_t size_read = stream_read(stream, cache->data + keep, size);
+    cache->data_size = keep + size_read;
+    cache->position = keep;
     return size_read;
 }
 
 bool stream_cache_flush(StreamCache* cache, Stream* stream) {
     const size_t size_written = stream_write(stream, cache->data, cache->data_size);
     const bool success = (size_written == cache->data_size);
-    cache->data_size = 0;
-    cache->position = 0;
+    stream_cache_drop(cache);
     return success;
 }
 
@@ -66,7 +107,7 @@ size_t stream_cache_read(StreamCache* cache, uint8_t* data, size_t size) {
 
 size_t stream_cache_write(StreamCache* cache, const uint8_t* data, size_t size) {
     furi_assert(cache->data_size >= cache->position);
-    const size_t size_written = MIN(size, STREAM_CACHE_MAX_SIZE - cache->position);
+    const size_t size_written = MIN(size, cache->capacity - cache->position);
     if(size_written > 0) {
         memcpy(cache->data + cache->position, data, size_written);
         cache->position += size_written;
@@ -90,3 +131,14 @@ int32_t stream_cache_seek(StreamCache* cache, int32_t offset) {
     cache->position += actual_offset;
     return actual_offset;
 }
+
+bool stream_cache_seek_to(StreamCache* cache, size_t position) {
+    furi_assert(cache->data_size >= cache->position);
+    if(cache->offset == STREAM_CACHE_POSITION_UNKNOWN || position < cache->offset ||
+       position - cache->offset > cache->data_size) {
+        return false;
+    }
+
+    cache->position = position - cache->offset;
+    return true;
+}
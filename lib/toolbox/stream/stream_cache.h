@@ -6,13 +6,19 @@
 extern "C" {
 #endif
 
+/** Cache is split into pages of SD card sector size */
+#define STREAM_CACHE_PAGE_SIZE 512U
+
 typedef struct StreamCache StreamCache;
 
 /**
  * Allocate stream cache.
+ * Caches of two pages and more keep the last page of previous data on refill,
+ * so short backward seeks don't drop the cache.
+ * @param size Cache size in bytes, multiple of STREAM_CACHE_PAGE_SIZE
  * @return StreamCache* pointer to a StreamCache instance
  */
-StreamCache* stream_cache_alloc(void);
+StreamCache* stream_cache_alloc(size_t size);
 
 /**
  * Free stream cache.
@@ -26,6 +32,20 @@ void stream_cache_free(StreamCache* cache);
  */
 void stream_cache_drop(StreamCache* cache);
 
+/**
+ * Drop the cache contents, next fill will start at known stream position.
+ * @param cache Pointer to a StreamCache instance
+ * @param position Stream position of the next fill
+ */
+void stream_cache_reset(StreamCache* cache, size_t position);
+
+/**
+ * Get the cache size set at allocation.
+ * @param cache Pointer to a StreamCache instance
+ * @return Cache size in bytes.
+ */
+size_t stream_cache_capacity(StreamCache* cache);
+
 /**
  * Determine if the internal cursor is at end the end of cached data.
  * @param cache Pointer to a StreamCache instance
@@ -47,8 +67,19 @@ size_t stream_cache_size(StreamCache* cache);
  */
 size_t stream_cache_pos(StreamCache* cache);
 
+/**
+ * Get the stream position of the internal cursor.
+ * Only known for data loaded with stream_cache_fill.
+ * @param cache Pointer to a StreamCache instance
+ * @param position Stream position of the cursor
+ * @return True if the position is known, otherwise false.
+ */
+bool stream_cache_tell(StreamCache* cache, size_t* position);
+
 /**
  * Load the cache with new data from a stream.
+ * The cache must be filled when the cursor is at the end of cached data.
+ * Reads are trimmed to end on a page boundary of the stream.
  * @param cache Pointer to a StreamCache instance
  * @param stream Pointer to a Stream instance
  * @return Size of newly cached data.
@@ -89,6 +120,14 @@ size_t stream_cache_write(StreamCache* cache, const uint8_t* data, size_t size);
  */
 int32_t stream_cache_seek(StreamCache* cache, int32_t offset);
 
+/**
+ * Move the internal cursor to a stream position if it is inside the cached data.
+ * @param cache Pointer to a StreamCache instance.
+ * @param position Stream position.
+ * @return True on hit, False if position is not cached.
+ */
+bool stream_cache_seek_to(StreamCache* cache, size_t position);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,251 @@
+#!/usr/bin/env python3
+
+import json
+import os
+import subprocess
+from concurrent.futures import ThreadPoolExecutor
+
+from flipper.app import App
+
+ROOT_DIR = os.path.abspath(os.path.join(os.path.dirname(__file__), ".."))
+
+SOURCES = [
+    "scripts/lfrfid_replay/lfrfid_replay.c",
+    "lib/lfrfid/protocols/*.c",
+    "lib/lfrfid/tools/fsk_demod.c",
+    "lib/lfrfid/tools/fsk_ocs.c",
+    "lib/lfrfid/tools/varint_pair.c",
+    "lib/bit_lib/bit_lib.c",
+    "lib/toolbox/crc.c",
+    "lib/toolbox/manchester_decoder.c",
+    "lib/toolbox/hex.c",
+    "lib/toolbox/varint.c",
+    "lib/toolbox/protocols/protocol_dict.c",
+]
+
+INCLUDES = [
+    "scripts/lfrfid_replay/stubs",
+    "lib",
+    "lib/toolbox",
+    ".",
+]
+
+CORPUS_FILE = "corpus.json"
+
+
+class Main(App):
+    def init(self):
+        self.subparsers = self.parser.add_subparsers(help="sub-command help")
+
+        self.parser_build = self.subparsers.add_parser(
+            "build", help="Build host replay binary"
+        )
+        self._add_build_args(self.parser_build)
+        self.parser_build.set_defaults(func=self.build)
+
+        self.parser_run = self.subparsers.add_parser(
+            "run", help="Replay raw captures and check decode results"
+        )
+        self._add_build_args(self.parser_run)
+        self.parser_run.add_argument(
+            "captures", nargs="+", help="Raw capture files or directories"
+        )
+        self.parser_run.add_argument(
+            "-j", "--jobs", type=int, default=os.cpu_count(), help="Parallel jobs"
+        )
+        self.parser_run.add_argument(
+            "-r",
+            "--repeats",
+            type=int,
+            default=1,
+            help="Replay each capture N times for throughput measurement",
+        )
+        self.parser_run.add_argument(
+            "-n",
+            "--no-lock",
+            action="store_true",
+            help="Do not lock decoders to a detected protocol",
+        )
+        self.parser_run.add_argument(
+            "-e",
+            "--expect",
+            help=f"Expected results, default is {CORPUS_FILE} in capture directory",
+        )
+        self.parser_run.add_argument(
+            "-u",
+            "--update",
+            action="store_true",
+            help="Write current results as expected results",
+        )
+        self.parser_run.set_defaults(func=self.run)
+
+    def _add_build_args(self, parser):
+        parser.add_argument(
+            "-o",
+            "--output",
+            default=os.path.join(ROOT_DIR, "build", "lfrfid_replay"),
+            help="Build directory",
+        )
+        parser.add_argument(
+            "--cc", default=os.environ.get("CC", "cc"), help="Host C compiler"
+        )
+
+    def _build(self):
+        os.makedirs(self.args.output, exist_ok=True)
+        binary = os.path.join(self.args.output, "lfrfid_replay")
+
+        sources = []
+        for source in SOURCES:
+            if source.endswith("*.c"):
+                directory = os.path.join(ROOT_DIR, os.path.dirname(source))
+                sources.extend(
+                    os.path.join(directory, name)
+                    for name in sorted(os.listdir(directory))
+                    if name.endswith(".c")
+                )
+            else:
+                sources.append(os.path.join(ROOT_DIR, source))
+
+        command = [self.args.cc, "-std=gnu17", "-O2", "-g", "-o", binary]
+        command.extend(f"-I{os.path.join(ROOT_DIR, path)}" for path in INCLUDES)
+        command.extend(sources)
+        command.append("-lm")
+
+        self.logger.debug(" ".join(command))
+        process = subprocess.run(command, capture_output=True, text=True)
+        if process.returncode != 0:
+            self.logger.error(f"Build failed:\n{process.stderr}")
+            return None
+
+        return binary
+
+    def build(self):
+        binary = self._build()
+        if not binary:
+            return 1
+
+        self.logger.info(f"Built {binary}")
+        return 0
+
+    def _collect(self, paths):
+        captures = []
+        for path in paths:
+            if os.path.isdir(path):
+                for root, _, files in os.walk(path):
+                    captures.extend(
+                        os.path.join(root, name)
+                        for name in sorted(files)
+                        if name.endswith(".raw")
+                    )
+            else:
+                captures.append(path)
+        return captures
+
+    def _replay(self, binary, capture):
+        command = [binary, "-r", str(self.args.repeats)]
+        if self.args.no_lock:
+            command.append("-n")
+        command.append(capture)
+
+        process = subprocess.run(command, capture_output=True, text=True)
+        if process.returncode != 0:
+            return {"file": capture, "error": process.stderr.strip()}
+        return json.loads(process.stdout)
+
+    def _expect_path(self):
+        if self.args.expect:
+            return self.args.expect
+
+        directories = [path for path in self.args.captures if os.path.isdir(path)]
+        if len(directories) == 1:
+            return os.path.join(directories[0], CORPUS_FILE)
+        return None
+
+    def run(self):
+        binary = self._build()
+        if not binary:
+            return 1
+
+        captures = self._collect(self.args.captures)
+        if not captures:
+            self.logger.error("No captures found")
+            return 1
+
+        with ThreadPoolExecutor(max_workers=self.args.jobs) as executor:
+            results = list(
+                executor.map(lambda capture: self._replay(binary, capture), captures)
+            )
+
+        expect_path = self._expect_path()
+        expect_root = os.path.dirname(expect_path) if expect_path else None
+        expected = {}
+        if expect_path and os.path.exists(expect_path) and not self.args.update:
+            with open(expect_path, "r") as file:
+                expected = json.load(file)
+
+        failed = 0
+        current = {}
+        protocols = {}
+        total_pairs = 0
+        total_time = 0
+        for result in results:
+            name = result["file"]
+            if expect_root:
+                name = os.path.relpath(name, expect_root)
+
+            if "error" in result:
+                self.logger.error(f"{name}: {result['error']}")
+                failed += 1
+                continue
+
+            read = result["read"]
+            current[name] = read
+            read_text = f"{read['protocol']} [{read['data']}]" if read else "no read"
+            self.logger.info(
+                f"{name}: {read_text}, {result['pairs']} pairs, "
+                f"{result['pairs_per_second'] / 1e6:.2f} Mpairs/s"
+            )
+            self.logger.debug(f"{name}: detections {result['detections']}")
+
+            protocol = read["protocol"] if read else None
+            protocols[protocol] = protocols.get(protocol, 0) + 1
+            if result["pairs_per_second"]:
+                total_pairs += result["pairs"]
+                total_time += result["pairs"] / result["pairs_per_second"]
+
+            if name in expected and expected[name] != read:
+                self.logger.error(f"{name}: expected {expected[name]}")
+                failed += 1
+
+        for protocol, count in sorted(
+            protocols.items(), key=lambda item: str(item[0])
+        ):
+            self.logger.info(f"{protocol or 'No read'}: {count} captures")
+        if total_time:
+            self.logger.info(
+                f"Decoded {total_pairs} pairs at {total_pairs / total_time / 1e6:.2f} Mpairs/s"
+            )
+
+        if self.args.update:
+            if not expect_path:
+                self.logger.error("Expected results file is not set, use --expect")
+                return 1
+            with open(expect_path, "w") as file:
+                json.dump(current, file, indent=4, sort_keys=True)
+                file.write("\n")
+            self.logger.info(f"Updated {expect_path}")
+        elif expected:
+            missing = [name for name in expected if name not in current]
+            for name in missing:
+                self.logger.warning(f"{name}: capture is missing")
+
+        if failed:
+            self.logger.error(f"{failed} of {len(results)} captures failed")
+            return 1
+
+        self.logger.info(f"{len(results)} captures replayed")
+        return 0
+
+
+if __name__ == "__main__":
+    Main()()
@@ -0,0 +1,279 @@
+/**
+ * @file lfrfid_replay.c
+ * Host replay of LF RFID raw captures (lfrfid_raw_file format, .ask.raw and
+ * .psk.raw files saved by the lfrfid app) through the same ProtocolDict
+ * pipeline as lfrfid_worker_read_internal.
+ *
+ * Prints one JSON object per capture with the validated read, per protocol
+ * detection counts and decoder throughput. Driven by scripts/lfrfid_replay.py.
+ */
+#include <furi.h>
+#include <time.h>
+
+#include <toolbox/protocols/protocol_dict.h>
+#include <lfrfid/protocols/lfrfid_protocols.h>
+#include <lfrfid/tools/varint_pair.h>
+
+// Must match lib/lfrfid/lfrfid_raw_file.c
+#define LFRFID_RAW_FILE_MAGIC   0x4C464952
+#define LFRFID_RAW_FILE_VERSION 1
+
+// Must match lib/lfrfid/lfrfid_worker_modes.c
+#define LFRFID_REPLAY_LOCK_TIME_US 200000
+
+#define LFRFID_REPLAY_MAX_BUFFER_SIZE (64 * 1024)
+
+typedef struct {
+    uint32_t magic;
+    uint32_t version;
+    float frequency;
+    float duty_cycle;
+    uint32_t max_buffer_size;
+} LFRFIDRawFileHeader;
+
+typedef struct {
+    uint32_t pulse;
+    uint32_t duration;
+} LFRFIDReplayPair;
+
+typedef struct {
+    LFRFIDRawFileHeader header;
+    LFRFIDReplayPair* pairs;
+    size_t count;
+} LFRFIDReplayCapture;
+
+typedef struct {
+    ProtocolId protocol;
+    uint8_t data[32];
+    uint32_t detections[LFRFIDProtocolMax];
+} LFRFIDReplayResult;
+
+static bool lfrfid_replay_load(const char* path, LFRFIDReplayCapture* capture) {
+    FILE* file = fopen(path, "rb");
+    if(!file) return false;
+
+    bool result = false;
+    uint8_t* buffer = NULL;
+    size_t capacity = 0;
+
+    do {
+        LFRFIDRawFileHeader* header = &capture->header;
+        if(fread(header, sizeof(LFRFIDRawFileHeader), 1, file) != 1) break;
+        if(header->magic != LFRFID_RAW_FILE_MAGIC) break;
+        if(header->version != LFRFID_RAW_FILE_VERSION) break;
+        if(header->max_buffer_size > LFRFID_REPLAY_MAX_BUFFER_SIZE) break;
+
+        buffer = malloc(header->max_buffer_size);
+
+        // Buffer size is written as device size_t
+        uint32_t buffer_size;
+        bool buffers_ok = true;
+        while(fread(&buffer_size, sizeof(buffer_size), 1, file) == 1) {
+            if(buffer_size > header->max_buffer_size ||
+               fread(buffer, 1, buffer_size, file) != buffer_size) {
+                buffers_ok = false;
+                break;
+            }
+
+            size_t offset = 0;
+            while(offset < buffer_size) {
+                if(capture->count == capacity) {
+                    capacity = capacity ? capacity * 2 : 4096;
+                    capture->pairs = realloc(capture->pairs, capacity * sizeof(LFRFIDReplayPair));
+                }
+
+                LFRFIDReplayPair* pair = &capture->pairs[capture->count];
+                size_t length;
+                if(!varint_pair_unpack(
+                       &buffer[offset],
+                       buffer_size - offset,
+                       &pair->pulse,
+                       &pair->duration,
+                       &length)) {
+                    break;
+                }
+                offset += length;
+                capture->count++;
+            }
+        }
+
+        result = buffers_ok;
+    } while(false);
+
+    free(buffer);
+    fclose(file);
+    return result;
+}
+
+static void lfrfid_replay_run(
+    ProtocolDict* dict,
+    const LFRFIDReplayCapture* capture,
+    uint32_t feature,
+    bool lock,
+    LFRFIDReplayResult* result) {
+    ProtocolId last_protocol = PROTOCOL_NO;
+    uint8_t last_data[sizeof(result->data)];
+    uint8_t protocol_data[sizeof(result->data)];
+    size_t last_read_count = 0;
+
+    protocol_dict_decoders_set_lock_timeout(dict, lock ? LFRFID_REPLAY_LOCK_TIME_US : 0);
+    protocol_dict_decoders_start(dict);
+
+    for(size_t i = 0; i < capture->count; i++) {
+        const LFRFIDReplayPair* pair = &capture->pairs[i];
+        ProtocolId protocol = protocol_dict_decoders_feed_pair_by_feature(
+            dict, feature, pair->pulse, pair->duration);
+
+        if(protocol == PROTOCOL_NO) continue;
+
+        result->detections[protocol]++;
+
+        // Same validation as the worker: data must repeat validate_count times
+        size_t data_size = protocol_dict_get_data_size(dict, protocol);
+        protocol_dict_get_data(dict, protocol, protocol_data, data_size);
+        if(protocol == last_protocol && memcmp(last_data, protocol_data, data_size) == 0) {
+            last_read_count++;
+            if(last_read_count >= protocol_dict_get_validate_count(dict, protocol) &&
+               result->protocol == PROTOCOL_NO) {
+                result->protocol = protocol;
+                memcpy(result->data, protocol_data, data_size);
+            }
+        } else {
+            last_protocol = protocol;
+            memcpy(last_data, protocol_data, data_size);
+            last_read_count = 0;
+        }
+
+        protocol_dict_decoders_start(dict);
+    }
+
+    protocol_dict_decoders_set_lock_timeout(dict, 0);
+}
+
+static double lfrfid_replay_time(void) {
+    struct timespec time;
+    clock_gettime(CLOCK_MONOTONIC, &time);
+    return time.tv_sec + time.tv_nsec * 1e-9;
+}
+
+static void lfrfid_replay_print_string(const char* string) {
+    putchar('"');
+    for(; *string; string++) {
+        if(*string == '"' || *string == '\\') {
+            printf("\\%c", *string);
+        } else if((uint8_t)*string < 0x20) {
+            printf("\\u%04x", *string);
+        } else {
+            putchar(*string);
+        }
+    }
+    putchar('"');
+}
+
+static void lfrfid_replay_usage(const char* name) {
+    fprintf(stderr, "Usage: %s [-f ask|psk] [-r repeats] [-n] capture.raw\n", name);
+    fprintf(stderr, "  -f  demodulation, by default taken from file name or frequency\n");
+    fprintf(stderr, "  -r  replay count for throughput measurement, default 1\n");
+    fprintf(stderr, "  -n  do not lock decoders to a detected protocol\n");
+}
+
+int main(int argc, char** argv) {
+    const char* path = NULL;
+    const char* feature_name = NULL;
+    unsigned long repeats = 1;
+    bool lock = true;
+
+    for(int i = 1; i < argc; i++) {
+        if(!strcmp(argv[i], "-f") && i + 1 < argc) {
+            feature_name = argv[++i];
+        } else if(!strcmp(argv[i], "-r") && i + 1 < argc) {
+            repeats = strtoul(argv[++i], NULL, 10);
+        } else if(!strcmp(argv[i], "-n")) {
+            lock = false;
+        } else if(argv[i][0] != '-' && !path) {
+            path = argv[i];
+        } else {
+            lfrfid_replay_usage(argv[0]);
+            return 2;
+        }
+    }
+    if(!path || !repeats) {
+        lfrfid_replay_usage(argv[0]);
+        return 2;
+    }
+
+    LFRFIDReplayCapture capture = {0};
+    if(!lfrfid_replay_load(path, &capture)) {
+        fprintf(stderr, "%s: not a valid LF RFID raw file\n", path);
+        free(capture.pairs);
+        return 1;
+    }
+
+    uint32_t feature;
+    if(feature_name) {
+        feature = strcmp(feature_name, "psk") ? LFRFIDFeatureASK : LFRFIDFeaturePSK;
+    } else if(strstr(path, ".psk.raw")) {
+        feature = LFRFIDFeaturePSK;
+    } else if(strstr(path, ".ask.raw")) {
+        feature = LFRFIDFeatureASK;
+    } else {
+        // Worker reads ASK at 125 kHz and PSK at 62.5 kHz
+        feature = capture.header.frequency > 100000 ? LFRFIDFeatureASK : LFRFIDFeaturePSK;
+    }
+
+    ProtocolDict* dict = protocol_dict_alloc(lfrfid_protocols, LFRFIDProtocolMax);
+    LFRFIDReplayResult result;
+    furi_check(protocol_dict_get_max_data_size(dict) <= sizeof(result.data));
+
+    double elapsed = 0;
+    for(unsigned long i = 0; i < repeats; i++) {
+        memset(&result, 0, sizeof(result));
+        result.protocol = PROTOCOL_NO;
+
+        double start = lfrfid_replay_time();
+        lfrfid_replay_run(dict, &capture, feature, lock, &result);
+        elapsed += lfrfid_replay_time() - start;
+    }
+
+    printf("{\"file\": ");
+    lfrfid_replay_print_string(path);
+    printf(
+        ", \"feature\": \"%s\", \"frequency\": %.0f, \"duty_cycle\": %.2f",
+        feature == LFRFIDFeaturePSK ? "PSK" : "ASK",
+        (double)capture.header.frequency,
+        (double)capture.header.duty_cycle);
+    printf(
+        ", \"pairs\": %zu, \"pairs_per_second\": %.0f",
+        capture.count,
+        elapsed > 0 ? capture.count * repeats / elapsed : 0);
+
+    printf(", \"read\": ");
+    if(result.protocol != PROTOCOL_NO) {
+        printf("{\"protocol\": ");
+        lfrfid_replay_print_string(protocol_dict_get_name(dict, result.protocol));
+        printf(", \"data\": \"");
+        size_t data_size = protocol_dict_get_data_size(dict, result.protocol);
+        for(size_t i = 0; i < data_size; i++) {
+            printf(i ? " %02X" : "%02X", result.data[i]);
+        }
+        printf("\"}");
+    } else {
+        printf("null");
+    }
+
+    printf(", \"detections\": {");
+    bool first = true;
+    for(size_t i = 0; i < LFRFIDProtocolMax; i++) {
+        if(!result.detections[i]) continue;
+        printf(first ? "" : ", ");
+        lfrfid_replay_print_string(protocol_dict_get_name(dict, i));
+        printf(": %u", result.detections[i]);
+        first = false;
+    }
+    printf("}}\n");
+
+    protocol_dict_free(dict);
+    free(capture.pairs);
+
+    return 0;
+}
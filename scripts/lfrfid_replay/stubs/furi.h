@@ -0,0 +1,105 @@
+/**
+ * @file furi.h
+ * Minimal host replacement of furi for building LF RFID decoders with the
+ * system compiler. Only what lib/lfrfid/protocols, lib/toolbox/protocols and
+ * lib/bit_lib use is provided.
+ */
+#pragma once
+
+#include <assert.h>
+#include <stdarg.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Firmware allocator returns zeroed memory and never fails
+#define malloc(size) calloc(1, size)
+
+#define furi_check(...)  assert(__VA_ARGS__)
+#define furi_assert(...) assert(__VA_ARGS__)
+#define furi_crash(...)  abort()
+
+#define FURI_LOG_E(tag, ...)
+#define FURI_LOG_W(tag, ...)
+#define FURI_LOG_I(tag, ...)
+#define FURI_LOG_D(tag, ...)
+#define FURI_LOG_T(tag, ...)
+
+#ifndef UNUSED
+#define UNUSED(x) (void)(x)
+#endif
+
+#ifndef COUNT_OF
+#define COUNT_OF(x) (sizeof(x) / sizeof(x[0]))
+#endif
+
+#ifndef MIN
+#define MIN(a, b) ((a) < (b) ? (a) : (b))
+#endif
+
+#ifndef MAX
+#define MAX(a, b) ((a) > (b) ? (a) : (b))
+#endif
+
+#define FURI_STRING_HOST_SIZE 256
+
+typedef struct FuriString {
+    char data[FURI_STRING_HOST_SIZE];
+} FuriString;
+
+static inline void furi_string_vcat(FuriString* string, const char* format, va_list args) {
+    size_t length = strlen(string->data);
+    vsnprintf(string->data + length, sizeof(string->data) - length, format, args);
+}
+
+static inline void furi_string_cat_printf(FuriString* string, const char* format, ...) {
+    va_list args;
+    va_start(args, format);
+    furi_string_vcat(string, format, args);
+    va_end(args);
+}
+
+static inline void furi_string_printf(FuriString* string, const char* format, ...) {
+    string->data[0] = '\0';
+    va_list args;
+    va_start(args, format);
+    furi_string_vcat(string, format, args);
+    va_end(args);
+}
+
+static inline void furi_string_cat_str(FuriString* string, const char* cstr) {
+    furi_string_cat_printf(string, "%s", cstr);
+}
+
+static inline void furi_string_cat_string(FuriString* string, const FuriString* other) {
+    furi_string_cat_printf(string, "%s", other->data);
+}
+
+#define furi_string_cat(string, other)                   \
+    _Generic(                                            \
+        (other),                                         \
+        char*: furi_string_cat_str,                      \
+        const char*: furi_string_cat_str,                \
+        FuriString*: furi_string_cat_string,             \
+        const FuriString*: furi_string_cat_string)(string, other)
+
+static inline void furi_string_set_str(FuriString* string, const char* cstr) {
+    furi_string_printf(string, "%s", cstr);
+}
+
+#define furi_string_set(string, other) furi_string_set_str(string, other)
+
+static inline FuriString* furi_string_alloc(void) {
+    return malloc(sizeof(FuriString));
+}
+
+static inline void furi_string_free(FuriString* string) {
+    free(string);
+}
+
+static inline const char* furi_string_get_cstr(const FuriString* string) {
+    return string->data;
+}
@@ -0,0 +1,228 @@
+#!/usr/bin/env python3
+
+import json
+import os
+import subprocess
+
+from flipper.app import App
+
+ROOT_DIR = os.path.abspath(os.path.join(os.path.dirname(__file__), ".."))
+
+SOURCES = [
+    "scripts/mfkey/mfkey.c",
+    "lib/nfc/helpers/crypto1.c",
+    "lib/nfc/helpers/nfc_util.c",
+    "lib/toolbox/bit_buffer.c",
+    "lib/bit_lib/bit_lib.c",
+    "lib/toolbox/crc.c",
+]
+
+INCLUDES = [
+    "scripts/mfkey/stubs",
+    "lib",
+    "lib/toolbox",
+    ".",
+]
+
+BENCH_DIR = os.path.join(ROOT_DIR, "scripts", "mfkey", "bench")
+CORPUS_FILE = "corpus.json"
+
+
+class Main(App):
+    def init(self):
+        self.subparsers = self.parser.add_subparsers(help="sub-command help")
+
+        self.parser_build = self.subparsers.add_parser(
+            "build", help="Build host key recovery binary"
+        )
+        self._add_build_args(self.parser_build)
+        self.parser_build.set_defaults(func=self.build)
+
+        self.parser_run = self.subparsers.add_parser(
+            "run", help="Recover keys from .mfkey32.log and nested nonce logs"
+        )
+        self._add_build_args(self.parser_run)
+        self._add_recovery_args(self.parser_run)
+        self.parser_run.add_argument("logs", nargs="+", help="Nonce log files")
+        self.parser_run.add_argument(
+            "-e", "--expect", help="Expected keys, checked when given"
+        )
+        self.parser_run.add_argument(
+            "-u",
+            "--update",
+            action="store_true",
+            help="Write recovered keys as expected keys",
+        )
+        self.parser_run.set_defaults(func=self.run)
+
+        self.parser_bench = self.subparsers.add_parser(
+            "bench", help="Recover known nonce sets and measure thread scaling"
+        )
+        self._add_build_args(self.parser_bench)
+        self._add_recovery_args(self.parser_bench)
+        self.parser_bench.add_argument(
+            "-d", "--dir", default=BENCH_DIR, help="Directory with nonce sets"
+        )
+        self.parser_bench.set_defaults(func=self.bench)
+
+    def _add_build_args(self, parser):
+        parser.add_argument(
+            "-o",
+            "--output",
+            default=os.path.join(ROOT_DIR, "build", "mfkey"),
+            help="Build directory",
+        )
+        parser.add_argument(
+            "--cc", default=os.environ.get("CC", "cc"), help="Host C compiler"
+        )
+
+    def _add_recovery_args(self, parser):
+        parser.add_argument(
+            "-j",
+            "--jobs",
+            type=int,
+            default=os.cpu_count(),
+            help="Worker threads, maximum for bench",
+        )
+        parser.add_argument(
+            "-t", "--tolerance", type=int, help="Nested PRNG distance tolerance"
+        )
+
+    def _build(self):
+        os.makedirs(self.args.output, exist_ok=True)
+        binary = os.path.join(self.args.output, "mfkey")
+
+        command = [self.args.cc, "-std=gnu17", "-O2", "-g", "-pthread", "-o", binary]
+        command.extend(f"-I{os.path.join(ROOT_DIR, path)}" for path in INCLUDES)
+        command.extend(os.path.join(ROOT_DIR, source) for source in SOURCES)
+
+        self.logger.debug(" ".join(command))
+        process = subprocess.run(command, capture_output=True, text=True)
+        if process.returncode != 0:
+            self.logger.error(f"Build failed:\n{process.stderr}")
+            return None
+
+        return binary
+
+    def _recover(self, binary, logs, jobs):
+        command = [binary, "-J", "-j", str(jobs)]
+        if self.args.tolerance is not None:
+            command.extend(["-t", str(self.args.tolerance)])
+        command.extend(logs)
+
+        process = subprocess.run(command, capture_output=True, text=True)
+        if process.returncode != 0:
+            self.logger.error(f"Recovery failed: {process.stderr.strip()}")
+            return None
+        return json.loads(process.stdout)
+
+    @staticmethod
+    def _result_name(result):
+        return f"{result['cuid']} sec {result['sector']} key {result['key_type']}"
+
+    def _check(self, results, expected):
+        failed = 0
+        for result in results:
+            name = self._result_name(result)
+            if name in expected and expected[name] != result["key"]:
+                self.logger.error(f"{name}: expected {expected[name]}")
+                failed += 1
+        return failed
+
+    @staticmethod
+    def _load_expected(path):
+        if not path or not os.path.exists(path):
+            return {}
+        with open(path, "r") as file:
+            return json.load(file)
+
+    def build(self):
+        binary = self._build()
+        if not binary:
+            return 1
+
+        self.logger.info(f"Built {binary}")
+        return 0
+
+    def run(self):
+        binary = self._build()
+        if not binary:
+            return 1
+
+        output = self._recover(binary, self.args.logs, self.args.jobs)
+        if not output:
+            return 1
+
+        for result in output["results"]:
+            key = result["key"] or f"not found, {result['candidates']} candidates"
+            self.logger.info(f"{result['type']} {self._result_name(result)}: {key}")
+        self.logger.info(
+            f"{output['recoveries']} recoveries in {output['seconds']:.2f} s "
+            f"on {output['threads']} threads"
+        )
+
+        if self.args.update:
+            if not self.args.expect:
+                self.logger.error("Expected keys file is not set, use --expect")
+                return 1
+            current = {
+                self._result_name(result): result["key"]
+                for result in output["results"]
+            }
+            with open(self.args.expect, "w") as file:
+                json.dump(current, file, indent=4, sort_keys=True)
+                file.write("\n")
+            self.logger.info(f"Updated {self.args.expect}")
+            return 0
+
+        failed = self._check(output["results"], self._load_expected(self.args.expect))
+        if failed:
+            self.logger.error(f"{failed} keys don't match")
+            return 1
+        return 0
+
+    def bench(self):
+        binary = self._build()
+        if not binary:
+            return 1
+
+        logs = [
+            os.path.join(self.args.dir, name)
+            for name in sorted(os.listdir(self.args.dir))
+            if name.endswith(".log")
+        ]
+        if not logs:
+            self.logger.error("No nonce sets found")
+            return 1
+        expected = self._load_expected(os.path.join(self.args.dir, CORPUS_FILE))
+
+        jobs = 1
+        base_rate = None
+        failed = 0
+        while True:
+            output = self._recover(binary, logs, jobs)
+            if not output:
+                return 1
+            failed += self._check(output["results"], expected)
+
+            rate = output["recoveries"] / max(output["seconds"], 1e-6)
+            base_rate = base_rate or rate
+            self.logger.info(
+                f"{jobs} threads: {output['recoveries']} recoveries in "
+                f"{output['seconds']:.2f} s, {rate:.1f} recoveries/s, "
+                f"{output['states'] / max(output['seconds'], 1e-6) / 1e6:.2f} Mstates/s, "
+                f"x{rate / base_rate:.2f}"
+            )
+
+            if jobs >= self.args.jobs:
+                break
+            jobs = min(jobs * 2, self.args.jobs)
+
+        if failed:
+            self.logger.error(f"{failed} keys don't match")
+            return 1
+        return 0
+
+
+if __name__ == "__main__":
+    Main()()
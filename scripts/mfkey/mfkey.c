@@ -0,0 +1,839 @@
+/**
+ * @file mfkey.c
+ * Host MIFARE Classic key recovery from nonces captured by the nfc app.
+ *
+ * Two kinds of log lines are accepted, other lines are ignored:
+ *
+ * - MFKey32 nonce pairs, as written to .mfkey32.log by mfkey32_logger:
+ *   "Sec 1 key A cuid 2a234f80 nt0 55721809 nr0 ce9985f6 ar0 772f55be
+ *    nt1 a27173f2 nr1 e386b505 ar1 5fa65203"
+ *   The key is recovered from a single line.
+ *
+ * - Nested nonces, as returned by mf_classic_poller_get_nt_nested() after an
+ *   authentication with a known key:
+ *   "Nested sec 4 key B cuid 2a234f80 nt 01200145 nt_enc c6d2c4a9 par 5 dist 160"
+ *   nt is the plain tag nonce of the known key authentication, nt_enc and par
+ *   are the encrypted nonce and its 4 parity bits (first byte in the MSB) of
+ *   the nested one, dist is the expected PRNG distance between them. Every
+ *   line gives a list of candidate keys, lines of the same cuid, sector and
+ *   key type are intersected until one key is left.
+ *
+ * State recovery follows crapto1 by bla: the 32 bit keystream is split into
+ * odd and even bits, both halves of the LFSR are extended bit by bit from the
+ * 2^20 filter inputs, candidate lists are sorted and joined on their feedback
+ * contribution, and matching states are rolled back to the key.
+ *
+ * Work is split into one task per MFKey32 line or per nested nonce candidate
+ * and spread over worker threads. Driven by scripts/mfkey.py.
+ */
+#include <furi.h>
+#include <getopt.h>
+#include <inttypes.h>
+#include <pthread.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <nfc/helpers/crypto1.h>
+
+#define MFKEY_LF_POLY_ODD  (0x29CE5C)
+#define MFKEY_LF_POLY_EVEN (0x870804)
+
+#define MFKEY_BEBIT(x, n) FURI_BIT(x, (n) ^ 24)
+
+// Sizes of the crapto1 working tables
+#define MFKEY_TABLE_SIZE  (1UL << 21)
+#define MFKEY_STATES_SIZE (1UL << 18)
+
+#define MFKEY_LINE_SIZE (256)
+
+#define MFKEY_NESTED_TOLERANCE_DEFAULT (16)
+#define MFKEY_CANDIDATES_PRINT_MAX     (8)
+
+typedef enum {
+    MfkeyJobTypeMfkey32,
+    MfkeyJobTypeNested,
+} MfkeyJobType;
+
+typedef struct {
+    uint64_t* keys;
+    size_t count;
+    size_t capacity;
+} MfkeyKeyList;
+
+typedef struct {
+    MfkeyJobType type;
+    size_t line;
+    uint8_t sector;
+    char key_type;
+    uint32_t cuid;
+    union {
+        struct {
+            uint32_t nt0, nr0, ar0;
+            uint32_t nt1, nr1, ar1;
+        } mfkey32;
+        struct {
+            uint32_t nt;
+            uint32_t nt_enc;
+            uint32_t par;
+            uint32_t dist;
+        } nested;
+    };
+
+    // Results
+    bool is_found;
+    uint64_t key;
+    MfkeyKeyList candidates;
+} MfkeyJob;
+
+typedef struct {
+    MfkeyJob* job;
+    uint32_t nt;
+    MfkeyKeyList keys;
+} MfkeyTask;
+
+typedef struct {
+    uint32_t* odd;
+    uint32_t* even;
+    uint32_t* scratch;
+    Crypto1* states;
+    size_t states_count;
+    uint64_t states_total;
+} MfkeyWorkspace;
+
+typedef struct {
+    MfkeyTask* tasks;
+    size_t tasks_count;
+    size_t next_task;
+    uint64_t states_total;
+    pthread_mutex_t mutex;
+} MfkeyPool;
+
+// Filter output for every 20 bit input, and lists of inputs for each output
+static uint32_t mfkey_filter_table[(1UL << 20) / 32];
+static uint32_t* mfkey_filter_inputs[2];
+static size_t mfkey_filter_inputs_count[2];
+
+static inline uint32_t mfkey_filter(uint32_t x) {
+    x &= 0xfffff;
+    return FURI_BIT(mfkey_filter_table[x / 32], x % 32);
+}
+
+static void mfkey_filter_init(void) {
+    mfkey_filter_inputs[0] = malloc((1UL << 20) * sizeof(uint32_t));
+    mfkey_filter_inputs[1] = malloc((1UL << 20) * sizeof(uint32_t));
+
+    // Inputs are listed in descending order, like crapto1 does
+    for(int32_t x = (1 << 20) - 1; x >= 0; --x) {
+        uint32_t f;
+        f = 0xf22c0 >> (x & 0xf) & 16;
+        f |= 0x6c9c0 >> (x >> 4 & 0xf) & 8;
+        f |= 0x3c8b0 >> (x >> 8 & 0xf) & 4;
+        f |= 0x1e458 >> (x >> 12 & 0xf) & 2;
+        f |= 0x0d938 >> (x >> 16 & 0xf) & 1;
+        uint32_t out = FURI_BIT(0xEC57E80A, f);
+        mfkey_filter_table[x / 32] |= out << (x % 32);
+        mfkey_filter_inputs[out][mfkey_filter_inputs_count[out]++] = x;
+    }
+}
+
+static inline uint32_t mfkey_parity(uint32_t x) {
+    return __builtin_parity(x);
+}
+
+static inline uint32_t mfkey_odd_parity8(uint32_t x) {
+    return !mfkey_parity(x & 0xff);
+}
+
+// Partial feedback contributions of the extended state are kept in the top byte
+static inline void mfkey_update_contribution(uint32_t* item, uint32_t mask1, uint32_t mask2) {
+    uint32_t p = *item >> 25;
+    p = p << 1 | mfkey_parity(*item & mask1);
+    p = p << 1 | mfkey_parity(*item & mask2);
+    *item = p << 24 | (*item & 0xffffff);
+}
+
+// Extend every state of the table by one bit that produces the keystream bit,
+// states that can't are dropped and states that fit both ways are split
+static void mfkey_extend_table_simple(uint32_t* tbl, uint32_t** end, uint32_t bit) {
+    for(*tbl <<= 1; tbl <= *end; *++tbl <<= 1) {
+        uint32_t out = mfkey_filter(*tbl);
+        if(out ^ mfkey_filter(*tbl | 1)) {
+            *tbl |= out ^ bit;
+        } else if(out == bit) {
+            *++*end = *++tbl;
+            *tbl = tbl[-1] | 1;
+        } else {
+            *tbl-- = *(*end)--;
+        }
+    }
+}
+
+static void mfkey_extend_table(
+    uint32_t* tbl,
+    uint32_t** end,
+    uint32_t bit,
+    uint32_t mask1,
+    uint32_t mask2,
+    uint32_t in) {
+    in <<= 24;
+    for(*tbl <<= 1; tbl <= *end; *++tbl <<= 1) {
+        uint32_t out = mfkey_filter(*tbl);
+        if(out ^ mfkey_filter(*tbl | 1)) {
+            *tbl |= out ^ bit;
+            mfkey_update_contribution(tbl, mask1, mask2);
+            *tbl ^= in;
+        } else if(out == bit) {
+            *++*end = tbl[1];
+            tbl[1] = tbl[0] | 1;
+            mfkey_update_contribution(tbl, mask1, mask2);
+            *tbl++ ^= in;
+            mfkey_update_contribution(tbl, mask1, mask2);
+            *tbl ^= in;
+        } else {
+            *tbl-- = *(*end)--;
+        }
+    }
+}
+
+// Order items by the contribution byte, the join doesn't need any other order
+static void mfkey_sort(uint32_t* scratch, uint32_t* head, uint32_t* tail) {
+    size_t count = tail - head + 1;
+    size_t offsets[256] = {};
+
+    for(size_t i = 0; i < count; i++) {
+        offsets[head[i] >> 24]++;
+    }
+    for(size_t i = 0, offset = 0; i < COUNT_OF(offsets); i++) {
+        size_t size = offsets[i];
+        offsets[i] = offset;
+        offset += size;
+    }
+    for(size_t i = 0; i < count; i++) {
+        scratch[offsets[head[i] >> 24]++] = head[i];
+    }
+    memcpy(head, scratch, count * sizeof(uint32_t));
+}
+
+// First item of the range with the same contribution byte as the last one
+static uint32_t* mfkey_group_head(uint32_t* head, uint32_t* tail) {
+    uint32_t contribution = *tail >> 24;
+    while(head < tail) {
+        uint32_t* mid = head + (tail - head) / 2;
+        if((*mid >> 24) < contribution) {
+            head = mid + 1;
+        } else {
+            tail = mid;
+        }
+    }
+    return head;
+}
+
+static void mfkey_recover(
+    MfkeyWorkspace* workspace,
+    uint32_t* o_head,
+    uint32_t* o_tail,
+    uint32_t oks,
+    uint32_t* e_head,
+    uint32_t* e_tail,
+    uint32_t eks,
+    int rem,
+    uint32_t in) {
+    if(rem == -1) {
+        for(uint32_t* e = e_head; e <= e_tail; ++e) {
+            *e = *e << 1 ^ mfkey_parity(*e & MFKEY_LF_POLY_EVEN) ^ !!(in & 4);
+            for(uint32_t* o = o_head; o <= o_tail; ++o) {
+                if(workspace->states_count == MFKEY_STATES_SIZE) return;
+                Crypto1* state = &workspace->states[workspace->states_count++];
+                state->even = *o;
+                state->odd = *e ^ mfkey_parity(*o & MFKEY_LF_POLY_ODD);
+            }
+        }
+        return;
+    }
+
+    for(uint32_t i = 0; i < 4 && rem--; i++) {
+        oks >>= 1;
+        eks >>= 1;
+        in >>= 2;
+        mfkey_extend_table(
+            o_head, &o_tail, oks & 1, MFKEY_LF_POLY_EVEN << 1 | 1, MFKEY_LF_POLY_ODD << 1, 0);
+        if(o_head > o_tail) return;
+
+        mfkey_extend_table(
+            e_head, &e_tail, eks & 1, MFKEY_LF_POLY_ODD, MFKEY_LF_POLY_EVEN << 1 | 1, in & 3);
+        if(e_head > e_tail) return;
+    }
+
+    mfkey_sort(workspace->scratch, o_head, o_tail);
+    mfkey_sort(workspace->scratch, e_head, e_tail);
+
+    // Groups are taken from the end, extending a group overwrites the ones after it
+    while(o_tail >= o_head && e_tail >= e_head) {
+        uint32_t o_contribution = *o_tail >> 24;
+        uint32_t e_contribution = *e_tail >> 24;
+        uint32_t* o = mfkey_group_head(o_head, o_tail);
+        uint32_t* e = mfkey_group_head(e_head, e_tail);
+        if(o_contribution == e_contribution) {
+            mfkey_recover(workspace, o, o_tail, oks, e, e_tail, eks, rem, in);
+            o_tail = o - 1;
+            e_tail = e - 1;
+        } else if(o_contribution > e_contribution) {
+            o_tail = o - 1;
+        } else {
+            e_tail = e - 1;
+        }
+    }
+}
+
+// Find all LFSR states that produce 32 bits of keystream while clocking in the input word.
+// The states are left in the workspace, as they are after the last keystream bit.
+static void mfkey_lfsr_recovery32(MfkeyWorkspace* workspace, uint32_t ks, uint32_t in) {
+    uint32_t oks = 0;
+    uint32_t eks = 0;
+
+    for(int i = 31; i >= 0; i -= 2) {
+        oks = oks << 1 | MFKEY_BEBIT(ks, i);
+    }
+    for(int i = 30; i >= 0; i -= 2) {
+        eks = eks << 1 | MFKEY_BEBIT(ks, i);
+    }
+
+    // Tables start one item in, so that an empty tail can point in front of the head
+    uint32_t* odd_head = workspace->odd + 1;
+    uint32_t* even_head = workspace->even + 1;
+    uint32_t* odd_tail = odd_head - 1;
+    uint32_t* even_tail = even_head - 1;
+
+    memcpy(odd_head, mfkey_filter_inputs[oks & 1], mfkey_filter_inputs_count[oks & 1] * 4);
+    odd_tail += mfkey_filter_inputs_count[oks & 1];
+    memcpy(even_head, mfkey_filter_inputs[eks & 1], mfkey_filter_inputs_count[eks & 1] * 4);
+    even_tail += mfkey_filter_inputs_count[eks & 1];
+
+    for(size_t i = 0; i < 4; i++) {
+        mfkey_extend_table_simple(odd_head, &odd_tail, (oks >>= 1) & 1);
+        mfkey_extend_table_simple(even_head, &even_tail, (eks >>= 1) & 1);
+    }
+
+    workspace->states_count = 0;
+    in = (in >> 16 & 0xff) | (in << 16) | (in & 0xff00);
+    mfkey_recover(workspace, odd_head, odd_tail, oks, even_head, even_tail, eks, 11, in << 1);
+    workspace->states_total += workspace->states_count;
+}
+
+static uint8_t mfkey_lfsr_rollback_bit(Crypto1* state, uint32_t in, uint32_t fb) {
+    state->odd &= 0xffffff;
+    FURI_SWAP(state->odd, state->even);
+
+    uint32_t out = state->even & 1;
+    out ^= MFKEY_LF_POLY_EVEN & (state->even >>= 1);
+    out ^= MFKEY_LF_POLY_ODD & state->odd;
+    out ^= !!in;
+    uint8_t ret = mfkey_filter(state->odd);
+    out ^= ret & !!fb;
+
+    state->even |= mfkey_parity(out) << 23;
+    return ret;
+}
+
+static uint32_t mfkey_lfsr_rollback_word(Crypto1* state, uint32_t in, uint32_t fb) {
+    uint32_t ret = 0;
+    for(int i = 31; i >= 0; --i) {
+        ret |= (uint32_t)mfkey_lfsr_rollback_bit(state, MFKEY_BEBIT(in, i), fb) << (i ^ 24);
+    }
+    return ret;
+}
+
+static uint64_t mfkey_get_lfsr(const Crypto1* state) {
+    uint64_t lfsr = 0;
+    for(int i = 23; i >= 0; --i) {
+        lfsr = lfsr << 1 | FURI_BIT(state->odd, i ^ 3);
+        lfsr = lfsr << 1 | FURI_BIT(state->even, i ^ 3);
+    }
+    return lfsr;
+}
+
+static void mfkey_key_list_add(MfkeyKeyList* list, uint64_t key) {
+    if(list->count == list->capacity) {
+        list->capacity = MAX(list->capacity * 2, 64UL);
+        list->keys = realloc(list->keys, list->capacity * sizeof(uint64_t));
+    }
+    list->keys[list->count++] = key;
+}
+
+static int mfkey_key_compare(const void* a, const void* b) {
+    uint64_t x = *(const uint64_t*)a;
+    uint64_t y = *(const uint64_t*)b;
+    return (x > y) - (x < y);
+}
+
+static void mfkey_key_list_sort(MfkeyKeyList* list) {
+    if(list->count == 0) return;
+
+    qsort(list->keys, list->count, sizeof(uint64_t), mfkey_key_compare);
+    size_t unique = 1;
+    for(size_t i = 1; i < list->count; i++) {
+        if(list->keys[i] != list->keys[unique - 1]) {
+            list->keys[unique++] = list->keys[i];
+        }
+    }
+    list->count = unique;
+}
+
+// Both lists must be sorted, the result is left in the first one
+static void mfkey_key_list_intersect(MfkeyKeyList* list, const MfkeyKeyList* other) {
+    size_t count = 0;
+    for(size_t i = 0, j = 0; i < list->count && j < other->count;) {
+        if(list->keys[i] < other->keys[j]) {
+            i++;
+        } else if(list->keys[i] > other->keys[j]) {
+            j++;
+        } else {
+            list->keys[count++] = list->keys[i];
+            i++;
+            j++;
+        }
+    }
+    list->count = count;
+}
+
+static void mfkey_solve_mfkey32(MfkeyWorkspace* workspace, MfkeyTask* task) {
+    MfkeyJob* job = task->job;
+    uint32_t ks2 = job->mfkey32.ar0 ^ prng_successor(job->mfkey32.nt0, 64);
+
+    mfkey_lfsr_recovery32(workspace, ks2, 0);
+
+    for(size_t i = 0; i < workspace->states_count; i++) {
+        Crypto1* state = &workspace->states[i];
+        mfkey_lfsr_rollback_word(state, 0, 0);
+        mfkey_lfsr_rollback_word(state, job->mfkey32.nr0, 1);
+        mfkey_lfsr_rollback_word(state, job->cuid ^ job->mfkey32.nt0, 0);
+        uint64_t key = mfkey_get_lfsr(state);
+
+        // Check the key against the second nonce
+        crypto1_word(state, job->cuid ^ job->mfkey32.nt1, 0);
+        crypto1_word(state, job->mfkey32.nr1, 1);
+        uint32_t ar1 = crypto1_word(state, 0, 0) ^ prng_successor(job->mfkey32.nt1, 64);
+        if(ar1 == job->mfkey32.ar1) {
+            mfkey_key_list_add(&task->keys, key);
+            break;
+        }
+    }
+}
+
+static void mfkey_solve_nested(MfkeyWorkspace* workspace, MfkeyTask* task) {
+    uint32_t in = task->job->cuid ^ task->nt;
+    mfkey_lfsr_recovery32(workspace, task->job->nested.nt_enc ^ task->nt, in);
+
+    for(size_t i = 0; i < workspace->states_count; i++) {
+        Crypto1* state = &workspace->states[i];
+        mfkey_lfsr_rollback_word(state, in, 0);
+        mfkey_key_list_add(&task->keys, mfkey_get_lfsr(state));
+    }
+}
+
+static void* mfkey_worker(void* context) {
+    MfkeyPool* pool = context;
+    MfkeyWorkspace workspace = {
+        .odd = malloc((MFKEY_TABLE_SIZE + 1) * sizeof(uint32_t)),
+        .even = malloc((MFKEY_TABLE_SIZE + 1) * sizeof(uint32_t)),
+        .scratch = malloc(MFKEY_TABLE_SIZE * sizeof(uint32_t)),
+        .states = malloc(MFKEY_STATES_SIZE * sizeof(Crypto1)),
+    };
+
+    while(true) {
+        size_t index = __atomic_fetch_add(&pool->next_task, 1, __ATOMIC_RELAXED);
+        if(index >= pool->tasks_count) break;
+
+        MfkeyTask* task = &pool->tasks[index];
+        if(task->job->type == MfkeyJobTypeMfkey32) {
+            mfkey_solve_mfkey32(&workspace, task);
+        } else {
+            mfkey_solve_nested(&workspace, task);
+        }
+    }
+
+    pthread_mutex_lock(&pool->mutex);
+    pool->states_total += workspace.states_total;
+    pthread_mutex_unlock(&pool->mutex);
+
+    free(workspace.states);
+    free(workspace.scratch);
+    free(workspace.even);
+    free(workspace.odd);
+    return NULL;
+}
+
+static bool mfkey_parse_line(const char* line, size_t line_num, MfkeyJob* job) {
+    memset(job, 0, sizeof(MfkeyJob));
+    job->line = line_num;
+
+    int parsed = sscanf(
+        line,
+        "Sec %" SCNu8 " key %c cuid %" SCNx32 " nt0 %" SCNx32 " nr0 %" SCNx32 " ar0 %" SCNx32
+        " nt1 %" SCNx32 " nr1 %" SCNx32 " ar1 %" SCNx32,
+        &job->sector,
+        &job->key_type,
+        &job->cuid,
+        &job->mfkey32.nt0,
+        &job->mfkey32.nr0,
+        &job->mfkey32.ar0,
+        &job->mfkey32.nt1,
+        &job->mfkey32.nr1,
+        &job->mfkey32.ar1);
+    if(parsed == 9) {
+        job->type = MfkeyJobTypeMfkey32;
+        return true;
+    }
+
+    parsed = sscanf(
+        line,
+        "Nested sec %" SCNu8 " key %c cuid %" SCNx32 " nt %" SCNx32 " nt_enc %" SCNx32
+        " par %" SCNx32 " dist %" SCNu32,
+        &job->sector,
+        &job->key_type,
+        &job->cuid,
+        &job->nested.nt,
+        &job->nested.nt_enc,
+        &job->nested.par,
+        &job->nested.dist);
+    if(parsed == 7) {
+        job->type = MfkeyJobTypeNested;
+        return true;
+    }
+
+    return false;
+}
+
+static bool mfkey_load(const char* path, MfkeyJob** jobs, size_t* count) {
+    FILE* file = strcmp(path, "-") ? fopen(path, "r") : stdin;
+    if(!file) return false;
+
+    char line[MFKEY_LINE_SIZE];
+    size_t line_num = 0;
+    while(fgets(line, sizeof(line), file)) {
+        line_num++;
+        MfkeyJob job;
+        if(!mfkey_parse_line(line, line_num, &job)) continue;
+        *jobs = realloc(*jobs, (*count + 1) * sizeof(MfkeyJob));
+        (*jobs)[(*count)++] = job;
+    }
+
+    if(file != stdin) fclose(file);
+    return true;
+}
+
+// Nested nonce candidates are the PRNG outputs around the expected distance that
+// match the parity bits. Parity bits are encrypted with the first keystream bit
+// of the next byte, so the last one can't be checked.
+static bool mfkey_nested_is_valid(const MfkeyJob* job, uint32_t nt) {
+    uint32_t ks = job->nested.nt_enc ^ nt;
+    for(size_t i = 0; i < 3; i++) {
+        uint32_t shift = 24 - i * 8;
+        uint32_t par = FURI_BIT(job->nested.par, 3 - i);
+        if(mfkey_odd_parity8(nt >> shift) != (par ^ FURI_BIT(ks, shift - 8))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static size_t
+    mfkey_make_tasks(MfkeyJob* jobs, size_t jobs_count, uint32_t tolerance, MfkeyTask** tasks) {
+    size_t count = 0;
+    for(size_t i = 0; i < jobs_count; i++) {
+        MfkeyJob* job = &jobs[i];
+        if(job->type == MfkeyJobTypeMfkey32) {
+            *tasks = realloc(*tasks, (count + 1) * sizeof(MfkeyTask));
+            (*tasks)[count++] = (MfkeyTask){.job = job};
+            continue;
+        }
+
+        uint32_t dist_min = job->nested.dist > tolerance ? job->nested.dist - tolerance : 0;
+        uint32_t nt = prng_successor(job->nested.nt, dist_min);
+        for(uint32_t dist = dist_min; dist <= job->nested.dist + tolerance; dist++) {
+            if(mfkey_nested_is_valid(job, nt)) {
+                *tasks = realloc(*tasks, (count + 1) * sizeof(MfkeyTask));
+                (*tasks)[count++] = (MfkeyTask){.job = job, .nt = nt};
+            }
+            nt = prng_successor(nt, 1);
+        }
+    }
+    return count;
+}
+
+static bool mfkey_is_same_key(const MfkeyJob* a, const MfkeyJob* b) {
+    return a->cuid == b->cuid && a->sector == b->sector && a->key_type == b->key_type;
+}
+
+static void mfkey_collect(MfkeyJob* jobs, size_t jobs_count, MfkeyTask* tasks, size_t count) {
+    for(size_t i = 0; i < count; i++) {
+        MfkeyJob* job = tasks[i].job;
+        for(size_t j = 0; j < tasks[i].keys.count; j++) {
+            mfkey_key_list_add(&job->candidates, tasks[i].keys.keys[j]);
+        }
+        free(tasks[i].keys.keys);
+    }
+
+    // Each nested line keeps the keys common with all nested lines before it
+    for(size_t i = 0; i < jobs_count; i++) {
+        MfkeyJob* job = &jobs[i];
+        mfkey_key_list_sort(&job->candidates);
+        if(job->type != MfkeyJobTypeNested) continue;
+
+        for(size_t j = i; j-- > 0;) {
+            if(jobs[j].type == MfkeyJobTypeNested && mfkey_is_same_key(job, &jobs[j])) {
+                mfkey_key_list_intersect(&job->candidates, &jobs[j].candidates);
+                break;
+            }
+        }
+    }
+
+    for(size_t i = 0; i < jobs_count; i++) {
+        MfkeyJob* job = &jobs[i];
+        job->is_found = job->candidates.count == 1;
+        if(job->is_found) job->key = job->candidates.keys[0];
+    }
+}
+
+static double mfkey_time(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static void mfkey_print(const MfkeyJob* jobs, size_t jobs_count, bool is_json) {
+    if(is_json) printf("{\"results\": [");
+
+    size_t printed = 0;
+    for(size_t i = 0; i < jobs_count; i++) {
+        const MfkeyJob* job = &jobs[i];
+        // Only the last nested line of a key has the complete intersection
+        bool is_last = true;
+        for(size_t j = i + 1; j < jobs_count && job->type == MfkeyJobTypeNested; j++) {
+            if(jobs[j].type == MfkeyJobTypeNested && mfkey_is_same_key(job, &jobs[j])) {
+                is_last = false;
+                break;
+            }
+        }
+        if(!is_last) continue;
+
+        const char* type = job->type == MfkeyJobTypeMfkey32 ? "mfkey32" : "nested";
+        if(is_json) {
+            printf(
+                "%s{\"line\": %zu, \"type\": \"%s\", \"cuid\": \"%08" PRIx32
+                "\", \"sector\": %u, \"key_type\": \"%c\", \"key\": ",
+                printed++ ? ", " : "",
+                job->line,
+                type,
+                job->cuid,
+                job->sector,
+                job->key_type);
+            if(job->is_found) {
+                printf("\"%012" PRIx64 "\"", job->key);
+            } else {
+                printf("null");
+            }
+            printf(", \"candidates\": %zu}", job->candidates.count);
+        } else if(job->is_found) {
+            printf(
+                "%s cuid %08" PRIx32 " sec %u key %c: %012" PRIx64 "\n",
+                type,
+                job->cuid,
+                job->sector,
+                job->key_type,
+                job->key);
+        } else {
+            printf(
+                "%s cuid %08" PRIx32 " sec %u key %c: not found, %zu candidates (line %zu)\n",
+                type,
+                job->cuid,
+                job->sector,
+                job->key_type,
+                job->candidates.count,
+                job->line);
+            // A few candidates left by nested lines are still worth trying on the card
+            if(job->candidates.count <= MFKEY_CANDIDATES_PRINT_MAX) {
+                for(size_t j = 0; j < job->candidates.count; j++) {
+                    printf("  %012" PRIx64 "\n", job->candidates.keys[j]);
+                }
+            }
+        }
+    }
+}
+
+static uint64_t mfkey_random_state = 0x9E3779B97F4A7C15ULL;
+
+static uint64_t mfkey_random(void) {
+    mfkey_random_state ^= mfkey_random_state << 13;
+    mfkey_random_state ^= mfkey_random_state >> 7;
+    mfkey_random_state ^= mfkey_random_state << 17;
+    return mfkey_random_state;
+}
+
+// Emulate a reader and a tag with a random key to produce log lines with known keys
+static void mfkey_generate(size_t count, uint32_t seed) {
+    mfkey_random_state ^= seed;
+    Crypto1 crypto;
+
+    for(size_t i = 0; i < count; i++) {
+        uint64_t key = mfkey_random() & 0xffffffffffffULL;
+        uint32_t cuid = mfkey_random();
+        uint8_t sector = mfkey_random() % 16;
+        char key_type = (mfkey_random() & 1) ? 'B' : 'A';
+        printf("# key %012" PRIx64 "\n", key);
+
+        uint32_t nt[2], nr[2], ar[2];
+        for(size_t j = 0; j < 2; j++) {
+            nt[j] = mfkey_random();
+            uint32_t nr_plain = mfkey_random();
+            crypto1_init(&crypto, key);
+            crypto1_word(&crypto, cuid ^ nt[j], 0);
+            nr[j] = crypto1_word(&crypto, nr_plain, 0) ^ nr_plain;
+            ar[j] = crypto1_word(&crypto, 0, 0) ^ prng_successor(nt[j], 64);
+        }
+        printf(
+            "Sec %u key %c cuid %08" PRIx32 " nt0 %08" PRIx32 " nr0 %08" PRIx32 " ar0 %08" PRIx32
+            " nt1 %08" PRIx32 " nr1 %08" PRIx32 " ar1 %08" PRIx32 "\n",
+            sector,
+            key_type,
+            cuid,
+            nt[0],
+            nr[0],
+            ar[0],
+            nt[1],
+            nr[1],
+            ar[1]);
+
+        // Two nested nonces of the same key
+        for(size_t j = 0; j < 2; j++) {
+            uint32_t nt_known = mfkey_random();
+            uint32_t dist = 100 + mfkey_random() % 500;
+            uint32_t nt_plain = prng_successor(nt_known, dist);
+            crypto1_init(&crypto, key);
+            uint32_t ks = crypto1_word(&crypto, cuid ^ nt_plain, 0);
+            uint32_t par = 0;
+            for(size_t k = 0; k < 4; k++) {
+                uint32_t ks_bit = k < 3 ? FURI_BIT(ks, 16 - k * 8) : crypto1_bit(&crypto, 0, 0);
+                par = par << 1 | (mfkey_odd_parity8(nt_plain >> (24 - k * 8)) ^ ks_bit);
+            }
+            printf(
+                "Nested sec %u key %c cuid %08" PRIx32 " nt %08" PRIx32 " nt_enc %08" PRIx32
+                " par %" PRIx32 " dist %" PRIu32 "\n",
+                (sector + 1) % 16,
+                key_type,
+                cuid,
+                nt_known,
+                nt_plain ^ ks,
+                par,
+                dist);
+        }
+    }
+}
+
+static void mfkey_usage(const char* name) {
+    fprintf(
+        stderr,
+        "Usage: %s [-j threads] [-t tolerance] [-J] log...\n"
+        "       %s -g count [-s seed]\n"
+        "  -j  worker threads, default is the number of CPUs\n"
+        "  -t  nested PRNG distance tolerance, default %d\n"
+        "  -J  print JSON with results and throughput\n"
+        "  -g  print generated nonces with known keys\n",
+        name,
+        name,
+        MFKEY_NESTED_TOLERANCE_DEFAULT);
+}
+
+int main(int argc, char** argv) {
+    size_t threads_count = sysconf(_SC_NPROCESSORS_ONLN);
+    uint32_t tolerance = MFKEY_NESTED_TOLERANCE_DEFAULT;
+    size_t generate = 0;
+    uint32_t seed = 0;
+    bool is_json = false;
+
+    int opt;
+    while((opt = getopt(argc, argv, "j:t:Jg:s:h")) != -1) {
+        if(opt == 'j') {
+            threads_count = strtoul(optarg, NULL, 0);
+        } else if(opt == 't') {
+            tolerance = strtoul(optarg, NULL, 0);
+        } else if(opt == 'J') {
+            is_json = true;
+        } else if(opt == 'g') {
+            generate = strtoul(optarg, NULL, 0);
+        } else if(opt == 's') {
+            seed = strtoul(optarg, NULL, 0);
+        } else {
+            mfkey_usage(argv[0]);
+            return 1;
+        }
+    }
+
+    if(generate) {
+        mfkey_generate(generate, seed);
+        return 0;
+    }
+
+    if(optind >= argc || threads_count == 0) {
+        mfkey_usage(argv[0]);
+        return 1;
+    }
+
+    MfkeyJob* jobs = NULL;
+    size_t jobs_count = 0;
+    for(int i = optind; i < argc; i++) {
+        if(!mfkey_load(argv[i], &jobs, &jobs_count)) {
+            fprintf(stderr, "Failed to open %s\n", argv[i]);
+            return 1;
+        }
+    }
+
+    mfkey_filter_init();
+
+    MfkeyPool pool = {.mutex = PTHREAD_MUTEX_INITIALIZER};
+    pool.tasks_count = mfkey_make_tasks(jobs, jobs_count, tolerance, &pool.tasks);
+    threads_count = MIN(threads_count, MAX(pool.tasks_count, 1UL));
+
+    double start = mfkey_time();
+    pthread_t* threads = malloc(threads_count * sizeof(pthread_t));
+    for(size_t i = 0; i < threads_count; i++) {
+        pthread_create(&threads[i], NULL, mfkey_worker, &pool);
+    }
+    for(size_t i = 0; i < threads_count; i++) {
+        pthread_join(threads[i], NULL);
+    }
+    double elapsed = mfkey_time() - start;
+
+    mfkey_collect(jobs, jobs_count, pool.tasks, pool.tasks_count);
+    mfkey_print(jobs, jobs_count, is_json);
+
+    if(is_json) {
+        printf(
+            "], \"threads\": %zu, \"recoveries\": %zu, \"states\": %" PRIu64
+            ", \"seconds\": %.3f}\n",
+            threads_count,
+            pool.tasks_count,
+            pool.states_total,
+            elapsed);
+    } else {
+        fprintf(
+            stderr,
+            "%zu recoveries, %" PRIu64 " states in %.2f s on %zu threads, %.1f recoveries/s\n",
+            pool.tasks_count,
+            pool.states_total,
+            elapsed,
+            threads_count,
+            elapsed > 0 ? pool.tasks_count / elapsed : 0);
+    }
+
+    for(size_t i = 0; i < jobs_count; i++) {
+        free(jobs[i].candidates.keys);
+    }
+    free(jobs);
+    free(pool.tasks);
+    free(mfkey_filter_inputs[0]);
+    free(mfkey_filter_inputs[1]);
+    free(threads);
+
+    return 0;
+}
@@ -0,0 +1,47 @@
+/**
+ * @file furi.h
+ * Minimal host replacement of furi for building Crypto1 with the system
+ * compiler. Only what lib/nfc/helpers/crypto1.c, lib/nfc/helpers/nfc_util.c,
+ * lib/toolbox/bit_buffer.c and lib/bit_lib use is provided.
+ */
+#pragma once
+
+#include <assert.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Firmware allocator returns zeroed memory and never fails
+#define malloc(size) calloc(1, size)
+
+#define furi_check(...)  assert(__VA_ARGS__)
+#define furi_assert(...) assert(__VA_ARGS__)
+#define furi_crash(...)  abort()
+
+#ifndef UNUSED
+#define UNUSED(x) (void)(x)
+#endif
+
+#ifndef COUNT_OF
+#define COUNT_OF(x) (sizeof(x) / sizeof(x[0]))
+#endif
+
+#ifndef MIN
+#define MIN(a, b) ((a) < (b) ? (a) : (b))
+#endif
+
+#ifndef MAX
+#define MAX(a, b) ((a) > (b) ? (a) : (b))
+#endif
+
+#define FURI_BIT(x, n) (((x) >> (n)) & 1)
+
+#define FURI_SWAP(x, y)     \
+    do {                    \
+        typeof(x) SWAP = x; \
+        x = y;              \
+        y = SWAP;           \
+    } while(0)
@@ -0,0 +1,224 @@
+#!/usr/bin/env python3
+
+import json
+import os
+import subprocess
+from concurrent.futures import ThreadPoolExecutor
+
+from flipper.app import App
+
+ROOT_DIR = os.path.abspath(os.path.join(os.path.dirname(__file__), ".."))
+
+SOURCES = [
+    "scripts/sd_cache_sim/sd_cache_sim.c",
+    "targets/f7/fatfs/sector_cache.c",
+    "lib/fatfs/ff.c",
+    "lib/fatfs/option/unicode.c",
+]
+
+INCLUDES = [
+    "scripts/sd_cache_sim/stubs",
+    "targets/f7/fatfs",
+    "lib/fatfs",
+]
+
+IMAGE_SOURCE_DIR = "applications/debug/unit_tests/resources"
+IMAGE_FILE = "image.img"
+MANIFEST_FILE = "image.txt"
+
+PHASES = ["mount", "browse", "read", "write", "unmount"]
+
+
+class Main(App):
+    def init(self):
+        self.subparsers = self.parser.add_subparsers(help="sub-command help")
+
+        self.parser_build = self.subparsers.add_parser(
+            "build", help="Build host simulation binary"
+        )
+        self._add_build_args(self.parser_build)
+        self.parser_build.set_defaults(func=self.build)
+
+        self.parser_run = self.subparsers.add_parser(
+            "run", help="Run FatFs workload on a disk image for several cache sizes"
+        )
+        self._add_build_args(self.parser_run)
+        self.parser_run.add_argument(
+            "image",
+            nargs="?",
+            help="FAT or exFAT disk image, e.g. a dump of an SD card, it is never "
+            f"modified; default is an image created from {IMAGE_SOURCE_DIR}",
+        )
+        self.parser_run.add_argument(
+            "-c",
+            "--create",
+            default=os.path.join(ROOT_DIR, IMAGE_SOURCE_DIR),
+            metavar="DIR",
+            help="Directory copied to the created image",
+        )
+        self.parser_run.add_argument(
+            "-s",
+            "--size",
+            type=int,
+            default=256,
+            help="Created image size in megabytes",
+        )
+        self.parser_run.add_argument(
+            "-n",
+            "--sectors",
+            default="0,8,16,32,64",
+            help="Comma separated cache sizes in sectors, 0 is no cache",
+        )
+        self.parser_run.add_argument(
+            "-w",
+            "--write-back",
+            action="store_true",
+            help="Enable write-back, as FURI_HAL_SD_CACHE_WRITE_BACK does",
+        )
+        self.parser_run.add_argument(
+            "-p",
+            "--phases",
+            action="store_true",
+            help="Print counters of every workload phase, not only totals",
+        )
+        self.parser_run.add_argument(
+            "-j", "--jobs", type=int, default=os.cpu_count(), help="Parallel jobs"
+        )
+        self.parser_run.set_defaults(func=self.run)
+
+    def _add_build_args(self, parser):
+        parser.add_argument(
+            "-o",
+            "--output",
+            default=os.path.join(ROOT_DIR, "build", "sd_cache_sim"),
+            help="Build directory",
+        )
+        parser.add_argument(
+            "--cc", default=os.environ.get("CC", "cc"), help="Host C compiler"
+        )
+
+    def _build(self):
+        os.makedirs(self.args.output, exist_ok=True)
+        binary = os.path.join(self.args.output, "sd_cache_sim")
+
+        command = [self.args.cc, "-std=gnu17", "-O2", "-g", "-o", binary]
+        command.extend(f"-I{os.path.join(ROOT_DIR, path)}" for path in INCLUDES)
+        command.extend(os.path.join(ROOT_DIR, source) for source in SOURCES)
+
+        self.logger.debug(" ".join(command))
+        process = subprocess.run(command, capture_output=True, text=True)
+        if process.returncode != 0:
+            self.logger.error(f"Build failed:\n{process.stderr}")
+            return None
+
+        return binary
+
+    def build(self):
+        binary = self._build()
+        if not binary:
+            return 1
+
+        self.logger.info(f"Built {binary}")
+        return 0
+
+    def _write_manifest(self, path):
+        # Image paths are relative to the copied directory and must not contain spaces
+        with open(path, "w") as manifest:
+            for root, directories, files in os.walk(self.args.create):
+                directories.sort()
+                relative = os.path.relpath(root, self.args.create)
+                image_root = ""
+                if relative != ".":
+                    image_root = "/" + relative.replace(os.sep, "/")
+                for name in directories:
+                    manifest.write(f"d {image_root}/{name}\n")
+                for name in sorted(files):
+                    host_path = os.path.join(root, name)
+                    manifest.write(f"f {image_root}/{name} {host_path}\n")
+
+    def _create_image(self, binary):
+        image = os.path.join(self.args.output, IMAGE_FILE)
+        manifest = os.path.join(self.args.output, MANIFEST_FILE)
+        self._write_manifest(manifest)
+        command = [binary, "-c", manifest, "-s", str(self.args.size), image]
+        process = subprocess.run(command, capture_output=True, text=True)
+        if process.returncode != 0:
+            self.logger.error(f"Image creation failed: {process.stderr.strip()}")
+            return None
+
+        self.logger.info(f"Created {image} from {self.args.create}")
+        return image
+
+    def _simulate(self, binary, image, sectors):
+        command = [binary, "-n", str(sectors)]
+        if self.args.write_back:
+            command.append("-w")
+        command.append(image)
+
+        process = subprocess.run(command, capture_output=True, text=True)
+        if process.returncode != 0:
+            return {"cache_size": sectors, "error": process.stderr.strip()}
+        return json.loads(process.stdout)
+
+    def _print(self, name, stats):
+        lookups = stats["hits"] + stats["misses"]
+        hit_rate = stats["hits"] / lookups * 100 if lookups else 0
+        self.logger.info(
+            f"{name:<20} {stats['hits']:>8} {stats['misses']:>8} {hit_rate:>6.1f}% "
+            f"{stats['evictions']:>9} {stats['writes']:>7} {stats['write_backs']:>7} "
+            f"{stats['card_reads']:>7} {stats['card_read_blocks']:>8} "
+            f"{stats['card_writes']:>7} {stats['card_write_blocks']:>8}"
+        )
+
+    def run(self):
+        binary = self._build()
+        if not binary:
+            return 1
+
+        try:
+            sizes = [int(size) for size in self.args.sectors.split(",")]
+        except ValueError:
+            self.logger.error(f"Invalid cache sizes: {self.args.sectors}")
+            return 1
+        if any(size == 1 or size < 0 for size in sizes):
+            self.logger.error("Cache size is 0 or at least 2 sectors")
+            return 1
+
+        image = self.args.image or self._create_image(binary)
+        if not image:
+            return 1
+
+        with ThreadPoolExecutor(max_workers=self.args.jobs) as executor:
+            results = list(
+                executor.map(lambda size: self._simulate(binary, image, size), sizes)
+            )
+
+        self.logger.info(
+            f"{'Cache':<20} {'Hits':>8} {'Misses':>8} {'Rate':>7} {'Evictions':>9} "
+            f"{'Writes':>7} {'WBacks':>7} {'Reads':>7} {'RBlocks':>8} "
+            f"{'CWrites':>7} {'WBlocks':>8}"
+        )
+        failed = 0
+        for result in results:
+            name = f"{result['cache_size']} sectors"
+            if "error" in result:
+                self.logger.error(f"{name}: {result['error']}")
+                failed += 1
+                continue
+
+            if self.args.phases:
+                for phase in PHASES:
+                    self._print(f"{name} {phase}", result["phases"][phase])
+            self._print(name, result["total"])
+
+        if failed:
+            self.logger.error(f"{failed} of {len(results)} runs failed")
+            return 1
+
+        mode = "write-back" if self.args.write_back else "write-through"
+        self.logger.info(f"{len(results)} cache sizes simulated, {mode}")
+        return 0
+
+
+if __name__ == "__main__":
+    Main()()
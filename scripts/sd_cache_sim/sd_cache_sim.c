@@ -0,0 +1,545 @@
+/**
+ * @file sd_cache_sim.c
+ * Host run of the SD card sector cache (targets/f7/fatfs/sector_cache.c)
+ * under FatFs, with a FAT disk image file in place of the card.
+ *
+ * Card access goes through the same cache calls as furi_hal_sd_read_blocks
+ * and furi_hal_sd_write_blocks. A fixed workload modeled on the firmware runs
+ * in phases and cache and card counters of every phase are printed as one
+ * JSON object. The image is never modified, written sectors are kept in
+ * memory. Driven by scripts/sd_cache_sim.py.
+ *
+ * With -c the image file is created instead: formatted with f_mkfs and filled
+ * with host files from a manifest, one entry per line:
+ *   d path            - directory
+ *   f path host_path  - file
+ */
+#include <furi.h>
+
+#include <stdio.h>
+
+#include <ff.h>
+#include <diskio.h>
+#include <sector_cache.h>
+
+#define SD_CACHE_SIM_SECTOR_SIZE    SECTOR_CACHE_SECTOR_SIZE
+#define SD_CACHE_SIM_OVERLAY_SIZE   (4096U)
+#define SD_CACHE_SIM_PATH_SIZE      (512U)
+#define SD_CACHE_SIM_BROWSE_COUNT   (2U)
+#define SD_CACHE_SIM_READ_SIZE      (512U)
+#define SD_CACHE_SIM_WRITE_FILES    (32U)
+#define SD_CACHE_SIM_WRITE_ROUNDS   (4U)
+#define SD_CACHE_SIM_WRITE_SIZE     (64U)
+#define SD_CACHE_SIM_WRITE_DIR      "/sd_cache_sim"
+#define SD_CACHE_SIM_COPY_SIZE      (4096U)
+#define SD_CACHE_SIM_MKFS_WORK_SIZE (4096U)
+
+typedef struct SdCacheSimSector {
+    uint32_t sector;
+    struct SdCacheSimSector* next;
+    uint8_t data[SD_CACHE_SIM_SECTOR_SIZE];
+} SdCacheSimSector;
+
+typedef struct {
+    uint32_t reads; /*!< card read commands */
+    uint32_t read_blocks; /*!< sectors read from card */
+    uint32_t writes; /*!< card write commands */
+    uint32_t write_blocks; /*!< sectors written to card */
+} SdCacheSimCardStats;
+
+typedef struct {
+    FILE* image;
+    uint32_t sector_count;
+    // Written sectors, NULL when writes go to the image
+    SdCacheSimSector** overlay;
+    // NULL when the card is accessed directly
+    SectorCache* cache;
+    SdCacheSimCardStats card;
+} SdCacheSim;
+
+static SdCacheSim sim;
+
+/******************* Card *******************/
+
+static SdCacheSimSector** sd_cache_sim_overlay_find(uint32_t sector) {
+    SdCacheSimSector** link = &sim.overlay[sector % SD_CACHE_SIM_OVERLAY_SIZE];
+    while(*link && (*link)->sector != sector) {
+        link = &(*link)->next;
+    }
+    return link;
+}
+
+static bool sd_cache_sim_card_read(uint8_t* buff, uint32_t sector, uint32_t count) {
+    if(sector + count > sim.sector_count) return false;
+
+    sim.card.reads++;
+    sim.card.read_blocks += count;
+
+    if(fseek(sim.image, (long)sector * SD_CACHE_SIM_SECTOR_SIZE, SEEK_SET) ||
+       fread(buff, SD_CACHE_SIM_SECTOR_SIZE, count, sim.image) != count) {
+        return false;
+    }
+
+    if(sim.overlay) {
+        for(uint32_t i = 0; i < count; i++) {
+            SdCacheSimSector* written = *sd_cache_sim_overlay_find(sector + i);
+            if(written) {
+                memcpy(&buff[i * SD_CACHE_SIM_SECTOR_SIZE], written->data, sizeof(written->data));
+            }
+        }
+    }
+
+    return true;
+}
+
+static bool sd_cache_sim_card_write(const uint8_t* buff, uint32_t sector, uint32_t count) {
+    if(sector + count > sim.sector_count) return false;
+
+    sim.card.writes++;
+    sim.card.write_blocks += count;
+
+    if(!sim.overlay) {
+        return !fseek(sim.image, (long)sector * SD_CACHE_SIM_SECTOR_SIZE, SEEK_SET) &&
+               fwrite(buff, SD_CACHE_SIM_SECTOR_SIZE, count, sim.image) == count;
+    }
+
+    for(uint32_t i = 0; i < count; i++) {
+        SdCacheSimSector** link = sd_cache_sim_overlay_find(sector + i);
+        if(!*link) {
+            *link = malloc(sizeof(SdCacheSimSector));
+            (*link)->sector = sector + i;
+        }
+        memcpy((*link)->data, &buff[i * SD_CACHE_SIM_SECTOR_SIZE], sizeof((*link)->data));
+    }
+
+    return true;
+}
+
+static bool sd_cache_sim_write_callback(void* context, uint32_t sector, const uint8_t* data) {
+    UNUSED(context);
+    return sd_cache_sim_card_write(data, sector, 1);
+}
+
+/******************* Cache, same as furi_hal_sd.c *******************/
+
+static bool sd_cache_sim_read_blocks(uint8_t* buff, uint32_t sector, uint32_t count) {
+    if(!sim.cache) return sd_cache_sim_card_read(buff, sector, count);
+
+    if(count == 1) {
+        uint8_t* cached_data = sector_cache_get(sim.cache, sector);
+        if(cached_data) {
+            memcpy(buff, cached_data, SD_CACHE_SIM_SECTOR_SIZE);
+            return true;
+        }
+    }
+
+    if(!sd_cache_sim_card_read(buff, sector, count)) return false;
+
+    if(count == 1) {
+        sector_cache_put(sim.cache, sector, buff);
+    } else {
+        sector_cache_apply_dirty(sim.cache, sector, count, buff);
+    }
+
+    return true;
+}
+
+static bool sd_cache_sim_write_blocks(const uint8_t* buff, uint32_t sector, uint32_t count) {
+    if(!sim.cache) return sd_cache_sim_card_write(buff, sector, count);
+
+    if(count == 1 && sector_cache_write(sim.cache, sector, buff)) {
+        return true;
+    }
+
+    bool result = sd_cache_sim_card_write(buff, sector, count);
+    sector_cache_invalidate_range(sim.cache, sector, sector + count - 1);
+
+    return result;
+}
+
+static bool sd_cache_sim_sync(void) {
+    return !sim.cache || sector_cache_flush(sim.cache);
+}
+
+/******************* FatFs disk interface *******************/
+
+DSTATUS disk_initialize(BYTE pdrv) {
+    UNUSED(pdrv);
+    return 0;
+}
+
+DSTATUS disk_status(BYTE pdrv) {
+    UNUSED(pdrv);
+    return 0;
+}
+
+DRESULT disk_read(BYTE pdrv, BYTE* buff, DWORD sector, UINT count) {
+    UNUSED(pdrv);
+    return sd_cache_sim_read_blocks(buff, sector, count) ? RES_OK : RES_ERROR;
+}
+
+DRESULT disk_write(BYTE pdrv, const BYTE* buff, DWORD sector, UINT count) {
+    UNUSED(pdrv);
+    return sd_cache_sim_write_blocks(buff, sector, count) ? RES_OK : RES_ERROR;
+}
+
+DRESULT disk_ioctl(BYTE pdrv, BYTE cmd, void* buff) {
+    UNUSED(pdrv);
+
+    switch(cmd) {
+    case CTRL_SYNC:
+        return sd_cache_sim_sync() ? RES_OK : RES_ERROR;
+    case GET_SECTOR_COUNT:
+        *(DWORD*)buff = sim.sector_count;
+        return RES_OK;
+    case GET_SECTOR_SIZE:
+        *(WORD*)buff = SD_CACHE_SIM_SECTOR_SIZE;
+        return RES_OK;
+    case GET_BLOCK_SIZE:
+        *(DWORD*)buff = 1;
+        return RES_OK;
+    default:
+        return RES_PARERR;
+    }
+}
+
+DWORD get_fattime(void) {
+    // 2024-01-01 00:00:00, timestamps must not change the written data between runs
+    return ((DWORD)(2024 - 1980) << 25) | ((DWORD)1 << 21) | ((DWORD)1 << 16);
+}
+
+/******************* Image creation *******************/
+
+static bool sd_cache_sim_copy_file(const char* host_path, const char* path) {
+    FILE* source = fopen(host_path, "rb");
+    if(!source) return false;
+
+    FIL file;
+    bool result = f_open(&file, path, FA_WRITE | FA_CREATE_ALWAYS) == FR_OK;
+    if(result) {
+        uint8_t buffer[SD_CACHE_SIM_COPY_SIZE];
+        size_t size;
+        while(result && (size = fread(buffer, 1, sizeof(buffer), source)) > 0) {
+            UINT written;
+            result = f_write(&file, buffer, size, &written) == FR_OK && written == size;
+        }
+        result = (f_close(&file) == FR_OK) && result;
+    }
+
+    fclose(source);
+    return result;
+}
+
+static bool sd_cache_sim_copy_manifest(const char* manifest_path) {
+    FILE* manifest = fopen(manifest_path, "r");
+    if(!manifest) return false;
+
+    bool result = true;
+    char line[SD_CACHE_SIM_PATH_SIZE * 2];
+    while(result && fgets(line, sizeof(line), manifest)) {
+        line[strcspn(line, "\n")] = '\0';
+        char* path = &line[2];
+        if(line[0] == 'd' && line[1] == ' ') {
+            result = f_mkdir(path) == FR_OK;
+        } else if(line[0] == 'f' && line[1] == ' ') {
+            // Image paths never contain spaces, host paths may
+            char* host_path = strchr(path, ' ');
+            result = host_path != NULL;
+            if(result) {
+                *host_path++ = '\0';
+                result = sd_cache_sim_copy_file(host_path, path);
+            }
+        } else if(line[0]) {
+            result = false;
+        }
+        if(!result) fprintf(stderr, "Can't copy %s\n", line);
+    }
+
+    fclose(manifest);
+    return result;
+}
+
+static bool
+    sd_cache_sim_create(const char* image_path, const char* manifest_path, uint32_t size_mb) {
+    sim.image = fopen(image_path, "w+b");
+    if(!sim.image) return false;
+    sim.sector_count = size_mb * 1024 * 1024 / SD_CACHE_SIM_SECTOR_SIZE;
+
+    // Sparse file of the full size, FatFs writes only metadata and copied files
+    uint8_t zero = 0;
+    bool result =
+        !fseek(sim.image, (long)sim.sector_count * SD_CACHE_SIM_SECTOR_SIZE - 1, SEEK_SET) &&
+        fwrite(&zero, 1, 1, sim.image) == 1;
+
+    FATFS fs;
+    uint8_t work[SD_CACHE_SIM_MKFS_WORK_SIZE];
+    result = result && f_mkfs("", FM_ANY | FM_SFD, 0, work, sizeof(work)) == FR_OK &&
+             f_mount(&fs, "", 1) == FR_OK && sd_cache_sim_copy_manifest(manifest_path);
+    f_mount(NULL, "", 0);
+
+    result = (fclose(sim.image) == 0) && result;
+    return result;
+}
+
+/******************* Workload *******************/
+
+typedef struct {
+    const char* name;
+    SectorCacheStats cache;
+    SdCacheSimCardStats card;
+} SdCacheSimPhase;
+
+static void sd_cache_sim_pin_metadata(FATFS* fs) {
+    // Same ranges as storage_ext.c: FAT and root directory
+    sector_cache_pin_range(sim.cache, fs->fatbase, fs->fatbase + fs->fsize * fs->n_fats - 1);
+
+    if(fs->fs_type == FS_FAT12 || fs->fs_type == FS_FAT16) {
+        sector_cache_pin_range(sim.cache, fs->dirbase, fs->database - 1);
+    } else {
+        uint32_t root_sector = fs->database + (fs->dirbase - 2) * fs->csize;
+        sector_cache_pin_range(sim.cache, root_sector, root_sector + fs->csize - 1);
+    }
+}
+
+/** Walk the tree as the file browser does, reading every file when read is set */
+static bool sd_cache_sim_walk(const char* path, bool read) {
+    DIR dir;
+    if(f_opendir(&dir, path) != FR_OK) return false;
+
+    bool result = true;
+    FILINFO info;
+    while(result && f_readdir(&dir, &info) == FR_OK && info.fname[0]) {
+        char entry_path[SD_CACHE_SIM_PATH_SIZE];
+        snprintf(entry_path, sizeof(entry_path), "%s/%s", path, info.fname);
+
+        // Browser stats each entry for its type and size
+        FILINFO entry_info;
+        result = f_stat(entry_path, &entry_info) == FR_OK;
+        if(!result) break;
+
+        if(entry_info.fattrib & AM_DIR) {
+            result = sd_cache_sim_walk(entry_path, read);
+        } else if(read) {
+            FIL file;
+            result = f_open(&file, entry_path, FA_READ) == FR_OK;
+            if(!result) break;
+            uint8_t buffer[SD_CACHE_SIM_READ_SIZE];
+            UINT size;
+            do {
+                result = f_read(&file, buffer, sizeof(buffer), &size) == FR_OK;
+            } while(result && size == sizeof(buffer));
+            result = (f_close(&file) == FR_OK) && result;
+        }
+    }
+
+    result = (f_closedir(&dir) == FR_OK) && result;
+    return result;
+}
+
+static bool sd_cache_sim_browse(void) {
+    bool result = true;
+    for(size_t i = 0; result && i < SD_CACHE_SIM_BROWSE_COUNT; i++) {
+        result = sd_cache_sim_walk("", false);
+    }
+    return result;
+}
+
+static bool sd_cache_sim_read(void) {
+    return sd_cache_sim_walk("", true);
+}
+
+static void sd_cache_sim_write_data(uint8_t* data, size_t file, size_t round) {
+    for(size_t i = 0; i < SD_CACHE_SIM_WRITE_SIZE; i++) {
+        data[i] = (uint8_t)(file * 31 + round * 7 + i);
+    }
+}
+
+/** Small appends to many files, as settings saves and logs do, then read back and delete */
+static bool sd_cache_sim_write(void) {
+    char path[SD_CACHE_SIM_PATH_SIZE];
+    uint8_t data[SD_CACHE_SIM_WRITE_SIZE];
+    uint8_t read_data[SD_CACHE_SIM_WRITE_SIZE];
+    FIL file;
+    UINT size;
+
+    if(f_mkdir(SD_CACHE_SIM_WRITE_DIR) != FR_OK) return false;
+
+    for(size_t round = 0; round < SD_CACHE_SIM_WRITE_ROUNDS; round++) {
+        for(size_t i = 0; i < SD_CACHE_SIM_WRITE_FILES; i++) {
+            snprintf(path, sizeof(path), SD_CACHE_SIM_WRITE_DIR "/%zu.txt", i);
+            sd_cache_sim_write_data(data, i, round);
+            if(f_open(&file, path, FA_WRITE | FA_OPEN_APPEND) != FR_OK) return false;
+            bool written = f_write(&file, data, sizeof(data), &size) == FR_OK &&
+                           size == sizeof(data);
+            if(f_close(&file) != FR_OK || !written) return false;
+        }
+    }
+
+    for(size_t i = 0; i < SD_CACHE_SIM_WRITE_FILES; i++) {
+        snprintf(path, sizeof(path), SD_CACHE_SIM_WRITE_DIR "/%zu.txt", i);
+        if(f_open(&file, path, FA_READ) != FR_OK) return false;
+        bool equal = true;
+        for(size_t round = 0; equal && round < SD_CACHE_SIM_WRITE_ROUNDS; round++) {
+            sd_cache_sim_write_data(data, i, round);
+            equal = f_read(&file, read_data, sizeof(read_data), &size) == FR_OK &&
+                    size == sizeof(read_data) && !memcmp(data, read_data, sizeof(data));
+        }
+        if(f_close(&file) != FR_OK || !equal) {
+            fprintf(stderr, "Read back mismatch in %s\n", path);
+            return false;
+        }
+        if(f_unlink(path) != FR_OK) return false;
+    }
+
+    return f_unlink(SD_CACHE_SIM_WRITE_DIR) == FR_OK;
+}
+
+static void sd_cache_sim_phase_begin(SdCacheSimPhase* phase, const char* name) {
+    phase->name = name;
+    memset(&phase->cache, 0, sizeof(phase->cache));
+    if(sim.cache) sector_cache_get_stats(sim.cache, &phase->cache);
+    phase->card = sim.card;
+}
+
+static void sd_cache_sim_phase_print(SdCacheSimPhase* phase, bool first) {
+    SectorCacheStats cache = {0};
+    if(sim.cache) sector_cache_get_stats(sim.cache, &cache);
+
+    printf(
+        "%s\"%s\": {\"hits\": %u, \"misses\": %u, \"evictions\": %u, \"writes\": %u, "
+        "\"write_backs\": %u, \"card_reads\": %u, \"card_read_blocks\": %u, "
+        "\"card_writes\": %u, \"card_write_blocks\": %u}",
+        first ? "" : ", ",
+        phase->name,
+        cache.hits - phase->cache.hits,
+        cache.misses - phase->cache.misses,
+        cache.evictions - phase->cache.evictions,
+        cache.writes - phase->cache.writes,
+        cache.write_backs - phase->cache.write_backs,
+        sim.card.reads - phase->card.reads,
+        sim.card.read_blocks - phase->card.read_blocks,
+        sim.card.writes - phase->card.writes,
+        sim.card.write_blocks - phase->card.write_blocks);
+}
+
+static bool sd_cache_sim_run(const char* image_path, size_t cache_size, bool write_back) {
+    sim.image = fopen(image_path, "rb");
+    if(!sim.image) {
+        fprintf(stderr, "Can't open %s\n", image_path);
+        return false;
+    }
+    fseek(sim.image, 0, SEEK_END);
+    sim.sector_count = ftell(sim.image) / SD_CACHE_SIM_SECTOR_SIZE;
+    sim.overlay = malloc(sizeof(SdCacheSimSector*) * SD_CACHE_SIM_OVERLAY_SIZE);
+
+    if(cache_size) {
+        sim.cache = sector_cache_alloc(cache_size, NULL);
+        if(write_back) {
+            sector_cache_set_write_callback(sim.cache, sd_cache_sim_write_callback, NULL);
+        }
+    }
+
+    static const struct {
+        const char* name;
+        bool (*run)(void);
+    } phases[] = {
+        {"browse", sd_cache_sim_browse},
+        {"read", sd_cache_sim_read},
+        {"write", sd_cache_sim_write},
+    };
+
+    FATFS fs;
+    SdCacheSimPhase phase;
+    SdCacheSimPhase total;
+    sd_cache_sim_phase_begin(&total, "total");
+    sd_cache_sim_phase_begin(&phase, "mount");
+
+    bool result = f_mount(&fs, "", 1) == FR_OK;
+    if(!result) fprintf(stderr, "Can't mount %s\n", image_path);
+    if(result && sim.cache) sd_cache_sim_pin_metadata(&fs);
+
+    printf(
+        "{\"image\": \"%s\", \"cache_size\": %zu, \"write_back\": %s, \"phases\": {",
+        image_path,
+        cache_size,
+        write_back ? "true" : "false");
+    sd_cache_sim_phase_print(&phase, true);
+
+    for(size_t i = 0; result && i < COUNT_OF(phases); i++) {
+        sd_cache_sim_phase_begin(&phase, phases[i].name);
+        result = phases[i].run();
+        if(!result) fprintf(stderr, "Phase %s failed\n", phases[i].name);
+        sd_cache_sim_phase_print(&phase, false);
+    }
+
+    // Same as unmount and furi_hal_sd_deinit
+    sd_cache_sim_phase_begin(&phase, "unmount");
+    f_mount(NULL, "", 0);
+    result = sd_cache_sim_sync() && result;
+    sd_cache_sim_phase_print(&phase, false);
+
+    printf("}, ");
+    sd_cache_sim_phase_print(&total, true);
+    printf("}\n");
+
+    if(sim.cache) sector_cache_free(sim.cache);
+    for(size_t i = 0; i < SD_CACHE_SIM_OVERLAY_SIZE; i++) {
+        while(sim.overlay[i]) {
+            SdCacheSimSector* next = sim.overlay[i]->next;
+            free(sim.overlay[i]);
+            sim.overlay[i] = next;
+        }
+    }
+    free(sim.overlay);
+    fclose(sim.image);
+
+    return result;
+}
+
+static void sd_cache_sim_usage(const char* name) {
+    fprintf(stderr, "Usage: %s [-n sectors] [-w] image.img\n", name);
+    fprintf(stderr, "       %s -c manifest [-s megabytes] image.img\n", name);
+    fprintf(stderr, "  -n  cache size in sectors, 0 for no cache, default 16\n");
+    fprintf(stderr, "  -w  enable write-back\n");
+    fprintf(stderr, "  -c  create the image with files listed in manifest\n");
+    fprintf(stderr, "  -s  size of the created image, default 256\n");
+}
+
+int main(int argc, char** argv) {
+    const char* image_path = NULL;
+    const char* create_path = NULL;
+    unsigned long cache_size = 16;
+    unsigned long size_mb = 256;
+    bool write_back = false;
+
+    for(int i = 1; i < argc; i++) {
+        if(!strcmp(argv[i], "-n") && i + 1 < argc) {
+            cache_size = strtoul(argv[++i], NULL, 10);
+        } else if(!strcmp(argv[i], "-w")) {
+            write_back = true;
+        } else if(!strcmp(argv[i], "-c") && i + 1 < argc) {
+            create_path = argv[++i];
+        } else if(!strcmp(argv[i], "-s") && i + 1 < argc) {
+            size_mb = strtoul(argv[++i], NULL, 10);
+        } else if(argv[i][0] != '-' && !image_path) {
+            image_path = argv[i];
+        } else {
+            sd_cache_sim_usage(argv[0]);
+            return 2;
+        }
+    }
+    if(!image_path || cache_size == 1 || !size_mb) {
+        sd_cache_sim_usage(argv[0]);
+        return 2;
+    }
+
+    if(create_path) {
+        if(!sd_cache_sim_create(image_path, create_path, size_mb)) {
+            fprintf(stderr, "Can't create %s from %s\n", image_path, create_path);
+            return 1;
+        }
+        return 0;
+    }
+
+    return sd_cache_sim_run(image_path, cache_size, write_back) ? 0 : 1;
+}
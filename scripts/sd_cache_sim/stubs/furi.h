@@ -0,0 +1,27 @@
+/**
+ * @file furi.h
+ * Minimal host replacement of furi for building the SD sector cache with the
+ * system compiler. Only what targets/f7/fatfs/sector_cache.c uses is provided.
+ */
+#pragma once
+
+#include <assert.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Firmware allocator returns zeroed memory and never fails
+#define malloc(size) calloc(1, size)
+
+#define furi_check(...)  assert(__VA_ARGS__)
+#define furi_assert(...) assert(__VA_ARGS__)
+
+#ifndef UNUSED
+#define UNUSED(x) (void)(x)
+#endif
+
+#ifndef COUNT_OF
+#define COUNT_OF(x) (sizeof(x) / sizeof(x[0]))
+#endif
@@ -0,0 +1,314 @@
+#!/usr/bin/env python3
+
+import json
+import os
+import subprocess
+from concurrent.futures import ThreadPoolExecutor
+
+from flipper.app import App
+
+ROOT_DIR = os.path.abspath(os.path.join(os.path.dirname(__file__), ".."))
+
+SOURCES = [
+    "scripts/subghz_decode/subghz_decode.c",
+    "scripts/subghz_decode/host.c",
+    "furi/core/string.c",
+    "lib/subghz/receiver.c",
+    "lib/subghz/environment.c",
+    "lib/subghz/registry.c",
+    "lib/subghz/subghz_file_decoder.c",
+    "lib/subghz/subghz_raw_binary.c",
+    "lib/subghz/blocks/*.c",
+    "lib/subghz/protocols/*.c",
+    "lib/flipper_format/*.c",
+    "lib/toolbox/stream/*.c",
+    "lib/toolbox/crc.c",
+    "lib/toolbox/hex.c",
+    "lib/toolbox/manchester_decoder.c",
+    "lib/toolbox/manchester_encoder.c",
+    "lib/toolbox/strint.c",
+    "lib/toolbox/varint.c",
+]
+
+INCLUDES = [
+    "scripts/subghz_decode/stubs",
+    "furi",
+    "lib/mlib",
+    "lib",
+    "lib/subghz",
+    "applications/services",
+    ".",
+]
+
+RAW_FILE_TYPE = "Filetype: Flipper SubGhz RAW File"
+CORPUS_DIR = "applications/debug/unit_tests/resources/unit_tests/subghz"
+CORPUS_FILE = "corpus.json"
+CORPUS_BIN_RAW_FILE = "corpus_bin_raw.json"
+BIN_RAW_STRIDE = 2039
+
+
+class Main(App):
+    def init(self):
+        self.subparsers = self.parser.add_subparsers(help="sub-command help")
+
+        self.parser_build = self.subparsers.add_parser(
+            "build", help="Build host decode binary"
+        )
+        self._add_build_args(self.parser_build)
+        self.parser_build.set_defaults(func=self.build)
+
+        self.parser_run = self.subparsers.add_parser(
+            "run", help="Decode RAW files and check decode results"
+        )
+        self._add_build_args(self.parser_run)
+        self.parser_run.add_argument(
+            "files",
+            nargs="*",
+            help=f"RAW files or directories, default is {CORPUS_DIR}",
+        )
+        self.parser_run.add_argument(
+            "-j", "--jobs", type=int, default=os.cpu_count(), help="Parallel jobs"
+        )
+        self.parser_run.add_argument(
+            "-r",
+            "--repeats",
+            type=int,
+            default=1,
+            help="Decode each file N times for throughput measurement",
+        )
+        self.parser_run.add_argument(
+            "-e",
+            "--expect",
+            help="Expected results, default is scripts/subghz_decode/"
+            f"{CORPUS_FILE} for the default directory and {CORPUS_FILE} "
+            "in the given directory otherwise",
+        )
+        self.parser_run.add_argument(
+            "-u",
+            "--update",
+            action="store_true",
+            help="Write current results as expected results",
+        )
+        self.parser_run.add_argument(
+            "-b",
+            "--bin-raw",
+            type=int,
+            nargs="?",
+            const=BIN_RAW_STRIDE,
+            metavar="STRIDE",
+            help="Decode BinRAW records cut from the files every STRIDE samples "
+            f"(default {BIN_RAW_STRIDE}), expected results for the default stride "
+            f"are in {CORPUS_BIN_RAW_FILE}",
+        )
+        self.parser_run.add_argument(
+            "-B",
+            "--block",
+            type=int,
+            metavar="PULSES",
+            help="Feed samples from memory in blocks of PULSES pulses, as the worker "
+            "does, 1 feeds them one by one; file parsing is not timed",
+        )
+        self.parser_run.add_argument(
+            "-p",
+            "--packets",
+            action="store_true",
+            help="Print decoded packets",
+        )
+        self.parser_run.set_defaults(func=self.run)
+
+    def _add_build_args(self, parser):
+        parser.add_argument(
+            "-o",
+            "--output",
+            default=os.path.join(ROOT_DIR, "build", "subghz_decode"),
+            help="Build directory",
+        )
+        parser.add_argument(
+            "--cc", default=os.environ.get("CC", "cc"), help="Host C compiler"
+        )
+
+    def _build(self):
+        os.makedirs(self.args.output, exist_ok=True)
+        binary = os.path.join(self.args.output, "subghz_decode")
+
+        sources = []
+        for source in SOURCES:
+            if source.endswith("*.c"):
+                directory = os.path.join(ROOT_DIR, os.path.dirname(source))
+                sources.extend(
+                    os.path.join(directory, name)
+                    for name in sorted(os.listdir(directory))
+                    if name.endswith(".c")
+                )
+            else:
+                sources.append(os.path.join(ROOT_DIR, source))
+
+        command = [self.args.cc, "-std=gnu17", "-O2", "-g", "-o", binary]
+        command.extend(f"-I{os.path.join(ROOT_DIR, path)}" for path in INCLUDES)
+        command.extend(sources)
+        command.append("-lm")
+
+        self.logger.debug(" ".join(command))
+        process = subprocess.run(command, capture_output=True, text=True)
+        if process.returncode != 0:
+            self.logger.error(f"Build failed:\n{process.stderr}")
+            return None
+
+        return binary
+
+    def build(self):
+        binary = self._build()
+        if not binary:
+            return 1
+
+        self.logger.info(f"Built {binary}")
+        return 0
+
+    def _is_raw(self, path):
+        try:
+            with open(path, "r", errors="replace") as file:
+                return file.readline().strip() == RAW_FILE_TYPE
+        except OSError:
+            return False
+
+    def _collect(self, paths):
+        files = []
+        for path in paths:
+            if os.path.isdir(path):
+                # Key files live next to RAW files, only RAW files are decoded
+                for root, _, names in os.walk(path):
+                    files.extend(
+                        os.path.join(root, name)
+                        for name in sorted(names)
+                        if name.endswith(".sub")
+                        and self._is_raw(os.path.join(root, name))
+                    )
+            else:
+                files.append(path)
+        return files
+
+    def _decode(self, binary, path):
+        command = [binary, "-r", str(self.args.repeats), path]
+        if self.args.bin_raw:
+            command[1:1] = ["-b", str(self.args.bin_raw)]
+        elif self.args.block:
+            command[1:1] = ["-B", str(self.args.block)]
+        process = subprocess.run(command, capture_output=True, text=True)
+        if process.returncode != 0:
+            return {"file": path, "error": process.stderr.strip()}
+        return json.loads(process.stdout)
+
+    def _expect_path(self, paths):
+        if self.args.expect:
+            return self.args.expect
+        corpus_file = CORPUS_BIN_RAW_FILE if self.args.bin_raw else CORPUS_FILE
+        if not self.args.files:
+            return os.path.join(ROOT_DIR, "scripts", "subghz_decode", corpus_file)
+
+        directories = [path for path in paths if os.path.isdir(path)]
+        if len(directories) == 1:
+            return os.path.join(directories[0], corpus_file)
+        return None
+
+    def run(self):
+        binary = self._build()
+        if not binary:
+            return 1
+
+        paths = self.args.files or [os.path.join(ROOT_DIR, CORPUS_DIR)]
+        files = self._collect(paths)
+        if not files:
+            self.logger.error("No RAW files found")
+            return 1
+
+        with ThreadPoolExecutor(max_workers=self.args.jobs) as executor:
+            results = list(executor.map(lambda path: self._decode(binary, path), files))
+
+        expect_path = self._expect_path(paths)
+        # Names are relative to the decoded directory, not to the corpus file
+        name_root = paths[0] if len(paths) == 1 and os.path.isdir(paths[0]) else None
+        expected = {}
+        if expect_path and os.path.exists(expect_path) and not self.args.update:
+            with open(expect_path, "r") as file:
+                expected = json.load(file)
+
+        failed = 0
+        current = {}
+        protocols = {}
+        total_pulses = 0
+        total_time = 0
+        for result in results:
+            name = result["file"]
+            if name_root:
+                name = os.path.relpath(name, name_root)
+
+            if "error" in result:
+                self.logger.error(f"{name}: {result['error']}")
+                failed += 1
+                continue
+
+            packets = result["packets"]
+            current[name] = packets
+            self.logger.info(
+                f"{name}: {len(packets)} packets, {result['pulses']} pulses, "
+                f"{result['pulses_per_second'] / 1e6:.2f} Mpulses/s"
+            )
+            if self.args.packets:
+                for packet in packets:
+                    self.logger.info(packet)
+
+            for protocol, stats in result["protocols"].items():
+                total = protocols.setdefault(
+                    protocol, {"pulses": 0, "ns": 0, "decoded": 0}
+                )
+                for key in total:
+                    total[key] += stats[key]
+            if result["pulses_per_second"]:
+                total_pulses += result["pulses"]
+                total_time += result["pulses"] / result["pulses_per_second"]
+
+            if name in expected and expected[name] != packets:
+                self.logger.error(
+                    f"{name}: expected {len(expected[name])} packets, "
+                    "decoded packets differ"
+                )
+                failed += 1
+
+        self.logger.info(
+            f"{'Protocol':<20} {'Pulses':>10} {'Mpulses/s':>10} {'Decoded':>8}"
+        )
+        for protocol, stats in sorted(
+            protocols.items(), key=lambda item: item[1]["ns"], reverse=True
+        ):
+            speed = stats["pulses"] / stats["ns"] * 1e3 if stats["ns"] else 0
+            self.logger.info(
+                f"{protocol:<20} {stats['pulses']:>10} {speed:>10.2f} {stats['decoded']:>8}"
+            )
+        if total_time:
+            self.logger.info(
+                f"Decoded {total_pulses} pulses at {total_pulses / total_time / 1e6:.2f} Mpulses/s"
+            )
+
+        if self.args.update:
+            if not expect_path:
+                self.logger.error("Expected results file is not set, use --expect")
+                return 1
+            with open(expect_path, "w") as file:
+                json.dump(current, file, indent=4, sort_keys=True)
+                file.write("\n")
+            self.logger.info(f"Updated {expect_path}")
+        elif expected:
+            missing = [name for name in expected if name not in current]
+            for name in missing:
+                self.logger.warning(f"{name}: file is missing")
+
+        if failed:
+            self.logger.error(f"{failed} of {len(results)} files failed")
+            return 1
+
+        self.logger.info(f"{len(results)} files decoded")
+        return 0
+
+
+if __name__ == "__main__":
+    Main()()
@@ -0,0 +1,236 @@
+/**
+ * @file host.c
+ * Host implementation of the storage API over stdio and stubs for the parts
+ * of lib/subghz that are linked in but can't work on host.
+ *
+ * Paths are host paths, storage prefixes like /ext are not translated.
+ */
+#include <furi.h>
+#include <storage/storage.h>
+#include <subghz/subghz_file_encoder_worker.h>
+#include <subghz/subghz_keystore.h>
+
+#include <sys/stat.h>
+#include <unistd.h>
+
+struct File {
+    FILE* file;
+    FS_Error error;
+};
+
+File* storage_file_alloc(Storage* storage) {
+    UNUSED(storage);
+    return malloc(sizeof(File));
+}
+
+void storage_file_free(File* file) {
+    if(file->file) storage_file_close(file);
+    free(file);
+}
+
+bool storage_file_open(
+    File* file,
+    const char* path,
+    FS_AccessMode access_mode,
+    FS_OpenMode open_mode) {
+    furi_check(!file->file);
+
+    bool exists = access(path, F_OK) == 0;
+    const char* mode = NULL;
+
+    if(open_mode == FSOM_OPEN_EXISTING) {
+        mode = (access_mode & FSAM_WRITE) ? "r+b" : "rb";
+    } else if(open_mode == FSOM_CREATE_NEW) {
+        mode = exists ? NULL : "w+b";
+    } else if(open_mode == FSOM_CREATE_ALWAYS) {
+        mode = "w+b";
+    } else {
+        // Open always and append, both create missing file
+        mode = exists ? "r+b" : "w+b";
+    }
+
+    file->file = mode ? fopen(path, mode) : NULL;
+    if(!file->file) {
+        file->error = exists ? FSE_DENIED : FSE_NOT_EXIST;
+        if(open_mode == FSOM_CREATE_NEW && exists) file->error = FSE_EXIST;
+        return false;
+    }
+
+    if(open_mode == FSOM_OPEN_APPEND) fseek(file->file, 0, SEEK_END);
+    file->error = FSE_OK;
+    return true;
+}
+
+bool storage_file_close(File* file) {
+    if(!file->file) return false;
+    fclose(file->file);
+    file->file = NULL;
+    return true;
+}
+
+bool storage_file_is_open(File* file) {
+    return file->file != NULL;
+}
+
+size_t storage_file_read(File* file, void* buff, size_t bytes_to_read) {
+    return fread(buff, 1, bytes_to_read, file->file);
+}
+
+size_t storage_file_write(File* file, const void* buff, size_t bytes_to_write) {
+    return fwrite(buff, 1, bytes_to_write, file->file);
+}
+
+bool storage_file_seek(File* file, uint32_t offset, bool from_start) {
+    // Same as FatFs, seeking past the end of a file opened for read stops at the end
+    long position = from_start ? (long)offset : ftell(file->file) + (long)offset;
+    long size = (long)storage_file_size(file);
+    if(position > size) position = size;
+    file->error = fseek(file->file, position, SEEK_SET) ? FSE_INTERNAL : FSE_OK;
+    return file->error == FSE_OK;
+}
+
+uint64_t storage_file_tell(File* file) {
+    return ftell(file->file);
+}
+
+bool storage_file_truncate(File* file) {
+    fflush(file->file);
+    return ftruncate(fileno(file->file), ftell(file->file)) == 0;
+}
+
+uint64_t storage_file_size(File* file) {
+    long position = ftell(file->file);
+    fseek(file->file, 0, SEEK_END);
+    long size = ftell(file->file);
+    fseek(file->file, position, SEEK_SET);
+    return size;
+}
+
+bool storage_file_sync(File* file) {
+    return fflush(file->file) == 0;
+}
+
+bool storage_file_eof(File* file) {
+    return storage_file_tell(file) >= storage_file_size(file);
+}
+
+FS_Error storage_file_get_error(File* file) {
+    return file->error;
+}
+
+FS_Error storage_common_remove(Storage* storage, const char* path) {
+    UNUSED(storage);
+    return remove(path) ? FSE_NOT_EXIST : FSE_OK;
+}
+
+bool storage_simply_remove(Storage* storage, const char* path) {
+    FS_Error error = storage_common_remove(storage, path);
+    return error == FSE_OK || error == FSE_NOT_EXIST;
+}
+
+bool storage_simply_mkdir(Storage* storage, const char* path) {
+    UNUSED(storage);
+    return mkdir(path, 0777) == 0 || access(path, F_OK) == 0;
+}
+
+void storage_get_next_filename(
+    Storage* storage,
+    const char* dirname,
+    const char* filename,
+    const char* fileextension,
+    FuriString* nextfilename,
+    uint8_t max_len) {
+    UNUSED(storage);
+    UNUSED(max_len);
+    FuriString* path = furi_string_alloc_printf("%s/%s%s", dirname, filename, fileextension);
+    furi_string_set(nextfilename, filename);
+    for(uint32_t num = 1; access(furi_string_get_cstr(path), F_OK) == 0; num++) {
+        furi_string_printf(nextfilename, "%s%lu", filename, (unsigned long)num);
+        furi_string_printf(
+            path, "%s/%s%s", dirname, furi_string_get_cstr(nextfilename), fileextension);
+    }
+    furi_string_free(path);
+}
+
+// RAW protocol encoder plays files back over the radio, not available on host
+
+SubGhzFileEncoderWorker* subghz_file_encoder_worker_alloc(void) {
+    furi_crash("Sub-GHz transmission is not supported on host");
+}
+
+void subghz_file_encoder_worker_free(SubGhzFileEncoderWorker* instance) {
+    UNUSED(instance);
+}
+
+void subghz_file_encoder_worker_callback_end(
+    SubGhzFileEncoderWorker* instance,
+    SubGhzFileEncoderWorkerCallbackEnd callback_end,
+    void* context_end) {
+    UNUSED(instance);
+    UNUSED(callback_end);
+    UNUSED(context_end);
+}
+
+LevelDuration subghz_file_encoder_worker_get_level_duration(void* context) {
+    UNUSED(context);
+    return level_duration_reset();
+}
+
+bool subghz_file_encoder_worker_start(
+    SubGhzFileEncoderWorker* instance,
+    const char* file_path,
+    const char* radio_device_name) {
+    UNUSED(instance);
+    UNUSED(file_path);
+    UNUSED(radio_device_name);
+    return false;
+}
+
+void subghz_file_encoder_worker_stop(SubGhzFileEncoderWorker* instance) {
+    UNUSED(instance);
+}
+
+bool subghz_file_encoder_worker_is_running(SubGhzFileEncoderWorker* instance) {
+    UNUSED(instance);
+    return false;
+}
+
+// Manufacture keys and rainbow tables are encrypted with the device unique key
+// (subghz_keystore.c is also ARM only), KeeLoq family decodes without keys
+
+struct SubGhzKeystore {
+    SubGhzKeyArray_t data;
+};
+
+SubGhzKeystore* subghz_keystore_alloc(void) {
+    SubGhzKeystore* instance = malloc(sizeof(SubGhzKeystore));
+    SubGhzKeyArray_init(instance->data);
+    return instance;
+}
+
+void subghz_keystore_free(SubGhzKeystore* instance) {
+    SubGhzKeyArray_clear(instance->data);
+    free(instance);
+}
+
+bool subghz_keystore_load(SubGhzKeystore* instance, const char* filename) {
+    UNUSED(instance);
+    UNUSED(filename);
+    return false;
+}
+
+SubGhzKeyArray_t* subghz_keystore_get_data(SubGhzKeystore* instance) {
+    return &instance->data;
+}
+
+bool subghz_keystore_raw_get_data(
+    const char* file_name,
+    size_t offset,
+    uint8_t* data,
+    size_t len) {
+    UNUSED(file_name);
+    UNUSED(offset);
+    UNUSED(data);
+    UNUSED(len);
+    return false;
+}
@@ -0,0 +1,8 @@
+#pragma once
+
+#include <assert.h>
+#include <stdlib.h>
+
+#define furi_check(...)  assert(__VA_ARGS__)
+#define furi_assert(...) assert(__VA_ARGS__)
+#define furi_crash(...)  abort()
@@ -0,0 +1,16 @@
+#pragma once
+
+#include <core/core_defines.h>
+#include <stdbool.h>
+
+#ifndef FURI_PACKED
+#define FURI_PACKED __attribute__((packed))
+#endif
+
+#ifndef FURI_ALWAYS_INLINE
+#define FURI_ALWAYS_INLINE __attribute__((always_inline)) inline
+#endif
+
+#ifndef FURI_WARN_UNUSED
+#define FURI_WARN_UNUSED __attribute__((warn_unused_result))
+#endif
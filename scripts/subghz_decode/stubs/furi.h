@@ -0,0 +1,50 @@
+/**
+ * @file furi.h
+ * Minimal host replacement of furi for building Sub-GHz decoders with the
+ * system compiler. Only what lib/subghz, lib/flipper_format and
+ * lib/toolbox/stream use is provided, FuriString is the firmware one.
+ */
+#pragma once
+
+#include <assert.h>
+#include <stdarg.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+// Newlib attribute macro used by firmware headers
+#ifndef _ATTRIBUTE
+#define _ATTRIBUTE(attrs) __attribute__(attrs)
+#endif
+
+#include <core/common_defines.h>
+#include <core/check.h>
+#include <core/string.h>
+
+typedef struct FuriPubSub FuriPubSub;
+
+// Firmware allocator returns zeroed memory and never fails
+#define malloc(size) calloc(1, size)
+
+#define FURI_LOG_E(tag, ...)
+#define FURI_LOG_W(tag, ...)
+#define FURI_LOG_I(tag, ...)
+#define FURI_LOG_D(tag, ...)
+#define FURI_LOG_T(tag, ...)
+
+// Storage is the only record opened, host storage API doesn't use the instance
+static inline void* furi_record_open(const char* name) {
+    return (void*)name;
+}
+
+static inline void furi_record_close(const char* name) {
+    UNUSED(name);
+}
+
+static inline void furi_delay_ms(uint32_t milliseconds) {
+    UNUSED(milliseconds);
+}
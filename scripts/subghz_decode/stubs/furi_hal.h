@@ -0,0 +1,52 @@
+/**
+ * @file furi_hal.h
+ * Host replacement of the furi_hal parts used by lib/subghz.
+ *
+ * DWT->CYCCNT counts nanoseconds, so receiver stats cycles are host
+ * nanoseconds. Crypto enclave is not available: encrypted keystores fail to
+ * load, plain ones work.
+ */
+#pragma once
+
+#include <furi.h>
+#include <time.h>
+#include <toolbox/level_duration.h>
+
+typedef struct {
+    uint32_t CYCCNT;
+} FuriHalHostDwt;
+
+static inline FuriHalHostDwt* furi_hal_host_dwt(void) {
+    static FuriHalHostDwt dwt;
+    struct timespec time;
+    clock_gettime(CLOCK_MONOTONIC, &time);
+    dwt.CYCCNT = (uint32_t)(time.tv_sec * 1000000000ULL + time.tv_nsec);
+    return &dwt;
+}
+
+#define DWT furi_hal_host_dwt()
+
+static inline bool furi_hal_crypto_enclave_load_key(uint8_t slot, const uint8_t* iv) {
+    UNUSED(slot);
+    UNUSED(iv);
+    return false;
+}
+
+static inline bool furi_hal_crypto_enclave_unload_key(uint8_t slot) {
+    UNUSED(slot);
+    return false;
+}
+
+static inline bool furi_hal_crypto_encrypt(const uint8_t* input, uint8_t* output, size_t size) {
+    UNUSED(input);
+    UNUSED(output);
+    UNUSED(size);
+    return false;
+}
+
+static inline bool furi_hal_crypto_decrypt(const uint8_t* input, uint8_t* output, size_t size) {
+    UNUSED(input);
+    UNUSED(output);
+    UNUSED(size);
+    return false;
+}
@@ -0,0 +1,10 @@
+#pragma once
+
+typedef enum {
+    FuriHalRtcLocaleUnitsMetric,
+    FuriHalRtcLocaleUnitsImperial,
+} FuriHalRtcLocaleUnits;
+
+static inline FuriHalRtcLocaleUnits furi_hal_rtc_get_locale_units(void) {
+    return FuriHalRtcLocaleUnitsMetric;
+}
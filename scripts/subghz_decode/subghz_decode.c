@@ -0,0 +1,400 @@
+/**
+ * @file subghz_decode.c
+ * Host decode of Sub-GHz RAW files (text or binary samples) through the same
+ * SubGhzFileDecoder and SubGhzReceiver as `subghz decode_raw`.
+ *
+ * Prints one JSON object per file with every decoded packet serialized by
+ * subghz_protocol_decoder_base_serialize, per protocol pulse counts and
+ * decoder throughput. Driven by scripts/subghz_decode.py.
+ *
+ * BinRAW needs RSSI to find the record boundaries, which RAW files don't
+ * have. With -b the file is cut into windows instead, and each window is
+ * fed to a fresh BinRAW decoder as one record: RSSI goes up, samples are
+ * fed, RSSI drops and the decoder analyzes the record.
+ */
+#include <furi.h>
+#include <time.h>
+
+#include <flipper_format/flipper_format_i.h>
+#include <subghz/environment.h>
+#include <subghz/receiver.h>
+#include <subghz/subghz_file_decoder.h>
+#include <subghz/subghz_keystore.h>
+#include <subghz/subghz_raw_binary.h>
+#include <subghz/protocols/protocol_items.h>
+#include <toolbox/strint.h>
+
+#define SUBGHZ_DECODE_PACKETS_MAX (1024)
+
+// Window lengths around the BinRAW classifier and buffer sizes, 0 is the rest of the file
+static const size_t subghz_decode_windows[] = {130, 511, 513, 2047, 2049, 0};
+
+typedef struct {
+    SubGhzFileDecoder* decoder;
+    FlipperFormat* serialized;
+    bool collect;
+    size_t packet_count;
+    FuriString* packets[SUBGHZ_DECODE_PACKETS_MAX];
+    FuriString* window;
+} SubGhzDecode;
+
+static void
+    subghz_decode_collect(SubGhzDecode* instance, SubGhzProtocolDecoderBase* decoder_base) {
+    if(!instance->collect || instance->packet_count >= SUBGHZ_DECODE_PACKETS_MAX) return;
+
+    SubGhzRadioPreset* preset = subghz_file_decoder_get_preset(instance->decoder);
+    FuriString* packet = furi_string_alloc_set(instance->window);
+    if(subghz_protocol_decoder_base_serialize(decoder_base, instance->serialized, preset) ==
+       SubGhzProtocolStatusOk) {
+        Stream* stream = flipper_format_get_raw_stream(instance->serialized);
+        size_t size = stream_size(stream);
+        char* text = malloc(size + 1);
+        stream_rewind(stream);
+        stream_read(stream, (uint8_t*)text, size);
+        furi_string_cat(packet, text);
+        free(text);
+    }
+    instance->packets[instance->packet_count++] = packet;
+}
+
+static void subghz_decode_callback(
+    SubGhzReceiver* receiver,
+    SubGhzProtocolDecoderBase* decoder_base,
+    void* context) {
+    // Same as decode_raw output: serialize before receiver reset
+    subghz_decode_collect(context, decoder_base);
+    subghz_receiver_reset(receiver);
+}
+
+static void
+    subghz_decode_bin_raw_callback(SubGhzProtocolDecoderBase* decoder_base, void* context) {
+    subghz_decode_collect(context, decoder_base);
+}
+
+typedef struct {
+    int32_t* data;
+    size_t count;
+    size_t capacity;
+} SubGhzDecodeSamples;
+
+static int32_t* subghz_decode_samples_reserve(SubGhzDecodeSamples* samples, size_t count) {
+    if(samples->count + count > samples->capacity) {
+        samples->capacity = (samples->count + count) * 2;
+        samples->data = realloc(samples->data, samples->capacity * sizeof(int32_t));
+    }
+    return samples->data + samples->count;
+}
+
+/** Load all samples of a RAW file, header is checked by SubGhzFileDecoder */
+static void subghz_decode_load(const char* path, SubGhzDecodeSamples* samples) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    FlipperFormat* flipper_format = flipper_format_file_alloc(storage);
+    FuriString* line = furi_string_alloc();
+
+    if(flipper_format_file_open_existing(flipper_format, path) &&
+       flipper_format_read_string(flipper_format, "Protocol", line)) {
+        Stream* stream = flipper_format_get_raw_stream(flipper_format);
+        stream_seek(stream, 1, StreamOffsetFromCurrent);
+
+        if(subghz_raw_binary_read_marker(stream)) {
+            SubGhzRawBinaryReader* reader = subghz_raw_binary_reader_alloc(stream);
+            size_t count;
+            do {
+                int32_t* data =
+                    subghz_decode_samples_reserve(samples, SUBGHZ_RAW_BINARY_BLOCK_SAMPLES);
+                count =
+                    subghz_raw_binary_reader_read(reader, data, SUBGHZ_RAW_BINARY_BLOCK_SAMPLES);
+                samples->count += count;
+            } while(count);
+            subghz_raw_binary_reader_free(reader);
+        } else {
+            while(stream_read_line(stream, line)) {
+                char* str = strstr(furi_string_get_cstr(line), "RAW_Data: ");
+                if(!str) break;
+                str = strchr(str, ' ');
+                int32_t duration;
+                while(strint_to_int32(str, &str, &duration, 10) == StrintParseNoError) {
+                    *subghz_decode_samples_reserve(samples, 1) = duration;
+                    samples->count++;
+                    if(*str == ',') str++;
+                }
+            }
+        }
+    }
+
+    // Same as playback, zero duration terminates the record
+    for(size_t i = 0; i < samples->count; i++) {
+        if(!samples->data[i]) {
+            samples->count = i;
+            break;
+        }
+    }
+
+    furi_string_free(line);
+    flipper_format_free(flipper_format);
+    furi_record_close(RECORD_STORAGE);
+}
+
+static void subghz_decode_bin_raw(
+    SubGhzDecode* instance,
+    SubGhzEnvironment* environment,
+    const int32_t* samples,
+    size_t count,
+    size_t stride) {
+    const SubGhzProtocolDecoder* decoder = subghz_protocol_bin_raw.decoder;
+
+    for(size_t start = 0; start < count; start += stride) {
+        for(size_t i = 0; i < COUNT_OF(subghz_decode_windows); i++) {
+            size_t length = subghz_decode_windows[i];
+            if(!length || length > count - start) length = count - start;
+            furi_string_printf(instance->window, "Window: %zu %zu\n", start, length);
+
+            SubGhzProtocolDecoderBase* decoder_base = decoder->alloc(environment);
+            subghz_protocol_decoder_base_set_decoder_callback(
+                decoder_base, subghz_decode_bin_raw_callback, instance);
+
+            subghz_protocol_decoder_bin_raw_data_input_rssi(
+                (SubGhzProtocolDecoderBinRAW*)decoder_base, -100.0f);
+            subghz_protocol_decoder_bin_raw_data_input_rssi(
+                (SubGhzProtocolDecoderBinRAW*)decoder_base, -50.0f);
+            for(size_t j = start; j < start + length; j++) {
+                decoder->feed(decoder_base, samples[j] > 0, abs(samples[j]));
+            }
+            subghz_protocol_decoder_bin_raw_data_input_rssi(
+                (SubGhzProtocolDecoderBinRAW*)decoder_base, -100.0f);
+
+            decoder->free(decoder_base);
+
+            // The rest of the file is one window however long it is
+            if(length == count - start) break;
+        }
+    }
+    furi_string_reset(instance->window);
+}
+
+/** Feed samples in blocks through subghz_receiver_decode_batch, block 1 is fed one by one */
+static void subghz_decode_blocks(
+    SubGhzReceiver* receiver,
+    const LevelDuration* pulses,
+    size_t count,
+    size_t block) {
+    subghz_receiver_reset(receiver);
+    if(block == 1) {
+        for(size_t i = 0; i < count; i++) {
+            subghz_receiver_decode(
+                receiver,
+                level_duration_get_level(pulses[i]),
+                level_duration_get_duration(pulses[i]));
+        }
+        return;
+    }
+    for(size_t i = 0; i < count; i += block) {
+        subghz_receiver_decode_batch(receiver, &pulses[i], MIN(block, count - i));
+    }
+}
+
+static SubGhzEnvironment* subghz_decode_environment_init(const char* assets) {
+    SubGhzEnvironment* environment = subghz_environment_alloc();
+    subghz_environment_set_protocol_registry(environment, (void*)&subghz_protocol_registry);
+    if(!assets) return environment;
+
+    FuriString* path = furi_string_alloc();
+
+    // Manufacture keys shipped with firmware are encrypted with the device key
+    // and can't be loaded on host, plain user keys can
+    furi_string_printf(path, "%s/keeloq_mfcodes", assets);
+    subghz_environment_load_keystore(environment, furi_string_get_cstr(path));
+    furi_string_printf(path, "%s/keeloq_mfcodes_user", assets);
+    subghz_environment_load_keystore(environment, furi_string_get_cstr(path));
+
+    // Environment keeps file names, so the strings are never freed
+    subghz_environment_set_came_atomo_rainbow_table_file_name(
+        environment, furi_string_get_cstr(furi_string_alloc_printf("%s/came_atomo", assets)));
+    subghz_environment_set_alutech_at_4n_rainbow_table_file_name(
+        environment, furi_string_get_cstr(furi_string_alloc_printf("%s/alutech_at_4n", assets)));
+    subghz_environment_set_nice_flor_s_rainbow_table_file_name(
+        environment, furi_string_get_cstr(furi_string_alloc_printf("%s/nice_flor_s", assets)));
+
+    furi_string_free(path);
+    return environment;
+}
+
+static double subghz_decode_time(void) {
+    struct timespec time;
+    clock_gettime(CLOCK_MONOTONIC, &time);
+    return time.tv_sec + time.tv_nsec * 1e-9;
+}
+
+static void subghz_decode_print_string(const char* string) {
+    putchar('"');
+    for(; *string; string++) {
+        if(*string == '"' || *string == '\\') {
+            printf("\\%c", *string);
+        } else if(*string == '\n') {
+            printf("\\n");
+        } else if((uint8_t)*string < 0x20) {
+            printf("\\u%04x", *string);
+        } else {
+            putchar(*string);
+        }
+    }
+    putchar('"');
+}
+
+static void subghz_decode_usage(const char* name) {
+    fprintf(
+        stderr, "Usage: %s [-a assets] [-r repeats] [-b stride] [-B block] file.sub\n", name);
+    fprintf(stderr, "  -a  directory with keystores and rainbow tables\n");
+    fprintf(stderr, "  -r  decode count for throughput measurement, default 1\n");
+    fprintf(stderr, "  -b  BinRAW windows starting every stride samples instead of decode\n");
+    fprintf(stderr, "  -B  feed samples from memory in blocks, 1 feeds them one by one\n");
+}
+
+int main(int argc, char** argv) {
+    const char* path = NULL;
+    const char* assets = NULL;
+    unsigned long repeats = 1;
+    unsigned long stride = 0;
+    unsigned long block = 0;
+
+    for(int i = 1; i < argc; i++) {
+        if(!strcmp(argv[i], "-a") && i + 1 < argc) {
+            assets = argv[++i];
+        } else if(!strcmp(argv[i], "-r") && i + 1 < argc) {
+            repeats = strtoul(argv[++i], NULL, 10);
+        } else if(!strcmp(argv[i], "-b") && i + 1 < argc) {
+            stride = strtoul(argv[++i], NULL, 10);
+        } else if(!strcmp(argv[i], "-B") && i + 1 < argc) {
+            block = strtoul(argv[++i], NULL, 10);
+        } else if(argv[i][0] != '-' && !path) {
+            path = argv[i];
+        } else {
+            subghz_decode_usage(argv[0]);
+            return 2;
+        }
+    }
+    if(!path || !repeats) {
+        subghz_decode_usage(argv[0]);
+        return 2;
+    }
+
+    SubGhzDecode instance = {
+        .decoder = subghz_file_decoder_alloc(),
+        .serialized = flipper_format_string_alloc(),
+        .collect = true,
+        .window = furi_string_alloc(),
+    };
+
+    SubGhzEnvironment* environment = subghz_decode_environment_init(assets);
+    SubGhzReceiver* receiver = subghz_receiver_alloc_init(environment);
+    subghz_receiver_set_filter(receiver, SubGhzProtocolFlag_Decodable);
+    subghz_receiver_set_rx_callback(receiver, subghz_decode_callback, &instance);
+
+    double elapsed = 0;
+    bool decoded;
+    if(stride) {
+        // Header and preset only, no decoder is enabled
+        subghz_receiver_set_filter(receiver, 0);
+        decoded = subghz_file_decoder_run(instance.decoder, receiver, path);
+
+        SubGhzDecodeSamples samples = {0};
+        if(decoded) subghz_decode_load(path, &samples);
+        for(unsigned long i = 0; decoded && i < repeats; i++) {
+            double start = subghz_decode_time();
+            subghz_decode_bin_raw(&instance, environment, samples.data, samples.count, stride);
+            elapsed += subghz_decode_time() - start;
+            instance.collect = false;
+        }
+        free(samples.data);
+    } else if(block) {
+        // Header and preset only, samples are fed from memory
+        subghz_receiver_set_filter(receiver, 0);
+        decoded = subghz_file_decoder_run(instance.decoder, receiver, path);
+        subghz_receiver_set_filter(receiver, SubGhzProtocolFlag_Decodable);
+
+        SubGhzDecodeSamples samples = {0};
+        if(decoded) subghz_decode_load(path, &samples);
+        LevelDuration* pulses = malloc(sizeof(LevelDuration) * MAX(samples.count, 1U));
+        for(size_t i = 0; i < samples.count; i++) {
+            pulses[i] = level_duration_make(samples.data[i] > 0, abs(samples.data[i]));
+        }
+
+        subghz_receiver_set_stats(receiver, true);
+        if(decoded) subghz_decode_blocks(receiver, pulses, samples.count, block);
+        subghz_receiver_set_stats(receiver, false);
+        instance.collect = false;
+
+        for(unsigned long i = 0; decoded && i < repeats; i++) {
+            double start = subghz_decode_time();
+            subghz_decode_blocks(receiver, pulses, samples.count, block);
+            elapsed += subghz_decode_time() - start;
+        }
+        free(pulses);
+        free(samples.data);
+    } else {
+        // First pass collects packets and per decoder stats, timing is taken
+        // without stats so that clock reads are not part of it
+        subghz_receiver_set_stats(receiver, true);
+        decoded = subghz_file_decoder_run(instance.decoder, receiver, path);
+        subghz_receiver_set_stats(receiver, false);
+        instance.collect = false;
+
+        for(unsigned long i = 0; decoded && i < repeats; i++) {
+            double start = subghz_decode_time();
+            subghz_file_decoder_run(instance.decoder, receiver, path);
+            elapsed += subghz_decode_time() - start;
+        }
+    }
+
+    int ret = 0;
+    if(decoded) {
+        size_t pulses = subghz_file_decoder_get_sample_count(instance.decoder);
+        SubGhzRadioPreset* preset = subghz_file_decoder_get_preset(instance.decoder);
+
+        printf("{\"file\": ");
+        subghz_decode_print_string(path);
+        printf(", \"frequency\": %lu, \"preset\": ", (unsigned long)preset->frequency);
+        subghz_decode_print_string(furi_string_get_cstr(preset->name));
+        printf(
+            ", \"pulses\": %zu, \"pulses_per_second\": %.0f",
+            pulses,
+            elapsed > 0 ? pulses * repeats / elapsed : 0);
+
+        printf(", \"packets\": [");
+        for(size_t i = 0; i < instance.packet_count; i++) {
+            printf(i ? ", " : "");
+            subghz_decode_print_string(furi_string_get_cstr(instance.packets[i]));
+        }
+
+        // Stats cycles are host nanoseconds, see stubs/furi_hal.h
+        printf("], \"protocols\": {");
+        SubGhzReceiverStats stats;
+        // Receiver is not used for BinRAW windows
+        size_t count = stride ? 0 : subghz_receiver_get_stats_count(receiver);
+        for(size_t i = 0; i < count; i++) {
+            subghz_receiver_get_stats(receiver, i, &stats);
+            printf(i ? ", " : "");
+            subghz_decode_print_string(stats.name);
+            printf(
+                ": {\"pulses\": %lu, \"ns\": %llu, \"decoded\": %lu}",
+                (unsigned long)stats.feed_count,
+                (unsigned long long)stats.cycles,
+                (unsigned long)stats.decode_count);
+        }
+        printf("}}\n");
+    } else {
+        fprintf(stderr, "%s: not a valid Sub-GHz RAW file\n", path);
+        ret = 1;
+    }
+
+    for(size_t i = 0; i < instance.packet_count; i++) {
+        furi_string_free(instance.packets[i]);
+    }
+    subghz_receiver_free(receiver);
+    subghz_environment_free(environment);
+    furi_string_free(instance.window);
+    flipper_format_free(instance.serialized);
+    subghz_file_decoder_free(instance.decoder);
+
+    return ret;
+}
@@ -1,56 +1,400 @@
 #include "sector_cache.h"
 
-#include <stddef.h>
-#include <stdio.h>
 #include <string.h>
 #include <furi.h>
-#include <furi_hal_memory.h>
 
-#define SECTOR_SIZE 512
-#define N_SECTORS   8
+#define SECTOR_CACHE_NONE     UINT16_MAX
+#define SECTOR_CACHE_MAX_SIZE (UINT16_MAX - 1)
+
+typedef enum {
+    SectorCacheListNormal,
+    SectorCacheListPinned,
+    SectorCacheListCount,
+} SectorCacheList;
+
+typedef enum {
+    SectorCacheFlagValid = (1 << 0),
+    SectorCacheFlagDirty = (1 << 1),
+} SectorCacheFlag;
+
+typedef struct {
+    uint32_t sector;
+    uint16_t prev;
+    uint16_t next;
+    uint16_t hash_next;
+    uint8_t list;
+    uint8_t flags;
+} SectorCacheEntry;
 
 typedef struct {
-    uint32_t itr;
-    uint32_t sectors[N_SECTORS];
-    uint8_t sector_data[N_SECTORS][SECTOR_SIZE];
-} SectorCache;
+    uint16_t head; // Most recently used
+    uint16_t tail; // Least recently used, first to be replaced
+    uint16_t count;
+} SectorCacheLru;
+
+typedef struct {
+    uint32_t start;
+    uint32_t end;
+} SectorCachePinRange;
+
+struct SectorCache {
+    size_t size;
+    size_t pinned_max;
+    uint32_t hash_mask;
+    uint16_t* hash;
+    SectorCacheEntry* entries;
+    uint8_t* data;
+    bool data_owned;
+
+    SectorCacheLru lru[SectorCacheListCount];
+    SectorCachePinRange pins[SECTOR_CACHE_PIN_RANGE_COUNT];
+    size_t pin_count;
+
+    SectorCacheWriteCallback write_callback;
+    void* context;
+
+    SectorCacheStats stats;
+};
+
+static inline uint8_t* sector_cache_data(SectorCache* cache, uint16_t index) {
+    return &cache->data[index * SECTOR_CACHE_SECTOR_SIZE];
+}
+
+static inline uint16_t* sector_cache_bucket(SectorCache* cache, uint32_t n_sector) {
+    // Sequential sectors land in sequential buckets
+    return &cache->hash[n_sector & cache->hash_mask];
+}
 
-static SectorCache* cache = NULL;
+static void sector_cache_lru_remove(SectorCache* cache, uint16_t index) {
+    SectorCacheEntry* entry = &cache->entries[index];
+    SectorCacheLru* lru = &cache->lru[entry->list];
 
-void sector_cache_init(void) {
-    if(cache == NULL) {
-        cache = memmgr_alloc_from_pool(sizeof(SectorCache));
+    if(entry->prev != SECTOR_CACHE_NONE) {
+        cache->entries[entry->prev].next = entry->next;
+    } else {
+        lru->head = entry->next;
     }
 
-    if(cache != NULL) {
-        memset(cache, 0, sizeof(SectorCache));
+    if(entry->next != SECTOR_CACHE_NONE) {
+        cache->entries[entry->next].prev = entry->prev;
+    } else {
+        lru->tail = entry->prev;
     }
+
+    lru->count--;
 }
 
-uint8_t* sector_cache_get(uint32_t n_sector) {
-    if(cache != NULL && n_sector != 0) {
-        for(int sector_i = 0; sector_i < N_SECTORS; ++sector_i) {
-            if(cache->sectors[sector_i] == n_sector) {
-                return cache->sector_data[sector_i];
-            }
+static void sector_cache_lru_push_head(SectorCache* cache, uint16_t index, SectorCacheList list) {
+    SectorCacheEntry* entry = &cache->entries[index];
+    SectorCacheLru* lru = &cache->lru[list];
+
+    entry->list = list;
+    entry->prev = SECTOR_CACHE_NONE;
+    entry->next = lru->head;
+    if(lru->head != SECTOR_CACHE_NONE) {
+        cache->entries[lru->head].prev = index;
+    } else {
+        lru->tail = index;
+    }
+    lru->head = index;
+    lru->count++;
+}
+
+static void sector_cache_lru_push_tail(SectorCache* cache, uint16_t index, SectorCacheList list) {
+    SectorCacheEntry* entry = &cache->entries[index];
+    SectorCacheLru* lru = &cache->lru[list];
+
+    entry->list = list;
+    entry->next = SECTOR_CACHE_NONE;
+    entry->prev = lru->tail;
+    if(lru->tail != SECTOR_CACHE_NONE) {
+        cache->entries[lru->tail].next = index;
+    } else {
+        lru->head = index;
+    }
+    lru->tail = index;
+    lru->count++;
+}
+
+static void sector_cache_hash_remove(SectorCache* cache, uint16_t index) {
+    uint16_t* link = sector_cache_bucket(cache, cache->entries[index].sector);
+    while(*link != index) {
+        link = &cache->entries[*link].hash_next;
+    }
+    *link = cache->entries[index].hash_next;
+}
+
+static uint16_t sector_cache_find(SectorCache* cache, uint32_t n_sector) {
+    uint16_t index = *sector_cache_bucket(cache, n_sector);
+    while(index != SECTOR_CACHE_NONE && cache->entries[index].sector != n_sector) {
+        index = cache->entries[index].hash_next;
+    }
+    return index;
+}
+
+static void sector_cache_drop(SectorCache* cache, uint16_t index) {
+    SectorCacheEntry* entry = &cache->entries[index];
+
+    sector_cache_hash_remove(cache, index);
+    if(entry->flags & SectorCacheFlagDirty) cache->stats.dirty--;
+    entry->flags = 0;
+
+    // Free entries are reused first
+    sector_cache_lru_remove(cache, index);
+    sector_cache_lru_push_tail(cache, index, SectorCacheListNormal);
+}
+
+static bool sector_cache_write_back(SectorCache* cache, uint16_t index) {
+    SectorCacheEntry* entry = &cache->entries[index];
+    if(!(entry->flags & SectorCacheFlagDirty)) return true;
+
+    if(!cache->write_callback(cache->context, entry->sector, sector_cache_data(cache, index))) {
+        return false;
+    }
+
+    entry->flags &= ~SectorCacheFlagDirty;
+    cache->stats.dirty--;
+    cache->stats.write_backs++;
+    return true;
+}
+
+static SectorCacheList sector_cache_get_list(SectorCache* cache, uint32_t n_sector) {
+    for(size_t i = 0; i < cache->pin_count; i++) {
+        if(n_sector >= cache->pins[i].start && n_sector <= cache->pins[i].end) {
+            return SectorCacheListPinned;
         }
     }
-    return NULL;
+    return SectorCacheListNormal;
+}
+
+static uint16_t sector_cache_insert(SectorCache* cache, uint32_t n_sector) {
+    SectorCacheList list = sector_cache_get_list(cache, n_sector);
+
+    // Pinned sectors replace each other once they take their share of the cache,
+    // normal list is never empty as pinned share is less than cache size
+    uint16_t index;
+    if(list == SectorCacheListPinned && cache->lru[list].count >= cache->pinned_max) {
+        index = cache->lru[SectorCacheListPinned].tail;
+    } else {
+        index = cache->lru[SectorCacheListNormal].tail;
+    }
+
+    SectorCacheEntry* entry = &cache->entries[index];
+    if(entry->flags & SectorCacheFlagValid) {
+        if(!sector_cache_write_back(cache, index)) return SECTOR_CACHE_NONE;
+        sector_cache_hash_remove(cache, index);
+        cache->stats.evictions++;
+    }
+
+    entry->sector = n_sector;
+    entry->flags = SectorCacheFlagValid;
+
+    uint16_t* bucket = sector_cache_bucket(cache, n_sector);
+    entry->hash_next = *bucket;
+    *bucket = index;
+
+    sector_cache_lru_remove(cache, index);
+    sector_cache_lru_push_head(cache, index, list);
+
+    return index;
 }
 
-void sector_cache_put(uint32_t n_sector, uint8_t* data) {
-    if(cache == NULL) return;
-    cache->sectors[cache->itr % N_SECTORS] = n_sector;
-    memcpy(cache->sector_data[cache->itr % N_SECTORS], data, SECTOR_SIZE);
-    cache->itr++;
+SectorCache* sector_cache_alloc(size_t size, uint8_t* buffer) {
+    furi_check(size >= 2 && size <= SECTOR_CACHE_MAX_SIZE);
+
+    SectorCache* cache = malloc(sizeof(SectorCache));
+    cache->size = size;
+    cache->pinned_max = size / 2;
+
+    size_t hash_size = 1;
+    while(hash_size < size) {
+        hash_size <<= 1;
+    }
+    cache->hash_mask = hash_size - 1;
+    cache->hash = malloc(hash_size * sizeof(uint16_t));
+    cache->entries = malloc(size * sizeof(SectorCacheEntry));
+
+    if(buffer) {
+        cache->data = buffer;
+    } else {
+        cache->data = malloc(size * SECTOR_CACHE_SECTOR_SIZE);
+        cache->data_owned = true;
+    }
+
+    sector_cache_reset(cache);
+
+    return cache;
 }
 
-void sector_cache_invalidate_range(uint32_t start_sector, uint32_t end_sector) {
-    if(cache == NULL) return;
-    for(int sector_i = 0; sector_i < N_SECTORS; ++sector_i) {
-        if((cache->sectors[sector_i] >= start_sector) &&
-           (cache->sectors[sector_i] <= end_sector)) {
-            cache->sectors[sector_i] = 0;
+void sector_cache_free(SectorCache* cache) {
+    furi_check(cache);
+
+    if(cache->data_owned) free(cache->data);
+    free(cache->entries);
+    free(cache->hash);
+    free(cache);
+}
+
+void sector_cache_set_write_callback(
+    SectorCache* cache,
+    SectorCacheWriteCallback callback,
+    void* context) {
+    furi_check(cache);
+    furi_check(callback || !cache->stats.dirty);
+
+    cache->write_callback = callback;
+    cache->context = context;
+}
+
+void sector_cache_reset(SectorCache* cache) {
+    furi_check(cache);
+
+    memset(cache->hash, 0xFF, (cache->hash_mask + 1) * sizeof(uint16_t));
+    for(size_t i = 0; i < SectorCacheListCount; i++) {
+        cache->lru[i] = (SectorCacheLru){SECTOR_CACHE_NONE, SECTOR_CACHE_NONE, 0};
+    }
+    for(size_t i = 0; i < cache->size; i++) {
+        cache->entries[i].flags = 0;
+        sector_cache_lru_push_tail(cache, i, SectorCacheListNormal);
+    }
+
+    cache->pin_count = 0;
+    cache->stats.dirty = 0;
+}
+
+uint8_t* sector_cache_get(SectorCache* cache, uint32_t n_sector) {
+    furi_check(cache);
+
+    uint16_t index = sector_cache_find(cache, n_sector);
+    if(index == SECTOR_CACHE_NONE) {
+        cache->stats.misses++;
+        return NULL;
+    }
+
+    cache->stats.hits++;
+    SectorCacheList list = cache->entries[index].list;
+    sector_cache_lru_remove(cache, index);
+    sector_cache_lru_push_head(cache, index, list);
+
+    return sector_cache_data(cache, index);
+}
+
+void sector_cache_put(SectorCache* cache, uint32_t n_sector, const uint8_t* data) {
+    furi_check(cache);
+    furi_check(data);
+
+    uint16_t index = sector_cache_find(cache, n_sector);
+    if(index != SECTOR_CACHE_NONE) {
+        // Cached copy is never older than device
+        return;
+    }
+
+    index = sector_cache_insert(cache, n_sector);
+    if(index != SECTOR_CACHE_NONE) {
+        memcpy(sector_cache_data(cache, index), data, SECTOR_CACHE_SECTOR_SIZE);
+    }
+}
+
+bool sector_cache_write(SectorCache* cache, uint32_t n_sector, const uint8_t* data) {
+    furi_check(cache);
+    furi_check(data);
+
+    if(!cache->write_callback) return false;
+
+    uint16_t index = sector_cache_find(cache, n_sector);
+    if(index != SECTOR_CACHE_NONE) {
+        SectorCacheList list = cache->entries[index].list;
+        sector_cache_lru_remove(cache, index);
+        sector_cache_lru_push_head(cache, index, list);
+    } else {
+        index = sector_cache_insert(cache, n_sector);
+        if(index == SECTOR_CACHE_NONE) return false;
+    }
+
+    SectorCacheEntry* entry = &cache->entries[index];
+    if(!(entry->flags & SectorCacheFlagDirty)) {
+        entry->flags |= SectorCacheFlagDirty;
+        cache->stats.dirty++;
+    }
+    memcpy(sector_cache_data(cache, index), data, SECTOR_CACHE_SECTOR_SIZE);
+    cache->stats.writes++;
+
+    return true;
+}
+
+void sector_cache_apply_dirty(
+    SectorCache* cache,
+    uint32_t start_sector,
+    uint32_t count,
+    uint8_t* data) {
+    furi_check(cache);
+    furi_check(data);
+
+    if(!cache->stats.dirty) return;
+
+    for(size_t i = 0; i < cache->size; i++) {
+        SectorCacheEntry* entry = &cache->entries[i];
+        if((entry->flags & SectorCacheFlagDirty) && entry->sector >= start_sector &&
+           entry->sector - start_sector < count) {
+            memcpy(
+                &data[(entry->sector - start_sector) * SECTOR_CACHE_SECTOR_SIZE],
+                sector_cache_data(cache, i),
+                SECTOR_CACHE_SECTOR_SIZE);
+        }
+    }
+}
+
+void sector_cache_invalidate_range(
+    SectorCache* cache,
+    uint32_t start_sector,
+    uint32_t end_sector) {
+    furi_check(cache);
+
+    for(size_t i = 0; i < cache->size; i++) {
+        SectorCacheEntry* entry = &cache->entries[i];
+        if((entry->flags & SectorCacheFlagValid) && entry->sector >= start_sector &&
+           entry->sector <= end_sector) {
+            sector_cache_drop(cache, i);
         }
     }
 }
+
+bool sector_cache_flush(SectorCache* cache) {
+    furi_check(cache);
+
+    // Ascending order keeps card writes sequential
+    while(cache->stats.dirty) {
+        uint16_t next = SECTOR_CACHE_NONE;
+        for(size_t i = 0; i < cache->size; i++) {
+            if((cache->entries[i].flags & SectorCacheFlagDirty) &&
+               (next == SECTOR_CACHE_NONE ||
+                cache->entries[i].sector < cache->entries[next].sector)) {
+                next = i;
+            }
+        }
+
+        if(!sector_cache_write_back(cache, next)) return false;
+    }
+
+    return true;
+}
+
+bool sector_cache_pin_range(SectorCache* cache, uint32_t start_sector, uint32_t end_sector) {
+    furi_check(cache);
+    furi_check(start_sector <= end_sector);
+
+    if(cache->pin_count >= SECTOR_CACHE_PIN_RANGE_COUNT) return false;
+
+    cache->pins[cache->pin_count].start = start_sector;
+    cache->pins[cache->pin_count].end = end_sector;
+    cache->pin_count++;
+
+    return true;
+}
+
+void sector_cache_get_stats(SectorCache* cache, SectorCacheStats* stats) {
+    furi_check(cache);
+    furi_check(stats);
+
+    *stats = cache->stats;
+}
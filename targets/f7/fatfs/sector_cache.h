@@ -1,35 +1,144 @@
 #pragma once
+#include <stdbool.h>
+#include <stddef.h>
 #include <stdint.h>
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+#define SECTOR_CACHE_SECTOR_SIZE 512
+
+/** Maximum amount of pinned sector ranges */
+#define SECTOR_CACHE_PIN_RANGE_COUNT 4
+
+typedef struct SectorCache SectorCache;
+
+/**
+ * @brief Device write callback, used to write back dirty sectors
+ * @param context Callback context
+ * @param sector Sector number
+ * @param data Pointer to sector data
+ * @return true if sector was written
+ */
+typedef bool (*SectorCacheWriteCallback)(void* context, uint32_t sector, const uint8_t* data);
+
+typedef struct {
+    uint32_t hits; /*!< sectors found in cache */
+    uint32_t misses; /*!< sectors not found in cache */
+    uint32_t writes; /*!< sector writes absorbed by cache */
+    uint32_t write_backs; /*!< dirty sectors written to device */
+    uint32_t evictions; /*!< valid sectors replaced with other sectors */
+    uint32_t dirty; /*!< sectors waiting to be written to device */
+} SectorCacheStats;
+
+/**
+ * @brief Allocate sector cache
+ * Lookup is hashed, replacement is LRU. Sectors in pinned ranges are kept in
+ * a separate LRU list that takes at most half of the cache, so directory and
+ * FAT sectors are not evicted by file data.
+ * @param size Cache size in sectors, 2..65534
+ * @param buffer Sector data buffer of size * SECTOR_CACHE_SECTOR_SIZE bytes,
+ * NULL to allocate it on heap
+ * @return SectorCache instance
+ */
+SectorCache* sector_cache_alloc(size_t size, uint8_t* buffer);
+
+/**
+ * @brief Free sector cache, dirty sectors are dropped
+ * @param cache SectorCache instance
+ */
+void sector_cache_free(SectorCache* cache);
+
 /**
- * @brief Init sector cache system
+ * @brief Enable write-back
+ * Writes absorbed with sector_cache_write are written to device with the
+ * callback on eviction and on sector_cache_flush.
+ * @param cache SectorCache instance
+ * @param callback Device write callback, NULL to disable write-back
+ * @param context Callback context
  */
-void sector_cache_init(void);
+void sector_cache_set_write_callback(
+    SectorCache* cache,
+    SectorCacheWriteCallback callback,
+    void* context);
+
+/**
+ * @brief Drop all sectors, including dirty ones, and pinned ranges
+ * @param cache SectorCache instance
+ */
+void sector_cache_reset(SectorCache* cache);
 
 /**
  * @brief Get sector data from cache
+ * @param cache SectorCache instance
  * @param n_sector Sector number
  * @return Pointer to sector data or NULL if not found
  */
-uint8_t* sector_cache_get(uint32_t n_sector);
+uint8_t* sector_cache_get(SectorCache* cache, uint32_t n_sector);
 
 /**
- * @brief Put sector data to cache
+ * @brief Put sector data read from device to cache
+ * @param cache SectorCache instance
  * @param n_sector Sector number
  * @param data Pointer to sector data
  */
-void sector_cache_put(uint32_t n_sector, uint8_t* data);
+void sector_cache_put(SectorCache* cache, uint32_t n_sector, const uint8_t* data);
 
 /**
- * @brief Invalidate sector cache for given range
+ * @brief Write sector data to cache, device is updated later
+ * @param cache SectorCache instance
+ * @param n_sector Sector number
+ * @param data Pointer to sector data
+ * @return false if write-back is disabled or evicted dirty sector could not be
+ * written, sector must be written to device by the caller in that case
+ */
+bool sector_cache_write(SectorCache* cache, uint32_t n_sector, const uint8_t* data);
+
+/**
+ * @brief Copy dirty sectors over data read directly from device
+ * @param cache SectorCache instance
+ * @param start_sector First sector in data
+ * @param count Number of sectors in data
+ * @param data Pointer to sectors data
+ */
+void sector_cache_apply_dirty(
+    SectorCache* cache,
+    uint32_t start_sector,
+    uint32_t count,
+    uint8_t* data);
+
+/**
+ * @brief Invalidate sector cache for given range, dirty sectors are dropped
+ * @param cache SectorCache instance
  * @param start_sector Start sector number
- * @param end_sector End sector number
+ * @param end_sector End sector number, inclusive
+ */
+void sector_cache_invalidate_range(SectorCache* cache, uint32_t start_sector, uint32_t end_sector);
+
+/**
+ * @brief Write all dirty sectors to device in ascending order
+ * @param cache SectorCache instance
+ * @return true if all dirty sectors were written
+ */
+bool sector_cache_flush(SectorCache* cache);
+
+/**
+ * @brief Pin sector range
+ * Only sectors put to cache after this call are affected.
+ * @param cache SectorCache instance
+ * @param start_sector Start sector number
+ * @param end_sector End sector number, inclusive
+ * @return false if there are too many pinned ranges
+ */
+bool sector_cache_pin_range(SectorCache* cache, uint32_t start_sector, uint32_t end_sector);
+
+/**
+ * @brief Get cache statistics
+ * @param cache SectorCache instance
+ * @param stats Pointer to statistics
  */
-void sector_cache_invalidate_range(uint32_t start_sector, uint32_t end_sector);
+void sector_cache_get_stats(SectorCache* cache, SectorCacheStats* stats);
 
 #ifdef __cplusplus
 }
@@ -1,7 +1,6 @@
 #include <furi.h>
 #include <furi_hal.h>
 #include "user_diskio.h"
-#include "sector_cache.h"
 
 static DSTATUS driver_initialize(BYTE pdrv);
 static DSTATUS driver_status(BYTE pdrv);
@@ -87,7 +86,7 @@ static DRESULT driver_ioctl(BYTE pdrv, BYTE cmd, void* buff) {
     switch(cmd) {
     /* Make sure that no pending write process */
     case CTRL_SYNC:
-        res = RES_OK;
+        res = furi_hal_sd_sync() == FuriStatusOk ? RES_OK : RES_ERROR;
         break;
 
     /* Get number of sectors on the disk (DWORD) */
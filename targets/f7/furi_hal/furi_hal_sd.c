@@ -18,9 +18,23 @@
 #define SD_TIMEOUT_MS         (1000)
 #define SD_BLOCK_SIZE         (512)
 
+/** Sector cache size in blocks, allocated from memory pool */
+#ifndef FURI_HAL_SD_CACHE_SIZE
+#define FURI_HAL_SD_CACHE_SIZE (16)
+#endif
+
+/** Keep single block writes in sector cache until sync, off by default: pending FAT and
+ * directory updates are lost on power loss or card removal without unmount */
+#ifndef FURI_HAL_SD_CACHE_WRITE_BACK
+#define FURI_HAL_SD_CACHE_WRITE_BACK (0)
+#endif
+
 #define FLAG_SET(x, y) (((x) & (y)) == (y))
 
 static bool sd_high_capacity = false;
+static SectorCache* sd_cache = NULL;
+static uint32_t sd_read_count = 0;
+static uint32_t sd_read_block_count = 0;
 
 typedef enum {
     SdSpiDataResponceOK = 0x05,
@@ -816,27 +830,6 @@ static FuriStatus sd_spi_get_card_state(void) {
     return FuriStatusError;
 }
 
-static inline bool sd_cache_get(uint32_t address, uint32_t* data) {
-    uint8_t* cached_data = sector_cache_get(address);
-    if(cached_data) {
-        memcpy(data, cached_data, SD_BLOCK_SIZE);
-        return true;
-    }
-    return false;
-}
-
-static inline void sd_cache_put(uint32_t address, uint32_t* data) {
-    sector_cache_put(address, (uint8_t*)data);
-}
-
-static inline void sd_cache_invalidate_range(uint32_t start_sector, uint32_t end_sector) {
-    sector_cache_invalidate_range(start_sector, end_sector);
-}
-
-static inline void sd_cache_invalidate_all(void) {
-    sector_cache_init();
-}
-
 static FuriStatus sd_device_read(uint32_t* buff, uint32_t sector, uint32_t count) {
     FuriStatus status = FuriStatusError;
 
@@ -877,8 +870,6 @@ static FuriStatus sd_device_write(const uint32_t* buff, uint32_t sector, uint32_
             status = sd_spi_get_card_state();
 
             if(furi_hal_cortex_timer_is_expired(timer)) {
-                sd_cache_invalidate_all();
-
                 status = FuriStatusErrorTimeout;
                 break;
             }
@@ -911,7 +902,7 @@ uint8_t furi_hal_sd_max_mount_retry_count(void) {
     return 10;
 }
 
-FuriStatus furi_hal_sd_init(bool power_reset) {
+static FuriStatus sd_card_init(bool power_reset) {
     // Slow speed init
     furi_hal_spi_acquire(&furi_hal_spi_bus_handle_sd_slow);
     furi_hal_sd_spi_handle = &furi_hal_spi_bus_handle_sd_slow;
@@ -953,37 +944,11 @@ FuriStatus furi_hal_sd_init(bool power_reset) {
     furi_hal_sd_spi_handle = NULL;
     furi_hal_spi_release(&furi_hal_spi_bus_handle_sd_slow);
 
-    // Init sector cache
-    sector_cache_init();
-
     return status;
 }
 
-FuriStatus furi_hal_sd_get_card_state(void) {
-    furi_hal_spi_acquire(&furi_hal_spi_bus_handle_sd_fast);
-    furi_hal_sd_spi_handle = &furi_hal_spi_bus_handle_sd_fast;
-
-    FuriStatus status = sd_spi_get_card_state();
-
-    furi_hal_sd_spi_handle = NULL;
-    furi_hal_spi_release(&furi_hal_spi_bus_handle_sd_fast);
-
-    return status;
-}
-
-FuriStatus furi_hal_sd_read_blocks(uint32_t* buff, uint32_t sector, uint32_t count) {
-    furi_check(buff);
-
-    FuriStatus status;
-    bool single_sector = count == 1;
-
-    if(single_sector) {
-        if(sd_cache_get(sector, buff)) {
-            return FuriStatusOk;
-        }
-    }
-
-    status = sd_device_read(buff, sector, count);
+static FuriStatus sd_device_read_retry(uint32_t* buff, uint32_t sector, uint32_t count) {
+    FuriStatus status = sd_device_read(buff, sector, count);
 
     if(status != FuriStatusOk) {
         uint8_t counter = furi_hal_sd_max_mount_retry_count();
@@ -991,9 +956,9 @@ FuriStatus furi_hal_sd_read_blocks(uint32_t* buff, uint32_t sector, uint32_t cou
         while(status != FuriStatusOk && counter > 0 && furi_hal_sd_is_present()) {
             if((counter % 2) == 0) {
                 // power reset sd card
-                status = furi_hal_sd_init(true);
+                status = sd_card_init(true);
             } else {
-                status = furi_hal_sd_init(false);
+                status = sd_card_init(false);
             }
 
             if(status == FuriStatusOk) {
@@ -1003,21 +968,11 @@ FuriStatus furi_hal_sd_read_blocks(uint32_t* buff, uint32_t sector, uint32_t cou
         }
     }
 
-    if(single_sector && status == FuriStatusOk) {
-        sd_cache_put(sector, buff);
-    }
-
     return status;
 }
 
-FuriStatus furi_hal_sd_write_blocks(const uint32_t* buff, uint32_t sector, uint32_t count) {
-    furi_check(buff);
-
-    FuriStatus status;
-
-    sd_cache_invalidate_range(sector, sector + count);
-
-    status = sd_device_write(buff, sector, count);
+static FuriStatus sd_device_write_retry(const uint32_t* buff, uint32_t sector, uint32_t count) {
+    FuriStatus status = sd_device_write(buff, sector, count);
 
     if(status != FuriStatusOk) {
         uint8_t counter = furi_hal_sd_max_mount_retry_count();
@@ -1025,9 +980,9 @@ FuriStatus furi_hal_sd_write_blocks(const uint32_t* buff, uint32_t sector, uint3
         while(status != FuriStatusOk && counter > 0 && furi_hal_sd_is_present()) {
             if((counter % 2) == 0) {
                 // power reset sd card
-                status = furi_hal_sd_init(true);
+                status = sd_card_init(true);
             } else {
-                status = furi_hal_sd_init(false);
+                status = sd_card_init(false);
             }
 
             if(status == FuriStatusOk) {
@@ -1040,6 +995,136 @@ FuriStatus furi_hal_sd_write_blocks(const uint32_t* buff, uint32_t sector, uint3
     return status;
 }
 
+static bool sd_cache_write_callback(void* context, uint32_t sector, const uint8_t* data) {
+    UNUSED(context);
+    return sd_device_write_retry((const uint32_t*)data, sector, 1) == FuriStatusOk;
+}
+
+static void sd_cache_reset(void) {
+    if(sd_cache == NULL) {
+        sd_cache = sector_cache_alloc(
+            FURI_HAL_SD_CACHE_SIZE,
+            memmgr_alloc_from_pool(FURI_HAL_SD_CACHE_SIZE * SECTOR_CACHE_SECTOR_SIZE));
+#if FURI_HAL_SD_CACHE_WRITE_BACK
+        sector_cache_set_write_callback(sd_cache, sd_cache_write_callback, NULL);
+#endif
+    } else {
+        sector_cache_reset(sd_cache);
+    }
+}
+
+FuriStatus furi_hal_sd_init(bool power_reset) {
+    // Same card as before, furi_hal_sd_deinit drops the cache when it can be replaced
+    if(sd_cache != NULL && !sector_cache_flush(sd_cache)) {
+        FURI_LOG_E(TAG, "Cache write back failed");
+    }
+
+    FuriStatus status = sd_card_init(power_reset);
+
+    // Retries inside read and write keep the cache
+    sd_cache_reset();
+
+    return status;
+}
+
+FuriStatus furi_hal_sd_deinit(void) {
+    if(sd_cache == NULL) return FuriStatusOk;
+
+    FuriStatus status = sector_cache_flush(sd_cache) ? FuriStatusOk : FuriStatusError;
+    // Card may be replaced before the next init, nothing must be written to the new one
+    sector_cache_reset(sd_cache);
+
+    return status;
+}
+
+FuriStatus furi_hal_sd_get_card_state(void) {
+    furi_hal_spi_acquire(&furi_hal_spi_bus_handle_sd_fast);
+    furi_hal_sd_spi_handle = &furi_hal_spi_bus_handle_sd_fast;
+
+    FuriStatus status = sd_spi_get_card_state();
+
+    furi_hal_sd_spi_handle = NULL;
+    furi_hal_spi_release(&furi_hal_spi_bus_handle_sd_fast);
+
+    return status;
+}
+
+FuriStatus furi_hal_sd_read_blocks(uint32_t* buff, uint32_t sector, uint32_t count) {
+    furi_check(buff);
+    furi_check(sd_cache);
+
+    FuriStatus status;
+
+    if(count == 1) {
+        uint8_t* cached_data = sector_cache_get(sd_cache, sector);
+        if(cached_data) {
+            memcpy(buff, cached_data, SD_BLOCK_SIZE);
+            return FuriStatusOk;
+        }
+    }
+
+    status = sd_device_read_retry(buff, sector, count);
+    sd_read_count++;
+    sd_read_block_count += count;
+
+    if(status == FuriStatusOk) {
+        if(count == 1) {
+            sector_cache_put(sd_cache, sector, (uint8_t*)buff);
+        } else {
+            sector_cache_apply_dirty(sd_cache, sector, count, (uint8_t*)buff);
+        }
+    }
+
+    return status;
+}
+
+FuriStatus furi_hal_sd_write_blocks(const uint32_t* buff, uint32_t sector, uint32_t count) {
+    furi_check(buff);
+    furi_check(sd_cache);
+
+    // Single sector writes are FAT, directory and FSInfo updates, often repeated
+    if(count == 1 && sector_cache_write(sd_cache, sector, (const uint8_t*)buff)) {
+        return FuriStatusOk;
+    }
+
+    FuriStatus status = sd_device_write_retry(buff, sector, count);
+
+    // Written data supersedes cached copies, including dirty ones
+    sector_cache_invalidate_range(sd_cache, sector, sector + count - 1);
+
+    return status;
+}
+
+FuriStatus furi_hal_sd_sync(void) {
+    if(sd_cache == NULL) return FuriStatusOk;
+    return sector_cache_flush(sd_cache) ? FuriStatusOk : FuriStatusError;
+}
+
+void furi_hal_sd_cache_pin_range(uint32_t start_sector, uint32_t end_sector) {
+    furi_check(sd_cache);
+    sector_cache_pin_range(sd_cache, start_sector, end_sector);
+}
+
+void furi_hal_sd_cache_get_stats(FuriHalSdCacheStats* stats) {
+    furi_check(stats);
+
+    memset(stats, 0, sizeof(FuriHalSdCacheStats));
+    if(sd_cache == NULL) return;
+
+    SectorCacheStats cache_stats;
+    sector_cache_get_stats(sd_cache, &cache_stats);
+
+    stats->size = FURI_HAL_SD_CACHE_SIZE;
+    stats->hits = cache_stats.hits;
+    stats->misses = cache_stats.misses;
+    stats->writes = cache_stats.writes;
+    stats->write_backs = cache_stats.write_backs;
+    stats->evictions = cache_stats.evictions;
+    stats->dirty = cache_stats.dirty;
+    stats->reads = sd_read_count;
+    stats->read_blocks = sd_read_block_count;
+}
+
 FuriStatus furi_hal_sd_info(FuriHalSdInfo* info) {
     furi_check(info);
 
@@ -26,6 +26,18 @@ typedef struct {
     uint16_t manufacturing_year; /*!< manufacturing year */
 } FuriHalSdInfo;
 
+typedef struct {
+    uint32_t size; /*!< cache size in blocks */
+    uint32_t hits; /*!< blocks read from cache */
+    uint32_t misses; /*!< blocks read from card */
+    uint32_t writes; /*!< block writes absorbed by cache */
+    uint32_t write_backs; /*!< cached blocks written to card */
+    uint32_t evictions; /*!< cached blocks replaced with other blocks */
+    uint32_t dirty; /*!< blocks waiting to be written to card */
+    uint32_t reads; /*!< read transactions sent to card */
+    uint32_t read_blocks; /*!< blocks read from card in those transactions */
+} FuriHalSdCacheStats;
+
 /** 
  * @brief Init SD card presence detection
  */
@@ -50,6 +62,13 @@ uint8_t furi_hal_sd_max_mount_retry_count(void);
  */
 FuriStatus furi_hal_sd_init(bool power_reset);
 
+/**
+ * @brief Write blocks kept in cache to SD card and drop the cache
+ * Call before the card is unmounted, it may be replaced before the next init.
+ * @return FuriStatus
+ */
+FuriStatus furi_hal_sd_deinit(void);
+
 /**
  * @brief Read blocks from SD card
  * @param buff 
@@ -68,6 +87,28 @@ FuriStatus furi_hal_sd_read_blocks(uint32_t* buff, uint32_t sector, uint32_t cou
  */
 FuriStatus furi_hal_sd_write_blocks(const uint32_t* buff, uint32_t sector, uint32_t count);
 
+/**
+ * @brief Write blocks kept in cache to SD card
+ * Single block writes may be held in cache, call this before the card can
+ * be removed or the file system state must be durable.
+ * @return FuriStatus
+ */
+FuriStatus furi_hal_sd_sync(void);
+
+/**
+ * @brief Keep blocks in range cached in preference to other blocks
+ * Used for FAT and directory blocks. Pinned ranges are cleared by furi_hal_sd_init.
+ * @param start_sector first block
+ * @param end_sector last block, inclusive
+ */
+void furi_hal_sd_cache_pin_range(uint32_t start_sector, uint32_t end_sector);
+
+/**
+ * @brief Get sector cache statistics
+ * @param stats pointer to statistics
+ */
+void furi_hal_sd_cache_get_stats(FuriHalSdCacheStats* stats);
+
 /**
  * @brief Get SD card info
  * @param info 